@@ -0,0 +1,118 @@
+#!/bin/sh
+#
+#  bench.sh
+#  Measures how fast the simulators themselves run. Every program in
+#  throughput/ is run on each simulator for a fixed number of cycles with
+#  --quiet, a few times, and the best simulated cycles and instructions per
+#  host second are compared with bench.baseline.
+#
+#  Usage : ./bench.sh [--threshold=PCT] [--reps=N] [--cycles=N] [--update]
+#  A program that runs more than PCT percent (default 10) fewer cycles per
+#  second than its baseline is a regression, and the script exits with 1.
+#  --update writes this run to bench.baseline instead. The baseline only
+#  means something on the machine and compiler it was measured with.
+#
+
+cd "$(dirname "$0")" || exit 1
+
+THRESHOLD=10
+REPS=3
+CYCLES=1000000
+UPDATE=0
+SIMS="part_a part_b sim2"
+
+sim_dir() {
+  case $1 in
+    part_a) echo "../Simulator I/Part A" ;;
+    part_b) echo "../Simulator I/Part B" ;;
+    sim2) echo "../Simulator II" ;;
+  esac
+}
+
+# Prints statistic $2 of the --stats-csv file $1, rounded to an integer
+stat_value() {
+  awk -F, -v n="$2" '$1 == n { printf "%.0f\n", $2 }' "$1"
+}
+
+for arg in "$@"; do
+  case $arg in
+    --threshold=*) THRESHOLD=${arg#*=} ;;
+    --reps=*) REPS=${arg#*=} ;;
+    --cycles=*) CYCLES=${arg#*=} ;;
+    --update) UPDATE=1 ;;
+    *)
+      echo "APEX_Help : Usage $0 [--threshold=PCT] [--reps=N] [--cycles=N] [--update]" >&2
+      exit 1
+      ;;
+  esac
+done
+
+for sim in $SIMS; do
+  if [ ! -x "$(sim_dir $sim)/apex_sim" ]; then
+    echo "APEX_Error : $(sim_dir $sim)/apex_sim is not built" >&2
+    exit 1
+  fi
+done
+
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+programs=$(cd throughput && ls *.s | sed 's/\.s$//')
+for program in $programs; do
+  ../Tools/apex_as "throughput/$program.s" -o "$tmp/$program.apexo" \
+    >/dev/null || exit 1
+done
+
+{
+  echo "# Simulator throughput from bench.sh, best of $REPS runs of $CYCLES cycles"
+  echo "# $(uname -m), $(${CC:-gcc} --version 2>/dev/null | head -n 1)"
+  echo "# sim     program   cycles/s   instructions/s"
+} >"$tmp/baseline"
+
+failed=0
+printf "%-8s %-9s %12s %12s %12s %8s\n" Sim Program Cycles/s Ins/s Baseline Change
+
+for sim in $SIMS; do
+  for program in $programs; do
+    best_cycles=0
+    best_ins=0
+    rep=0
+    while [ $rep -lt "$REPS" ]; do
+      rm -f "$tmp/stats"
+      "$(sim_dir $sim)/apex_sim" "$tmp/$program.apexo" simulate "$CYCLES" \
+        --stats-csv="$tmp/stats" --quiet >/dev/null 2>&1
+      cycles=$(stat_value "$tmp/stats" sim.cycles_per_second)
+      ins=$(stat_value "$tmp/stats" sim.instructions_per_second)
+      if [ "${cycles:-0}" -gt "$best_cycles" ]; then
+        best_cycles=$cycles
+        best_ins=$ins
+      fi
+      rep=$((rep + 1))
+    done
+
+    printf "%-9s %-9s %-10s %s\n" $sim "$program" $best_cycles $best_ins \
+      >>"$tmp/baseline"
+
+    baseline=$(awk -v s=$sim -v p="$program" \
+      '$1 == s && $2 == p { print $3 }' bench.baseline 2>/dev/null)
+    if [ -z "$baseline" ] || [ $UPDATE = 1 ]; then
+      printf "%-8s %-9s %12s %12s %12s %8s\n" $sim "$program" $best_cycles \
+        $best_ins "${baseline:--}" -
+      continue
+    fi
+
+    change=$(awk -v n=$best_cycles -v b="$baseline" \
+      'BEGIN { printf "%+.1f", (n / b - 1) * 100 }')
+    result=$(awk -v c="$change" -v t="$THRESHOLD" \
+      'BEGIN { print (c < -t) ? "SLOWER" : "" }')
+    [ -n "$result" ] && failed=1
+    printf "%-8s %-9s %12s %12s %12s %7s%% %s\n" $sim "$program" \
+      $best_cycles $best_ins "$baseline" "$change" "$result"
+  done
+done
+
+if [ $UPDATE = 1 ]; then
+  cp "$tmp/baseline" bench.baseline
+  echo "APEX_Bench : wrote bench.baseline"
+fi
+exit $failed
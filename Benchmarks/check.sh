@@ -0,0 +1,121 @@
+#!/bin/sh
+#
+#  check.sh
+#  Runs the benchmark kernels on the three simulators and checks the final
+#  state of each run against <kernel>.golden. The cycles to HALT are shown
+#  next to the reference in cycles.ref; with no simulator options a run
+#  that takes other cycles than its reference fails as CYCLES.
+#
+#  Usage : ./check.sh [kernel ...] [-- simulator options]
+#  With no kernels every *.s here is run. Simulator options, such as
+#  --l1d=64:2:16, are passed to every run; the state must not change, the
+#  cycles may. Every run is checked in lockstep against the functional
+#  model, --check=digest:N trades that for a digest every N retires. A
+#  run that exits with a non-zero status, diverged or faulted, fails.
+#
+#  A simulator with no reference cycles for a kernel ('-' in cycles.ref) is
+#  known not to reach its golden state; it is reported as XFAIL, or XPASS
+#  once it does. Exits with 1 if any other run fails.
+#
+
+cd "$(dirname "$0")" || exit 1
+
+MAX_CYCLES=100000
+SIMS="part_a part_b sim2"
+
+sim_dir() {
+  case $1 in
+    part_a) echo "../Simulator I/Part A" ;;
+    part_b) echo "../Simulator I/Part B" ;;
+    sim2) echo "../Simulator II" ;;
+  esac
+}
+
+# Prints column $2 of the cycles.ref line for kernel $1
+reference() {
+  awk -v k="$1" -v col="$2" '$1 == k { print $col }' cycles.ref
+}
+
+# Prints the word at index $2 of the binary image $1, 0 past its end
+word_at() {
+  value=$(od -An -t d4 -j $(($2 * 4)) -N 4 "$1" 2>/dev/null | tr -d ' ')
+  echo "${value:-0}"
+}
+
+# Prints statistic $2 of the --stats-csv file $1
+stat_value() {
+  awk -F, -v n="$2" '$1 == n { print $2 }' "$1"
+}
+
+kernels=
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+  kernels="$kernels $1"
+  shift
+done
+[ "$1" = "--" ] && shift
+if [ -z "$kernels" ]; then
+  kernels=$(ls *.s | sed 's/\.s$//')
+fi
+
+for sim in $SIMS; do
+  if [ ! -x "$(sim_dir $sim)/apex_sim" ]; then
+    echo "APEX_Error : $(sim_dir $sim)/apex_sim is not built" >&2
+    exit 1
+  fi
+done
+
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+failed=0
+printf "%-10s %-8s %-6s %10s %10s\n" Kernel Sim Result Cycles Reference
+
+for kernel in $kernels; do
+  if ! ../Tools/apex_as "$kernel.s" -o "$tmp/$kernel.apexo" >/dev/null; then
+    failed=1
+    continue
+  fi
+
+  column=2
+  for sim in $SIMS; do
+    ref=$(reference "$kernel" $column)
+    column=$((column + 1))
+
+    rm -f "$tmp/stats"
+    "$(sim_dir $sim)/apex_sim" "$tmp/$kernel.apexo" simulate $MAX_CYCLES \
+      --mem-out="$tmp/mem" --regs-out="$tmp/regs" --stats-csv="$tmp/stats" \
+      --quiet --check=lockstep "$@" >/dev/null 2>&1
+    status=$?
+
+    result=PASS
+    if [ $status != 0 ] || [ "$(stat_value "$tmp/stats" sim.halted)" != 1 ] ||
+       [ "$(stat_value "$tmp/stats" check.diverged)" != 0 ] ||
+       [ "$(stat_value "$tmp/stats" check.final_diverged)" != 0 ]; then
+      result=FAIL
+    fi
+
+    while read -r kind index value; do
+      case $kind in
+        hash) [ "$(stat_value "$tmp/stats" sim.state_hash)" = "$index" ] ;;
+        reg) [ "$(word_at "$tmp/regs" "$index")" = "$value" ] ;;
+        mem) [ "$(word_at "$tmp/mem" "$index")" = "$value" ] ;;
+        *) true ;;
+      esac || result=FAIL
+    done <"$kernel.golden"
+
+    cycles=$(stat_value "$tmp/stats" sim.cycles)
+    if [ "$ref" = "-" ]; then
+      result=X$result
+    elif [ $result = PASS ] && [ $# -eq 0 ] && [ "$cycles" != "$ref" ]; then
+      result=CYCLES
+    fi
+    case $result in
+      FAIL | CYCLES) failed=1 ;;
+    esac
+
+    printf "%-10s %-8s %-6s %10s %10s\n" "$kernel" $sim $result \
+      "$cycles" "${ref:-?}"
+  done
+done
+
+exit $failed
@@ -0,0 +1,42 @@
+; Dot product of two vectors of N words
+        .equ N, 64
+
+        .data 0
+result: .word 0
+
+        .data 256
+a:
+        .word 20, -8, 46, -34, 45, -7, -31, -14
+        .word 5, -18, 22, -43, 45, 17, 46, -15
+        .word 33, -4, 41, 24, 46, -38, -4, -49
+        .word 15, -49, -38, 42, 13, -3, 43, -47
+        .word -7, 36, 13, -44, -48, -20, -9, -40
+        .word -30, -7, -29, 22, -41, 11, -4, -40
+        .word -13, -30, 23, -41, 36, -34, 19, 43
+        .word 6, 13, -9, 0, 29, -1, -46, -17
+b:
+        .word 49, 26, 48, 8, 14, 21, 46, -45
+        .word -36, 35, -7, 20, 10, -38, -41, -2
+        .word 1, -25, 6, -1, 37, -50, -17, 24
+        .word 42, -22, -19, 50, 24, -28, -48, 35
+        .word -40, -38, -36, 39, -28, -47, -34, 39
+        .word 12, 28, 28, -49, 35, 9, 14, 46
+        .word -29, 46, 18, -13, 19, 6, 44, 0
+        .word -44, 39, -1, 16, 44, 29, -15, 19
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R10, #b - a        ; distance from a[i] to b[i]
+        MOVC R1, #a             ; pointer into a
+        MOVC R2, #N             ; elements left
+        MOVC R3, #0             ; sum
+loop:   LOAD R4, R1, #0
+        LDR R5, R1, R10
+        MUL R6, R4, R5
+        ADD R3, R3, R6
+        ADDL R1, R1, #1
+        SUB R2, R2, R9
+        BNZ loop
+        STORE R3, R0, #result
+        HALT
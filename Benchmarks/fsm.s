@@ -0,0 +1,70 @@
+; State machine counting the 1, 2, 3 runs in a string of symbols, and
+; the zero symbols. Every symbol takes a different path of branches
+        .equ N, 128
+
+        .macro GOTO target
+        SUB R15, R15, R15
+        BZ \target
+        .endm
+
+        .data 0
+matches: .word 0
+zeros:  .word 0
+state:  .word 0
+
+        .data 256
+input:
+        .word 2, 1, 1, 1, 1, 2, 2, 1, 2, 2, 2, 2, 3, 1, 3, 2
+        .word 2, 1, 1, 3, 0, 3, 3, 1, 0, 1, 3, 1, 1, 3, 1, 0
+        .word 1, 3, 3, 3, 2, 2, 1, 1, 3, 3, 2, 0, 1, 1, 0, 2
+        .word 1, 1, 2, 3, 1, 1, 1, 2, 0, 2, 0, 2, 1, 1, 1, 2
+        .word 1, 0, 3, 3, 2, 0, 3, 1, 0, 1, 0, 2, 1, 3, 0, 2
+        .word 2, 1, 3, 0, 0, 3, 0, 0, 1, 3, 1, 3, 2, 1, 1, 1
+        .word 1, 1, 1, 1, 3, 1, 1, 3, 3, 3, 2, 1, 1, 2, 2, 1
+        .word 1, 1, 3, 1, 1, 0, 0, 1, 3, 3, 1, 2, 1, 1, 1, 1
+
+        .text
+        MOVC R0, #0
+        MOVC R10, #1
+        MOVC R11, #2
+        MOVC R12, #3
+        MOVC R1, #input
+        MOVC R2, #N
+        MOVC R3, #0             ; state, the length of the run so far
+        MOVC R4, #0             ; matches
+        MOVC R5, #0             ; zeros
+loop:   LOAD R6, R1, #0
+        ADD R7, R6, R0
+        BNZ dispatch
+        ADDL R5, R5, #1
+dispatch:
+        ADD R7, R3, R0
+        BZ s0
+        SUB R7, R3, R10
+        BZ s1
+        SUB R7, R6, R12         ; state 2
+        BZ match
+        SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+s1:     SUB R7, R6, R11
+        BZ to2
+        SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+s0:     SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+match:  ADDL R4, R4, #1
+to0:    MOVC R3, #0
+        GOTO next
+to1:    MOVC R3, #1
+        GOTO next
+to2:    MOVC R3, #2
+next:   ADDL R1, R1, #1
+        SUB R2, R2, R10
+        BNZ loop
+        STORE R4, R0, #matches
+        STORE R5, R0, #zeros
+        STORE R3, R0, #state
+        HALT
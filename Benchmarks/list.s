@@ -0,0 +1,72 @@
+; Sums and counts the nodes of a linked list scattered over memory. A
+; node is a value followed by the address of the next node, 0 at the end
+        .data 0
+sum:    .word 0
+count:  .word 0
+head:   .word n12
+
+        .data 512
+n0:     .word 89, n42
+n1:     .word 617, n14
+n2:     .word 808, n6
+n3:     .word 80, n18
+n4:     .word 887, n19
+n5:     .word 92, n47
+n6:     .word 544, n25
+n7:     .word 450, n24
+n8:     .word 134, n26
+n9:     .word 617, n32
+n10:    .word 379, n23
+n11:    .word 196, n35
+n12:    .word 978, n28
+n13:    .word 727, n37
+n14:    .word 501, n45
+n15:    .word 519, n36
+n16:    .word 572, n43
+n17:    .word 615, n20
+n18:    .word 23, n21
+n19:    .word 757, n15
+n20:    .word 570, n40
+n21:    .word 664, n41
+n22:    .word 793, n33
+n23:    .word 519, n16
+n24:    .word 999, n2
+n25:    .word 616, n0
+n26:    .word 862, 0
+n27:    .word 263, n13
+n28:    .word 29, n1
+n29:    .word 602, n8
+n30:    .word 355, n34
+n31:    .word 841, n46
+n32:    .word 567, n11
+n33:    .word 193, n9
+n34:    .word 588, n7
+n35:    .word 991, n4
+n36:    .word 406, n31
+n37:    .word 522, n10
+n38:    .word 704, n44
+n39:    .word 325, n22
+n40:    .word 299, n30
+n41:    .word 508, n29
+n42:    .word 810, n39
+n43:    .word 404, n5
+n44:    .word 282, n27
+n45:    .word 424, n38
+n46:    .word 945, n3
+n47:    .word 226, n17
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R2, #0             ; sum
+        MOVC R3, #0             ; count
+        LOAD R1, R0, #head
+loop:   LOAD R4, R1, #0
+        ADD R2, R2, R4
+        ADDL R3, R3, #1
+        LDR R1, R1, R9
+        ADD R1, R1, R0
+        BNZ loop
+        STORE R2, R0, #sum
+        STORE R3, R0, #count
+        HALT
@@ -0,0 +1,51 @@
+; C = A * B for N x N matrices stored by rows
+        .equ N, 6
+
+        .data 0
+C:      .space N * N
+
+        .data 256
+A:
+        .word 7, -4, 1, 6, 0, 6
+        .word -6, 2, 8, -7, 9, 2
+        .word 5, 3, -9, 5, 5, -6
+        .word -2, 2, 8, -4, 5, -6
+        .word -2, 0, -6, -2, 4, -8
+        .word 4, 2, 5, 8, -9, -4
+B:
+        .word -6, 6, 1, 7, -6, 7
+        .word -2, 8, 5, -2, -5, -3
+        .word 3, -3, -1, -2, 8, 7
+        .word 3, 5, -3, -5, 5, -6
+        .word 5, 8, -3, 9, -9, 2
+        .word 4, 9, -1, -2, -3, 2
+
+        .text
+        MOVC R0, #0
+        MOVC R13, #1
+        MOVC R1, #A             ; row i of A
+        MOVC R2, #C             ; C[i][j]
+        MOVC R4, #N             ; rows left
+row:    MOVC R3, #B             ; column j of B
+        MOVC R5, #N             ; columns left
+col:    ADDL R8, R1, #0         ; walks along the row of A
+        ADDL R9, R3, #0         ; walks down the column of B
+        MOVC R7, #0
+        MOVC R6, #N
+dot:    LOAD R10, R8, #0
+        LOAD R11, R9, #0
+        MUL R12, R10, R11
+        ADD R7, R7, R12
+        ADDL R8, R8, #1
+        ADDL R9, R9, #N
+        SUB R6, R6, R13
+        BNZ dot
+        STORE R7, R2, #0
+        ADDL R2, R2, #1
+        ADDL R3, R3, #1
+        SUB R5, R5, R13
+        BNZ col
+        ADDL R1, R1, #N
+        SUB R4, R4, R13
+        BNZ row
+        HALT
@@ -0,0 +1,55 @@
+; Sets N words to a value, then copies N words, both unrolled by 4
+        .equ N, 96
+        .equ FILL, 0x55
+
+        .macro COPY off
+        LOAD R4, R1, #\off
+        STORE R4, R2, #\off
+        .endm
+
+        .data 0
+dst:    .space N
+
+        .data 1024
+src:
+        .word 877, -252, -905, 117, -653, -895, -65, -338
+        .word -410, -753, -833, -202, 152, 576, 503, -29
+        .word 944, 265, -893, 735, -888, 725, -227, -124
+        .word -953, -288, -464, -977, -726, 522, 762, -717
+        .word 430, -47, 2, -749, -372, 530, -326, -61
+        .word -184, -769, -941, 199, 150, -817, -691, -285
+        .word 52, -412, 144, 556, 825, 230, -920, -562
+        .word 751, -315, 831, -82, 453, 702, 295, -285
+        .word -206, 545, -132, -854, -875, -756, 66, 592
+        .word 164, -259, -864, -908, 448, -590, 900, -134
+        .word -527, -820, 722, -232, -386, 350, -847, 540
+        .word -273, 167, -347, 500, -689, -457, 938, 4
+
+        .data 2048
+fill:   .space N
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R1, #fill
+        MOVC R2, #N / 4
+        MOVC R3, #FILL
+set:    STORE R3, R1, #0
+        STORE R3, R1, #1
+        STORE R3, R1, #2
+        STORE R3, R1, #3
+        ADDL R1, R1, #4
+        SUB R2, R2, R9
+        BNZ set
+        MOVC R1, #src
+        MOVC R2, #dst
+        MOVC R3, #N / 4
+copy:   COPY 0
+        COPY 1
+        COPY 2
+        COPY 3
+        ADDL R1, R1, #4
+        ADDL R2, R2, #4
+        SUB R3, R3, R9
+        BNZ copy
+        HALT
@@ -0,0 +1,46 @@
+; Evaluates a degree 6 polynomial at N points with Horner's rule
+        .equ N, 32
+
+        .macro STEP c
+        MUL R9, R9, R8
+        ADD R9, R9, \c
+        .endm
+
+        .data 0
+y:      .space N
+
+        .data 256
+x:
+        .word -16, -15, -14, -13, -12, -11, -10, -9
+        .word -8, -7, -6, -5, -4, -3, -2, -1
+        .word 0, 1, 2, 3, 4, 5, 6, 7
+        .word 8, 9, 10, 11, 12, 13, 14, 15
+c:      .word 3, -2, 5, 0, -7, 1, 2     ; c0 to c6
+
+        .text
+        MOVC R0, #0
+        MOVC R12, #1
+        LOAD R1, R0, #c
+        LOAD R2, R0, #c + 1
+        LOAD R3, R0, #c + 2
+        LOAD R4, R0, #c + 3
+        LOAD R5, R0, #c + 4
+        LOAD R6, R0, #c + 5
+        LOAD R7, R0, #c + 6
+        MOVC R13, #x
+        MOVC R10, #y
+        MOVC R11, #N
+loop:   LOAD R8, R13, #0
+        ADDL R9, R7, #0
+        STEP R6
+        STEP R5
+        STEP R4
+        STEP R3
+        STEP R2
+        STEP R1
+        STORE R9, R10, #0
+        ADDL R13, R13, #1
+        ADDL R10, R10, #1
+        SUB R11, R11, R12
+        BNZ loop
+        HALT
@@ -0,0 +1,27 @@
+; In place prefix sum, x[i] = x[0] + ... + x[i]
+        .equ N, 64
+
+        .data 0
+x:
+        .word -30, -59, -51, 14, 12, -6, -82, 80
+        .word 21, 97, -55, 74, 26, -63, -7, 7
+        .word 28, -61, 65, 9, -44, 90, -89, -47
+        .word -39, -32, 28, -41, -100, 39, -53, -90
+        .word -25, 19, -53, 78, -28, 100, 41, -19
+        .word 34, 26, 92, -89, 5, 75, -21, -16
+        .word -35, 27, 52, -6, -32, 44, -54, -55
+        .word -26, -65, -1, -46, 97, -46, 58, -72
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R1, #x
+        MOVC R2, #N
+        MOVC R3, #0             ; running sum
+loop:   LOAD R4, R1, #0
+        ADD R3, R3, R4
+        STORE R3, R1, #0
+        ADDL R1, R1, #1
+        SUB R2, R2, R9
+        BNZ loop
+        HALT
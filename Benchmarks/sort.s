@@ -0,0 +1,35 @@
+; Insertion sort of N signed words. There is no compare instruction, so
+; a < b is the sign bit of a - b, moved into the zero flag by an ADD
+        .equ N, 24
+        .equ SIGN, 0x80000000
+
+        .data 0
+a:
+        .word -416, -132, -308, -319, -326, -356, -213, 5
+        .word -37, 371, -359, -149, -293, 101, -489, -14
+        .word -25, 205, -199, -76, 282, 127, -391, -5
+
+        .text
+        MOVC R0, #0
+        MOVC R13, #1
+        MOVC R12, #SIGN
+        MOVC R1, #a + 1         ; a[i]
+        MOVC R2, #N - 1         ; elements left to insert
+outer:  LOAD R3, R1, #0         ; key
+        SUBL R4, R1, #1         ; a[j]
+inner:  LOAD R6, R4, #0
+        SUB R7, R3, R6
+        AND R7, R7, R12
+        ADD R7, R7, R0
+        BZ place                ; a[j] <= key
+        STORE R6, R4, #1
+        SUBL R4, R4, #1
+        SUBL R5, R4, #a
+        AND R5, R5, R12
+        ADD R5, R5, R0
+        BZ inner                ; j >= 0
+place:  STORE R3, R4, #1
+        ADDL R1, R1, #1
+        SUB R2, R2, R13
+        BNZ outer
+        HALT
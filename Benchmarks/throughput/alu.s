@@ -0,0 +1,18 @@
+; Integer and multiply work in a loop, no memory traffic
+        .equ ITERATIONS, 1000000
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R1, #ITERATIONS
+        MOVC R2, #7
+loop:   ADD R2, R2, R9
+        MUL R3, R2, R2
+        SUB R4, R3, R2
+        AND R5, R4, R3
+        OR R6, R5, R2
+        EX-OR R7, R6, R4
+        ADDL R8, R7, #3
+        SUB R1, R1, R9
+        BNZ loop
+        HALT
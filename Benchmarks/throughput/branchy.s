@@ -0,0 +1,123 @@
+; The state machine of fsm.s over 1024 random symbols, PASSES times
+        .equ N, 1024
+        .equ PASSES, 200
+
+        .macro GOTO target
+        SUB R15, R15, R15
+        BZ \target
+        .endm
+
+        .data 2048
+input:
+        .word 1, 3, 2, 0, 2, 3, 3, 1, 0, 3, 0, 1, 0, 0, 3, 0
+        .word 1, 1, 3, 0, 2, 3, 1, 3, 3, 2, 2, 3, 1, 3, 3, 2
+        .word 2, 2, 1, 3, 2, 2, 3, 0, 3, 1, 2, 0, 0, 0, 0, 0
+        .word 1, 0, 2, 0, 0, 3, 0, 1, 0, 1, 1, 2, 1, 1, 0, 3
+        .word 0, 1, 0, 1, 2, 2, 3, 1, 0, 2, 3, 0, 3, 0, 3, 1
+        .word 0, 1, 1, 0, 3, 3, 1, 0, 1, 0, 1, 1, 2, 3, 0, 2
+        .word 2, 1, 2, 0, 0, 3, 2, 1, 0, 2, 0, 3, 3, 0, 0, 3
+        .word 2, 0, 2, 2, 3, 0, 0, 2, 1, 0, 2, 3, 3, 2, 1, 3
+        .word 3, 1, 0, 0, 2, 0, 1, 0, 1, 3, 3, 3, 2, 1, 1, 1
+        .word 3, 1, 0, 3, 2, 1, 0, 3, 3, 1, 1, 1, 0, 2, 0, 3
+        .word 1, 1, 2, 3, 1, 2, 3, 0, 0, 3, 3, 0, 0, 1, 3, 2
+        .word 0, 1, 1, 0, 2, 1, 3, 0, 2, 0, 2, 3, 3, 2, 0, 0
+        .word 2, 2, 1, 2, 2, 3, 2, 3, 3, 2, 2, 2, 1, 3, 0, 0
+        .word 3, 1, 2, 2, 0, 3, 0, 1, 0, 1, 1, 2, 0, 1, 0, 1
+        .word 3, 3, 1, 2, 1, 1, 3, 3, 3, 3, 3, 0, 1, 1, 3, 2
+        .word 3, 2, 3, 2, 1, 3, 0, 1, 0, 3, 3, 1, 2, 0, 1, 3
+        .word 1, 0, 2, 1, 0, 0, 2, 0, 2, 0, 3, 1, 1, 2, 2, 2
+        .word 3, 3, 3, 0, 1, 3, 1, 3, 1, 3, 2, 2, 2, 2, 0, 2
+        .word 3, 2, 1, 3, 0, 2, 1, 1, 1, 2, 2, 0, 1, 0, 2, 3
+        .word 2, 0, 1, 0, 1, 2, 0, 3, 3, 0, 3, 0, 0, 2, 0, 2
+        .word 1, 1, 2, 2, 2, 3, 0, 1, 2, 0, 2, 3, 1, 2, 3, 2
+        .word 1, 1, 0, 3, 3, 1, 2, 1, 3, 0, 0, 2, 1, 0, 3, 3
+        .word 2, 3, 2, 0, 1, 2, 2, 2, 3, 1, 2, 1, 2, 2, 1, 2
+        .word 3, 3, 0, 0, 0, 0, 3, 2, 1, 0, 2, 1, 1, 0, 0, 0
+        .word 0, 0, 0, 0, 1, 0, 2, 1, 1, 1, 3, 1, 1, 1, 3, 3
+        .word 2, 0, 0, 3, 3, 2, 1, 1, 2, 3, 2, 1, 0, 3, 1, 1
+        .word 3, 3, 2, 2, 0, 1, 2, 0, 1, 1, 3, 3, 0, 1, 3, 1
+        .word 1, 0, 1, 0, 3, 2, 1, 3, 1, 2, 1, 0, 2, 1, 1, 0
+        .word 0, 2, 1, 0, 3, 1, 1, 1, 2, 2, 2, 3, 2, 2, 0, 2
+        .word 3, 2, 0, 0, 0, 1, 0, 1, 0, 3, 2, 2, 3, 1, 3, 3
+        .word 2, 1, 2, 0, 1, 3, 2, 1, 0, 3, 2, 0, 1, 3, 2, 0
+        .word 1, 0, 1, 1, 0, 1, 1, 2, 2, 2, 3, 2, 2, 1, 1, 2
+        .word 0, 2, 2, 2, 3, 0, 3, 0, 2, 2, 0, 3, 1, 3, 3, 3
+        .word 2, 0, 2, 3, 3, 0, 1, 0, 1, 2, 2, 3, 3, 3, 0, 1
+        .word 0, 2, 0, 0, 3, 1, 2, 0, 1, 1, 3, 0, 1, 2, 2, 2
+        .word 0, 3, 0, 0, 3, 0, 1, 0, 3, 0, 3, 0, 1, 2, 1, 1
+        .word 1, 1, 2, 2, 0, 3, 2, 1, 3, 0, 1, 3, 0, 1, 2, 3
+        .word 1, 1, 3, 2, 0, 0, 2, 0, 3, 2, 2, 3, 2, 3, 2, 3
+        .word 1, 2, 1, 1, 3, 1, 2, 0, 3, 1, 2, 1, 1, 3, 1, 1
+        .word 0, 3, 2, 1, 0, 3, 1, 1, 3, 3, 0, 2, 0, 0, 2, 0
+        .word 0, 3, 0, 1, 1, 0, 1, 0, 3, 3, 3, 0, 0, 0, 1, 1
+        .word 0, 2, 1, 3, 1, 1, 1, 2, 3, 0, 0, 1, 2, 3, 1, 2
+        .word 1, 1, 0, 3, 3, 2, 2, 0, 3, 3, 2, 3, 1, 0, 1, 0
+        .word 1, 2, 1, 1, 2, 2, 2, 3, 1, 0, 1, 3, 2, 3, 3, 2
+        .word 3, 2, 1, 1, 1, 2, 1, 2, 0, 0, 3, 2, 0, 0, 0, 0
+        .word 2, 3, 2, 2, 1, 1, 0, 3, 0, 3, 2, 2, 3, 2, 0, 1
+        .word 2, 2, 0, 1, 1, 1, 2, 0, 3, 2, 2, 3, 1, 0, 0, 0
+        .word 0, 0, 1, 3, 1, 1, 3, 3, 1, 2, 2, 0, 3, 3, 0, 1
+        .word 0, 3, 2, 1, 3, 1, 0, 1, 2, 1, 1, 1, 0, 2, 3, 1
+        .word 1, 0, 0, 0, 0, 2, 2, 2, 2, 3, 0, 3, 1, 1, 3, 2
+        .word 1, 0, 2, 2, 2, 2, 1, 0, 0, 1, 0, 3, 3, 2, 2, 2
+        .word 1, 2, 3, 1, 2, 0, 1, 2, 1, 3, 3, 3, 1, 0, 0, 3
+        .word 2, 0, 3, 2, 2, 1, 0, 1, 0, 2, 2, 3, 1, 0, 2, 1
+        .word 1, 3, 2, 3, 2, 1, 0, 1, 2, 1, 2, 3, 3, 3, 1, 3
+        .word 1, 0, 3, 0, 1, 3, 2, 1, 1, 1, 3, 1, 2, 3, 3, 3
+        .word 0, 2, 0, 1, 2, 1, 0, 3, 2, 0, 1, 1, 1, 0, 2, 3
+        .word 3, 0, 1, 1, 2, 3, 3, 3, 0, 3, 3, 3, 2, 0, 0, 1
+        .word 2, 1, 0, 3, 3, 0, 3, 3, 0, 3, 2, 1, 3, 1, 2, 3
+        .word 1, 2, 2, 3, 0, 1, 3, 3, 1, 0, 0, 2, 2, 3, 3, 2
+        .word 3, 2, 2, 1, 0, 0, 2, 0, 0, 0, 2, 2, 3, 0, 1, 0
+        .word 2, 2, 2, 0, 0, 2, 2, 2, 0, 0, 3, 0, 2, 1, 0, 2
+        .word 2, 2, 1, 0, 0, 3, 0, 1, 1, 1, 3, 0, 2, 2, 3, 3
+        .word 0, 1, 1, 3, 1, 1, 3, 2, 0, 0, 0, 1, 0, 1, 1, 1
+        .word 1, 0, 0, 0, 2, 0, 2, 3, 3, 2, 3, 3, 2, 0, 2, 0
+
+        .text
+        MOVC R0, #0
+        MOVC R10, #1
+        MOVC R11, #2
+        MOVC R12, #3
+        MOVC R13, #PASSES
+        MOVC R3, #0             ; state
+        MOVC R4, #0             ; matches
+        MOVC R5, #0             ; zeros
+pass:   MOVC R1, #input
+        MOVC R2, #N
+loop:   LOAD R6, R1, #0
+        ADD R7, R6, R0
+        BNZ dispatch
+        ADDL R5, R5, #1
+dispatch:
+        ADD R7, R3, R0
+        BZ s0
+        SUB R7, R3, R10
+        BZ s1
+        SUB R7, R6, R12
+        BZ match
+        SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+s1:     SUB R7, R6, R11
+        BZ to2
+        SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+s0:     SUB R7, R6, R10
+        BZ to1
+        GOTO to0
+match:  ADDL R4, R4, #1
+to0:    MOVC R3, #0
+        GOTO next
+to1:    MOVC R3, #1
+        GOTO next
+to2:    MOVC R3, #2
+next:   ADDL R1, R1, #1
+        SUB R2, R2, R10
+        BNZ loop
+        SUB R13, R13, R10
+        BNZ pass
+        STORE R4, R0, #0
+        STORE R5, R0, #1
+        HALT
@@ -0,0 +1,4116 @@
+; Walks a ring of 4096 nodes scattered over 32 KB, one dependent LDR per
+; step, so every load waits on the one before it
+        .equ STEPS, 500000
+
+        .data 1024
+ring:
+        .word 44, 4328
+        .word 92, 1666
+        .word 98, 1490
+        .word 43, 5024
+        .word 10, 4148
+        .word 76, 8204
+        .word 41, 7124
+        .word 49, 7622
+        .word 91, 3348
+        .word 73, 1264
+        .word 24, 3440
+        .word 44, 1126
+        .word 24, 2404
+        .word 60, 7620
+        .word 29, 2596
+        .word 16, 3074
+        .word 71, 1454
+        .word 78, 6756
+        .word 41, 7778
+        .word 47, 8588
+        .word 27, 1692
+        .word 27, 8012
+        .word 90, 5242
+        .word 30, 2522
+        .word 20, 1408
+        .word 7, 9022
+        .word 69, 1458
+        .word 25, 5462
+        .word 6, 2340
+        .word 36, 7596
+        .word 6, 4900
+        .word 59, 8624
+        .word 62, 8706
+        .word 50, 2164
+        .word 1, 7126
+        .word 31, 3598
+        .word 18, 4970
+        .word 74, 2152
+        .word 90, 3902
+        .word 63, 8354
+        .word 84, 1340
+        .word 72, 3632
+        .word 23, 4324
+        .word 12, 4134
+        .word 51, 4226
+        .word 99, 8504
+        .word 3, 3256
+        .word 81, 3346
+        .word 23, 8456
+        .word 84, 3160
+        .word 81, 7856
+        .word 46, 6792
+        .word 21, 4168
+        .word 69, 8904
+        .word 72, 7538
+        .word 23, 8542
+        .word 17, 1106
+        .word 92, 4530
+        .word 85, 8190
+        .word 59, 6486
+        .word 8, 5962
+        .word 49, 7580
+        .word 99, 1554
+        .word 6, 8862
+        .word 44, 5896
+        .word 75, 1948
+        .word 9, 5488
+        .word 8, 2816
+        .word 80, 1516
+        .word 86, 3904
+        .word 34, 7322
+        .word 35, 3064
+        .word 18, 2582
+        .word 53, 6416
+        .word 31, 4892
+        .word 85, 4498
+        .word 99, 4648
+        .word 36, 8482
+        .word 74, 6966
+        .word 99, 6356
+        .word 70, 4238
+        .word 21, 6920
+        .word 47, 5738
+        .word 70, 1188
+        .word 14, 6426
+        .word 10, 9078
+        .word 85, 1108
+        .word 1, 2968
+        .word 73, 1370
+        .word 63, 2974
+        .word 16, 1136
+        .word 57, 1934
+        .word 40, 1860
+        .word 82, 3188
+        .word 58, 2128
+        .word 35, 8342
+        .word 41, 7474
+        .word 43, 7406
+        .word 1, 2988
+        .word 11, 9060
+        .word 22, 3772
+        .word 22, 7086
+        .word 19, 1152
+        .word 16, 2306
+        .word 17, 2744
+        .word 75, 3228
+        .word 82, 2850
+        .word 41, 3966
+        .word 30, 2944
+        .word 86, 5942
+        .word 89, 7818
+        .word 47, 9172
+        .word 2, 8198
+        .word 97, 6946
+        .word 61, 3694
+        .word 10, 1144
+        .word 3, 4382
+        .word 49, 6458
+        .word 64, 2902
+        .word 33, 7402
+        .word 79, 7614
+        .word 8, 1274
+        .word 80, 2474
+        .word 22, 5682
+        .word 87, 8912
+        .word 75, 2634
+        .word 44, 6492
+        .word 78, 4608
+        .word 6, 4818
+        .word 3, 2302
+        .word 77, 7362
+        .word 41, 4710
+        .word 33, 8168
+        .word 19, 2484
+        .word 71, 7782
+        .word 56, 1568
+        .word 83, 1202
+        .word 94, 7642
+        .word 5, 6926
+        .word 90, 3472
+        .word 16, 3572
+        .word 50, 8364
+        .word 43, 3778
+        .word 44, 2642
+        .word 49, 2832
+        .word 19, 5972
+        .word 67, 6548
+        .word 32, 3558
+        .word 4, 1760
+        .word 28, 6030
+        .word 79, 5476
+        .word 83, 2294
+        .word 10, 4270
+        .word 4, 7196
+        .word 2, 8082
+        .word 92, 4202
+        .word 32, 1150
+        .word 66, 1748
+        .word 43, 7692
+        .word 74, 3708
+        .word 85, 1526
+        .word 21, 1846
+        .word 57, 7798
+        .word 46, 6032
+        .word 39, 5944
+        .word 64, 5394
+        .word 57, 1494
+        .word 57, 3968
+        .word 38, 1508
+        .word 59, 5472
+        .word 29, 6496
+        .word 12, 7248
+        .word 42, 2876
+        .word 84, 2852
+        .word 46, 3294
+        .word 15, 2846
+        .word 5, 6740
+        .word 37, 1752
+        .word 37, 3754
+        .word 64, 7202
+        .word 35, 7246
+        .word 91, 3662
+        .word 37, 8730
+        .word 1, 2014
+        .word 89, 2092
+        .word 60, 5290
+        .word 38, 8316
+        .word 11, 4186
+        .word 18, 2298
+        .word 79, 3916
+        .word 47, 5618
+        .word 57, 1184
+        .word 39, 7270
+        .word 56, 5496
+        .word 58, 1682
+        .word 50, 7210
+        .word 2, 6212
+        .word 63, 3614
+        .word 63, 4360
+        .word 43, 1994
+        .word 98, 2462
+        .word 45, 8598
+        .word 17, 2426
+        .word 7, 1726
+        .word 88, 8410
+        .word 78, 8848
+        .word 35, 4882
+        .word 55, 4870
+        .word 96, 6046
+        .word 77, 8600
+        .word 49, 8698
+        .word 67, 6538
+        .word 27, 1572
+        .word 94, 8052
+        .word 70, 4770
+        .word 26, 3236
+        .word 52, 8556
+        .word 87, 7306
+        .word 71, 4646
+        .word 8, 8282
+        .word 92, 5486
+        .word 45, 6358
+        .word 57, 7424
+        .word 76, 7694
+        .word 35, 5766
+        .word 24, 5076
+        .word 17, 2828
+        .word 31, 5214
+        .word 26, 2674
+        .word 65, 1840
+        .word 9, 2870
+        .word 75, 4072
+        .word 91, 8596
+        .word 77, 6912
+        .word 29, 7256
+        .word 78, 3456
+        .word 19, 3308
+        .word 47, 6382
+        .word 12, 4712
+        .word 75, 6408
+        .word 34, 6974
+        .word 30, 6854
+        .word 1, 7874
+        .word 3, 8236
+        .word 2, 8378
+        .word 57, 6948
+        .word 48, 5556
+        .word 11, 4536
+        .word 87, 7412
+        .word 38, 1638
+        .word 81, 2714
+        .word 11, 2434
+        .word 78, 7794
+        .word 4, 1958
+        .word 46, 5594
+        .word 20, 3556
+        .word 57, 5550
+        .word 65, 4632
+        .word 78, 5054
+        .word 25, 4570
+        .word 12, 2478
+        .word 69, 9150
+        .word 61, 4488
+        .word 60, 4972
+        .word 54, 7272
+        .word 94, 6864
+        .word 9, 5644
+        .word 70, 5460
+        .word 15, 1068
+        .word 1, 1248
+        .word 86, 1930
+        .word 70, 4318
+        .word 35, 5716
+        .word 26, 8676
+        .word 14, 4806
+        .word 50, 1640
+        .word 67, 7880
+        .word 13, 8004
+        .word 18, 7432
+        .word 98, 5976
+        .word 97, 1518
+        .word 67, 1218
+        .word 55, 5414
+        .word 49, 6102
+        .word 69, 4938
+        .word 82, 2288
+        .word 63, 5914
+        .word 87, 8646
+        .word 69, 6970
+        .word 22, 8328
+        .word 9, 7132
+        .word 51, 6812
+        .word 39, 8684
+        .word 83, 6024
+        .word 26, 7236
+        .word 4, 5740
+        .word 72, 2520
+        .word 94, 8514
+        .word 84, 7996
+        .word 40, 1098
+        .word 63, 7790
+        .word 6, 3446
+        .word 10, 3066
+        .word 16, 5062
+        .word 55, 8558
+        .word 66, 7598
+        .word 96, 1276
+        .word 78, 4600
+        .word 89, 6978
+        .word 93, 8124
+        .word 79, 5650
+        .word 15, 4320
+        .word 85, 8126
+        .word 2, 5206
+        .word 23, 2266
+        .word 36, 3058
+        .word 11, 5340
+        .word 67, 1990
+        .word 15, 5470
+        .word 69, 8666
+        .word 82, 9204
+        .word 78, 8192
+        .word 94, 6320
+        .word 91, 4936
+        .word 9, 4170
+        .word 29, 6768
+        .word 20, 3910
+        .word 88, 7036
+        .word 18, 3842
+        .word 12, 4452
+        .word 14, 6164
+        .word 79, 8858
+        .word 62, 1894
+        .word 81, 1614
+        .word 66, 2884
+        .word 15, 5386
+        .word 87, 3780
+        .word 28, 3148
+        .word 59, 6178
+        .word 61, 6636
+        .word 31, 1988
+        .word 51, 2922
+        .word 2, 2830
+        .word 59, 9170
+        .word 68, 2280
+        .word 87, 4248
+        .word 91, 6982
+        .word 59, 8002
+        .word 81, 3102
+        .word 20, 3458
+        .word 60, 6268
+        .word 58, 3970
+        .word 33, 2436
+        .word 69, 2176
+        .word 26, 1324
+        .word 36, 3990
+        .word 62, 2894
+        .word 51, 2888
+        .word 43, 2758
+        .word 36, 5788
+        .word 90, 7342
+        .word 4, 3882
+        .word 14, 8392
+        .word 89, 3784
+        .word 49, 4680
+        .word 11, 4910
+        .word 42, 2410
+        .word 52, 1950
+        .word 78, 6832
+        .word 70, 3964
+        .word 41, 8242
+        .word 48, 1892
+        .word 55, 8374
+        .word 7, 6452
+        .word 21, 5166
+        .word 56, 6678
+        .word 29, 4992
+        .word 40, 7832
+        .word 28, 3366
+        .word 14, 5756
+        .word 3, 4380
+        .word 12, 5986
+        .word 74, 1266
+        .word 79, 2542
+        .word 50, 8572
+        .word 57, 2572
+        .word 99, 4880
+        .word 79, 4830
+        .word 11, 6938
+        .word 16, 4230
+        .word 25, 8708
+        .word 54, 3596
+        .word 71, 4598
+        .word 19, 8074
+        .word 60, 4630
+        .word 92, 5156
+        .word 36, 2842
+        .word 16, 3946
+        .word 54, 3264
+        .word 94, 1746
+        .word 7, 4684
+        .word 17, 1066
+        .word 75, 2138
+        .word 24, 3958
+        .word 7, 7926
+        .word 9, 1720
+        .word 42, 1290
+        .word 38, 6628
+        .word 36, 6656
+        .word 38, 4720
+        .word 70, 4110
+        .word 77, 7894
+        .word 11, 6302
+        .word 61, 9118
+        .word 65, 7192
+        .word 64, 5540
+        .word 95, 1530
+        .word 38, 3668
+        .word 24, 4162
+        .word 2, 8438
+        .word 39, 3384
+        .word 32, 4782
+        .word 58, 1424
+        .word 17, 4222
+        .word 37, 3706
+        .word 81, 6094
+        .word 74, 6326
+        .word 11, 6502
+        .word 79, 3510
+        .word 17, 4564
+        .word 14, 3652
+        .word 50, 7336
+        .word 37, 2082
+        .word 50, 2254
+        .word 61, 8984
+        .word 92, 7290
+        .word 22, 3438
+        .word 31, 4540
+        .word 43, 8510
+        .word 25, 5058
+        .word 81, 1784
+        .word 27, 4558
+        .word 11, 3892
+        .word 46, 5494
+        .word 62, 7488
+        .word 46, 4220
+        .word 42, 5604
+        .word 16, 1808
+        .word 97, 2006
+        .word 81, 4434
+        .word 48, 3326
+        .word 31, 4568
+        .word 97, 8106
+        .word 8, 6448
+        .word 5, 3542
+        .word 56, 6090
+        .word 63, 8466
+        .word 43, 8454
+        .word 37, 8142
+        .word 78, 4034
+        .word 50, 8156
+        .word 65, 8538
+        .word 93, 7690
+        .word 27, 8570
+        .word 85, 2938
+        .word 27, 9050
+        .word 60, 9108
+        .word 69, 3790
+        .word 51, 3862
+        .word 53, 1694
+        .word 1, 8692
+        .word 35, 3014
+        .word 66, 2654
+        .word 15, 6828
+        .word 19, 2112
+        .word 50, 8870
+        .word 7, 9124
+        .word 22, 4042
+        .word 68, 7180
+        .word 61, 7378
+        .word 82, 6650
+        .word 60, 7428
+        .word 59, 8728
+        .word 41, 9176
+        .word 59, 2144
+        .word 81, 3688
+        .word 9, 4638
+        .word 38, 4472
+        .word 45, 6558
+        .word 66, 4862
+        .word 7, 4332
+        .word 1, 7722
+        .word 42, 1410
+        .word 42, 2278
+        .word 33, 8782
+        .word 46, 2062
+        .word 91, 5534
+        .word 83, 5762
+        .word 31, 2368
+        .word 96, 5838
+        .word 11, 7510
+        .word 67, 7012
+        .word 42, 7302
+        .word 74, 8264
+        .word 83, 6478
+        .word 82, 2396
+        .word 68, 2132
+        .word 48, 6384
+        .word 1, 1698
+        .word 7, 8548
+        .word 28, 1038
+        .word 55, 8070
+        .word 70, 2248
+        .word 61, 7478
+        .word 31, 8122
+        .word 60, 2970
+        .word 59, 1938
+        .word 90, 7532
+        .word 29, 2678
+        .word 63, 1474
+        .word 18, 8094
+        .word 97, 8788
+        .word 85, 8834
+        .word 28, 5938
+        .word 94, 4154
+        .word 37, 3192
+        .word 24, 5688
+        .word 70, 7684
+        .word 48, 1164
+        .word 16, 3214
+        .word 90, 7804
+        .word 52, 6328
+        .word 93, 3878
+        .word 82, 8014
+        .word 65, 5118
+        .word 1, 8450
+        .word 57, 3928
+        .word 64, 3252
+        .word 55, 2550
+        .word 35, 6162
+        .word 63, 8776
+        .word 68, 4690
+        .word 90, 5704
+        .word 95, 5116
+        .word 65, 3844
+        .word 52, 4618
+        .word 84, 4338
+        .word 34, 2486
+        .word 86, 8528
+        .word 86, 3666
+        .word 84, 8256
+        .word 35, 8786
+        .word 96, 4166
+        .word 36, 4708
+        .word 13, 6524
+        .word 48, 4384
+        .word 78, 2560
+        .word 79, 6892
+        .word 5, 5022
+        .word 34, 5344
+        .word 62, 5246
+        .word 42, 4370
+        .word 80, 4842
+        .word 66, 3080
+        .word 98, 6518
+        .word 91, 2666
+        .word 92, 7174
+        .word 39, 5074
+        .word 10, 1492
+        .word 8, 3006
+        .word 22, 2724
+        .word 2, 6150
+        .word 24, 1764
+        .word 6, 2444
+        .word 4, 7356
+        .word 22, 5220
+        .word 62, 1876
+        .word 35, 5268
+        .word 11, 6280
+        .word 90, 7052
+        .word 15, 7088
+        .word 36, 1602
+        .word 59, 1238
+        .word 47, 3992
+        .word 99, 3036
+        .word 90, 3422
+        .word 23, 1334
+        .word 70, 1972
+        .word 28, 6644
+        .word 72, 7324
+        .word 71, 7654
+        .word 65, 7924
+        .word 37, 3132
+        .word 94, 6614
+        .word 41, 6834
+        .word 80, 2118
+        .word 81, 6870
+        .word 13, 7714
+        .word 67, 6542
+        .word 24, 4924
+        .word 23, 2184
+        .word 82, 8890
+        .word 1, 3462
+        .word 60, 2948
+        .word 28, 9206
+        .word 7, 9202
+        .word 54, 8780
+        .word 39, 2224
+        .word 30, 2124
+        .word 68, 5790
+        .word 24, 6274
+        .word 84, 4666
+        .word 65, 8092
+        .word 54, 6156
+        .word 14, 2218
+        .word 6, 2662
+        .word 75, 2378
+        .word 90, 6660
+        .word 16, 7886
+        .word 70, 6118
+        .word 21, 7404
+        .word 69, 3604
+        .word 67, 6420
+        .word 30, 5518
+        .word 50, 3136
+        .word 78, 7566
+        .word 28, 9106
+        .word 84, 3866
+        .word 55, 8436
+        .word 96, 2906
+        .word 28, 1536
+        .word 62, 7440
+        .word 51, 4634
+        .word 5, 6050
+        .word 25, 6230
+        .word 46, 5940
+        .word 63, 7850
+        .word 64, 7716
+        .word 74, 2336
+        .word 77, 6642
+        .word 90, 1768
+        .word 24, 7418
+        .word 64, 4152
+        .word 70, 3268
+        .word 48, 7556
+        .word 85, 2028
+        .word 72, 2242
+        .word 84, 9066
+        .word 9, 7984
+        .word 95, 8994
+        .word 88, 6508
+        .word 25, 6380
+        .word 30, 4858
+        .word 75, 5720
+        .word 89, 5456
+        .word 26, 1270
+        .word 85, 3426
+        .word 45, 7546
+        .word 93, 5758
+        .word 35, 4012
+        .word 1, 3154
+        .word 10, 2824
+        .word 8, 8934
+        .word 18, 1162
+        .word 58, 5342
+        .word 3, 1472
+        .word 87, 6838
+        .word 12, 5466
+        .word 23, 7806
+        .word 66, 8258
+        .word 76, 8170
+        .word 34, 1404
+        .word 28, 7148
+        .word 50, 5760
+        .word 11, 6898
+        .word 23, 3560
+        .word 21, 5370
+        .word 6, 1658
+        .word 43, 8602
+        .word 78, 5446
+        .word 12, 6850
+        .word 40, 2696
+        .word 86, 6690
+        .word 9, 1254
+        .word 7, 1200
+        .word 40, 8832
+        .word 70, 4234
+        .word 4, 7238
+        .word 34, 3974
+        .word 82, 5172
+        .word 4, 5522
+        .word 54, 2494
+        .word 44, 2438
+        .word 70, 3328
+        .word 43, 2068
+        .word 54, 6654
+        .word 34, 5028
+        .word 23, 8372
+        .word 81, 6362
+        .word 89, 3012
+        .word 90, 5530
+        .word 3, 4586
+        .word 39, 5712
+        .word 43, 3274
+        .word 87, 2782
+        .word 53, 2836
+        .word 27, 8592
+        .word 66, 6796
+        .word 73, 9046
+        .word 61, 2466
+        .word 68, 6902
+        .word 37, 2858
+        .word 36, 5926
+        .word 76, 6042
+        .word 25, 9068
+        .word 94, 7768
+        .word 50, 7170
+        .word 58, 1626
+        .word 70, 5020
+        .word 45, 5690
+        .word 2, 3720
+        .word 38, 6936
+        .word 50, 6160
+        .word 1, 3362
+        .word 44, 5128
+        .word 61, 2900
+        .word 11, 6766
+        .word 14, 9136
+        .word 50, 1848
+        .word 68, 2814
+        .word 51, 3880
+        .word 21, 7966
+        .word 42, 7646
+        .word 44, 6020
+        .word 84, 3832
+        .word 99, 1252
+        .word 18, 6134
+        .word 98, 9028
+        .word 92, 2472
+        .word 19, 8416
+        .word 74, 8836
+        .word 93, 5354
+        .word 74, 7512
+        .word 62, 4376
+        .word 6, 5750
+        .word 86, 6064
+        .word 27, 6314
+        .word 45, 6188
+        .word 17, 2792
+        .word 49, 3952
+        .word 99, 5886
+        .word 4, 8250
+        .word 94, 8874
+        .word 76, 7602
+        .word 57, 3360
+        .word 38, 3434
+        .word 94, 5538
+        .word 20, 3824
+        .word 25, 6806
+        .word 58, 2326
+        .word 69, 7980
+        .word 11, 5860
+        .word 45, 4100
+        .word 45, 5978
+        .word 34, 3530
+        .word 29, 1084
+        .word 25, 8550
+        .word 99, 7840
+        .word 80, 1866
+        .word 7, 9004
+        .word 27, 4030
+        .word 76, 7576
+        .word 36, 3406
+        .word 62, 4108
+        .word 37, 4126
+        .word 87, 5648
+        .word 25, 1176
+        .word 18, 6722
+        .word 34, 4044
+        .word 20, 3766
+        .word 86, 7612
+        .word 6, 8672
+        .word 2, 1778
+        .word 47, 2630
+        .word 41, 5832
+        .word 82, 5104
+        .word 75, 1102
+        .word 78, 5376
+        .word 87, 1292
+        .word 32, 1806
+        .word 71, 6298
+        .word 13, 6916
+        .word 39, 6666
+        .word 74, 7870
+        .word 4, 5700
+        .word 27, 9048
+        .word 98, 9160
+        .word 15, 1436
+        .word 81, 1612
+        .word 30, 1680
+        .word 28, 1086
+        .word 82, 1130
+        .word 56, 1260
+        .word 7, 4998
+        .word 35, 5380
+        .word 87, 5668
+        .word 32, 4106
+        .word 72, 4948
+        .word 4, 7442
+        .word 63, 7720
+        .word 57, 1562
+        .word 35, 2182
+        .word 79, 8920
+        .word 78, 6760
+        .word 64, 6206
+        .word 65, 5468
+        .word 17, 2574
+        .word 82, 8090
+        .word 71, 1690
+        .word 24, 8544
+        .word 10, 2752
+        .word 79, 8208
+        .word 33, 8574
+        .word 72, 6140
+        .word 4, 5436
+        .word 88, 4688
+        .word 77, 3286
+        .word 38, 5450
+        .word 72, 3152
+        .word 65, 5874
+        .word 22, 4396
+        .word 89, 7826
+        .word 22, 3496
+        .word 36, 7288
+        .word 95, 8652
+        .word 62, 4160
+        .word 41, 5492
+        .word 66, 7584
+        .word 88, 9042
+        .word 36, 4294
+        .word 38, 3996
+        .word 88, 6514
+        .word 19, 3776
+        .word 56, 2928
+        .word 96, 8452
+        .word 90, 3536
+        .word 49, 8424
+        .word 6, 3690
+        .word 7, 8196
+        .word 10, 2026
+        .word 58, 6336
+        .word 85, 7078
+        .word 66, 7604
+        .word 7, 6554
+        .word 53, 5862
+        .word 6, 4958
+        .word 3, 2540
+        .word 91, 4408
+        .word 56, 1450
+        .word 86, 4746
+        .word 21, 7738
+        .word 51, 2916
+        .word 46, 7746
+        .word 41, 6844
+        .word 12, 6444
+        .word 73, 4872
+        .word 85, 2460
+        .word 71, 1822
+        .word 42, 7590
+        .word 87, 1728
+        .word 26, 8072
+        .word 18, 8448
+        .word 53, 1104
+        .word 2, 1820
+        .word 43, 6746
+        .word 58, 2788
+        .word 90, 5632
+        .word 16, 2318
+        .word 39, 6482
+        .word 66, 2626
+        .word 70, 3768
+        .word 18, 7348
+        .word 79, 7564
+        .word 80, 3390
+        .word 56, 5854
+        .word 2, 7520
+        .word 56, 3244
+        .word 19, 5638
+        .word 78, 1998
+        .word 66, 5858
+        .word 63, 3332
+        .word 60, 8232
+        .word 77, 5316
+        .word 12, 8982
+        .word 74, 9076
+        .word 81, 2194
+        .word 31, 3948
+        .word 53, 7704
+        .word 95, 7084
+        .word 73, 5378
+        .word 16, 1178
+        .word 86, 1832
+        .word 37, 6388
+        .word 92, 4662
+        .word 75, 2188
+        .word 92, 4484
+        .word 68, 1442
+        .word 36, 2332
+        .word 3, 1298
+        .word 38, 2652
+        .word 75, 7258
+        .word 57, 6234
+        .word 37, 2090
+        .word 36, 6764
+        .word 83, 6152
+        .word 78, 8088
+        .word 97, 2742
+        .word 40, 4962
+        .word 15, 3642
+        .word 81, 1160
+        .word 97, 3340
+        .word 28, 5274
+        .word 29, 7366
+        .word 73, 2874
+        .word 95, 9096
+        .word 88, 7992
+        .word 7, 2980
+        .word 98, 3318
+        .word 65, 2244
+        .word 32, 5356
+        .word 93, 6584
+        .word 90, 3428
+        .word 44, 8348
+        .word 81, 3114
+        .word 20, 4400
+        .word 21, 4546
+        .word 70, 8278
+        .word 66, 1854
+        .word 58, 6180
+        .word 22, 5852
+        .word 13, 4276
+        .word 57, 3124
+        .word 88, 6036
+        .word 49, 9020
+        .word 44, 1416
+        .word 83, 7434
+        .word 61, 2990
+        .word 32, 8524
+        .word 79, 5348
+        .word 81, 4128
+        .word 90, 5180
+        .word 85, 5068
+        .word 97, 8000
+        .word 35, 2558
+        .word 24, 2412
+        .word 58, 6248
+        .word 65, 6296
+        .word 36, 5392
+        .word 85, 8554
+        .word 47, 1982
+        .word 71, 7072
+        .word 2, 7954
+        .word 29, 6396
+        .word 96, 5084
+        .word 29, 6716
+        .word 35, 3134
+        .word 97, 1342
+        .word 63, 1322
+        .word 52, 5796
+        .word 32, 2230
+        .word 43, 3358
+        .word 65, 4856
+        .word 45, 7754
+        .word 96, 8926
+        .word 21, 6750
+        .word 62, 5276
+        .word 59, 2632
+        .word 14, 1496
+        .word 65, 3344
+        .word 1, 1462
+        .word 5, 7920
+        .word 47, 6964
+        .word 17, 6992
+        .word 3, 5736
+        .word 7, 2084
+        .word 93, 8318
+        .word 28, 7696
+        .word 67, 6780
+        .word 67, 7524
+        .word 53, 6442
+        .word 35, 7968
+        .word 89, 9184
+        .word 33, 2504
+        .word 1, 5086
+        .word 8, 8266
+        .word 99, 4256
+        .word 64, 8308
+        .word 61, 2292
+        .word 72, 6044
+        .word 48, 2500
+        .word 64, 3700
+        .word 31, 7372
+        .word 86, 8138
+        .word 27, 1744
+        .word 67, 8930
+        .word 13, 7056
+        .word 78, 7304
+        .word 47, 8470
+        .word 88, 2864
+        .word 14, 1700
+        .word 66, 4944
+        .word 26, 7436
+        .word 45, 4018
+        .word 27, 1888
+        .word 13, 2468
+        .word 23, 2672
+        .word 37, 7054
+        .word 93, 2354
+        .word 79, 8892
+        .word 25, 8462
+        .word 73, 8702
+        .word 97, 4534
+        .word 27, 2502
+        .word 60, 4654
+        .word 15, 4988
+        .word 2, 3868
+        .word 1, 6874
+        .word 75, 5258
+        .word 84, 7318
+        .word 64, 6852
+        .word 42, 4582
+        .word 14, 4514
+        .word 35, 2356
+        .word 67, 4026
+        .word 19, 4432
+        .word 13, 4692
+        .word 62, 2976
+        .word 19, 4686
+        .word 8, 4656
+        .word 2, 6988
+        .word 28, 2926
+        .word 69, 7490
+        .word 59, 4766
+        .word 9, 4504
+        .word 34, 6516
+        .word 29, 4922
+        .word 5, 5136
+        .word 35, 4206
+        .word 19, 3926
+        .word 21, 8720
+        .word 7, 5990
+        .word 24, 2030
+        .word 91, 6672
+        .word 56, 4442
+        .word 88, 7062
+        .word 74, 8166
+        .word 19, 1634
+        .word 16, 6618
+        .word 52, 5528
+        .word 41, 4544
+        .word 80, 7594
+        .word 92, 1040
+        .word 1, 1400
+        .word 3, 1278
+        .word 13, 2400
+        .word 14, 1642
+        .word 47, 8324
+        .word 90, 3884
+        .word 19, 8394
+        .word 31, 1090
+        .word 29, 7074
+        .word 34, 7888
+        .word 96, 6626
+        .word 54, 6712
+        .word 82, 3028
+        .word 67, 1686
+        .word 99, 7562
+        .word 1, 1802
+        .word 71, 4800
+        .word 21, 4014
+        .word 96, 3022
+        .word 30, 4890
+        .word 16, 2506
+        .word 75, 4780
+        .word 83, 5934
+        .word 81, 1604
+        .word 33, 8952
+        .word 34, 5030
+        .word 41, 4150
+        .word 2, 9138
+        .word 85, 8828
+        .word 48, 1234
+        .word 65, 7624
+        .word 64, 4250
+        .word 35, 6732
+        .word 21, 6076
+        .word 99, 7502
+        .word 37, 1146
+        .word 91, 5612
+        .word 3, 1284
+        .word 36, 9162
+        .word 80, 8658
+        .word 53, 5768
+        .word 71, 3052
+        .word 83, 5868
+        .word 94, 5794
+        .word 29, 2546
+        .word 62, 8118
+        .word 50, 6702
+        .word 50, 2548
+        .word 58, 1214
+        .word 55, 1794
+        .word 50, 6706
+        .word 74, 8578
+        .word 3, 4136
+        .word 22, 7408
+        .word 94, 6366
+        .word 9, 7878
+        .word 81, 4592
+        .word 33, 3092
+        .word 99, 4532
+        .word 1, 1712
+        .word 37, 6480
+        .word 6, 3834
+        .word 92, 6954
+        .word 15, 1226
+        .word 27, 2094
+        .word 96, 2614
+        .word 66, 7636
+        .word 47, 8830
+        .word 13, 4706
+        .word 46, 3826
+        .word 61, 4178
+        .word 14, 7526
+        .word 65, 3280
+        .word 3, 8158
+        .word 85, 2252
+        .word 72, 4844
+        .word 47, 4440
+        .word 66, 6176
+        .word 45, 6282
+        .word 42, 3262
+        .word 41, 6908
+        .word 85, 5382
+        .word 13, 7994
+        .word 87, 8516
+        .word 34, 8302
+        .word 51, 1718
+        .word 71, 5908
+        .word 93, 6002
+        .word 35, 4282
+        .word 51, 8856
+        .word 86, 7128
+        .word 4, 5120
+        .word 21, 5360
+        .word 77, 2154
+        .word 57, 3890
+        .word 87, 5264
+        .word 26, 8492
+        .word 92, 8036
+        .word 97, 4596
+        .word 22, 3858
+        .word 59, 6168
+        .word 17, 4928
+        .word 68, 5904
+        .word 91, 7494
+        .word 26, 7734
+        .word 60, 3978
+        .word 89, 5164
+        .word 99, 2240
+        .word 73, 5840
+        .word 75, 6748
+        .word 59, 2476
+        .word 20, 1312
+        .word 74, 7836
+        .word 37, 2962
+        .word 79, 6738
+        .word 34, 6124
+        .word 14, 3714
+        .word 29, 5402
+        .word 38, 8924
+        .word 66, 1432
+        .word 84, 7028
+        .word 9, 6270
+        .word 34, 4464
+        .word 56, 7316
+        .word 23, 7912
+        .word 84, 6962
+        .word 33, 5282
+        .word 54, 4886
+        .word 45, 1580
+        .word 56, 8238
+        .word 50, 3062
+        .word 48, 1060
+        .word 19, 7200
+        .word 88, 3278
+        .word 37, 1390
+        .word 89, 1786
+        .word 95, 8486
+        .word 48, 2246
+        .word 49, 1116
+        .word 50, 8674
+        .word 87, 4660
+        .word 42, 3806
+        .word 26, 3182
+        .word 78, 5318
+        .word 63, 4390
+        .word 78, 8526
+        .word 26, 3316
+        .word 96, 8616
+        .word 69, 4744
+        .word 82, 5484
+        .word 3, 5182
+        .word 34, 2390
+        .word 82, 2186
+        .word 51, 6736
+        .word 86, 2984
+        .word 14, 1564
+        .word 49, 7900
+        .word 97, 7050
+        .word 1, 7370
+        .word 55, 4492
+        .word 10, 6106
+        .word 51, 8176
+        .word 97, 1512
+        .word 97, 4372
+        .word 40, 2588
+        .word 4, 1754
+        .word 11, 1984
+        .word 83, 8946
+        .word 88, 3118
+        .word 93, 5168
+        .word 1, 8050
+        .word 15, 5912
+        .word 65, 8412
+        .word 25, 2706
+        .word 31, 2946
+        .word 1, 6236
+        .word 76, 8418
+        .word 49, 4184
+        .word 11, 4676
+        .word 40, 3886
+        .word 59, 8990
+        .word 24, 6464
+        .word 28, 3566
+        .word 91, 5004
+        .word 6, 3722
+        .word 3, 1468
+        .word 40, 5322
+        .word 67, 4860
+        .word 73, 7444
+        .word 84, 3908
+        .word 93, 3098
+        .word 24, 1122
+        .word 29, 6848
+        .word 52, 7214
+        .word 90, 5478
+        .word 60, 5678
+        .word 98, 2012
+        .word 15, 3954
+        .word 55, 6070
+        .word 33, 4480
+        .word 61, 3276
+        .word 21, 7374
+        .word 72, 5544
+        .word 22, 8938
+        .word 92, 2978
+        .word 11, 7744
+        .word 37, 5902
+        .word 32, 3352
+        .word 54, 5710
+        .word 49, 6616
+        .word 40, 8754
+        .word 82, 5032
+        .word 77, 2394
+        .word 95, 3370
+        .word 47, 1906
+        .word 12, 6010
+        .word 55, 1918
+        .word 22, 1688
+        .word 69, 2778
+        .word 35, 8464
+        .word 98, 2498
+        .word 45, 3200
+        .word 10, 8522
+        .word 23, 6698
+        .word 59, 3260
+        .word 99, 2374
+        .word 68, 1456
+        .word 78, 5044
+        .word 6, 5624
+        .word 65, 7282
+        .word 85, 7582
+        .word 78, 2042
+        .word 13, 7776
+        .word 50, 1350
+        .word 66, 3100
+        .word 87, 6498
+        .word 9, 1362
+        .word 50, 3084
+        .word 8, 4066
+        .word 89, 2712
+        .word 92, 9014
+        .word 68, 8086
+        .word 31, 8642
+        .word 74, 5352
+        .word 2, 1506
+        .word 31, 4280
+        .word 82, 3408
+        .word 96, 2808
+        .word 97, 3470
+        .word 69, 2134
+        .word 81, 7194
+        .word 53, 4436
+        .word 29, 3246
+        .word 67, 6588
+        .word 98, 2402
+        .word 28, 3368
+        .word 51, 6528
+        .word 1, 3442
+        .word 41, 8396
+        .word 22, 3618
+        .word 33, 2554
+        .word 5, 2338
+        .word 47, 3242
+        .word 55, 1650
+        .word 39, 4978
+        .word 92, 8310
+        .word 52, 6886
+        .word 68, 5884
+        .word 9, 5190
+        .word 63, 8608
+        .word 74, 3376
+        .word 21, 7616
+        .word 65, 5490
+        .word 62, 5928
+        .word 41, 4080
+        .word 90, 4520
+        .word 52, 1466
+        .word 87, 5026
+        .word 42, 4430
+        .word 64, 7648
+        .word 24, 2064
+        .word 34, 5930
+        .word 76, 8210
+        .word 43, 2148
+        .word 70, 6262
+        .word 13, 8032
+        .word 93, 7970
+        .word 86, 8758
+        .word 32, 6798
+        .word 71, 6646
+        .word 60, 3090
+        .word 22, 8344
+        .word 70, 8872
+        .word 24, 7390
+        .word 26, 3744
+        .word 77, 4700
+        .word 84, 1114
+        .word 31, 5218
+        .word 4, 8400
+        .word 10, 1540
+        .word 38, 6906
+        .word 76, 5670
+        .word 96, 6052
+        .word 72, 2086
+        .word 70, 2866
+        .word 74, 3312
+        .word 96, 5952
+        .word 58, 5878
+        .word 30, 7638
+        .word 1, 3164
+        .word 4, 6810
+        .word 5, 1368
+        .word 96, 7498
+        .word 71, 1646
+        .word 80, 1042
+        .word 10, 4398
+        .word 36, 2720
+        .word 31, 1780
+        .word 64, 2592
+        .word 90, 2736
+        .word 48, 4716
+        .word 94, 3684
+        .word 63, 3774
+        .word 66, 3710
+        .word 59, 6330
+        .word 45, 6724
+        .word 46, 4816
+        .word 27, 6084
+        .word 88, 6830
+        .word 56, 4356
+        .word 18, 6272
+        .word 72, 8766
+        .word 44, 3810
+        .word 36, 8008
+        .word 77, 8852
+        .word 1, 4920
+        .word 67, 3494
+        .word 40, 5998
+        .word 86, 1024
+        .word 90, 3994
+        .word 3, 3516
+        .word 12, 2760
+        .word 85, 6990
+        .word 88, 6006
+        .word 69, 9192
+        .word 71, 3380
+        .word 59, 5568
+        .word 82, 1192
+        .word 79, 3184
+        .word 7, 7364
+        .word 25, 5906
+        .word 62, 3676
+        .word 53, 7234
+        .word 7, 4218
+        .word 37, 8724
+        .word 24, 1314
+        .word 81, 8140
+        .word 70, 4358
+        .word 96, 7698
+        .word 41, 3924
+        .word 37, 1198
+        .word 56, 5412
+        .word 31, 2798
+        .word 54, 4140
+        .word 85, 7274
+        .word 65, 3626
+        .word 48, 8016
+        .word 65, 4522
+        .word 94, 8340
+        .word 3, 8226
+        .word 77, 8442
+        .word 4, 8218
+        .word 51, 3818
+        .word 7, 3982
+        .word 82, 5308
+        .word 9, 3232
+        .word 3, 3798
+        .word 8, 3056
+        .word 68, 7846
+        .word 35, 4762
+        .word 93, 9110
+        .word 31, 7844
+        .word 54, 2564
+        .word 41, 7514
+        .word 31, 1812
+        .word 66, 6714
+        .word 72, 5498
+        .word 83, 6630
+        .word 86, 3126
+        .word 5, 5656
+        .word 81, 5718
+        .word 96, 1620
+        .word 14, 6778
+        .word 90, 6956
+        .word 81, 1770
+        .word 89, 1510
+        .word 4, 1434
+        .word 57, 8460
+        .word 39, 3568
+        .word 34, 3010
+        .word 32, 3630
+        .word 78, 3394
+        .word 97, 1584
+        .word 44, 3976
+        .word 57, 8704
+        .word 13, 7242
+        .word 74, 6634
+        .word 36, 3900
+        .word 24, 4028
+        .word 85, 2168
+        .word 26, 4768
+        .word 81, 2328
+        .word 59, 6086
+        .word 47, 4068
+        .word 35, 2190
+        .word 4, 3644
+        .word 82, 9210
+        .word 91, 1920
+        .word 9, 3168
+        .word 22, 8296
+        .word 43, 7978
+        .word 83, 1874
+        .word 39, 4494
+        .word 14, 1864
+        .word 81, 1272
+        .word 1, 7384
+        .word 35, 7772
+        .word 27, 3162
+        .word 63, 9140
+        .word 78, 1946
+        .word 19, 8398
+        .word 24, 4566
+        .word 32, 8148
+        .word 75, 1616
+        .word 14, 3960
+        .word 34, 6888
+        .word 87, 4850
+        .word 15, 5850
+        .word 23, 6662
+        .word 90, 8322
+        .word 85, 3748
+        .word 14, 2818
+        .word 7, 9154
+        .word 30, 5314
+        .word 9, 6208
+        .word 42, 2746
+        .word 40, 9186
+        .word 37, 8178
+        .word 2, 8854
+        .word 12, 6494
+        .word 72, 2170
+        .word 53, 2804
+        .word 50, 7644
+        .word 43, 6640
+        .word 27, 3196
+        .word 18, 1870
+        .word 71, 8974
+        .word 10, 2908
+        .word 5, 2032
+        .word 33, 2730
+        .word 49, 2698
+        .word 40, 8370
+        .word 39, 4200
+        .word 61, 4352
+        .word 14, 6120
+        .word 18, 1488
+        .word 89, 8800
+        .word 75, 3822
+        .word 19, 5202
+        .word 51, 2986
+        .word 88, 4336
+        .word 88, 6894
+        .word 12, 4314
+        .word 66, 7014
+        .word 9, 2766
+        .word 11, 1678
+        .word 1, 4392
+        .word 98, 2418
+        .word 10, 1172
+        .word 49, 6726
+        .word 72, 4704
+        .word 56, 8564
+        .word 7, 1596
+        .word 51, 8246
+        .word 27, 8120
+        .word 98, 2694
+        .word 64, 7042
+        .word 4, 8046
+        .word 82, 2442
+        .word 86, 2272
+        .word 88, 9032
+        .word 89, 6562
+        .word 17, 2074
+        .word 66, 6620
+        .word 11, 6060
+        .word 74, 4232
+        .word 7, 6142
+        .word 80, 5408
+        .word 18, 8678
+        .word 53, 3574
+        .word 68, 3110
+        .word 79, 8552
+        .word 75, 7484
+        .word 57, 8358
+        .word 87, 8610
+        .word 54, 7422
+        .word 58, 1800
+        .word 88, 4790
+        .word 78, 2264
+        .word 9, 6824
+        .word 70, 3140
+        .word 59, 2428
+        .word 77, 3226
+        .word 75, 8212
+        .word 14, 1968
+        .word 68, 7660
+        .word 28, 5888
+        .word 27, 1072
+        .word 4, 6454
+        .word 92, 4754
+        .word 79, 8632
+        .word 4, 8314
+        .word 23, 8978
+        .word 92, 7928
+        .word 61, 4142
+        .word 95, 7096
+        .word 27, 1088
+        .word 4, 6354
+        .word 80, 6114
+        .word 8, 7416
+        .word 78, 4054
+        .word 47, 6794
+        .word 55, 4506
+        .word 98, 1886
+        .word 3, 7688
+        .word 47, 9064
+        .word 23, 2420
+        .word 8, 2104
+        .word 4, 9214
+        .word 96, 3488
+        .word 62, 5804
+        .word 81, 4678
+        .word 11, 8508
+        .word 47, 3016
+        .word 77, 2392
+        .word 26, 2046
+        .word 6, 6820
+        .word 47, 8808
+        .word 5, 3452
+        .word 17, 5872
+        .word 4, 1208
+        .word 12, 7046
+        .word 3, 7410
+        .word 39, 8806
+        .word 44, 7250
+        .word 44, 1598
+        .word 51, 2262
+        .word 13, 6836
+        .word 6, 7626
+        .word 69, 1074
+        .word 30, 8932
+        .word 79, 1842
+        .word 13, 7368
+        .word 9, 1316
+        .word 72, 4138
+        .word 16, 6846
+        .word 59, 8320
+        .word 38, 8586
+        .word 56, 4574
+        .word 65, 3848
+        .word 91, 6110
+        .word 61, 4302
+        .word 95, 3444
+        .word 29, 2552
+        .word 16, 4450
+        .word 71, 1482
+        .word 80, 2150
+        .word 50, 3898
+        .word 23, 4388
+        .word 21, 7686
+        .word 90, 1124
+        .word 77, 7002
+        .word 52, 7358
+        .word 85, 2518
+        .word 83, 7020
+        .word 33, 6276
+        .word 41, 1174
+        .word 82, 6504
+        .word 17, 1430
+        .word 73, 3320
+        .word 39, 7118
+        .word 50, 8566
+        .word 55, 8104
+        .word 17, 5824
+        .word 18, 7496
+        .word 46, 1632
+        .word 35, 7702
+        .word 78, 2516
+        .word 80, 8860
+        .word 68, 6074
+        .word 84, 4526
+        .word 69, 3106
+        .word 88, 8710
+        .word 50, 6428
+        .word 32, 1528
+        .word 63, 4786
+        .word 70, 1772
+        .word 87, 8260
+        .word 32, 5742
+        .word 10, 2934
+        .word 33, 6284
+        .word 73, 3034
+        .word 95, 2838
+        .word 69, 8604
+        .word 63, 1036
+        .word 2, 2130
+        .word 26, 2308
+        .word 17, 2510
+        .word 32, 1110
+        .word 80, 7972
+        .word 33, 1652
+        .word 8, 4310
+        .word 28, 3480
+        .word 86, 8954
+        .word 2, 3860
+        .word 97, 3054
+        .word 91, 3424
+        .word 45, 2260
+        .word 3, 5130
+        .word 80, 8506
+        .word 73, 1486
+        .word 6, 5338
+        .word 76, 8428
+        .word 35, 3540
+        .word 97, 8664
+        .word 82, 2802
+        .word 39, 6460
+        .word 1, 7896
+        .word 32, 4794
+        .word 23, 2912
+        .word 28, 5996
+        .word 35, 2780
+        .word 73, 1158
+        .word 14, 3190
+        .word 94, 1648
+        .word 18, 4470
+        .word 24, 3218
+        .word 52, 1352
+        .word 81, 2806
+        .word 4, 4474
+        .word 86, 5596
+        .word 48, 6292
+        .word 28, 9100
+        .word 5, 8292
+        .word 37, 8738
+        .word 29, 4836
+        .word 52, 2796
+        .word 88, 6402
+        .word 45, 4926
+        .word 92, 8700
+        .word 62, 8784
+        .word 98, 6112
+        .word 88, 8382
+        .word 17, 7876
+        .word 76, 1426
+        .word 91, 5176
+        .word 67, 7264
+        .word 55, 8628
+        .word 66, 1546
+        .word 13, 6774
+        .word 27, 6146
+        .word 69, 9180
+        .word 1, 5114
+        .word 98, 1818
+        .word 27, 1134
+        .word 42, 1974
+        .word 36, 7038
+        .word 98, 1952
+        .word 21, 5144
+        .word 71, 1576
+        .word 67, 5000
+        .word 54, 5946
+        .word 3, 7276
+        .word 56, 5326
+        .word 81, 1850
+        .word 90, 2956
+        .word 22, 9164
+        .word 54, 6788
+        .word 26, 1096
+        .word 61, 1548
+        .word 82, 3850
+        .word 65, 6104
+        .word 71, 4076
+        .word 78, 8948
+        .word 41, 6144
+        .word 39, 6462
+        .word 18, 4718
+        .word 22, 1100
+        .word 74, 8478
+        .word 10, 5916
+        .word 21, 5306
+        .word 48, 4674
+        .word 30, 8772
+        .word 88, 7986
+        .word 68, 6422
+        .word 66, 7346
+        .word 73, 4580
+        .word 19, 2348
+        .word 93, 6540
+        .word 10, 6368
+        .word 60, 4912
+        .word 76, 3222
+        .word 55, 5582
+        .word 69, 2196
+        .word 35, 4086
+        .word 49, 2640
+        .word 57, 6446
+        .word 68, 9188
+        .word 16, 5152
+        .word 89, 8152
+        .word 67, 9122
+        .word 26, 4466
+        .word 91, 8164
+        .word 68, 3194
+        .word 11, 1138
+        .word 1, 5948
+        .word 17, 8468
+        .word 7, 3870
+        .word 50, 3374
+        .word 51, 7430
+        .word 98, 2972
+        .word 68, 7890
+        .word 15, 2120
+        .word 46, 9016
+        .word 99, 6116
+        .word 4, 1986
+        .word 88, 5158
+        .word 29, 6972
+        .word 23, 1028
+        .word 37, 9178
+        .word 58, 7018
+        .word 63, 6800
+        .word 30, 6252
+        .word 82, 4502
+        .word 11, 1476
+        .word 17, 1180
+        .word 79, 8562
+        .word 78, 7388
+        .word 35, 3794
+        .word 92, 7974
+        .word 35, 7080
+        .word 1, 2096
+        .word 69, 1826
+        .word 23, 1236
+        .word 22, 2256
+        .word 6, 3830
+        .word 95, 1402
+        .word 30, 7176
+        .word 70, 5684
+        .word 75, 6612
+        .word 66, 7090
+        .word 51, 7952
+        .word 48, 4032
+        .word 18, 5150
+        .word 69, 5310
+        .word 36, 3398
+        .word 72, 6658
+        .word 91, 2470
+        .word 26, 1970
+        .word 11, 8270
+        .word 91, 1306
+        .word 61, 3942
+        .word 36, 5546
+        .word 16, 4668
+        .word 44, 8942
+        .word 88, 2372
+        .word 7, 4560
+        .word 99, 5422
+        .word 71, 6058
+        .word 44, 8680
+        .word 81, 2610
+        .word 33, 5516
+        .word 12, 5064
+        .word 55, 1196
+        .word 14, 7918
+        .word 9, 3334
+        .word 81, 4726
+        .word 91, 1170
+        .word 45, 4752
+        .word 68, 4610
+        .word 94, 2616
+        .word 76, 4664
+        .word 28, 3448
+        .word 9, 8764
+        .word 63, 7808
+        .word 70, 3736
+        .word 62, 8896
+        .word 93, 6604
+        .word 51, 9094
+        .word 3, 6342
+        .word 20, 1344
+        .word 77, 8880
+        .word 51, 7732
+        .word 17, 5634
+        .word 92, 7040
+        .word 78, 5662
+        .word 36, 7244
+        .word 85, 1500
+        .word 4, 5148
+        .word 39, 2982
+        .word 23, 2812
+        .word 56, 1120
+        .word 86, 4964
+        .word 11, 2406
+        .word 77, 5818
+        .word 74, 8958
+        .word 64, 7950
+        .word 49, 8326
+        .word 62, 8790
+        .word 59, 7278
+        .word 55, 1056
+        .word 1, 7824
+        .word 23, 4644
+        .word 33, 2774
+        .word 69, 4462
+        .word 76, 2932
+        .word 32, 2954
+        .word 23, 6782
+        .word 74, 4930
+        .word 46, 3068
+        .word 95, 8972
+        .word 21, 5178
+        .word 29, 5368
+        .word 13, 4774
+        .word 55, 5588
+        .word 21, 4650
+        .word 22, 4518
+        .word 45, 6258
+        .word 29, 1814
+        .word 23, 2036
+        .word 80, 2056
+        .word 25, 8842
+        .word 49, 7838
+        .word 16, 2606
+        .word 73, 6842
+        .word 92, 4956
+        .word 8, 1932
+        .word 8, 7000
+        .word 21, 5288
+        .word 65, 5440
+        .word 42, 2350
+        .word 84, 6014
+        .word 90, 4628
+        .word 56, 2966
+        .word 79, 3534
+        .word 21, 5748
+        .word 9, 3240
+        .word 17, 3060
+        .word 33, 7504
+        .word 25, 6734
+        .word 29, 8056
+        .word 26, 3392
+        .word 75, 7658
+        .word 51, 1210
+        .word 87, 5132
+        .word 18, 4798
+        .word 97, 3562
+        .word 60, 5814
+        .word 41, 7902
+        .word 40, 3180
+        .word 83, 4322
+        .word 87, 1258
+        .word 95, 1412
+        .word 78, 1792
+        .word 96, 1910
+        .word 96, 3248
+        .word 96, 2098
+        .word 80, 7480
+        .word 71, 1724
+        .word 48, 5532
+        .word 95, 8518
+        .word 9, 1380
+        .word 35, 2452
+        .word 3, 1418
+        .word 8, 1112
+        .word 17, 4460
+        .word 40, 5012
+        .word 72, 4216
+        .word 52, 5396
+        .word 25, 4838
+        .word 72, 7710
+        .word 33, 1674
+        .word 52, 5894
+        .word 92, 2050
+        .word 92, 4304
+        .word 48, 4174
+        .word 76, 4562
+        .word 66, 2612
+        .word 19, 8712
+        .word 19, 2320
+        .word 8, 8736
+        .word 60, 5780
+        .word 34, 3430
+        .word 71, 1782
+        .word 68, 4132
+        .word 74, 5822
+        .word 68, 2594
+        .word 80, 3930
+        .word 53, 7812
+        .word 57, 4852
+        .word 32, 5240
+        .word 56, 7712
+        .word 6, 4244
+        .word 72, 1080
+        .word 83, 4834
+        .word 25, 6350
+        .word 25, 1078
+        .word 4, 2726
+        .word 20, 4212
+        .word 99, 7190
+        .word 5, 6232
+        .word 37, 4058
+        .word 11, 1242
+        .word 78, 7750
+        .word 14, 2898
+        .word 17, 2276
+        .word 56, 4254
+        .word 37, 5586
+        .word 96, 1062
+        .word 43, 6762
+        .word 50, 5046
+        .word 22, 8042
+        .word 79, 5664
+        .word 75, 3914
+        .word 57, 5798
+        .word 10, 2618
+        .word 9, 5560
+        .word 37, 6488
+        .word 59, 2890
+        .word 61, 2496
+        .word 6, 3874
+        .word 39, 8886
+        .word 54, 8640
+        .word 70, 2234
+        .word 68, 3804
+        .word 24, 7800
+        .word 54, 5812
+        .word 28, 1926
+        .word 73, 6088
+        .word 69, 6610
+        .word 47, 7668
+        .word 67, 1824
+        .word 54, 2534
+        .word 40, 5434
+        .word 31, 5014
+        .word 72, 8144
+        .word 91, 6986
+        .word 65, 1656
+        .word 60, 8384
+        .word 32, 7910
+        .word 35, 5714
+        .word 43, 5034
+        .word 68, 2918
+        .word 99, 9092
+        .word 57, 3702
+        .word 74, 3864
+        .word 68, 1224
+        .word 98, 1996
+        .word 58, 5730
+        .word 73, 3024
+        .word 98, 5092
+        .word 18, 7866
+        .word 14, 2038
+        .word 59, 7630
+        .word 3, 8098
+        .word 6, 5234
+        .word 24, 1302
+        .word 72, 5474
+        .word 17, 8756
+        .word 89, 6918
+        .word 93, 7226
+        .word 27, 7848
+        .word 22, 6932
+        .word 34, 5844
+        .word 16, 2146
+        .word 50, 6578
+        .word 90, 1908
+        .word 3, 5696
+        .word 71, 2100
+        .word 37, 2538
+        .word 43, 6344
+        .word 90, 4658
+        .word 49, 5244
+        .word 70, 2078
+        .word 5, 7536
+        .word 76, 5646
+        .word 72, 1026
+        .word 13, 3578
+        .word 19, 4802
+        .word 24, 4772
+        .word 40, 5300
+        .word 35, 8626
+        .word 84, 6710
+        .word 91, 6186
+        .word 84, 8432
+        .word 86, 5186
+        .word 99, 2886
+        .word 75, 8048
+        .word 84, 2258
+        .word 73, 1880
+        .word 96, 2206
+        .word 26, 3202
+        .word 26, 7352
+        .word 26, 8102
+        .word 66, 8154
+        .word 94, 6158
+        .word 88, 2590
+        .word 48, 6346
+        .word 41, 9086
+        .word 86, 4588
+        .word 78, 7650
+        .word 54, 1354
+        .word 47, 5932
+        .word 95, 6308
+        .word 86, 1550
+        .word 88, 3552
+        .word 29, 7158
+        .word 87, 3586
+        .word 43, 1190
+        .word 52, 4740
+        .word 35, 3956
+        .word 35, 2304
+        .word 33, 2800
+        .word 74, 7554
+        .word 60, 6928
+        .word 7, 2364
+        .word 61, 2366
+        .word 82, 5154
+        .word 22, 2018
+        .word 64, 4950
+        .word 82, 5302
+        .word 67, 2448
+        .word 36, 5536
+        .word 22, 2034
+        .word 46, 5774
+        .word 31, 8404
+        .word 94, 4960
+        .word 71, 7706
+        .word 24, 6082
+        .word 76, 3464
+        .word 46, 3828
+        .word 67, 7360
+        .word 73, 3172
+        .word 73, 5512
+        .word 25, 4342
+        .word 27, 7156
+        .word 9, 5364
+        .word 42, 5620
+        .word 71, 7948
+        .word 72, 7102
+        .word 7, 3324
+        .word 66, 4262
+        .word 17, 1118
+        .word 72, 4500
+        .word 93, 7122
+        .word 59, 4214
+        .word 62, 1662
+        .word 16, 2716
+        .word 97, 1624
+        .word 26, 7094
+        .word 80, 3108
+        .word 72, 5590
+        .word 10, 5630
+        .word 55, 8274
+        .word 59, 7030
+        .word 87, 6304
+        .word 41, 1336
+        .word 8, 3338
+        .word 9, 8390
+        .word 17, 3166
+        .word 70, 4750
+        .word 32, 2236
+        .word 94, 3088
+        .word 94, 4004
+        .word 88, 7592
+        .word 56, 2690
+        .word 23, 5628
+        .word 96, 6214
+        .word 77, 1676
+        .word 44, 1890
+        .word 24, 6138
+        .word 64, 4682
+        .word 20, 7294
+        .word 36, 3528
+        .word 61, 7574
+        .word 86, 7792
+        .word 51, 8582
+        .word 43, 7130
+        .word 61, 1556
+        .word 69, 1654
+        .word 79, 8280
+        .word 17, 1142
+        .word 54, 1374
+        .word 21, 1304
+        .word 37, 2344
+        .word 68, 5210
+        .word 32, 1520
+        .word 92, 5654
+        .word 24, 2386
+        .word 99, 1558
+        .word 96, 7138
+        .word 53, 5626
+        .word 50, 4986
+        .word 34, 5424
+        .word 45, 3808
+        .word 93, 5280
+        .word 53, 2156
+        .word 50, 1622
+        .word 15, 3602
+        .word 77, 2648
+        .word 70, 2284
+        .word 35, 4602
+        .word 67, 2342
+        .word 1, 8944
+        .word 61, 8044
+        .word 15, 9040
+        .word 51, 2024
+        .word 98, 3342
+        .word 73, 8064
+        .word 19, 7398
+        .word 60, 8426
+        .word 95, 5954
+        .word 18, 4298
+        .word 84, 5500
+        .word 4, 2416
+        .word 42, 8936
+        .word 30, 4556
+        .word 21, 6390
+        .word 44, 5050
+        .word 97, 4236
+        .word 1, 6816
+        .word 83, 1262
+        .word 45, 2602
+        .word 16, 5752
+        .word 42, 3048
+        .word 72, 5444
+        .word 47, 9126
+        .word 66, 7380
+        .word 67, 7522
+        .word 10, 8878
+        .word 83, 2508
+        .word 33, 5554
+        .word 1, 2458
+        .word 28, 5262
+        .word 2, 5324
+        .word 9, 7550
+        .word 49, 7830
+        .word 35, 5658
+        .word 50, 2398
+        .word 95, 7224
+        .word 51, 6216
+        .word 7, 3220
+        .word 7, 9044
+        .word 20, 8380
+        .word 68, 7068
+        .word 36, 7252
+        .word 59, 5816
+        .word 76, 6742
+        .word 48, 3042
+        .word 29, 4316
+        .word 62, 6872
+        .word 27, 2352
+        .word 8, 4024
+        .word 11, 2480
+        .word 18, 1206
+        .word 2, 2670
+        .word 59, 1308
+        .word 65, 7182
+        .word 41, 7310
+        .word 39, 5968
+        .word 94, 4198
+        .word 38, 4714
+        .word 98, 4456
+        .word 22, 4112
+        .word 60, 3512
+        .word 96, 8228
+        .word 29, 8500
+        .word 2, 8284
+        .word 75, 7146
+        .word 70, 4942
+        .word 23, 8918
+        .word 78, 1942
+        .word 45, 1166
+        .word 45, 5992
+        .word 55, 2072
+        .word 91, 6856
+        .word 58, 8184
+        .word 63, 8484
+        .word 42, 3856
+        .word 35, 6226
+        .word 87, 4776
+        .word 82, 7748
+        .word 55, 6340
+        .word 57, 3072
+        .word 12, 3796
+        .word 3, 7198
+        .word 57, 6476
+        .word 35, 3250
+        .word 88, 8898
+        .word 88, 6600
+        .word 2, 6708
+        .word 49, 4374
+        .word 18, 1774
+        .word 57, 5606
+        .word 25, 1534
+        .word 45, 1388
+        .word 73, 4510
+        .word 81, 8662
+        .word 45, 6348
+        .word 95, 8656
+        .word 12, 5764
+        .word 81, 6570
+        .word 53, 8010
+        .word 20, 4188
+        .word 36, 3454
+        .word 67, 8134
+        .word 78, 1204
+        .word 33, 7898
+        .word 13, 3142
+        .word 25, 4696
+        .word 28, 7934
+        .word 9, 6684
+        .word 82, 4010
+        .word 70, 8716
+        .word 34, 4642
+        .word 89, 2270
+        .word 16, 6148
+        .word 86, 2536
+        .word 9, 3514
+        .word 84, 3296
+        .word 54, 8908
+        .word 69, 1222
+        .word 8, 3634
+        .word 3, 4918
+        .word 78, 1422
+        .word 63, 5652
+        .word 68, 5416
+        .word 81, 4348
+        .word 1, 9024
+        .word 4, 8498
+        .word 98, 7396
+        .word 40, 9062
+        .word 54, 1734
+        .word 71, 2274
+        .word 22, 4404
+        .word 72, 2658
+        .word 1, 8494
+        .word 9, 8006
+        .word 36, 6470
+        .word 22, 4604
+        .word 94, 5332
+        .word 97, 3788
+        .word 7, 5410
+        .word 32, 2688
+        .word 19, 7664
+        .word 67, 2914
+        .word 30, 5786
+        .word 7, 8980
+        .word 99, 9002
+        .word 40, 8686
+        .word 32, 2936
+        .word 15, 2622
+        .word 99, 2794
+        .word 57, 2868
+        .word 88, 8018
+        .word 96, 5480
+        .word 58, 3520
+        .word 1, 3962
+        .word 20, 3636
+        .word 25, 2528
+        .word 88, 6940
+        .word 43, 1376
+        .word 94, 1286
+        .word 54, 5724
+        .word 25, 5286
+        .word 74, 1542
+        .word 9, 2940
+        .word 72, 2920
+        .word 55, 6334
+        .word 13, 7186
+        .word 11, 6536
+        .word 77, 1914
+        .word 6, 5960
+        .word 4, 2222
+        .word 26, 1256
+        .word 53, 5374
+        .word 56, 5676
+        .word 60, 1660
+        .word 58, 6808
+        .word 17, 5056
+        .word 62, 3504
+        .word 39, 4050
+        .word 40, 2054
+        .word 72, 4496
+        .word 19, 9134
+        .word 37, 1956
+        .word 49, 3500
+        .word 81, 6306
+        .word 38, 6896
+        .word 78, 5636
+        .word 93, 3032
+        .word 79, 4446
+        .word 97, 1738
+        .word 14, 8960
+        .word 9, 4512
+        .word 5, 8252
+        .word 65, 8332
+        .word 95, 6194
+        .word 32, 7572
+        .word 49, 7458
+        .word 35, 3234
+        .word 54, 5514
+        .word 83, 5542
+        .word 39, 7932
+        .word 30, 4486
+        .word 67, 6592
+        .word 91, 3752
+        .word 8, 4448
+        .word 27, 6128
+        .word 34, 4410
+        .word 63, 1230
+        .word 78, 6394
+        .word 90, 5174
+        .word 3, 1392
+        .word 46, 6400
+        .word 15, 3478
+        .word 85, 4246
+        .word 99, 2004
+        .word 28, 2624
+        .word 96, 3762
+        .word 66, 6814
+        .word 16, 5856
+        .word 24, 2424
+        .word 38, 3138
+        .word 64, 4866
+        .word 22, 7376
+        .word 20, 8634
+        .word 41, 5792
+        .word 34, 7104
+        .word 84, 2382
+        .word 21, 2286
+        .word 64, 5864
+        .word 81, 7208
+        .word 37, 5918
+        .word 7, 2840
+        .word 36, 5964
+        .word 70, 8272
+        .word 13, 8816
+        .word 53, 6242
+        .word 1, 7534
+        .word 7, 3306
+        .word 37, 2204
+        .word 84, 3254
+        .word 33, 7468
+        .word 78, 3400
+        .word 10, 3436
+        .word 31, 4736
+        .word 30, 8180
+        .word 56, 6802
+        .word 67, 2310
+        .word 26, 1048
+        .word 61, 9194
+        .word 90, 2160
+        .word 90, 6556
+        .word 45, 3620
+        .word 68, 3364
+        .word 39, 5372
+        .word 39, 7518
+        .word 91, 1830
+        .word 98, 8206
+        .word 10, 2810
+        .word 22, 5238
+        .word 83, 5390
+        .word 62, 5404
+        .word 30, 6632
+        .word 49, 4990
+        .word 95, 1594
+        .word 45, 3696
+        .word 45, 6860
+        .word 44, 5754
+        .word 86, 7022
+        .word 52, 3018
+        .word 82, 6804
+        .word 12, 2646
+        .word 94, 4490
+        .word 36, 4406
+        .word 67, 2058
+        .word 10, 2770
+        .word 1, 7144
+        .word 16, 2430
+        .word 37, 5184
+        .word 61, 8682
+        .word 21, 4578
+        .word 43, 3410
+        .word 53, 1046
+        .word 88, 5432
+        .word 42, 6996
+        .word 7, 1740
+        .word 58, 8360
+        .word 77, 8346
+        .word 97, 2334
+        .word 47, 7326
+        .word 44, 8894
+        .word 63, 7032
+        .word 4, 3628
+        .word 53, 7982
+        .word 7, 4652
+        .word 29, 2930
+        .word 87, 6884
+        .word 12, 6062
+        .word 32, 2684
+        .word 22, 2854
+        .word 40, 5608
+        .word 17, 8188
+        .word 73, 8560
+        .word 54, 7940
+        .word 15, 8068
+        .word 43, 3640
+        .word 34, 4640
+        .word 45, 6078
+        .word 34, 2116
+        .word 83, 8916
+        .word 59, 3950
+        .word 87, 6072
+        .word 42, 8338
+        .word 30, 5358
+        .word 3, 2904
+        .word 15, 7868
+        .word 93, 7552
+        .word 24, 4190
+        .word 51, 7136
+        .word 42, 3122
+        .word 85, 8356
+        .word 85, 1232
+        .word 99, 9036
+        .word 86, 4894
+        .word 37, 8734
+        .word 55, 3076
+        .word 23, 7786
+        .word 82, 5006
+        .word 54, 8066
+        .word 61, 8534
+        .word 79, 3498
+        .word 47, 9212
+        .word 93, 7168
+        .word 38, 7354
+        .word 51, 4052
+        .word 7, 6286
+        .word 63, 7544
+        .word 65, 2048
+        .word 13, 1148
+        .word 8, 4916
+        .word 42, 4548
+        .word 28, 7922
+        .word 37, 7082
+        .word 62, 4224
+        .word 42, 9034
+        .word 60, 3094
+        .word 21, 7426
+        .word 86, 8612
+        .word 53, 8420
+        .word 99, 1928
+        .word 95, 5616
+        .word 88, 8752
+        .word 13, 9098
+        .word 67, 1884
+        .word 72, 7320
+        .word 82, 2070
+        .word 17, 8620
+        .word 35, 3756
+        .word 32, 1524
+        .word 85, 2570
+        .word 36, 4840
+        .word 96, 3980
+        .word 94, 6000
+        .word 6, 7106
+        .word 62, 1464
+        .word 3, 5002
+        .word 76, 5222
+        .word 36, 8294
+        .word 19, 3608
+        .word 95, 7904
+        .word 23, 4176
+        .word 71, 6670
+        .word 74, 5592
+        .word 93, 5366
+        .word 91, 2700
+        .word 99, 1156
+        .word 94, 1396
+        .word 24, 5204
+        .word 66, 8688
+        .word 22, 4702
+        .word 79, 5958
+        .word 18, 5196
+        .word 80, 8648
+        .word 31, 2958
+        .word 70, 5140
+        .word 45, 8496
+        .word 21, 2178
+        .word 41, 5566
+        .word 20, 5776
+        .word 99, 2772
+        .word 5, 1898
+        .word 76, 7184
+        .word 19, 5686
+        .word 88, 8434
+        .word 29, 2322
+        .word 5, 7260
+        .word 45, 6950
+        .word 25, 6910
+        .word 83, 4228
+        .word 39, 7816
+        .word 85, 4418
+        .word 4, 6018
+        .word 27, 6694
+        .word 83, 7134
+        .word 75, 1742
+        .word 75, 2512
+        .word 49, 1838
+        .word 49, 4724
+        .word 25, 3576
+        .word 16, 6256
+        .word 97, 5802
+        .word 86, 4984
+        .word 53, 7110
+        .word 25, 5108
+        .word 38, 4258
+        .word 67, 9112
+        .word 96, 2136
+        .word 86, 4284
+        .word 93, 6456
+        .word 77, 4854
+        .word 86, 5266
+        .word 58, 3846
+        .word 45, 5304
+        .word 70, 3544
+        .word 30, 2826
+        .word 18, 3680
+        .word 55, 1294
+        .word 3, 4722
+        .word 89, 2892
+        .word 24, 2162
+        .word 26, 8580
+        .word 78, 2604
+        .word 49, 3206
+        .word 40, 7796
+        .word 79, 5418
+        .word 88, 2834
+        .word 44, 2370
+        .word 80, 6414
+        .word 86, 5448
+        .word 53, 1076
+        .word 61, 2530
+        .word 5, 1484
+        .word 59, 4082
+        .word 29, 6316
+        .word 18, 7482
+        .word 59, 2664
+        .word 12, 3508
+        .word 64, 7828
+        .word 46, 4846
+        .word 87, 6968
+        .word 66, 4438
+        .word 18, 7662
+        .word 9, 8084
+        .word 37, 3304
+        .word 78, 1732
+        .word 74, 8986
+        .word 24, 6510
+        .word 38, 6914
+        .word 85, 8826
+        .word 95, 8254
+        .word 60, 4812
+        .word 47, 5880
+        .word 94, 2076
+        .word 8, 3038
+        .word 39, 9200
+        .word 58, 8812
+        .word 81, 9054
+        .word 2, 3872
+        .word 55, 6876
+        .word 48, 2998
+        .word 17, 5614
+        .word 93, 2174
+        .word 75, 8748
+        .word 67, 4606
+        .word 58, 5162
+        .word 79, 1834
+        .word 55, 1750
+        .word 98, 4810
+        .word 36, 2044
+        .word 11, 1182
+        .word 96, 2330
+        .word 39, 3416
+        .word 20, 3610
+        .word 51, 1672
+        .word 22, 5602
+        .word 69, 6386
+        .word 18, 6434
+        .word 31, 3070
+        .word 47, 7006
+        .word 18, 4824
+        .word 75, 3760
+        .word 97, 8136
+        .word 38, 8446
+        .word 36, 5508
+        .word 88, 7394
+        .word 22, 2992
+        .word 95, 2214
+        .word 21, 5642
+        .word 50, 4016
+        .word 20, 2762
+        .word 70, 8844
+        .word 78, 4426
+        .word 43, 1922
+        .word 49, 6862
+        .word 58, 5732
+        .word 37, 7652
+        .word 30, 1696
+        .word 49, 8480
+        .word 90, 7676
+        .word 8, 2296
+        .word 53, 6048
+        .word 10, 2910
+        .word 81, 4120
+        .word 39, 5334
+        .word 45, 4116
+        .word 6, 3186
+        .word 17, 5454
+        .word 6, 7466
+        .word 61, 6512
+        .word 68, 5936
+        .word 54, 7740
+        .word 1, 8746
+        .word 47, 3658
+        .word 56, 2126
+        .word 12, 6520
+        .word 42, 3564
+        .word 20, 7944
+        .word 7, 7814
+        .word 98, 3550
+        .word 93, 2482
+        .word 81, 6130
+        .word 44, 1960
+        .word 80, 5680
+        .word 93, 7762
+        .word 47, 7810
+        .word 71, 5224
+        .word 83, 1816
+        .word 43, 4980
+        .word 17, 3378
+        .word 65, 6930
+        .word 87, 4146
+        .word 21, 8414
+        .word 2, 8778
+        .word 35, 4060
+        .word 54, 2166
+        .word 47, 4362
+        .word 69, 5708
+        .word 76, 2586
+        .word 40, 8940
+        .word 38, 3386
+        .word 17, 2380
+        .word 46, 3998
+        .word 29, 4064
+        .word 99, 8670
+        .word 4, 1478
+        .word 2, 3460
+        .word 7, 2702
+        .word 70, 3764
+        .word 63, 3266
+        .word 98, 8650
+        .word 76, 3174
+        .word 52, 5828
+        .word 24, 7906
+        .word 47, 6098
+        .word 20, 1936
+        .word 86, 4698
+        .word 18, 5072
+        .word 10, 6222
+        .word 87, 1246
+        .word 19, 7882
+        .word 37, 2638
+        .word 28, 6224
+        .word 6, 6440
+        .word 40, 4636
+        .word 27, 2608
+        .word 14, 6290
+        .word 24, 3130
+        .word 61, 2862
+        .word 94, 3356
+        .word 19, 7708
+        .word 29, 4996
+        .word 41, 5284
+        .word 48, 3112
+        .word 19, 6136
+        .word 10, 4334
+        .word 78, 5482
+        .word 23, 6364
+        .word 13, 7872
+        .word 86, 3298
+        .word 3, 5250
+        .word 79, 5810
+        .word 83, 1320
+        .word 50, 5194
+        .word 60, 4476
+        .word 98, 2220
+        .word 32, 1280
+        .word 96, 3678
+        .word 38, 3466
+        .word 86, 7852
+        .word 60, 1244
+        .word 85, 1216
+        .word 44, 3474
+        .word 27, 4210
+        .word 97, 4458
+        .word 75, 7152
+        .word 63, 5292
+        .word 59, 2312
+        .word 24, 6008
+        .word 47, 3770
+        .word 90, 3906
+        .word 1, 7016
+        .word 34, 6484
+        .word 16, 4828
+        .word 65, 8174
+        .word 3, 6066
+        .word 56, 1330
+        .word 95, 8202
+        .word 72, 5982
+        .word 43, 7108
+        .word 37, 6550
+        .word 37, 3638
+        .word 19, 7296
+        .word 29, 3912
+        .word 69, 2408
+        .word 38, 3116
+        .word 23, 7340
+        .word 54, 6016
+        .word 44, 7220
+        .word 6, 7858
+        .word 56, 4098
+        .word 63, 3158
+        .word 75, 9058
+        .word 1, 3740
+        .word 51, 1708
+        .word 32, 6944
+        .word 11, 3272
+        .word 34, 7578
+        .word 69, 3730
+        .word 2, 7528
+        .word 61, 6096
+        .word 97, 4808
+        .word 9, 3096
+        .word 76, 2856
+        .word 88, 5016
+        .word 31, 3704
+        .word 8, 9018
+        .word 49, 3482
+        .word 54, 7760
+        .word 68, 2764
+        .word 17, 2250
+        .word 27, 5216
+        .word 83, 6784
+        .word 63, 8162
+        .word 82, 5876
+        .word 45, 8430
+        .word 45, 5548
+        .word 28, 7770
+        .word 59, 1032
+        .word 66, 8300
+        .word 40, 5336
+        .word 93, 8750
+        .word 49, 1730
+        .word 26, 8796
+        .word 4, 7456
+        .word 4, 4672
+        .word 99, 6692
+        .word 87, 9102
+        .word 17, 2324
+        .word 5, 5102
+        .word 43, 6868
+        .word 18, 4122
+        .word 24, 9120
+        .word 44, 4528
+        .word 27, 5770
+        .word 16, 9152
+        .word 16, 3580
+        .word 84, 1590
+        .word 38, 6378
+        .word 74, 2748
+        .word 26, 6432
+        .word 4, 9182
+        .word 40, 8622
+        .word 92, 4420
+        .word 66, 7718
+        .word 55, 7334
+        .word 11, 8906
+        .word 38, 3938
+        .word 97, 4884
+        .word 75, 2142
+        .word 56, 5098
+        .word 1, 5252
+        .word 3, 5066
+        .word 80, 6752
+        .word 7, 7254
+        .word 93, 3986
+        .word 63, 3746
+        .word 36, 1070
+        .word 81, 8444
+        .word 36, 3210
+        .word 20, 7976
+        .word 27, 2226
+        .word 78, 3792
+        .word 17, 2580
+        .word 32, 5956
+        .word 41, 7960
+        .word 23, 5052
+        .word 79, 4002
+        .word 39, 2584
+        .word 63, 2208
+        .word 81, 3310
+        .word 19, 7048
+        .word 18, 5384
+        .word 29, 2524
+        .word 58, 5036
+        .word 23, 2052
+        .word 68, 4614
+        .word 92, 4620
+        .word 44, 1452
+        .word 34, 8594
+        .word 82, 6166
+        .word 34, 3476
+        .word 31, 7724
+        .word 51, 4908
+        .word 82, 7448
+        .word 66, 1296
+        .word 36, 8026
+        .word 62, 5142
+        .word 33, 4764
+        .word 91, 4286
+        .word 19, 1288
+        .word 40, 1552
+        .word 51, 1358
+        .word 93, 6606
+        .word 56, 6210
+        .word 81, 8186
+        .word 86, 6952
+        .word 15, 5458
+        .word 5, 3682
+        .word 3, 6596
+        .word 46, 3802
+        .word 27, 8718
+        .word 90, 2568
+        .word 68, 7066
+        .word 43, 8182
+        .word 56, 5510
+        .word 78, 5160
+        .word 41, 1636
+        .word 90, 4094
+        .word 73, 5870
+        .word 37, 1220
+        .word 35, 6398
+        .word 82, 4896
+        .word 81, 6998
+        .word 47, 8690
+        .word 32, 7860
+        .word 49, 3302
+        .word 56, 5842
+        .word 50, 2180
+        .word 9, 4084
+        .word 82, 2140
+        .word 16, 7486
+        .word 22, 3940
+        .word 51, 5464
+        .word 22, 1446
+        .word 44, 8950
+        .word 50, 4814
+        .word 16, 3432
+        .word 6, 1228
+        .word 82, 8172
+        .word 22, 2660
+        .word 67, 2022
+        .word 68, 6530
+        .word 84, 1240
+        .word 18, 1664
+        .word 93, 4366
+        .word 25, 9010
+        .word 67, 7618
+        .word 71, 1140
+        .word 88, 8290
+        .word 95, 3402
+        .word 12, 3664
+        .word 50, 5848
+        .word 82, 6676
+        .word 3, 6288
+        .word 58, 5980
+        .word 50, 5820
+        .word 52, 1544
+        .word 8, 5420
+        .word 67, 1608
+        .word 74, 5350
+        .word 20, 4124
+        .word 86, 5574
+        .word 23, 7666
+        .word 90, 4832
+        .word 6, 8636
+        .word 28, 4732
+        .word 68, 5294
+        .word 13, 5428
+        .word 94, 9006
+        .word 37, 8900
+        .word 19, 7044
+        .word 47, 6410
+        .word 79, 6300
+        .word 1, 2388
+        .word 33, 5580
+        .word 10, 7854
+        .word 41, 1582
+        .word 68, 3230
+        .word 66, 7892
+        .word 88, 2950
+        .word 59, 2820
+        .word 37, 5060
+        .word 62, 2192
+        .word 32, 8214
+        .word 18, 4952
+        .word 62, 1504
+        .word 97, 4000
+        .word 61, 5504
+        .word 74, 3350
+        .word 39, 5728
+        .word 6, 1094
+        .word 97, 3812
+        .word 9, 5100
+        .word 23, 8530
+        .word 47, 7958
+        .word 70, 3104
+        .word 66, 6534
+        .word 18, 1346
+        .word 99, 1856
+        .word 2, 1706
+        .word 43, 5110
+        .word 90, 5598
+        .word 45, 4300
+        .word 81, 6004
+        .word 60, 7284
+        .word 3, 4626
+        .word 73, 8590
+        .word 71, 2362
+        .word 50, 8884
+        .word 12, 8774
+        .word 94, 1058
+        .word 35, 8794
+        .word 13, 2740
+        .word 99, 1052
+        .word 22, 7332
+        .word 72, 7540
+        .word 34, 6244
+        .word 55, 1710
+        .word 21, 7116
+        .word 46, 7756
+        .word 14, 8630
+        .word 80, 3624
+        .word 17, 4354
+        .word 82, 1790
+        .word 30, 8194
+        .word 96, 6594
+        .word 91, 6686
+        .word 98, 8458
+        .word 49, 4272
+        .word 54, 3450
+        .word 28, 5138
+        .word 78, 2598
+        .word 17, 4788
+        .word 59, 5826
+        .word 11, 3548
+        .word 16, 7338
+        .word 38, 6374
+        .word 79, 5170
+        .word 15, 2732
+        .word 7, 7672
+        .word 38, 3656
+        .word 97, 3532
+        .word 38, 7682
+        .word 9, 7766
+        .word 78, 1684
+        .word 54, 6318
+        .word 7, 2756
+        .word 54, 2636
+        .word 27, 8888
+        .word 36, 6246
+        .word 10, 1560
+        .word 17, 7034
+        .word 19, 5984
+        .word 37, 3726
+        .word 33, 7142
+        .word 10, 2346
+        .word 50, 8568
+        .word 22, 2682
+        .word 49, 3204
+        .word 97, 6172
+        .word 27, 8060
+        .word 34, 3546
+        .word 31, 7788
+        .word 79, 5702
+        .word 32, 5146
+        .word 32, 9190
+        .word 9, 4022
+        .word 73, 7392
+        .word 9, 6980
+        .word 8, 1574
+        .word 37, 6582
+        .word 66, 6254
+        .word 13, 3698
+        .word 86, 2102
+        .word 94, 3330
+        .word 28, 6294
+        .word 72, 6220
+        .word 96, 1900
+        .word 57, 5400
+        .word 68, 3734
+        .word 92, 8820
+        .word 76, 9168
+        .word 44, 2848
+        .word 79, 3854
+        .word 28, 3492
+        .word 34, 5362
+        .word 38, 8200
+        .word 87, 2106
+        .word 8, 4804
+        .word 28, 2158
+        .word 80, 7070
+        .word 28, 4020
+        .word 19, 3836
+        .word 72, 2644
+        .word 81, 2628
+        .word 8, 7400
+        .word 61, 6728
+        .word 88, 1282
+        .word 88, 6468
+        .word 5, 4172
+        .word 57, 1154
+        .word 9, 5782
+        .word 65, 4040
+        .word 75, 4182
+        .word 60, 2114
+        .word 38, 1844
+        .word 51, 8876
+        .word 13, 3150
+        .word 11, 4204
+        .word 68, 5078
+        .word 71, 5070
+        .word 61, 6526
+        .word 75, 3728
+        .word 72, 4428
+        .word 37, 7586
+        .word 86, 2450
+        .word 28, 8810
+        .word 74, 3288
+        .word 16, 6770
+        .word 8, 6352
+        .word 13, 4088
+        .word 44, 8966
+        .word 8, 3412
+        .word 15, 3382
+        .word 98, 3742
+        .word 18, 2566
+        .word 32, 6022
+        .word 76, 7736
+        .word 84, 7864
+        .word 55, 3208
+        .word 21, 7632
+        .word 75, 3418
+        .word 30, 2786
+        .word 68, 1168
+        .word 22, 1414
+        .word 82, 3020
+        .word 22, 7884
+        .word 7, 3918
+        .word 32, 8840
+        .word 29, 4954
+        .word 43, 1904
+        .word 52, 9056
+        .word 19, 6960
+        .word 52, 5808
+        .word 45, 2314
+        .word 32, 6934
+        .word 73, 3002
+        .word 1, 5660
+        .word 94, 5042
+        .word 50, 4266
+        .word 99, 2440
+        .word 62, 8062
+        .word 95, 2232
+        .word 14, 5398
+        .word 14, 1356
+        .word 73, 3506
+        .word 8, 6154
+        .word 30, 4524
+        .word 73, 3718
+        .word 87, 2212
+        .word 70, 7506
+        .word 27, 7292
+        .word 97, 3388
+        .word 51, 6450
+        .word 64, 3894
+        .word 42, 5846
+        .word 67, 7472
+        .word 59, 5426
+        .word 60, 1438
+        .word 56, 7386
+        .word 43, 8726
+        .word 41, 2600
+        .word 25, 8366
+        .word 42, 1896
+        .word 2, 1940
+        .word 30, 1570
+        .word 32, 4508
+        .word 98, 8108
+        .word 11, 7516
+        .word 91, 6038
+        .word 75, 5572
+        .word 43, 6412
+        .word 63, 6942
+        .word 38, 8350
+        .word 63, 5970
+        .word 17, 9080
+        .word 6, 7930
+        .word 12, 8286
+        .word 83, 4208
+        .word 48, 3852
+        .word 33, 8220
+        .word 54, 4946
+        .word 15, 3524
+        .word 24, 6772
+        .word 97, 2650
+        .word 57, 8864
+        .word 35, 8130
+        .word 24, 4616
+        .word 10, 9026
+        .word 36, 5406
+        .word 3, 2060
+        .word 41, 7834
+        .word 74, 7382
+        .word 31, 4402
+        .word 60, 7610
+        .word 77, 8584
+        .word 70, 8638
+        .word 8, 3224
+        .word 23, 1054
+        .word 71, 5112
+        .word 71, 6424
+        .word 61, 1318
+        .word 29, 7678
+        .word 73, 2738
+        .word 41, 8902
+        .word 27, 8030
+        .word 22, 6198
+        .word 63, 3920
+        .word 44, 7956
+        .word 61, 8814
+        .word 43, 7462
+        .word 22, 8472
+        .word 28, 7166
+        .word 77, 6586
+        .word 56, 3896
+        .word 71, 4118
+        .word 39, 4394
+        .word 78, 6056
+        .word 63, 2790
+        .word 64, 7178
+        .word 56, 8476
+        .word 60, 9104
+        .word 83, 1868
+        .word 25, 5198
+        .word 19, 1668
+        .word 36, 2268
+        .word 41, 7026
+        .word 73, 8440
+        .word 10, 8368
+        .word 3, 8054
+        .word 97, 2454
+        .word 81, 9130
+        .word 12, 7608
+        .word 77, 1924
+        .word 21, 1030
+        .word 27, 8474
+        .word 94, 4036
+        .word 82, 4542
+        .word 43, 8536
+        .word 54, 8114
+        .word 36, 7962
+        .word 70, 4114
+        .word 49, 7008
+        .word 70, 5008
+        .word 33, 1448
+        .word 42, 5692
+        .word 79, 1348
+        .word 11, 5834
+        .word 51, 7120
+        .word 82, 7530
+        .word 18, 3144
+        .word 66, 4756
+        .word 2, 7232
+        .word 45, 1980
+        .word 50, 6376
+        .word 87, 3692
+        .word 5, 2514
+        .word 24, 1372
+        .word 1, 8882
+        .word 42, 5296
+        .word 73, 8910
+        .word 56, 6200
+        .word 44, 3414
+        .word 62, 8222
+        .word 80, 1384
+        .word 31, 3526
+        .word 50, 4070
+        .word 39, 1444
+        .word 1, 2964
+        .word 34, 8352
+        .word 63, 6026
+        .word 55, 1398
+        .word 43, 4932
+        .word 98, 2880
+        .word 99, 1586
+        .word 41, 2422
+        .word 79, 5726
+        .word 51, 7218
+        .word 52, 7164
+        .word 45, 7460
+        .word 59, 1704
+        .word 29, 3082
+        .word 23, 5974
+        .word 21, 4478
+        .word 10, 4934
+        .word 11, 3420
+        .word 48, 6608
+        .word 75, 5922
+        .word 13, 8330
+        .word 25, 7764
+        .word 87, 3944
+        .word 53, 1828
+        .word 8, 2432
+        .word 7, 8850
+        .word 31, 8234
+        .word 52, 3612
+        .word 64, 6704
+        .word 69, 4516
+        .word 72, 1858
+        .word 13, 6790
+        .word 77, 7946
+        .word 2, 5784
+        .word 9, 7438
+        .word 6, 6312
+        .word 8, 8422
+        .word 50, 8722
+        .word 71, 8732
+        .word 49, 5698
+        .word 88, 1722
+        .word 63, 2996
+        .word 4, 5584
+        .word 30, 7656
+        .word 1, 1954
+        .word 47, 7452
+        .word 19, 4552
+        .word 15, 9114
+        .word 45, 8802
+        .word 22, 8488
+        .word 62, 3372
+        .word 31, 2490
+        .word 42, 2896
+        .word 80, 3654
+        .word 79, 3590
+        .word 39, 8040
+        .word 37, 4290
+        .word 36, 9166
+        .word 40, 5890
+        .word 69, 3672
+        .word 96, 6564
+        .word 97, 2562
+        .word 27, 7908
+        .word 38, 6054
+        .word 9, 1862
+        .word 35, 9142
+        .word 87, 3820
+        .word 41, 8922
+        .word 54, 5526
+        .word 94, 5706
+        .word 59, 2216
+        .word 73, 6506
+        .word 44, 1600
+        .word 30, 1366
+        .word 52, 9012
+        .word 17, 2776
+        .word 5, 3716
+        .word 17, 4422
+        .word 59, 6598
+        .word 34, 3040
+        .word 46, 6360
+        .word 68, 1364
+        .word 59, 8262
+        .word 32, 4468
+        .word 12, 4288
+        .word 1, 6040
+        .word 45, 2960
+        .word 45, 8768
+        .word 14, 1360
+        .word 71, 3732
+        .word 28, 4340
+        .word 33, 7004
+        .word 49, 3258
+        .word 30, 8248
+        .word 27, 3404
+        .word 46, 5694
+        .word 44, 4364
+        .word 72, 6664
+        .word 51, 4758
+        .word 59, 2952
+        .word 41, 6174
+        .word 8, 7010
+        .word 85, 6754
+        .word 60, 1394
+        .word 57, 3670
+        .word 29, 6544
+        .word 62, 6430
+        .word 82, 7266
+        .word 17, 6472
+        .word 38, 2620
+        .word 81, 8914
+        .word 95, 8976
+        .word 99, 1132
+        .word 31, 7240
+        .word 95, 6744
+        .word 22, 3600
+        .word 42, 4414
+        .word 3, 6474
+        .word 54, 6338
+        .word 69, 4056
+        .word 79, 8028
+        .word 19, 7492
+        .word 66, 2680
+        .word 93, 6730
+        .word 27, 8160
+        .word 38, 6266
+        .word 63, 6170
+        .word 43, 7454
+        .word 70, 7998
+        .word 51, 7206
+        .word 76, 8034
+        .word 27, 5192
+        .word 42, 2282
+        .word 78, 2532
+        .word 4, 4194
+        .word 63, 1796
+        .word 75, 5010
+        .word 86, 7942
+        .word 63, 5122
+        .word 50, 9174
+        .word 82, 7862
+        .word 43, 8956
+        .word 68, 4326
+        .word 23, 3000
+        .word 21, 4096
+        .word 50, 1186
+        .word 40, 4274
+        .word 97, 7822
+        .word 99, 1644
+        .word 90, 3284
+        .word 58, 8312
+        .word 34, 7548
+        .word 67, 4006
+        .word 73, 8080
+        .word 97, 1498
+        .word 91, 4826
+        .word 68, 1480
+        .word 27, 5452
+        .word 13, 6622
+        .word 29, 4048
+        .word 60, 1428
+        .word 41, 4102
+        .word 10, 4416
+        .word 66, 4538
+        .word 58, 4046
+        .word 90, 4078
+        .word 15, 3178
+        .word 16, 1758
+        .word 20, 1332
+        .word 89, 8614
+        .word 44, 6590
+        .word 17, 3484
+        .word 32, 2010
+        .word 41, 1716
+        .word 79, 9146
+        .word 24, 4306
+        .word 39, 2088
+        .word 78, 5920
+        .word 3, 3086
+        .word 65, 4728
+        .word 51, 7784
+        .word 19, 7700
+        .word 25, 2202
+        .word 6, 9074
+        .word 96, 4074
+        .word 36, 7098
+        .word 19, 1406
+        .word 90, 6034
+        .word 94, 8798
+        .word 58, 5506
+        .word 48, 2734
+        .word 58, 8988
+        .word 54, 7300
+        .word 4, 6108
+        .word 11, 4092
+        .word 63, 3648
+        .word 23, 8714
+        .word 48, 4158
+        .word 20, 6576
+        .word 89, 4312
+        .word 37, 8928
+        .word 56, 1566
+        .word 32, 4738
+        .word 69, 3156
+        .word 17, 2290
+        .word 41, 3468
+        .word 93, 3816
+        .word 56, 7114
+        .word 5, 3738
+        .word 23, 4156
+        .word 60, 8644
+        .word 92, 4994
+        .word 83, 6192
+        .word 79, 5564
+        .word 86, 9132
+        .word 17, 8618
+        .word 31, 7154
+        .word 51, 2676
+        .word 83, 1966
+        .word 90, 7420
+        .word 80, 8038
+        .word 44, 1250
+        .word 89, 8660
+        .word 94, 6624
+        .word 81, 6648
+        .word 83, 5090
+        .word 42, 3046
+        .word 14, 6652
+        .word 19, 2656
+        .word 4, 7680
+        .word 47, 6776
+        .word 22, 1714
+        .word 12, 6922
+        .word 25, 6904
+        .word 16, 2066
+        .word 34, 8964
+        .word 55, 5230
+        .word 1, 5882
+        .word 47, 4572
+        .word 47, 7286
+        .word 32, 1630
+        .word 97, 3502
+        .word 41, 1852
+        .word 44, 5836
+        .word 81, 3522
+        .word 42, 5866
+        .word 32, 3876
+        .word 16, 5524
+        .word 18, 1736
+        .word 37, 1670
+        .word 92, 1882
+        .word 36, 1762
+        .word 23, 5910
+        .word 17, 2722
+        .word 55, 5346
+        .word 72, 1420
+        .word 1, 3594
+        .word 46, 4822
+        .word 83, 5552
+        .word 56, 3686
+        .word 22, 7938
+        .word 71, 2556
+        .word 86, 2728
+        .word 39, 6682
+        .word 33, 4874
+        .word 38, 3518
+        .word 93, 7112
+        .word 86, 8846
+        .word 40, 4868
+        .word 53, 6218
+        .word 88, 8230
+        .word 54, 6522
+        .word 68, 5226
+        .word 84, 4760
+        .word 23, 1514
+        .word 66, 4424
+        .word 87, 4038
+        .word 56, 4820
+        .word 57, 2414
+        .word 40, 1798
+        .word 29, 6012
+        .word 10, 7314
+        .word 67, 2122
+        .word 94, 3004
+        .word 47, 7470
+        .word 12, 3270
+        .word 90, 7916
+        .word 57, 6882
+        .word 24, 3724
+        .word 54, 5228
+        .word 2, 8376
+        .word 95, 6126
+        .word 36, 3354
+        .word 65, 6826
+        .word 88, 8818
+        .word 6, 2080
+        .word 78, 7076
+        .word 26, 4876
+        .word 55, 8868
+        .word 48, 8792
+        .word 2, 7726
+        .word 21, 5722
+        .word 21, 1310
+        .word 45, 2316
+        .word 57, 2300
+        .word 57, 2008
+        .word 63, 8968
+        .word 71, 6310
+        .word 59, 2384
+        .word 39, 2358
+        .word 16, 7330
+        .word 42, 2784
+        .word 59, 7230
+        .word 70, 6958
+        .word 66, 1912
+        .word 51, 6068
+        .word 5, 6092
+        .word 29, 3198
+        .word 81, 5666
+        .word 34, 4914
+        .word 56, 8298
+        .word 22, 8362
+        .word 58, 4268
+        .word 35, 3888
+        .word 66, 5806
+        .word 83, 2994
+        .word 93, 4350
+        .word 3, 6080
+        .word 7, 1902
+        .word 31, 1082
+        .word 71, 8512
+        .word 21, 1916
+        .word 61, 2576
+        .word 55, 3972
+        .word 67, 8110
+        .word 87, 8490
+        .word 96, 1300
+        .word 75, 3176
+        .word 45, 6866
+        .word 86, 6688
+        .word 67, 5672
+        .word 85, 2692
+        .word 49, 3300
+        .word 32, 8996
+        .word 7, 5328
+        .word 86, 7262
+        .word 58, 9072
+        .word 34, 3290
+        .word 44, 7476
+        .word 9, 6890
+        .word 37, 4264
+        .word 41, 9008
+        .word 92, 5994
+        .word 83, 7606
+        .word 52, 4878
+        .word 64, 7092
+        .word 96, 5988
+        .word 17, 8696
+        .word 58, 7350
+        .word 22, 6696
+        .word 69, 4196
+        .word 26, 6786
+        .word 79, 7728
+        .word 11, 4090
+        .word 63, 1382
+        .word 41, 6122
+        .word 3, 4902
+        .word 59, 7758
+        .word 87, 9082
+        .word 93, 3050
+        .word 80, 2882
+        .word 5, 1978
+        .word 81, 7024
+        .word 35, 4062
+        .word 35, 3026
+        .word 90, 1776
+        .word 78, 5388
+        .word 1, 4590
+        .word 72, 3570
+        .word 13, 5622
+        .word 76, 5040
+        .word 25, 4444
+        .word 4, 5576
+        .word 41, 4296
+        .word 83, 6490
+        .word 13, 8824
+        .word 22, 3008
+        .word 9, 7100
+        .word 1, 7344
+        .word 10, 1326
+        .word 31, 6638
+        .word 35, 5442
+        .word 81, 5950
+        .word 68, 2108
+        .word 87, 8866
+        .word 87, 5772
+        .word 14, 3782
+        .word 75, 4180
+        .word 43, 5746
+        .word 58, 5254
+        .word 16, 4330
+        .word 32, 2860
+        .word 92, 3336
+        .word 68, 5298
+        .word 44, 2526
+        .word 27, 4748
+        .word 84, 7160
+        .word 54, 3322
+        .word 49, 2750
+        .word 29, 2000
+        .word 85, 6818
+        .word 75, 7140
+        .word 6, 4694
+        .word 10, 3146
+        .word 58, 2710
+        .word 56, 7228
+        .word 11, 4904
+        .word 32, 2872
+        .word 8, 7064
+        .word 29, 3282
+        .word 42, 7508
+        .word 64, 8540
+        .word 81, 6404
+        .word 38, 2456
+        .word 10, 1532
+        .word 54, 6858
+        .word 74, 8020
+        .word 6, 1872
+        .word 20, 7204
+        .word 39, 7558
+        .word 93, 5778
+        .word 62, 1962
+        .word 69, 8546
+        .word 87, 1338
+        .word 52, 2172
+        .word 88, 2492
+        .word 65, 7560
+        .word 77, 2228
+        .word 8, 2878
+        .word 93, 9070
+        .word 19, 6184
+        .word 89, 2016
+        .word 44, 6532
+        .word 59, 2942
+        .word 99, 1588
+        .word 53, 1804
+        .word 2, 5734
+        .word 11, 6100
+        .word 49, 1610
+        .word 13, 9084
+        .word 78, 3838
+        .word 13, 2578
+        .word 43, 5200
+        .word 43, 1328
+        .word 81, 1788
+        .word 23, 7640
+        .word 25, 1606
+        .word 68, 7162
+        .word 75, 4778
+        .word 40, 2704
+        .word 11, 3128
+        .word 12, 8606
+        .word 66, 2198
+        .word 40, 1766
+        .word 15, 1538
+        .word 89, 3120
+        .word 88, 7280
+        .word 11, 7670
+        .word 67, 1386
+        .word 43, 7588
+        .word 92, 3988
+        .word 7, 9144
+        .word 11, 7450
+        .word 94, 7774
+        .word 9, 5260
+        .word 49, 6466
+        .word 16, 9052
+        .word 12, 5800
+        .word 55, 1964
+        .word 48, 4906
+        .word 65, 8770
+        .word 31, 3212
+        .word 40, 4792
+        .word 39, 6228
+        .word 52, 4192
+        .word 38, 8998
+        .word 85, 8576
+        .word 39, 6370
+        .word 29, 3490
+        .word 44, 4622
+        .word 49, 7634
+        .word 6, 1810
+        .word 77, 3396
+        .word 4, 6580
+        .word 25, 7820
+        .word 6, 5232
+        .word 73, 6822
+        .word 9, 3932
+        .word 28, 3660
+        .word 9, 1378
+        .word 79, 7058
+        .word 22, 7628
+        .word 26, 6392
+        .word 45, 4550
+        .word 39, 9030
+        .word 10, 6278
+        .word 56, 8150
+        .word 97, 7964
+        .word 25, 5744
+        .word 5, 6324
+        .word 28, 3922
+        .word 53, 7990
+        .word 8, 5558
+        .word 93, 7742
+        .word 19, 8668
+        .word 21, 6976
+        .word 52, 6238
+        .word 76, 6840
+        .word 46, 4130
+        .word 21, 5278
+        .word 90, 6878
+        .word 34, 4554
+        .word 27, 7464
+        .word 28, 1702
+        .word 36, 6552
+        .word 65, 4848
+        .word 12, 7570
+        .word 99, 1522
+        .word 31, 7312
+        .word 49, 5126
+        .word 29, 9090
+        .word 55, 7914
+        .word 70, 8760
+        .word 20, 9208
+        .word 15, 7328
+        .word 85, 8742
+        .word 10, 7060
+        .word 74, 8762
+        .word 33, 3078
+        .word 39, 1440
+        .word 92, 6994
+        .word 16, 5578
+        .word 65, 6984
+        .word 58, 1976
+        .word 79, 7414
+        .word 14, 3486
+        .word 46, 4240
+        .word 27, 8970
+        .word 66, 4412
+        .word 47, 7446
+        .word 52, 8096
+        .word 85, 6700
+        .word 21, 4976
+        .word 13, 3238
+        .word 60, 9156
+        .word 52, 4576
+        .word 66, 7188
+        .word 18, 1836
+        .word 88, 8336
+        .word 86, 6680
+        .word 92, 4940
+        .word 58, 8502
+        .word 22, 9128
+        .word 27, 4734
+        .word 23, 6758
+        .word 48, 5562
+        .word 66, 5600
+        .word 64, 2668
+        .word 13, 5830
+        .word 71, 6190
+        .word 51, 5124
+        .word 3, 4594
+        .word 36, 3674
+        .word 62, 3554
+        .word 19, 4966
+        .word 99, 5270
+        .word 45, 5088
+        .word 91, 4730
+        .word 3, 5900
+        .word 80, 1756
+        .word 17, 8306
+        .word 7, 8078
+        .word 98, 3984
+        .word 75, 8022
+        .word 50, 6182
+        .word 64, 6250
+        .word 70, 3616
+        .word 77, 8804
+        .word 57, 9088
+        .word 87, 3170
+        .word 65, 6560
+        .word 28, 6880
+        .word 58, 5312
+        .word 54, 9198
+        .word 97, 5094
+        .word 28, 4104
+        .word 11, 6568
+        .word 82, 2718
+        .word 21, 5570
+        .word 85, 1092
+        .word 76, 3030
+        .word 79, 7752
+        .word 83, 6264
+        .word 94, 6572
+        .word 11, 5212
+        .word 99, 4252
+        .word 64, 8406
+        .word 15, 4982
+        .word 3, 5610
+        .word 59, 4346
+        .word 35, 5330
+        .word 24, 3538
+        .word 78, 5430
+        .word 33, 3622
+        .word 99, 5320
+        .word 50, 7222
+        .word 61, 2488
+        .word 58, 8532
+        .word 27, 8076
+        .word 88, 4796
+        .word 71, 3588
+        .word 97, 8694
+        .word 69, 2708
+        .word 2, 1128
+        .word 37, 1050
+        .word 28, 6132
+        .word 49, 4742
+        .word 97, 1064
+        .word 84, 6260
+        .word 23, 6718
+        .word 22, 2686
+        .word 18, 8304
+        .word 91, 7212
+        .word 41, 6720
+        .word 46, 8146
+        .word 9, 6028
+        .word 46, 9196
+        .word 81, 1194
+        .word 38, 8386
+        .word 91, 2464
+        .word 33, 5106
+        .word 94, 3936
+        .word 87, 2020
+        .word 82, 7216
+        .word 49, 3750
+        .word 24, 1944
+        .word 15, 6204
+        .word 34, 7988
+        .word 45, 5248
+        .word 67, 5188
+        .word 71, 5892
+        .word 49, 3758
+        .word 71, 7802
+        .word 11, 6322
+        .word 97, 5236
+        .word 45, 3584
+        .word 20, 7308
+        .word 3, 6566
+        .word 77, 4482
+        .word 24, 4968
+        .word 68, 3592
+        .word 21, 7150
+        .word 58, 1470
+        .word 84, 2768
+        .word 74, 2200
+        .word 6, 3314
+        .word 43, 2002
+        .word 33, 4164
+        .word 48, 5048
+        .word 19, 1044
+        .word 5, 5520
+        .word 19, 4670
+        .word 14, 8024
+        .word 78, 6674
+        .word 49, 5134
+        .word 61, 8288
+        .word 96, 6500
+        .word 79, 3292
+        .word 98, 7780
+        .word 72, 2754
+        .word 48, 6196
+        .word 34, 4898
+        .word 23, 7172
+        .word 75, 6418
+        .word 80, 9000
+        .word 79, 5272
+        .word 93, 9038
+        .word 67, 4144
+        .word 8, 3650
+        .word 66, 2844
+        .word 51, 9148
+        .word 56, 1878
+        .word 86, 3606
+        .word 15, 6436
+        .word 64, 7542
+        .word 55, 6574
+        .word 10, 2446
+        .word 6, 6202
+        .word 52, 5096
+        .word 67, 5640
+        .word 51, 7268
+        .word 41, 3582
+        .word 69, 8216
+        .word 79, 8240
+        .word 54, 7730
+        .word 42, 8224
+        .word 88, 6546
+        .word 72, 7600
+        .word 16, 8100
+        .word 66, 4888
+        .word 22, 6240
+        .word 36, 8244
+        .word 10, 8058
+        .word 72, 8116
+        .word 50, 1212
+        .word 26, 8112
+        .word 70, 2822
+        .word 20, 9116
+        .word 52, 4378
+        .word 62, 8822
+        .word 19, 2110
+        .word 22, 4260
+        .word 26, 8962
+        .word 24, 5080
+        .word 97, 3044
+        .word 92, 8992
+        .word 26, 2360
+        .word 56, 7842
+        .word 38, 5038
+        .word 98, 5502
+        .word 90, 7674
+        .word 24, 4864
+        .word 53, 1578
+        .word 25, 8408
+        .word 25, 3646
+        .word 90, 1502
+        .word 14, 1618
+        .word 78, 6602
+        .word 95, 5208
+        .word 87, 8128
+        .word 44, 8268
+        .word 66, 8132
+        .word 56, 8402
+        .word 50, 5924
+        .word 10, 5018
+        .word 71, 3840
+        .word 40, 7298
+        .word 95, 8654
+        .word 48, 2544
+        .word 25, 4344
+        .word 32, 5966
+        .word 72, 8388
+        .word 3, 5256
+        .word 93, 8334
+        .word 49, 2210
+        .word 30, 4624
+        .word 91, 3216
+        .word 41, 5898
+        .word 59, 8744
+        .word 24, 3712
+        .word 37, 4308
+        .word 75, 1992
+        .word 62, 2040
+        .word 26, 8520
+        .word 7, 5674
+        .word 34, 3814
+        .word 95, 3786
+        .word 12, 5082
+        .word 56, 7936
+        .word 51, 6438
+        .word 23, 6900
+        .word 67, 6332
+        .word 13, 4292
+        .word 6, 1628
+        .word 61, 4784
+        .word 8, 4454
+        .word 55, 8740
+        .word 54, 1592
+        .word 8, 2238
+        .word 69, 4278
+        .word 37, 6372
+        .word 92, 3800
+        .word 10, 5438
+        .word 6, 2376
+        .word 46, 4242
+        .word 47, 7568
+        .word 72, 1460
+        .word 12, 4386
+        .word 54, 4612
+        .word 33, 9158
+        .word 85, 6924
+        .word 24, 1268
+        .word 38, 6406
+        .word 67, 2924
+        .word 75, 1034
+        .word 55, 6668
+        .word 35, 4368
+        .word 18, 7500
+        .word 66, 4008
+        .word 61, 3934
+        .word 6, 4584
+        .word 91, 8838
+        .word 7, 8276
+        .word 60, 4974
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R1, #ring
+        MOVC R2, #STEPS
+        MOVC R3, #0
+loop:   LOAD R4, R1, #0
+        ADD R3, R3, R4
+        LDR R1, R1, R9
+        SUB R2, R2, R9
+        BNZ loop
+        STORE R3, R0, #0
+        HALT
@@ -0,0 +1,32 @@
+; Streams over a block of words, adding each into the next block, again
+; and again. Touches WORDS * 2 words of data memory
+        .equ WORDS, 16384
+        .equ PASSES, 64
+
+        .macro STEP off
+        LOAD R4, R1, #\off
+        LOAD R5, R2, #\off
+        ADD R5, R5, R4
+        STORE R5, R2, #\off
+        .endm
+
+        .text
+        MOVC R0, #0
+        MOVC R9, #1
+        MOVC R10, #PASSES
+pass:   MOVC R1, #0
+        MOVC R2, #WORDS
+        MOVC R3, #WORDS / 4
+block:  STEP 0
+        STEP 1
+        STEP 2
+        STEP 3
+        ADDL R1, R1, #4
+        ADDL R2, R2, #4
+        SUB R3, R3, R9
+        BNZ block
+        ADDL R6, R6, #1
+        STORE R6, R0, #0
+        SUB R10, R10, R9
+        BNZ pass
+        HALT
@@ -0,0 +1,85 @@
+#ifndef _APEX_BYPASS_H_
+#define _APEX_BYPASS_H_
+/**
+ *  bypass.h
+ *  Contains the bypass network of the in-order pipeline. A scoreboard
+ *  counts the instructions in flight writing each register and the zero
+ *  flag and remembers the youngest of them. A matrix selects which stage
+ *  latches forward a result to which kind of operand.
+ *
+ *  Decode reads a register or the flag from the register file when nothing
+ *  in flight writes it. Otherwise it takes the value from the youngest
+ *  writer, if that writer's latch holds the result and the path is on; if
+ *  not, decode stalls. A BZ or BNZ resolved in a later stage reads the
+ *  flag there the same way, from the writer it left decode behind.
+ */
+#include "isa.h"
+#include "stats.h"
+
+/* Scoreboard slots, the registers then the zero flag */
+#define BYPASS_ZERO_FLAG ISA_REGS
+#define BYPASS_SLOTS (ISA_REGS + 1)
+
+/* Stage latches a result can be forwarded from, EX2 to WB */
+enum
+{
+  BYPASS_EX2,
+  BYPASS_MEM1,
+  BYPASS_MEM2,
+  BYPASS_WB,
+  NUM_BYPASS_SRCS
+};
+
+/* Operands a result can be forwarded to */
+enum
+{
+  BYPASS_ALU,		// Sources of arithmetic and logic instructions
+  BYPASS_ADDR,		// Address sources of loads and stores, JUMP target
+  BYPASS_DATA,		// Value a STORE or STR writes
+  BYPASS_FLAG,		// Zero flag BZ and BNZ test
+  NUM_BYPASS_DSTS
+};
+
+/* Model of the bypass network */
+typedef struct Bypass
+{
+  unsigned int path[NUM_BYPASS_SRCS];	// Bit per BYPASS_* operand it feeds
+  int pending[BYPASS_SLOTS];	// Writers in flight
+  long writer[BYPASS_SLOTS];	// Sequence number of the youngest of them
+  long forwarded[NUM_BYPASS_SRCS * NUM_BYPASS_DSTS];	// Operands by path
+} Bypass;
+
+/* Returns 1 if results in latch src are forwarded to operands of kind dst */
+static inline int
+bypass_enabled(const Bypass* bypass, int src, int dst)
+{
+  return (bypass->path[src] >> dst) & 1;
+}
+
+/* Records an instruction with sequence number seq leaving decode to
+ * write reg, a register or BYPASS_ZERO_FLAG
+ */
+static inline void
+bypass_issue(Bypass* bypass, int reg, long seq)
+{
+  bypass->pending[reg]++;
+  bypass->writer[reg] = seq;
+}
+
+/* Records a writer of reg leaving the pipeline, retired or squashed */
+static inline void
+bypass_release(Bypass* bypass, int reg)
+{
+  bypass->pending[reg]--;
+}
+
+int
+bypass_init(Bypass* bypass, const char* spec);
+
+void
+bypass_print_stats(const Bypass* bypass);
+
+void
+bypass_register_stats(Bypass* bypass, Stats* stats);
+
+#endif
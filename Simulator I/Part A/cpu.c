@@ -9,18 +9,53 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <signal.h>
+#include <time.h>
 
 #include "cpu.h"
 
-/* Set this flag to 1 to enable debug messages */
-#define ENABLE_DEBUG_MESSAGES 1
+/* Debug messages are printed unless --quiet is given */
+static int debug_messages = 1;
+#define ENABLE_DEBUG_MESSAGES debug_messages
 
-int BZ_Flag;
+/* Set by SIGUSR1, the statistics are written at the end of the cycle */
+static volatile sig_atomic_t stats_requested;
 
-int stageEX1 = 1;
-int stageEX2 = 1;
-int stageMEM1 = 1;
-int stageMEM2 = 1;
+static void
+register_stats(APEX_CPU* cpu);
+
+/* Copies the data segment of an assembled object into data memory dm */
+static int
+load_object_data(APEX_CPU* cpu, Data_Memory* dm)
+{
+  const Apexo_Header* header = cpu->object.header;
+
+  for (uint32_t i = 0; header && i < header->data_count; ++i) {
+    if (datamem_write(dm, header->data_base + i, cpu->object.data[i])) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Sets up dm with the object data and --mem-in image, for the pipeline
+ * and for the functional model alike.
+ * Returns 0 on success, -1 on failure
+ */
+static int
+setup_data_memory(APEX_CPU* cpu, Data_Memory* dm)
+{
+  const APEX_Options* opts = &cpu->opts;
+
+  if (datamem_init(dm, &opts->datamem) || load_object_data(cpu, dm)) {
+    return -1;
+  }
+  if (opts->mem_in &&
+      image_load_memory(dm, opts->mem_in, opts->mem_in_base)) {
+    return -1;
+  }
+  return 0;
+}
 
 /*
  * This function creates and initializes APEX cpu.
@@ -29,32 +64,148 @@ int stageMEM2 = 1;
  * 				implementation
  */
 APEX_CPU*
-APEX_cpu_init(const char* filename)
+APEX_cpu_init(const char* filename, const APEX_Options* opts)
 {
   if (!filename) {
     return NULL;
   }
 
+  /* The dependence graph needs the ROB of Simulator II */
+  if (opts->critpath) {
+    fprintf(stderr,
+            "APEX_Error : --critpath is only supported by Simulator II\n");
+    return NULL;
+  }
+
   APEX_CPU* cpu = malloc(sizeof(*cpu));
   if (!cpu) {
     return NULL;
   }
 
   /* Initialize PC, Registers and all pipeline stages */
+  cpu->clock = 0;
   cpu->pc = 4000;
+  cpu->opts = *opts;
+  debug_messages = !opts->quiet;
   memset(cpu->regs, 0, sizeof(int) * 32);
-  memset(cpu->regs_valid, 1, sizeof(int) * 32);
+  cpu->zero_flag = 1;
   memset(cpu->stage, 0, sizeof(CPU_Stage) * NUM_STAGES);
-  memset(cpu->data_memory, 0, sizeof(int) * 4000);
-
-  /* Parse input file and create code memory */
-  cpu->code_memory = create_code_memory(filename, &cpu->code_memory_size);
+  cpu->faulted = 0;
+  cpu->halted = 0;
+  cpu->ins_completed = 0;
+  memset(cpu->cpi_stack, 0, sizeof(cpu->cpi_stack));
+  memset(cpu->interval_stack, 0, sizeof(cpu->interval_stack));
+  memset(cpu->op_retired, 0, sizeof(cpu->op_retired));
+  cpu->branches = 0;
+  cpu->flushes = 0;
+  cpu->flush_penalty = 0;
+  cpu->resolve_stage = opts->resolve == RESOLVE_DECODE ? DRF
+                       : opts->resolve == RESOLVE_EX1  ? EX1
+                                                       : MEM1;
+  cpu->redirected = 0;
+  cpu->next_seq = 0;
+  memset(&cpu->profile, 0, sizeof(cpu->profile));
+
+  /* Map an assembled object, or parse input file and create code memory */
+  switch (object_open(&cpu->object, filename)) {
+    case 0:
+      cpu->code_memory = cpu->object.code;
+      cpu->code_memory_size = cpu->object.header->code_count;
+      break;
+    case 1:
+      cpu->code_memory = create_code_memory(filename, &cpu->code_memory_size);
+      break;
+    default:
+      cpu->code_memory = NULL;
+  }
 
   if (!cpu->code_memory) {
     free(cpu);
     return NULL;
   }
 
+  if (bypass_init(&cpu->bypass, opts->bypass ? opts->bypass : DEFAULT_BYPASS)) {
+    fprintf(stderr, "APEX_Error : Invalid bypass paths %s\n", opts->bypass);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (memsys_init(&cpu->memsys, &opts->l1d, &opts->l2, &opts->dram,
+                  &opts->prefetch, opts->mshrs)) {
+    fprintf(stderr, "APEX_Error : Invalid memory hierarchy configuration\n");
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (frontend_init(&cpu->frontend, &opts->icache, opts->fetch_buffer_size,
+                    cpu->pc)) {
+    fprintf(stderr, "APEX_Error : Invalid I-cache configuration\n");
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (setup_data_memory(cpu, &cpu->data_memory)) {
+    fprintf(stderr, "APEX_Error : Unable to set up data memory\n");
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (opts->profile && profile_init(&cpu->profile, cpu->code_memory_size)) {
+    fprintf(stderr, "APEX_Error : Unable to set up the profile\n");
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (funcmodel_init(&cpu->model, cpu->code_memory, cpu->code_memory_size,
+                     &cpu->data_memory)) {
+    fprintf(stderr, "APEX_Error : Unable to set up the functional model\n");
+    profile_free(&cpu->profile);
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  /* A host that can not run translated code only interprets */
+  if (opts->jit) {
+    funcmodel_use_jit(&cpu->model);
+  }
+
+  if (checker_init(&cpu->checker, opts->check, opts->check_interval,
+                   cpu->code_memory, cpu->code_memory_size) ||
+      (opts->check && setup_data_memory(cpu, &cpu->checker.data_memory))) {
+    fprintf(stderr, "APEX_Error : Unable to set up the checker\n");
+    checker_free(&cpu->checker);
+    funcmodel_free(&cpu->model);
+    profile_free(&cpu->profile);
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+  if (opts->check && opts->jit) {
+    funcmodel_use_jit(&cpu->checker.model);
+  }
+
+  register_stats(cpu);
+
   if (ENABLE_DEBUG_MESSAGES) {
     fprintf(stderr,
             "APEX_CPU : Initialized APEX CPU, loaded %d instructions\n",
@@ -89,7 +240,14 @@ APEX_cpu_init(const char* filename)
 void
 APEX_cpu_stop(APEX_CPU* cpu)
 {
-  free(cpu->code_memory);
+  stats_free(&cpu->stats);
+  profile_free(&cpu->profile);
+  checker_free(&cpu->checker);
+  funcmodel_free(&cpu->model);
+  datamem_free(&cpu->data_memory);
+  frontend_free(&cpu->frontend);
+  memsys_free(&cpu->memsys);
+  object_free_code(&cpu->object, cpu->code_memory);
   free(cpu);
 }
 
@@ -108,109 +266,418 @@ get_code_index(int pc)
 static void
 print_instruction(CPU_Stage* stage)
 {
-  if (strcmp(stage->opcode, "STORE") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rs1, stage->rs2, stage->imm);
+  if (!stage->pc) {
+    return;
   }
 
-  if (strcmp(stage->opcode, "STR") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  switch (stage->op) {
+    case OP_STORE:
+      printf(
+        "%s,R%d,R%d,#%d ", stage->opcode, stage->rs1, stage->rs2, stage->imm);
+      break;
+    case OP_LOAD:
+    case OP_ADDL:
+    case OP_SUBL:
+      printf(
+        "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+      break;
+    case OP_STR:
+    case OP_LDR:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_AND:
+    case OP_OR:
+    case OP_EXOR:
+      printf(
+        "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+      break;
+    case OP_MOVC:
+      printf("%s,R%d,#%d ", stage->opcode, stage->rd, stage->imm);
+      break;
+    case OP_BZ:
+      printf("%s,#%d ", stage->opcode, stage->imm);
+      break;
+    case OP_BNZ:
+      printf("%s,#%d", stage->opcode, stage->imm);
+      break;
+    case OP_JUMP:
+      printf("%s,R%d,#%d", stage->opcode, stage->rs1, stage->imm);
+      break;
+    case OP_HALT:
+      printf("HALT");
+      break;
   }
+}
+
+/* Debug function which dumps the cpu stage
+ * content
+ *
+ * Note : You are not supposed to edit this function
+ *
+ */
+static void
+print_stage_content(char* name, CPU_Stage* stage)
+{
+  printf("%-15s: pc(%d) ", name, stage->pc);
+  print_instruction(stage);
+  printf("\n");
+}
+
+void make_stage_empty(CPU_Stage *stage) {
+    strcpy(stage->opcode, "");
+    stage->pc = 0;
+}
+
+/* Empties a stage, recording why for the CPI stack */
+static void
+make_stage_bubble(CPU_Stage* stage, int cause)
+{
+  make_stage_empty(stage);
+  stage->cpi_cause = cause;
+}
+
+/* What an instruction does besides its operation, as bits of op_flags */
+enum
+{
+  WRITES_RD = 1 << 0,	// Writes register rd
+  SETS_FLAG = 1 << 1,	// Sets the zero flag
+  LOADS = 1 << 2,	// Reads data memory
+  STORES = 1 << 3	// Writes data memory
+};
+
+/* Indexed by OP_*, so the stages never compare opcode strings */
+static const unsigned char op_flags[NUM_OPCODES] = {
+  [OP_MOVC] = WRITES_RD,
+  [OP_STORE] = STORES,
+  [OP_STR] = STORES,
+  [OP_ADD] = WRITES_RD | SETS_FLAG,
+  [OP_ADDL] = WRITES_RD,
+  [OP_SUB] = WRITES_RD | SETS_FLAG,
+  [OP_SUBL] = WRITES_RD,
+  [OP_MUL] = WRITES_RD | SETS_FLAG,
+  [OP_LOAD] = WRITES_RD | LOADS,
+  [OP_LDR] = WRITES_RD | LOADS,
+  [OP_AND] = WRITES_RD,
+  [OP_OR] = WRITES_RD,
+  [OP_EXOR] = WRITES_RD,
+};
+
+/* Returns 1 if the instruction in the stage writes register rd */
+static int
+writes_register(const CPU_Stage* stage)
+{
+  return stage->pc && (op_flags[stage->op] & WRITES_RD);
+}
+
+/* Returns 1 if the instruction in the stage sets the zero flag */
+static int
+sets_flag(const CPU_Stage* stage)
+{
+  return stage->pc && (op_flags[stage->op] & SETS_FLAG);
+}
+
+/* Returns 1 if the instruction in the stage is a load or store */
+static int
+accesses_memory(const CPU_Stage* stage)
+{
+  return stage->pc && (op_flags[stage->op] & (LOADS | STORES));
+}
 
-  if (strcmp(stage->opcode, "LOAD") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+/* Returns 1 if a later stage holds stage where and the ones behind it:
+ * Memory1 waiting on the memory hierarchy, or a branch waiting on the
+ * zero flag in the stage it resolves in
+ */
+static int
+held(const APEX_CPU* cpu, int where)
+{
+  for (int i = where + 1; i <= MEM1; ++i) {
+    if (cpu->stage[i].busy) {
+      return 1;
+    }
   }
+  return 0;
+}
 
-  if (strcmp(stage->opcode, "LDR") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+/* Returns 1 if the instruction in the stage writes scoreboard slot slot */
+static int
+writes_slot(const CPU_Stage* stage, int slot)
+{
+  if (slot == BYPASS_ZERO_FLAG) {
+    return sets_flag(stage);
   }
+  return writes_register(stage) && stage->rd == slot;
+}
 
-  if (strcmp(stage->opcode, "MOVC") == 0) {
-    printf("%s,R%d,#%d ", stage->opcode, stage->rd, stage->imm);
+/* Returns the BYPASS_* kind of the source in slot of an instruction op */
+static int
+operand_kind(int op, int slot)
+{
+  switch (op) {
+    case OP_STORE:
+      return slot == SLOT_RS1 ? BYPASS_DATA : BYPASS_ADDR;
+    case OP_STR:
+      return slot == SLOT_RD ? BYPASS_DATA : BYPASS_ADDR;
+    case OP_LOAD:
+    case OP_LDR:
+    case OP_JUMP:
+      return BYPASS_ADDR;
+    default:
+      return BYPASS_ALU;
   }
+}
+
+/*
+ * Reads scoreboard slot reg, a register or BYPASS_ZERO_FLAG, into value,
+ * from the register file or through the bypass network from the youngest
+ * instruction in flight writing it. Sets path to the forwarded.* index
+ * used, -1 for the register file.
+ * Returns 0 on success, else the CPI_* cause decode stalls for
+ */
+static int
+read_register(APEX_CPU* cpu, int reg, int kind, int* value, int* path)
+{
+  Bypass* bypass = &cpu->bypass;
 
-  if (strcmp(stage->opcode, "ADD") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  *path = -1;
+  if (!bypass->pending[reg]) {
+    *value = reg == BYPASS_ZERO_FLAG ? cpu->zero_flag : cpu->regs[reg];
+    return 0;
   }
 
-  if (strcmp(stage->opcode, "ADDL") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+  /* Execute1 has already passed its instruction on to Execute2 */
+  for (int i = EX2; i <= WB; ++i) {
+    const CPU_Stage* producer = &cpu->stage[i];
+
+    if (producer->pc && producer->seq == bypass->writer[reg]) {
+
+      /* Loads have their data once Memory1 has read it */
+      int ready = i >= MEM2 || !(op_flags[producer->op] & LOADS);
+
+      if (!ready || !bypass_enabled(bypass, i - EX2, kind)) {
+        return reg == BYPASS_ZERO_FLAG ? CPI_FLAG : CPI_RAW_EX2 + (i - EX2);
+      }
+      *value = reg == BYPASS_ZERO_FLAG ? producer->buffer == 0
+                                       : producer->buffer;
+      *path = (i - EX2) * NUM_BYPASS_DSTS + kind;
+      return 0;
+    }
   }
+  return reg == BYPASS_ZERO_FLAG ? CPI_FLAG : CPI_RAW_NONE;
+}
 
-  if (strcmp(stage->opcode, "SUB") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+/* Reads the source registers of the instruction in decode, and the zero
+ * flag of a BZ or BNZ resolved in decode, or stalls it with the cause of
+ * the first one not available yet. Forwarded operands are counted once
+ * all of them are read
+ */
+static void
+read_operands(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  const Instruction_Format* format = instruction_format(stage->op);
+  int path[4] = { -1, -1, -1, -1 };
+  int cause = 0;
+
+  if (!stage->pc) {
+    return;
   }
 
-  if (strcmp(stage->opcode, "SUBL") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+  for (int i = 0; format && i < format->count && !cause; ++i) {
+    int slot = format->slot[i];
+    int kind = operand_kind(stage->op, slot);
+
+    if (slot == SLOT_RS1) {
+      cause = read_register(cpu, stage->rs1, kind, &stage->rs1_value,
+                            &path[i]);
+    } else if (slot == SLOT_RS2) {
+      cause = read_register(cpu, stage->rs2, kind, &stage->rs2_value,
+                            &path[i]);
+    } else if (slot == SLOT_RD && stage->op == OP_STR) {
+      cause = read_register(cpu, stage->rd, kind, &stage->rd_value,
+                            &path[i]);
+    }
   }
 
-  if (strcmp(stage->opcode, "MUL") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  if (!cause && cpu->resolve_stage == DRF &&
+      (stage->op == OP_BZ || stage->op == OP_BNZ)) {
+    cause = read_register(cpu, BYPASS_ZERO_FLAG, BYPASS_FLAG,
+                          &stage->zero_flag, &path[3]);
   }
 
-  if (strcmp(stage->opcode, "BZ") == 0) {
-    printf(
-      "%s,#%d ", stage->opcode, stage->imm);
+  if (cause) {
+    stage->stalled = 1;
+    stage->cpi_cause = cause;
+    return;
   }
 
-  if (strcmp(stage->opcode, "AND") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  for (int i = 0; i < 4; ++i) {
+    if (path[i] >= 0) {
+      cpu->bypass.forwarded[path[i]]++;
+    }
   }
+}
 
-  if (strcmp(stage->opcode, "OR") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+/* Records the instruction leaving decode as the youngest writer of the
+ * scoreboard slots it writes
+ */
+static void
+issue(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  Bypass* bypass = &cpu->bypass;
+
+  /* A BZ or BNZ resolved later reads the flag of the writer it follows */
+  stage->flag_seq =
+    bypass->pending[BYPASS_ZERO_FLAG] ? bypass->writer[BYPASS_ZERO_FLAG] : 0;
+
+  if (!writes_register(stage)) {
+    return;
   }
 
-  if (strcmp(stage->opcode, "EX-OR") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  stage->seq = ++cpu->next_seq;
+  bypass_issue(bypass, stage->rd, stage->seq);
+  if (sets_flag(stage)) {
+    bypass_issue(bypass, BYPASS_ZERO_FLAG, stage->seq);
   }
+}
 
-  if (strcmp(stage->opcode, "HALT") == 0){
-    printf("HALT");
+/* Takes an instruction that left decode out of the scoreboard, retired in
+ * Writeback or squashed
+ */
+static void
+release(APEX_CPU* cpu, const CPU_Stage* stage)
+{
+  if (writes_register(stage)) {
+    bypass_release(&cpu->bypass, stage->rd);
+  }
+  if (sets_flag(stage)) {
+    bypass_release(&cpu->bypass, BYPASS_ZERO_FLAG);
   }
+}
+
+/* Squashes the stages from Decode up to the taken branch in stage where,
+ * and takes the instructions that had left decode out of the scoreboard.
+ * Fetch restarts, a HALT that stopped it may have been squashed.
+ * Returns the instructions squashed, bubbles do not count
+ */
+static long
+flush_younger(APEX_CPU* cpu, int where)
+{
+  Bypass* bypass = &cpu->bypass;
+  long squashed = 0;
+
+  cpu->stage[F].stalled = 0;
+
+  for (int i = DRF; i < where; ++i) {
+    CPU_Stage* stage = &cpu->stage[i];
 
-  if (strcmp(stage->opcode, "JUMP") == 0) {
-    printf("%s,R%d,#%d", stage->opcode,stage->rs1,stage->imm);
+    /* A stalled instruction in decode is real, in later stages a copy */
+    if (stage->pc && (i == DRF || !stage->stalled)) {
+      squashed++;
+    }
+    if (i != DRF && !stage->stalled) {
+      release(cpu, stage);
+    }
+    make_stage_bubble(stage, CPI_FLUSH);
   }
 
-  if (strcmp(stage->opcode, "BNZ") == 0) {
-    printf("%s,#%d", stage->opcode,stage->imm);
+  /* The youngest writer left of a slot is the branch or older, in a later
+   * stage. A latch already passed on this cycle holds a copy, which is
+   * harmless here
+   */
+  for (int slot = 0; slot < BYPASS_SLOTS; ++slot) {
+    long youngest = 0;
+
+    for (int i = where; i <= WB && bypass->pending[slot]; ++i) {
+      if (writes_slot(&cpu->stage[i], slot) &&
+          cpu->stage[i].seq > youngest) {
+        youngest = cpu->stage[i].seq;
+      }
+    }
+    bypass->writer[slot] = youngest;
   }
+  return squashed;
 }
 
-/* Debug function which dumps the cpu stage
- * content
- *
- * Note : You are not supposed to edit this function
- *
+/*
+ * Reads the zero flag into the BZ or BNZ in the latch of stage where, from
+ * the writer it left decode behind if that is still in a later latch and
+ * the path from there is on, else from the flag register once that writer
+ * retired. By the time a stage runs the ones after it have moved on, so
+ * the writer is looked for from two latches on, as decode does.
+ * Returns 0 on success, else CPI_FLAG
  */
-static void
-print_stage_content(char* name, CPU_Stage* stage)
+static int
+read_flag(APEX_CPU* cpu, CPU_Stage* stage, int where)
 {
-  printf("%-15s: pc(%d) ", name, stage->pc);
-  print_instruction(stage);
-  printf("\n");
-}
+  for (int i = where + 2; i <= WB && stage->flag_seq; ++i) {
+    const CPU_Stage* producer = &cpu->stage[i];
 
-void make_stage_empty(CPU_Stage *stage) {
-    strcpy(stage->opcode, "");
-    stage->pc = 0;
+    if (sets_flag(producer) && producer->seq == stage->flag_seq) {
+      if (!bypass_enabled(&cpu->bypass, i - EX2, BYPASS_FLAG)) {
+        return CPI_FLAG;
+      }
+      stage->zero_flag = producer->buffer == 0;
+      cpu->bypass.forwarded[(i - EX2) * NUM_BYPASS_DSTS + BYPASS_FLAG]++;
+      return 0;
+    }
+  }
+  stage->zero_flag = cpu->zero_flag;
+  return 0;
 }
 
-void make_register_valid(APEX_CPU* cpu, CPU_Stage *stage) {
-    
-    cpu->regs_valid[stage->rd] = 1;
-    cpu->regs_valid[stage->rs1] = 1;
-    cpu->regs_valid[stage->rs2] = 1;
+/*
+ * Resolves the BZ, BNZ or JUMP in the latch of stage where. A JUMP has rs1
+ * from decode, a BZ or BNZ reads the zero flag here unless it did in
+ * decode. A taken one redirects fetch to its target and squashes the
+ * younger instructions behind it, and what fetch reads in the same cycle
+ * is lost too.
+ * Returns 0 once resolved, else CPI_FLAG while the flag is not there yet
+ */
+static int
+resolve_branch(APEX_CPU* cpu, CPU_Stage* stage, int where)
+{
+  int taken;
+  long squashed;
+
+  if (!stage->pc) {
+    return 0;
+  }
+
+  if (where != DRF && (stage->op == OP_BZ || stage->op == OP_BNZ) &&
+      read_flag(cpu, stage, where)) {
+    return CPI_FLAG;
+  }
+
+  switch (stage->op) {
+    case OP_BZ:
+      taken = stage->zero_flag;
+      break;
+    case OP_BNZ:
+      taken = !stage->zero_flag;
+      break;
+    case OP_JUMP:
+      taken = 1;
+      break;
+    default:
+      return 0;
+  }
+
+  cpu->branches++;
+  if (!taken) {
+    return 0;
+  }
+
+  cpu->pc = stage->op == OP_JUMP ? stage->rs1_value + stage->imm
+                                 : stage->pc + stage->imm;
+  squashed = flush_younger(cpu, where);
+  cpu->redirected = 1;
+  cpu->flushes++;
+
+  /* A bubble for each stage squashed and one for the fetch slot */
+  cpu->flush_penalty += where - DRF + 1;
+  profile_add(&cpu->profile, stage->pc, PROFILE_FLUSHES, 1);
+  profile_add(&cpu->profile, stage->pc, PROFILE_SQUASHED, squashed);
+  return 0;
 }
 
 /*
@@ -224,8 +691,50 @@ fetch(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[F];
 
+  /* Hold while a load, store or branch ahead waits */
+  if (held(cpu, F)) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Fetch", stage);
+    }
+    return 0;
+  }
+
+  /* What was fetched while a branch redirected fetch is thrown away */
+  if (cpu->redirected) {
+    cpu->redirected = 0;
+    make_stage_bubble(stage, CPI_FLUSH);
+    cpu->stage[DRF] = cpu->stage[F];
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Fetch", stage);
+    }
+    return 0;
+  }
+
   if (!stage->busy && !stage->stalled) {  
 
+    /* Ask the fetch buffer whether this pc has arrived from the I-cache */
+    int ready =
+      frontend_fetch(&cpu->frontend, &cpu->memsys, cpu->pc, cpu->clock);
+
+    /* Running off the end of code memory, or waiting on an I-cache miss,
+     * sends a bubble to decode
+     */
+    if (get_code_index(cpu->pc) < 0 ||
+        get_code_index(cpu->pc) >= cpu->code_memory_size || !ready) {
+
+      if (cpu->stage[DRF].stalled == 0) {
+        if (!ready) {
+          cpu->frontend.stall_cycles++;
+        }
+        make_stage_bubble(stage, ready ? CPI_DRAIN : CPI_FETCH);
+        cpu->stage[DRF] = cpu->stage[F];
+      }
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Fetch", stage);
+      }
+      return 0;
+    }
+
     /* Store current PC in fetch latch */
     stage->pc = cpu->pc;
 
@@ -234,6 +743,7 @@ fetch(APEX_CPU* cpu)
      */
     APEX_Instruction* current_ins = &cpu->code_memory[get_code_index(cpu->pc)];
     strcpy(stage->opcode, current_ins->opcode);
+    stage->op = current_ins->op;
     stage->rd = current_ins->rd;
     stage->rs1 = current_ins->rs1;
     stage->rs2 = current_ins->rs2;
@@ -280,251 +790,38 @@ decode(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[DRF];
 
-  if (!stage->busy && !stage->stalled) {
-
-
-    /* Read data from register file for store */
-    if (strcmp(stage->opcode, "STORE") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        	stage->rs2_value = cpu->regs[stage->rs2];
-  		}
-    }
-
-    if (strcmp(stage->opcode, "BZ") == 0) {
-
-      APEX_Instruction* current = &cpu->code_memory[get_code_index(cpu->pc - 8)];
-
-
-      if(strcmp(current->opcode, "SUB") == 0 || strcmp(current->opcode, "ADDL") == 0 || strcmp(current->opcode, "ADD") == 0 || strcmp(current->opcode, "SUBL") == 0 || strcmp(current->opcode, "MUL") == 0){
-
-        if(stageEX2 == 0 && stageMEM1 == 0 && stageMEM2 == 0){
-          
-          stage->stalled = 0;
-          cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-
-        }else{
-          stage->stalled = 1;
-            cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-        }      
-        }        
-    }
-
-    if (strcmp(stage->opcode, "BNZ") == 0) {
-
-      APEX_Instruction* current = &cpu->code_memory[get_code_index(cpu->pc - 8)];
-
-
-      if(strcmp(current->opcode, "SUB") == 0 || strcmp(current->opcode, "ADDL") == 0 || strcmp(current->opcode, "ADD") == 0 || strcmp(current->opcode, "SUBL") == 0 || strcmp(current->opcode, "MUL") == 0){
-
-        if(stageEX2 == 0 && stageMEM1 == 0 && stageMEM2 == 0){
-          
-          stage->stalled = 0;
-          cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-
-        }else{
-          stage->stalled = 1;
-            cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-        }      
-        }        
-    }
-
-    if (strcmp(stage->opcode, "JUMP") == 0) {
-
-      APEX_Instruction* current = &cpu->code_memory[get_code_index(cpu->pc - 8)];
-
-
-      if(strcmp(current->opcode, "SUB") == 0 || strcmp(current->opcode, "ADDL") == 0 || strcmp(current->opcode, "ADD") == 0 || strcmp(current->opcode, "SUBL") == 0 || strcmp(current->opcode, "MUL") == 0){
-
-        if(stageEX2 == 0 && stageMEM1 == 0 && stageMEM2 == 0){
-          
-          stage->stalled = 0;
-          cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-
-        }else{
-          stage->stalled = 1;
-            cpu->stage[EX1] = cpu->stage[DRF];
-            if (ENABLE_DEBUG_MESSAGES) {
-              print_stage_content("Decode/RF", stage);
-            }
-
-            return 0;
-        }      
-        }        
-    }
-
-    /* Read data from register file for store */
-    if (strcmp(stage->opcode, "STR") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        	stage->rs2_value = cpu->regs[stage->rs2];
-  		}
-    }
-
-    /* No Register file read needed for MOVC */
-    if (strcmp(stage->opcode, "MOVC") == 0) {
-
-    	if(cpu->regs_valid[stage->rd] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			cpu->regs_valid[stage->rd] = 0;
-  		}
-    }
-
-    if (strcmp(stage->opcode, "ADD") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-    	
-    }
-
-    if (strcmp(stage->opcode, "AND") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-    	
-    }
-
-    if (strcmp(stage->opcode, "SUB") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-    }
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-    	if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-    }
-
-    /* Read data from register file for Load */
-    if (strcmp(stage->opcode, "LOAD") == 0) {
-
-
-	   if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rd] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-    }
-
-    /* Read data from register file for LDR */
-    if (strcmp(stage->opcode, "LDR") == 0) {
-
-    	
-	   if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rd] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
+  /* Hold while a load, store or branch ahead waits */
+  if (held(cpu, DRF)) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Decode/RF", stage);
     }
+    return 0;
+  }
 
-    /* Read data from register file for Or */
-    if (strcmp(stage->opcode, "OR") == 0) {
-	   if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
-			stage->stalled = 1;
-  		} else{
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        stage->rs2_value = cpu->regs[stage->rs2];
-        cpu->regs_valid[stage->rd] = 0;
-  		}
-	  }
-  
-
-    /* Read data from register file for Ex-Or */
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-	   if(cpu->regs_valid[stage->rs1] == 0 || cpu->regs_valid[stage->rs2] == 0){
+  if (!stage->busy) {
 
-			stage->stalled = 1;
-  		} else{
+    /* A stalled instruction tries again every cycle */
+    stage->stalled = 0;
 
-			stage->stalled = 0;
-			stage->rs1_value = cpu->regs[stage->rs1];
-        	stage->rs2_value = cpu->regs[stage->rs2];
-        	cpu->regs_valid[stage->rd] = 0;
-  		}
-     
+    read_operands(cpu, stage);
+    if (!stage->stalled) {
+      issue(cpu, stage);
+      if (cpu->resolve_stage == DRF) {
+        resolve_branch(cpu, stage, DRF);
+      }
     }
 
-    if (strcmp(stage->opcode, "HALT") == 0) {}
-
     cpu->stage[EX1] = cpu->stage[DRF];
 
     if (ENABLE_DEBUG_MESSAGES) {
       print_stage_content("Decode/RF", stage);
     }
-} else{
-	if (ENABLE_DEBUG_MESSAGES) {
+  } else {
+    if (ENABLE_DEBUG_MESSAGES) {
       print_stage_content("Decode/RF", stage);
     }
-}
+  }
 
- 
   return 0;
 }
 
@@ -537,123 +834,87 @@ decode(APEX_CPU* cpu)
 int
 execute1(APEX_CPU* cpu)
 {
-  CPU_Stage* stage = &cpu->stage[EX1];
-
-  stageEX1 = stage->pc;
-
-  if (!stage->busy && !stage->stalled) {
-
-  	if (strcmp(stage->opcode, "HALT") == 0) {
-	   
-	  	
-	  	cpu->stage[F].stalled = 1;
-	  	make_stage_empty(&cpu->stage[F]);
-	  	make_stage_empty(&cpu->stage[DRF]);
-	  	cpu->stage[EX2] = cpu->stage[EX1];
-	  	if (ENABLE_DEBUG_MESSAGES) {
-      		print_stage_content("Execute1", stage);
-    	}
-	  	return 0;
-     
-    }
-
-    /* STORE */
-    if(strcmp(stage->opcode, "STORE") == 0) {
-      stage->mem_address = stage->rs2_value + stage->imm;
-    }
-
-    if(strcmp(stage->opcode, "STR") == 0) {
-      stage->mem_address = stage->rs1_value + stage->rs2_value;
-    }
-
-    /* MOVC */
-    if(strcmp(stage->opcode, "MOVC") == 0) {
-
-      stage->buffer = stage->imm;
-    }
-
-    if(strcmp(stage->opcode, "LOAD") == 0) {
-
-      stage->mem_address = stage->rs1_value + stage->imm;
-    }
-
-    if(strcmp(stage->opcode, "LDR") == 0) {
-
-      stage->mem_address = stage->rs1_value + stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "ADD") == 0) {
-
-    	stage->buffer = stage->rs1_value + stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "ADDL") == 0) {
-
-    	stage->buffer = stage->rs1_value + stage->imm;
-           
-    }
-
-    if (strcmp(stage->opcode, "SUB") == 0) {
-
-    	stage->buffer = stage->rs1_value - stage->rs2_value;
-
-    }
-
-    if (strcmp(stage->opcode, "SUBL") == 0) {
-
-    	stage->buffer = stage->rs1_value - stage->imm;
-
-    }
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-    	stage->buffer = stage->rs1_value * stage->rs2_value;
-
-    }
-
-    if (strcmp(stage->opcode, "OR") == 0) {
-
-      stage->buffer = stage->rs1_value | stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-
-      stage->buffer = stage->rs1_value ^ stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "AND") == 0) {
-
-      stage->buffer = stage->rs1_value&stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "BZ") == 0) {
-
-        if (BZ_Flag == 0) {
-              stage->buffer = stage->pc + stage->imm;             
-                
-        } else {
-
-                stage->buffer = cpu->pc + 8;
-        }
-    }
+  CPU_Stage* stage = &cpu->stage[EX1];
 
-    if (strcmp(stage->opcode, "JUMP") == 0) {
+  /* An instruction issues the first cycle it is in Execute1 */
+  if (stage->pc && !stage->issue_cycle) {
+    stage->issue_cycle = cpu->clock;
+  }
 
-        stage->buffer = stage->pc + stage->imm;
+  /* Hold while a load, store or branch ahead waits */
+  if (held(cpu, EX1)) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Execute1", stage);
     }
-        
+    return 0;
+  }
 
-    if (strcmp(stage->opcode, "BNZ") == 0) {
+  if (!stage->stalled) {
 
-    	if (BZ_Flag == 1) {
-              stage->buffer = stage->pc + stage->imm;             
-                
-        } else {
-        	
-                stage->buffer = cpu->pc + 8;
-        }
-        
-    }        
+    if (stage->pc && stage->op == OP_HALT) {
+      cpu->stage[F].stalled = 1;
+      make_stage_bubble(&cpu->stage[F], CPI_DRAIN);
+      make_stage_bubble(&cpu->stage[DRF], CPI_DRAIN);
+      cpu->stage[EX2] = cpu->stage[EX1];
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Execute1", stage);
+      }
+      return 0;
+    }
+
+    /* A bubble keeps the op of whatever it replaced, it computes nothing */
+    switch (stage->pc ? stage->op : -1) {
+      case OP_STORE:
+        stage->mem_address = stage->rs2_value + stage->imm;
+        break;
+      case OP_STR:
+      case OP_LDR:
+        stage->mem_address = stage->rs1_value + stage->rs2_value;
+        break;
+      case OP_LOAD:
+        stage->mem_address = stage->rs1_value + stage->imm;
+        break;
+      case OP_MOVC:
+        stage->buffer = stage->imm;
+        break;
+      case OP_ADD:
+        stage->buffer = stage->rs1_value + stage->rs2_value;
+        break;
+      case OP_ADDL:
+        stage->buffer = stage->rs1_value + stage->imm;
+        break;
+      case OP_SUB:
+        stage->buffer = stage->rs1_value - stage->rs2_value;
+        break;
+      case OP_SUBL:
+        stage->buffer = stage->rs1_value - stage->imm;
+        break;
+      case OP_MUL:
+        stage->buffer = stage->rs1_value * stage->rs2_value;
+        break;
+      case OP_OR:
+        stage->buffer = stage->rs1_value | stage->rs2_value;
+        break;
+      case OP_EXOR:
+        stage->buffer = stage->rs1_value ^ stage->rs2_value;
+        break;
+      case OP_AND:
+        stage->buffer = stage->rs1_value & stage->rs2_value;
+        break;
+    }
+
+    /* A branch waiting on the zero flag holds Execute1 and the stages
+     * behind it, and sends a bubble on
+     */
+    stage->busy =
+      cpu->resolve_stage == EX1 && resolve_branch(cpu, stage, EX1);
+    if (stage->busy) {
+      make_stage_bubble(&cpu->stage[EX2], CPI_FLAG);
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Execute1", stage);
+      }
+      return 0;
+    }
 
     cpu->stage[EX2] = cpu->stage[EX1];
 
@@ -678,74 +939,15 @@ execute2(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[EX2];
 
-  stageEX2 = stage->pc;
-
-  if (!stage->busy && !stage->stalled) {
-
-  	if (strcmp(stage->opcode, "HALT") == 0) {}
-
-    /* STORE */
-    if(strcmp(stage->opcode, "STORE") == 0) {}
-
-    if(strcmp(stage->opcode, "STR") == 0) {}
-
-    /* MOVC */
-    if(strcmp(stage->opcode, "MOVC") == 0) {
-      
-
-    }
-
-    if(strcmp(stage->opcode, "LOAD") == 0) {
-      
-
-    }
-
-    if(strcmp(stage->opcode, "LDR") == 0) {
-      
-
-    }
-
-    if (strcmp(stage->opcode, "ADD") == 0) {
-
-    	
-    }
-
-    if (strcmp(stage->opcode, "ADDL") == 0) {
-
-    	
-    }
-
-    if (strcmp(stage->opcode, "SUB") == 0) {
-
-    	
-    }
-
-    if (strcmp(stage->opcode, "SUBL") == 0) {
-
-    	
-    }
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-    	
-    }
-
-    if (strcmp(stage->opcode, "OR") == 0) {
-      
-    }
-
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-      
-    }
-
-    if (strcmp(stage->opcode, "AND") == 0) {
-      
+  /* Hold while a load, store or branch ahead waits */
+  if (held(cpu, EX2)) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Execute2", stage);
     }
+    return 0;
+  }
 
-    if (strcmp(stage->opcode, "BZ") == 0) {
-      
-      
-    }
+  if (!stage->busy && !stage->stalled) {
 
     cpu->stage[MEM1] = cpu->stage[EX2];
 
@@ -774,73 +976,64 @@ memory1(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MEM1];
 
-  stageMEM1 = stage->pc;
-
-  if (!stage->busy && !stage->stalled) {
-
-  	if (strcmp(stage->opcode, "HALT") == 0) { 	
-     
-    }
-
-    /* Store */
-    if (strcmp(stage->opcode, "STORE") == 0) {
-
-    	cpu->data_memory[stage->mem_address] = stage->rs1_value;
-    }
-
-    if (strcmp(stage->opcode, "STR") == 0) {
-
-    	cpu->data_memory[stage->mem_address] = cpu->regs[stage->rd];
-    }
-
-    if (strcmp(stage->opcode, "LOAD") == 0) {
-
-      stage->buffer = cpu->data_memory[stage->mem_address];
-    }
-
-    if (strcmp(stage->opcode, "LDR") == 0) {
-
-      stage->buffer = cpu->data_memory[stage->mem_address];
-    }
-
-    /* MOVC */
-    if (strcmp(stage->opcode, "MOVC") == 0) {
+  /* Loads and stores hold Memory1 until the memory hierarchy answers,
+   * upstream stages are frozen and a bubble goes to Memory2
+   */
+  if (memsys_enabled(&cpu->memsys) && accesses_memory(stage)) {
+
+    if (!stage->mem_request) {
+      int is_write = (op_flags[stage->op] & STORES) != 0;
+      stage->mem_request =
+        memsys_request(&cpu->memsys, memsys_data_address(stage->mem_address),
+                       is_write ? MEM_WRITE : MEM_READ, cpu->clock);
+
+      /* Loads entering the memory hierarchy train the prefetcher */
+      if (stage->mem_request && !is_write) {
+        memsys_prefetch_train(&cpu->memsys, stage->pc,
+                              memsys_data_address(stage->mem_address),
+                              cpu->clock);
+      }
     }
 
-    if (strcmp(stage->opcode, "BZ") == 0) {
-
-      if(BZ_Flag == 0){
-                cpu->pc = stage->buffer;
-                
-                make_register_valid(cpu, &cpu->stage[EX2]);
-                make_register_valid(cpu, &cpu->stage[EX1]);
-                make_register_valid(cpu, &cpu->stage[DRF]);
-                make_register_valid(cpu, &cpu->stage[F]);
-                make_stage_empty(&cpu->stage[DRF]); 
-                make_stage_empty(&cpu->stage[EX1]);
-                make_stage_empty(&cpu->stage[EX2]);
-      }else{
-                cpu->pc = stage->buffer;             
+    stage->busy = !stage->mem_request ||
+                  !memsys_done(&cpu->memsys, stage->mem_request, cpu->clock);
+    if (stage->busy) {
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Memory1", stage);
       }
-      
+      make_stage_bubble(&cpu->stage[MEM2], CPI_MEMORY);
+      return 0;
     }
+    stage->mem_request = 0;
+  }
 
-    if (strcmp(stage->opcode, "BNZ") == 0) {
-
-      if(BZ_Flag == 1){
-                cpu->pc = stage->buffer;
-                
-                make_register_valid(cpu, &cpu->stage[EX2]);
-                make_register_valid(cpu, &cpu->stage[EX1]);
-                make_register_valid(cpu, &cpu->stage[DRF]);
-                make_register_valid(cpu, &cpu->stage[F]);
-                make_stage_empty(&cpu->stage[DRF]); 
-                make_stage_empty(&cpu->stage[EX1]);
-                make_stage_empty(&cpu->stage[EX2]);
-      }else{
-                cpu->pc = stage->buffer;             
+  /* Only a branch waiting on the zero flag is still busy here */
+  if (!stage->stalled) {
+
+    switch (stage->pc ? stage->op : -1) {
+      case OP_STORE:
+        stage->mem_fault = datamem_write(&cpu->data_memory, stage->mem_address,
+                                         stage->rs1_value) != 0;
+        break;
+      case OP_STR:
+        stage->mem_fault = datamem_write(&cpu->data_memory, stage->mem_address,
+                                         stage->rd_value) != 0;
+        break;
+      case OP_LOAD:
+      case OP_LDR:
+        stage->mem_fault = datamem_read(&cpu->data_memory, stage->mem_address,
+                                        &stage->buffer) != 0;
+        break;
+    }
+
+    stage->busy =
+      cpu->resolve_stage == MEM1 && resolve_branch(cpu, stage, MEM1);
+    if (stage->busy) {
+      make_stage_bubble(&cpu->stage[MEM2], CPI_FLAG);
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Memory1", stage);
       }
-      
+      return 0;
     }
 
     cpu->stage[MEM2] = cpu->stage[MEM1];
@@ -872,27 +1065,8 @@ memory2(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MEM2];
 
-  stageMEM2 = stage->pc;
-
   if (!stage->busy && !stage->stalled) {
 
-  	if (strcmp(stage->opcode, "HALT") == 0) {
-	   
-	  	
-	  	
-     
-    }
-
-    /* Store */
-    if (strcmp(stage->opcode, "STORE") == 0) {
-    }
-
-    /* MOVC */
-    if (strcmp(stage->opcode, "MOVC") == 0) {
-    }
-
-    
-
     cpu->stage[WB] = cpu->stage[MEM2];
 
     if (ENABLE_DEBUG_MESSAGES) {
@@ -912,6 +1086,45 @@ make_stage_empty(stage);
 }
 
 
+/* Checks the instruction retiring in Writeback against the functional
+ * model
+ */
+static void
+check_retire(APEX_CPU* cpu, const CPU_Stage* stage)
+{
+  Func_Commit commit = {
+    .pc = stage->pc,
+    .op = stage->op,
+    .rd = -1,
+  };
+
+  if (writes_register(stage)) {
+    commit.rd = stage->rd;
+    commit.value = stage->buffer;
+  }
+  if (sets_flag(stage)) {
+    commit.sets_flag = 1;
+    commit.zero_flag = stage->buffer == 0;
+  }
+  switch (stage->op) {
+    case OP_STORE:
+      commit.store_value = stage->rs1_value;
+      /* fall through */
+    case OP_LOAD:
+    case OP_LDR:
+      commit.memory = 1;
+      commit.address = stage->mem_address;
+      break;
+    case OP_STR:
+      commit.store_value = stage->rd_value;
+      commit.memory = 1;
+      commit.address = stage->mem_address;
+      break;
+  }
+
+  checker_retire(&cpu->checker, &commit);
+}
+
 /*
  *  Writeback Stage of APEX Pipeline
  *
@@ -924,107 +1137,448 @@ writeback(APEX_CPU* cpu)
   CPU_Stage* stage = &cpu->stage[WB];
   	
 
+  /* A faulting load or store stops the simulation before it retires */
+  if (stage->mem_fault && accesses_memory(stage)) {
+    fprintf(stderr, "APEX_Error : Data memory fault at address %u, pc %d\n",
+            (unsigned int)stage->mem_address, stage->pc);
+    cpu->faulted = 1;
+    return 0;
+  }
+
+  /* A cycle retiring nothing is charged to the cause its bubble carries */
+  if (!stage->pc || stage->busy || stage->stalled) {
+    cpu->cpi_stack[stage->cpi_cause]++;
+  }
+
   if (!stage->busy && !stage->stalled) {
 
-  	if (strcmp(stage->opcode, "HALT") == 0) { }
-  	
+    if (stage->pc && stage->op == OP_HALT) {
+      cpu->halted = 1;
+    }
 
-    /* Update register file */
-    if (strcmp(stage->opcode, "MOVC") == 0) {
+    /* Update register file, ADD, SUB and MUL also set the zero flag */
+    if (writes_register(stage)) {
       cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
+    }
+    if (sets_flag(stage)) {
+      cpu->zero_flag = stage->buffer == 0;
+    }
+    release(cpu, stage);
 
+    /* Bubbles pass through Writeback too */
+    if (stage->pc) {
+      cpu->ins_completed++;
+      cpu->op_retired[stage->op]++;
+      profile_add(&cpu->profile, stage->pc, PROFILE_RETIRED, 1);
+      if (stage->issue_cycle) {
+        profile_add(&cpu->profile, stage->pc, PROFILE_LATENCY,
+                    cpu->clock - stage->issue_cycle);
+        profile_add(&cpu->profile, stage->pc, PROFILE_COMPLETED, 1);
+      }
+      if (cpu->checker.mode) {
+        check_retire(cpu, stage);
+      }
     }
 
-    if (strcmp(stage->opcode, "LOAD") == 0) {
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Writeback", stage);
     }
+  } else{
 
-    if (strcmp(stage->opcode, "ADD") == 0) {
+make_stage_empty(stage);
+if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Writeback", stage);
+    }  	
+  }
 
-      if (!stage->buffer) {
-                BZ_Flag = 0;
-           } else {
 
-                BZ_Flag = 1;
-              }
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
+  return 0;
+}
 
-    }
+/* Returns a monotonic host time in seconds */
+static double
+host_time(void)
+{
+  struct timespec ts;
 
-    if (strcmp(stage->opcode, "SUB") == 0) {
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
 
-      if (!stage->buffer) {
-                BZ_Flag = 0;
-           } else {
+/* Prints how long the program ran and whether it reached HALT, and how
+ * fast the simulator ran it
+ */
+static void
+print_run_stats(const APEX_CPU* cpu)
+{
+  double seconds = cpu->host_seconds > 0 ? cpu->host_seconds : 1e-9;
+
+  printf("============= Run =============\n");
+  printf("| Cycles                | %d |\n", cpu->clock);
+  printf("| Instructions          | %d |\n", cpu->ins_completed);
+  printf("| CPI                   | %.3f |\n",
+         cpu->ins_completed ? (double)cpu->clock / cpu->ins_completed : 0.0);
+  printf("| Halted                | %s |\n", cpu->halted ? "yes" : "no");
+  printf("| Host time (s)         | %.6f |\n", cpu->host_seconds);
+  printf("| Cycles per second     | %.0f |\n", cpu->clock / seconds);
+  printf("| Instructions/second   | %.0f |\n", cpu->ins_completed / seconds);
+}
 
-                BZ_Flag = 1;
-              }
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+/* Prints the branches resolved in the --resolve stage, the taken ones and
+ * the instructions they squashed
+ */
+static void
+print_branch_stats(const APEX_CPU* cpu)
+{
+  const char* where = cpu->resolve_stage == DRF   ? "Decode/RF"
+                      : cpu->resolve_stage == EX1 ? "Execute1"
+                                                  : "Memory1";
+
+  printf("============= Branches =============\n");
+  printf("| Resolved in           | %s |\n", where);
+  printf("| Branches              | %ld |\n", cpu->branches);
+  printf("| Taken                 | %ld |\n", cpu->flushes);
+  printf("| Flush penalty         | %ld |\n", cpu->flush_penalty);
+  printf("| Penalty per branch    | %.3f |\n",
+         cpu->branches ? (double)cpu->flush_penalty / cpu->branches : 0.0);
+  printf("| Penalty per taken     | %.3f |\n",
+         cpu->flushes ? (double)cpu->flush_penalty / cpu->flushes : 0.0);
+}
 
-    if (strcmp(stage->opcode, "OR") == 0) {
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+/* Prints a CPI stack: the cycles an instruction retired, then every other
+ * cycle by the cause of the bubble in Writeback, as cycles and as their
+ * share of the CPI
+ */
+static void
+print_cpi_stack(const char* title, int retired, const long* stack)
+{
+  static const char* names[NUM_CPI_CAUSES] = {
+    [CPI_FILL] = "Pipeline fill",
+    [CPI_RAW_EX2] = "RAW on EX2 producer",
+    [CPI_RAW_MEM1] = "RAW on MEM1 producer",
+    [CPI_RAW_MEM2] = "RAW on MEM2 producer",
+    [CPI_RAW_WB] = "RAW on WB producer",
+    [CPI_RAW_NONE] = "RAW, no producer",
+    [CPI_FLAG] = "Flag dependence",
+    [CPI_FLUSH] = "Branch flush",
+    [CPI_MEMORY] = "Structural (memory)",
+    [CPI_FETCH] = "I-cache",
+    [CPI_DRAIN] = "HALT drain",
+  };
+  double ins = retired ? retired : 1;
+
+  printf("============= %s =============\n", title);
+  printf("| Base                  | %d | %.3f |\n", retired, retired / ins);
+  for (int i = 0; i < NUM_CPI_CAUSES; ++i) {
+    printf("| %-21s | %ld | %.3f |\n", names[i], stack[i], stack[i] / ins);
+  }
+}
 
-    if (strcmp(stage->opcode, "AND") == 0) {
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+/* Prints the CPI stack of the cycles since the last interval */
+static void
+print_interval(APEX_CPU* cpu)
+{
+  int start = cpu->clock - (cpu->clock - 1) % cpu->opts.interval - 1;
+  long* last = cpu->interval_stack;
+  long stack[NUM_CPI_CAUSES];
+  char title[64];
+
+  for (int i = 0; i < NUM_CPI_CAUSES; ++i) {
+    stack[i] = cpu->cpi_stack[i] - last[i];
+    last[i] = cpu->cpi_stack[i];
+  }
 
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+  snprintf(title, sizeof(title), "CPI Stack, cycles %d-%d", start,
+           cpu->clock - 1);
+  print_cpi_stack(title, cpu->ins_completed - last[NUM_CPI_CAUSES], stack);
+  last[NUM_CPI_CAUSES] = cpu->ins_completed;
+}
+
+static double
+ipc(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
 
-    if (strcmp(stage->opcode, "MUL") == 0) {
-      if (!stage->buffer) {
-                BZ_Flag = 0;
-                
-           } else {
+  return cpu->clock ? (double)cpu->ins_completed / cpu->clock : 0.0;
+}
 
-                BZ_Flag = 1;
-                
-              }
-      cpu->regs[stage->rd] = stage->buffer;
-      cpu->regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+static double
+cpi(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
 
-    cpu->ins_completed++;
+  return cpu->ins_completed ? (double)cpu->clock / cpu->ins_completed : 0.0;
+}
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_stage_content("Writeback", stage);
+static double
+host_seconds(const void* ctx)
+{
+  return ((const APEX_CPU*)ctx)->host_seconds;
+}
+
+static double
+cycles_per_second(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->host_seconds > 0 ? cpu->clock / cpu->host_seconds : 0.0;
+}
+
+static double
+instructions_per_second(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->host_seconds > 0 ? cpu->ins_completed / cpu->host_seconds
+                               : 0.0;
+}
+
+static double
+branch_mpki(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->ins_completed ? 1000.0 * cpu->flushes / cpu->ins_completed
+                            : 0.0;
+}
+
+static double
+l1d_mpki(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->ins_completed
+           ? 1000.0 * cpu->memsys.l1d.misses / cpu->ins_completed
+           : 0.0;
+}
+
+/* Registers the counters of the pipeline and of every module it owns */
+static void
+register_stats(APEX_CPU* cpu)
+{
+  static const char* op_names[NUM_OPCODES];
+  static const char* cpi_names[NUM_CPI_CAUSES] = {
+    [CPI_FILL] = "fill",
+    [CPI_RAW_EX2] = "raw_ex2",
+    [CPI_RAW_MEM1] = "raw_mem1",
+    [CPI_RAW_MEM2] = "raw_mem2",
+    [CPI_RAW_WB] = "raw_wb",
+    [CPI_RAW_NONE] = "raw_none",
+    [CPI_FLAG] = "flag",
+    [CPI_FLUSH] = "flush",
+    [CPI_MEMORY] = "memory",
+    [CPI_FETCH] = "icache",
+    [CPI_DRAIN] = "halt_drain",
+  };
+  Stats* stats = &cpu->stats;
+
+  for (int i = 0; i < NUM_OPCODES; ++i) {
+    op_names[i] = opcode_name(i);
+  }
+
+  stats_init(stats);
+  stats_group(stats, "sim");
+  stats_int(stats, "cycles", &cpu->clock, "Cycles simulated");
+  stats_int(stats, "instructions", &cpu->ins_completed,
+            "Instructions retired");
+  stats_formula(stats, "ipc", ipc, cpu, "Instructions per cycle");
+  stats_formula(stats, "cpi", cpi, cpu, "Cycles per instruction");
+  stats_int(stats, "halted", &cpu->halted, "HALT reached Writeback");
+  stats_int(stats, "faulted", &cpu->faulted,
+            "A data memory fault reached Writeback");
+  stats_hash(stats, "state_hash", &cpu->state_hash,
+             "Hash of the registers and data memory");
+  stats_formula(stats, "host_seconds", host_seconds, cpu,
+                "Host time spent in the simulation loop");
+  stats_formula(stats, "cycles_per_second", cycles_per_second, cpu,
+                "Simulated cycles per host second");
+  stats_formula(stats, "instructions_per_second", instructions_per_second,
+                cpu, "Retired instructions per host second");
+
+  stats_group(stats, "core");
+  stats_vector(stats, "retired", cpu->op_retired, NUM_OPCODES, op_names,
+               "Instructions retired by opcode");
+  stats_long(stats, "branches", &cpu->branches,
+             "BZ, BNZ and JUMP resolved");
+  stats_long(stats, "flushes", &cpu->flushes,
+             "Taken BZ, BNZ and JUMP that redirected fetch");
+  stats_long(stats, "flush_penalty", &cpu->flush_penalty,
+             "Younger instructions squashed by the redirects");
+  stats_formula(stats, "branch_mpki", branch_mpki, cpu,
+                "Flushes per thousand instructions");
+  if (cpu->memsys.l1d.config.sets) {
+    stats_formula(stats, "l1d_mpki", l1d_mpki, cpu,
+                  "L1D misses per thousand instructions");
+  }
+  stats_vector(stats, "cpi_stack", cpu->cpi_stack, NUM_CPI_CAUSES, cpi_names,
+               "Cycles retiring nothing, by cause");
+
+  frontend_register_stats(&cpu->frontend, stats);
+  memsys_register_stats(&cpu->memsys, stats);
+  datamem_register_stats(&cpu->data_memory, stats);
+  bypass_register_stats(&cpu->bypass, stats);
+  checker_register_stats(&cpu->checker, stats);
+  funcmodel_register_stats(&cpu->model, stats);
+}
+
+/*
+ * Writes the registered statistics to the files given by --stats-json and
+ * --stats-csv.
+ * Returns 0 on success, 1 if a file could not be written
+ */
+static int
+write_stats(APEX_CPU* cpu)
+{
+  int failed = 0;
+
+  if (!cpu->opts.stats_json && !cpu->opts.stats_csv) {
+    return 0;
+  }
+
+  cpu->state_hash = image_hash(&cpu->data_memory, cpu->regs, ISA_REGS);
+
+  if (cpu->opts.stats_json &&
+      stats_write_json(&cpu->stats, cpu->opts.stats_json)) {
+    failed = 1;
+  }
+
+  if (cpu->opts.stats_csv &&
+      stats_write_csv(&cpu->stats, cpu->opts.stats_csv)) {
+    failed = 1;
+  }
+  return failed;
+}
+
+static void
+request_stats(int sig)
+{
+  (void)sig;
+  stats_requested = 1;
+}
+
+/* Charges the cycle to the oldest instruction not retired, the one in the
+ * latest stage, else to the one being fetched
+ */
+static void
+profile_cycle(APEX_CPU* cpu)
+{
+  CPU_Stage* stage = &cpu->stage[DRF];
+  int pc = cpu->halted ? cpu->stage[WB].pc : cpu->pc;
+
+  for (int i = WB; i >= DRF; --i) {
+    if (cpu->stage[i].pc) {
+      pc = cpu->stage[i].pc;
+      break;
     }
-  } else{
+  }
+  profile_add(&cpu->profile, pc, PROFILE_CYCLES, 1);
 
-make_stage_empty(stage);
-if (ENABLE_DEBUG_MESSAGES) {
-      print_stage_content("Writeback", stage);
-    }  	
+  if (stage->pc && stage->stalled) {
+    profile_add(&cpu->profile, stage->pc, PROFILE_STALLS, 1);
   }
 
+  /* So is a branch waiting on the zero flag where it resolves */
+  stage = &cpu->stage[cpu->resolve_stage];
+  if (cpu->resolve_stage != DRF && stage->pc && stage->busy &&
+      (stage->op == OP_BZ || stage->op == OP_BNZ)) {
+    profile_add(&cpu->profile, stage->pc, PROFILE_STALLS, 1);
+  }
+}
 
-  return 0;
+/*
+ * Prints the hash of the final registers and data memory, and writes
+ * them out as binary images if asked.
+ * Returns 0 on success, 1 if an image could not be written
+ */
+static int
+write_final_state(APEX_CPU* cpu)
+{
+  int failed = 0;
+
+  printf("============= Final State =============\n");
+  printf("| State hash            | %016lx |\n",
+         image_hash(&cpu->data_memory, cpu->regs, ISA_REGS));
+
+  if (cpu->opts.mem_out &&
+      image_save_memory(&cpu->data_memory, cpu->opts.mem_out)) {
+    failed = 1;
+  }
+
+  if (cpu->opts.regs_out &&
+      image_save_words(cpu->opts.regs_out, cpu->regs, ISA_REGS)) {
+    failed = 1;
+  }
+  return failed;
+}
+
+/* Prints the register file and the first words of data memory */
+static void
+print_architectural_state(const APEX_CPU* cpu)
+{
+	printf("============= Register File =============\n");
+	for(int i=0;i<16;i++){
+		printf("| Reg[%d] |  Values = %d |\n",i,cpu->regs[i]);
+	}
+
+	printf("====== State of Data Memory ======\n");
+	for(int i=0;i<50;i++){
+		printf("| MEM[%d] | Data Value = %d |\n",i,datamem_peek(&cpu->data_memory, i));
+	}
+}
+
+/* Takes the registers, zero flag and pc the functional model left */
+static void
+take_model_state(APEX_CPU* cpu)
+{
+  const Func_Model* fm = &cpu->model;
+
+  memcpy(cpu->regs, fm->regs, sizeof(fm->regs));
+  cpu->zero_flag = fm->zero_flag;
+  cpu->pc = fm->pc;
+  cpu->halted = fm->halted;
+  if (fm->faulted) {
+    fprintf(stderr, "APEX_Error : Data memory fault at address %u, pc %d\n",
+            fm->fault_address, fm->pc);
+    cpu->faulted = 1;
+  }
+}
+
+/*
+ * Runs the first --fast-forward instructions on the functional model, and
+ * the checker's model with it, then starts the pipeline from the state
+ * they leave. The caches and predictors start cold
+ */
+static void
+fast_forward(APEX_CPU* cpu)
+{
+  funcmodel_run(&cpu->model, cpu->opts.fast_forward);
+  if (cpu->checker.mode) {
+    funcmodel_run(&cpu->checker.model, cpu->opts.fast_forward);
+  }
+  take_model_state(cpu);
+  cpu->frontend.start_pc = cpu->pc;
+  cpu->frontend.end_pc = cpu->pc;
+}
+
+/*
+ * Runs up to n instructions on the functional model alone, with no
+ * pipeline, and reports how fast it went.
+ * Returns 0 on success, 1 on a fault or if an output could not be written
+ */
+static int
+run_functional(APEX_CPU* cpu, long n)
+{
+  int failed;
+
+  funcmodel_run(&cpu->model, n);
+  take_model_state(cpu);
+
+  print_architectural_state(cpu);
+  funcmodel_print_stats(&cpu->model);
+
+  failed = write_final_state(cpu);
+  failed |= write_stats(cpu);
+  return failed || cpu->faulted;
 }
 
 /*
@@ -1036,9 +1590,25 @@ if (ENABLE_DEBUG_MESSAGES) {
 int
 APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
 {
+	if (strcmp(argv[2], "functional") == 0) {
+		return run_functional(cpu, n);
+	}
+
 	if(strcmp(argv[2],"display") == 0){
 
-		while (cpu->clock < n) {
+		if (cpu->opts.fast_forward) {
+			fast_forward(cpu);
+		}
+
+		double start = host_time();
+
+		/* kill -USR1 writes the statistics of a long run so far */
+		if (cpu->opts.stats_json || cpu->opts.stats_csv) {
+			signal(SIGUSR1, request_stats);
+		}
+
+		while (cpu->clock < n && !cpu->halted && !cpu->faulted &&
+		       !cpu->checker.diverged) {
 
     		if (ENABLE_DEBUG_MESSAGES) {
       			printf("--------------------------------\n");
@@ -1046,6 +1616,8 @@ APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
       			printf("--------------------------------\n");
     		}
 
+    		memsys_tick(&cpu->memsys, cpu->clock);
+
     		writeback(cpu);
     		memory2(cpu);
     		memory1(cpu);
@@ -1053,27 +1625,68 @@ APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
     		execute1(cpu);
     		decode(cpu);
     		fetch(cpu);
+    		if (cpu->profile.count) {
+    			profile_cycle(cpu);
+    		}
     		cpu->clock++;
-  		}
 
-			printf("============= Register File =============\n");
-  			printf("1 -> Valid Register\n0-> Invalid Register\n");
-  				for(int i=0;i<16;i++){
-  					printf("| Reg[%d] |  Valid_Status = %d |\n",i,cpu->regs[i]);
-				}
+    		if (cpu->opts.interval && cpu->clock % cpu->opts.interval == 0) {
+    			print_interval(cpu);
+    		}
 
-  			printf("====== State of Data Memory ======\n");
-  				for(int i=0;i<50;i++){
-  					printf("| MEM[%d] | Data Value = %d |\n",i,cpu->data_memory[i]);
-				}
+    		if (stats_requested) {
+    			stats_requested = 0;
+    			cpu->host_seconds = host_time() - start;
+    			write_stats(cpu);
+    		}
+  		}
+		cpu->host_seconds = host_time() - start;
+		int diverged = checker_finish(&cpu->checker, cpu->regs,
+		                              cpu->zero_flag, &cpu->data_memory,
+		                              cpu->halted) != 0;
+
+			print_architectural_state(cpu);
+
+  			frontend_print_stats(&cpu->frontend);
+  			memsys_print_stats(&cpu->memsys);
+  			datamem_print_stats(&cpu->data_memory);
+
+  			/* The last interval may be cut short by HALT or the limit */
+  			if (cpu->opts.interval && cpu->clock % cpu->opts.interval) {
+  				print_interval(cpu);
+  			}
+  			print_cpi_stack("CPI Stack", cpu->ins_completed, cpu->cpi_stack);
+  			bypass_print_stats(&cpu->bypass);
+  			print_branch_stats(cpu);
+  			checker_print_stats(&cpu->checker);
+  			print_run_stats(cpu);
 		
 
-		return 0;
+		int failed = write_final_state(cpu);
+		failed |= write_stats(cpu);
+		if (cpu->opts.profile &&
+		    profile_write(&cpu->profile, cpu->opts.profile, cpu->code_memory,
+		                  &cpu->object, cpu->clock)) {
+			failed = 1;
+		}
+		return failed || cpu->faulted || diverged;
  	}
 
 	if(strcmp(argv[2],"simulate") == 0){
 
-		while (cpu->clock < n) {
+		if (cpu->opts.fast_forward) {
+			fast_forward(cpu);
+		}
+
+		double start = host_time();
+
+		/* kill -USR1 writes the statistics of a long run so far */
+		if (cpu->opts.stats_json || cpu->opts.stats_csv) {
+			signal(SIGUSR1, request_stats);
+		}
+
+		while (cpu->clock < n && !cpu->halted && !cpu->faulted &&
+		       !cpu->checker.diverged) {
 
     		if (ENABLE_DEBUG_MESSAGES) {
       			printf("--------------------------------\n");
@@ -1081,6 +1694,8 @@ APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
       			printf("--------------------------------\n");
     		}
 
+    		memsys_tick(&cpu->memsys, cpu->clock);
+
     		writeback(cpu);
     		memory2(cpu);
     		memory1(cpu);
@@ -1088,21 +1703,53 @@ APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
     		execute1(cpu);
     		decode(cpu);
     		fetch(cpu);
+    		if (cpu->profile.count) {
+    			profile_cycle(cpu);
+    		}
     		cpu->clock++;
-  		}
 
-			printf("============= Register File =============\n");
-  			printf("1 -> Valid Register\n0-> Invalid Register\n");
-  				for(int i=0;i<16;i++){
-  					printf("| Reg[%d] |  Valid_Status = %d |\n",i,cpu->regs[i]);
-				}
+    		if (cpu->opts.interval && cpu->clock % cpu->opts.interval == 0) {
+    			print_interval(cpu);
+    		}
 
-  			printf("====== State of Data Memory ======\n");
-  				for(int i=0;i<50;i++){
-  					printf("| MEM[%d] | Data Value = %d |\n",i,cpu->data_memory[i]);
-				}
+    		if (stats_requested) {
+    			stats_requested = 0;
+    			cpu->host_seconds = host_time() - start;
+    			write_stats(cpu);
+    		}
+  		}
+		cpu->host_seconds = host_time() - start;
+		int diverged = checker_finish(&cpu->checker, cpu->regs,
+		                              cpu->zero_flag, &cpu->data_memory,
+		                              cpu->halted) != 0;
+
+			print_architectural_state(cpu);
+
+  			frontend_print_stats(&cpu->frontend);
+  			memsys_print_stats(&cpu->memsys);
+  			datamem_print_stats(&cpu->data_memory);
+
+  			/* The last interval may be cut short by HALT or the limit */
+  			if (cpu->opts.interval && cpu->clock % cpu->opts.interval) {
+  				print_interval(cpu);
+  			}
+  			print_cpi_stack("CPI Stack", cpu->ins_completed, cpu->cpi_stack);
+  			bypass_print_stats(&cpu->bypass);
+  			print_branch_stats(cpu);
+  			checker_print_stats(&cpu->checker);
+  			print_run_stats(cpu);
 		
 
-		return 0;
+		int failed = write_final_state(cpu);
+		failed |= write_stats(cpu);
+		if (cpu->opts.profile &&
+		    profile_write(&cpu->profile, cpu->opts.profile, cpu->code_memory,
+		                  &cpu->object, cpu->clock)) {
+			failed = 1;
+		}
+		return failed || cpu->faulted || diverged;
 	}
+
+	fprintf(stderr, "APEX_Error : Unknown mode %s\n", argv[2]);
+	return 1;
 }
@@ -8,6 +8,19 @@
  *  Gaurav Kothari (gkothar1@binghamton.edu)
  *  State University of New York, Binghamton
  */
+#include "bypass.h"
+#include "checker.h"
+#include "datamem.h"
+#include "frontend.h"
+#include "isa.h"
+#include "object.h"
+#include "image.h"
+#include "memsys.h"
+#include "options.h"
+#include "profile.h"
+
+/* Bypass paths when --bypass is not given, Part A forwards nothing */
+#define DEFAULT_BYPASS "none"
 
 enum
 {
@@ -21,32 +34,50 @@ enum
   NUM_STAGES
 };
 
-/* Format of an APEX instruction  */
-typedef struct APEX_Instruction
+/* Why Writeback retired nothing in a cycle, for the CPI stack. A bubble
+ * carries the cause it was made for from the stage that made it
+ */
+enum
 {
-  char opcode[128];	// Operation Code
-  int rd;		    // Destination Register Address
-  int rs1;		    // Source-1 Register Address
-  int rs2;		    // Source-2 Register Address
-  int imm;		    // Literal Value
-} APEX_Instruction;
+  CPI_FILL,	// Pipeline not yet full after reset
+  CPI_RAW_EX2,	// Decode waits on a producer in Execute2
+  CPI_RAW_MEM1,	// ... in Memory1
+  CPI_RAW_MEM2,	// ... in Memory2
+  CPI_RAW_WB,	// ... in Writeback
+  CPI_RAW_NONE,	// Decode waits on a register nothing in flight writes
+  CPI_FLAG,	// BZ or BNZ waits on the zero flag
+  CPI_FLUSH,	// Younger stages squashed by a taken branch
+  CPI_MEMORY,	// Memory1 held by the memory hierarchy
+  CPI_FETCH,	// Fetch waits on the I-cache
+  CPI_DRAIN,	// Nothing fetched behind HALT or past the end of code
+  NUM_CPI_CAUSES
+};
 
 /* Model of CPU stage latch */
 typedef struct CPU_Stage
 {
   int pc;		    // Program Counter
   char opcode[128];	// Operation Code
+  int op;		    // Operation Code, one of OP_*
   int rs1;		    // Source-1 Register Address
   int rs2;		    // Source-2 Register Address
   int rd;		    // Destination Register Address
   int imm;		    // Literal Value
   int rs1_value;	// Source-1 Register Value
   int rs2_value;	// Source-2 Register Value
+  int rd_value;		// Value of rd when it is a source (STR)
+  int zero_flag;	// Zero flag BZ or BNZ read where it resolves
   int buffer;		// Latch to hold some value
   int mem_address;	// Computed Memory Address
   int busy;		    // Flag to indicate, stage is performing some action
   int stalled;		// Flag to indicate, stage is stalled 
   int empty; //Flag to indicate,stage is empty
+  int mem_request;	// Memory hierarchy access in flight, 0 if none
+  int mem_fault;	// Flag to indicate, the access faulted
+  int cpi_cause;	// CPI_* cause, when the stage holds a bubble
+  long issue_cycle;	// Cycle it entered Execute1, 0 until then
+  long seq;		    // Order it left decode in, names it in the scoreboard
+  long flag_seq;	// Flag writer a BZ or BNZ left decode behind, 0 if none
 } CPU_Stage;
 
 /* Model of APEX CPU */
@@ -60,7 +91,21 @@ typedef struct APEX_CPU
 
   /* Integer register file */
   int regs[32];
-  int regs_valid[32];
+
+  /* Set when the last ADD, SUB or MUL to retire gave zero */
+  int zero_flag;
+
+  /* Scoreboard of the registers in flight and the forwarding paths */
+  Bypass bypass;
+  long next_seq;
+
+  /* Stage BZ, BNZ and JUMP are resolved in, from --resolve */
+  int resolve_stage;
+
+  /* Flag to indicate, a branch redirected fetch this cycle and the slot
+   * fetched meanwhile was on the wrong path
+   */
+  int redirected;
 
   /* Array of 5 CPU_stage */
   CPU_Stage stage[7];
@@ -69,19 +114,58 @@ typedef struct APEX_CPU
   APEX_Instruction* code_memory;
   int code_memory_size;
 
-  /* Data Memory */
-  int data_memory[4096];
+  /* Assembled object code memory is mapped from, if any */
+  Apexo_Object object;
+
+  /* Data Memory, sparse 32-bit address space */
+  Data_Memory data_memory;
+
+  /* Flag to indicate, a memory fault reached Writeback */
+  int faulted;
+
+  /* Flag to indicate, HALT reached Writeback */
+  int halted;
+
+  /* Options given on the command line */
+  APEX_Options opts;
+
+  /* I-cache and fetch buffer feeding the Fetch stage */
+  Frontend frontend;
+
+  /* L1 D-cache, L2 and DRAM timing behind Memory1 */
+  MemSys memsys;
 
   /* Some stats */
   int ins_completed;
+  long cpi_stack[NUM_CPI_CAUSES];	// Cycles retiring nothing, by cause
+  long interval_stack[NUM_CPI_CAUSES + 1];	// Stack and retired at interval start
+  double host_seconds;	// Host time spent in the simulation loop
 
-} APEX_CPU;
+  /* Counters only read through the statistics registry */
+  long op_retired[NUM_OPCODES];	// Retired instructions by OP_*
+  long branches;		// BZ, BNZ and JUMP resolved
+  long flushes;		// Of them, taken and redirecting fetch
+  long flush_penalty;	// Cycles the redirects lost, as bubbles in Writeback
+  unsigned long state_hash;	// Hash of regs and data memory, when written
+
+  /* Every statistic above and of the modules, by name */
+  Stats stats;
+
+  /* Cycles, stalls and retires by PC, with --profile */
+  Profile profile;
 
-APEX_Instruction*
-create_code_memory(const char* filename, int* size);
+  /* Functional model the retires are checked against, with --check */
+  Checker checker;
+
+  /* Functional model of the functional mode and --fast-forward, running
+   * on data_memory
+   */
+  Func_Model model;
+
+} APEX_CPU;
 
 APEX_CPU*
-APEX_cpu_init(const char* filename);
+APEX_cpu_init(const char* filename, const APEX_Options* opts);
 
 int
 APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n);
@@ -0,0 +1,313 @@
+/*
+ *  datamem.c
+ *  Contains the sparse data memory.
+ *
+ *  An address is split into a directory index, a table index and a word
+ *  within the page. Reads of a page that was never written return 0
+ *  without allocating it. The software TLB caches the last page seen per
+ *  slot so a hit skips both levels of the walk.
+ *
+ *  Hugepage regions are backed by one anonymous mapping each, asking the
+ *  kernel for explicit hugepages first and transparent ones otherwise.
+ *  Their pages, like those of a mapped memory image, are entered in the
+ *  page table up front.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "datamem.h"
+
+#define HUGEPAGE_BYTES (2UL << 20)
+
+static unsigned int
+dir_index(unsigned int page)
+{
+  return page >> DATAMEM_TABLE_BITS;
+}
+
+static unsigned int
+table_index(unsigned int page)
+{
+  return page & ((1U << DATAMEM_TABLE_BITS) - 1);
+}
+
+/* Returns the page table slot of page, allocating the table if asked */
+static int**
+page_slot(Data_Memory* dm, unsigned int page, int allocate)
+{
+  int*** table = &dm->directory[dir_index(page)];
+
+  if (!*table) {
+    if (!allocate) {
+      return NULL;
+    }
+    *table = calloc(1U << DATAMEM_TABLE_BITS, sizeof(int*));
+    if (!*table) {
+      return NULL;
+    }
+  }
+  return &(*table)[table_index(page)];
+}
+
+/*
+ * Enters the pages holding words words of map, starting at first_page.
+ * Pages that already exist get a copy of the data instead. The data
+ * memory owns map from then on and unmaps it when freed.
+ * Returns 0 on success, -1 on failure
+ */
+int
+datamem_attach(Data_Memory* dm, unsigned int first_page, void* map,
+               unsigned long bytes, unsigned long words)
+{
+  unsigned long count = (words + DATAMEM_PAGE_WORDS - 1) >> DATAMEM_PAGE_BITS;
+
+  if (dm->map_count == DATAMEM_MAX_MAPS ||
+      first_page + count > (1UL << (32 - DATAMEM_PAGE_BITS))) {
+    munmap(map, bytes);
+    return -1;
+  }
+  dm->map[dm->map_count] = map;
+  dm->map_bytes[dm->map_count] = bytes;
+  dm->map_count++;
+
+  for (unsigned long i = 0; i < count; ++i) {
+    int** slot = page_slot(dm, first_page + i, 1);
+    int* words_in = (int*)map + i * DATAMEM_PAGE_WORDS;
+
+    if (!slot) {
+      return -1;
+    }
+    if (*slot) {
+      unsigned long left = words - i * DATAMEM_PAGE_WORDS;
+      memcpy(*slot, words_in,
+             (left < DATAMEM_PAGE_WORDS ? left : DATAMEM_PAGE_WORDS) *
+               sizeof(int));
+      continue;
+    }
+    *slot = words_in;
+    dm->mapped_pages++;
+  }
+
+  /* Pages may have moved under cached translations */
+  memset(dm->tlb, 0, sizeof(dm->tlb));
+  return 0;
+}
+
+static int
+map_huge_region(Data_Memory* dm, int index)
+{
+  Huge_Region* region = &dm->config.huge[index];
+  unsigned long first = region->base >> DATAMEM_PAGE_BITS;
+  unsigned long count;
+  unsigned long bytes;
+  void* map;
+
+  region->base = first << DATAMEM_PAGE_BITS;
+  count = (region->size + DATAMEM_PAGE_WORDS - 1) >> DATAMEM_PAGE_BITS;
+  region->size = count << DATAMEM_PAGE_BITS;
+
+  if (count == 0 || region->base + region->size > (1UL << 32)) {
+    return -1;
+  }
+
+  bytes = count * DATAMEM_PAGE_WORDS * sizeof(int);
+  bytes = (bytes + HUGEPAGE_BYTES - 1) / HUGEPAGE_BYTES * HUGEPAGE_BYTES;
+
+  map = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (map == MAP_FAILED) {
+    map = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+      return -1;
+    }
+    madvise(map, bytes, MADV_HUGEPAGE);
+  }
+
+  return datamem_attach(dm, first, map, bytes, region->size);
+}
+
+/* Returns 0 on success, -1 if a hugepage region can not be set up */
+int
+datamem_init(Data_Memory* dm, const Data_Memory_Config* config)
+{
+  memset(dm, 0, sizeof(*dm));
+  dm->config = *config;
+
+  for (int i = 0; i < dm->config.huge_count; ++i) {
+    if (map_huge_region(dm, i)) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static int
+in_mapping(const Data_Memory* dm, const int* page)
+{
+  for (int i = 0; i < dm->map_count; ++i) {
+    const char* map = dm->map[i];
+
+    if ((const char*)page >= map && (const char*)page < map + dm->map_bytes[i]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void
+datamem_free(Data_Memory* dm)
+{
+  for (int d = 0; d < (1 << DATAMEM_DIR_BITS); ++d) {
+    if (!dm->directory[d]) {
+      continue;
+    }
+    for (int t = 0; t < (1 << DATAMEM_TABLE_BITS); ++t) {
+      if (!in_mapping(dm, dm->directory[d][t])) {
+        free(dm->directory[d][t]);
+      }
+    }
+    free(dm->directory[d]);
+    dm->directory[d] = NULL;
+  }
+
+  for (int i = 0; i < dm->map_count; ++i) {
+    munmap(dm->map[i], dm->map_bytes[i]);
+  }
+  dm->map_count = 0;
+}
+
+/* Counts a fault for addresses beyond the configured limit */
+static int
+out_of_range(Data_Memory* dm, unsigned int address)
+{
+  if (dm->config.limit && address >= dm->config.limit) {
+    dm->faults++;
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * Finds the page holding address, allocating it if asked.
+ * Returns NULL if the page is absent, or can not be allocated
+ */
+static int*
+lookup_page(Data_Memory* dm, unsigned int address, int allocate)
+{
+  unsigned int page = address >> DATAMEM_PAGE_BITS;
+  Datamem_Tlb_Entry* entry = &dm->tlb[page % DATAMEM_TLB_ENTRIES];
+  int** slot;
+
+  if (entry->tag == page + 1) {
+    dm->tlb_hits++;
+    return entry->page;
+  }
+  dm->tlb_misses++;
+
+  slot = page_slot(dm, page, allocate);
+  if (slot && !*slot && allocate) {
+    *slot = calloc(DATAMEM_PAGE_WORDS, sizeof(int));
+    if (*slot) {
+      dm->pages++;
+    }
+  }
+
+  if (!slot || !*slot) {
+    return NULL;
+  }
+
+  entry->tag = page + 1;
+  entry->page = *slot;
+  return *slot;
+}
+
+/*
+ * Reads the word at address into value.
+ * Returns 0 on success, -1 on a fault
+ */
+int
+datamem_read(Data_Memory* dm, unsigned int address, int* value)
+{
+  int* page;
+
+  if (out_of_range(dm, address)) {
+    return -1;
+  }
+
+  page = lookup_page(dm, address, 0);
+  *value = page ? page[address & (DATAMEM_PAGE_WORDS - 1)] : 0;
+  return 0;
+}
+
+/*
+ * Writes value to the word at address.
+ * Returns 0 on success, -1 on a fault
+ */
+int
+datamem_write(Data_Memory* dm, unsigned int address, int value)
+{
+  int* page;
+
+  if (out_of_range(dm, address)) {
+    return -1;
+  }
+
+  page = lookup_page(dm, address, 1);
+  if (!page) {
+    dm->faults++;
+    return -1;
+  }
+
+  page[address & (DATAMEM_PAGE_WORDS - 1)] = value;
+  return 0;
+}
+
+/* Returns page number page, NULL if it was never written or mapped */
+int*
+datamem_page(const Data_Memory* dm, unsigned int page)
+{
+  int** table = dm->directory[dir_index(page)];
+
+  return table ? table[table_index(page)] : NULL;
+}
+
+/* Returns the word at address without touching the TLB or the stats */
+int
+datamem_peek(const Data_Memory* dm, unsigned int address)
+{
+  int* page = datamem_page(dm, address >> DATAMEM_PAGE_BITS);
+
+  return page ? page[address & (DATAMEM_PAGE_WORDS - 1)] : 0;
+}
+
+void
+datamem_print_stats(const Data_Memory* dm)
+{
+  long lookups = dm->tlb_hits + dm->tlb_misses;
+
+  printf("============= Data Memory =============\n");
+  printf("| Pages touched         | %ld |\n", dm->pages);
+  printf("| Pages mapped          | %ld |\n", dm->mapped_pages);
+  printf("| Footprint (KB)        | %ld |\n",
+         (dm->pages + dm->mapped_pages) *
+           (long)(DATAMEM_PAGE_WORDS * sizeof(int)) / 1024);
+  printf("| TLB hit rate          | %.2f%% |\n",
+         lookups ? 100.0 * dm->tlb_hits / lookups : 0.0);
+  printf("| Faults                | %ld |\n", dm->faults);
+}
+
+void
+datamem_register_stats(const Data_Memory* dm, Stats* stats)
+{
+  stats_group(stats, "datamem");
+  stats_long(stats, "pages", &dm->pages, "Pages allocated on first touch");
+  stats_long(stats, "mapped_pages", &dm->mapped_pages,
+             "Pages backed by a hugepage region or image");
+  stats_long(stats, "tlb_hits", &dm->tlb_hits, "Software TLB hits");
+  stats_long(stats, "tlb_misses", &dm->tlb_misses, "Software TLB misses");
+  stats_long(stats, "faults", &dm->faults, "Accesses outside the limit");
+}
@@ -0,0 +1,501 @@
+/*
+ *  funcmodel.c
+ *  Contains the functional model of the instruction set
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "funcmodel.h"
+#include "jit.h"
+
+/* Code of the threaded interpreter beyond the opcodes */
+enum
+{
+  FUNC_OUT = NUM_OPCODES,	// Stops at an entry's pc, outside code memory
+  NUM_HANDLERS
+};
+
+static long
+interpret(Func_Model* fm, long count, const void* const** labels);
+
+/* Returns the code memory index of pc, -1 if no instruction is there */
+static int
+code_index(const Func_Model* fm, int pc)
+{
+  unsigned int offset = (unsigned int)(pc - 4000);
+
+  if (offset % 4 || offset / 4 >= (unsigned int)fm->code_size) {
+    return -1;
+  }
+  return offset / 4;
+}
+
+/* Predecodes the program into threaded code.
+ * Returns 0 on success, -1 if it could not be allocated
+ */
+static int
+predecode(Func_Model* fm)
+{
+  const void* const* labels;
+  int size = fm->code_size;
+  int outside = size + 1;
+
+  interpret(NULL, 0, &labels);
+
+  /* An entry per instruction, one past the end, and in the worst case one
+   * for the target of each instruction
+   */
+  fm->threaded = calloc(2 * size + 1, sizeof(*fm->threaded));
+  if (!fm->threaded) {
+    return -1;
+  }
+
+  for (int i = 0; i < size; ++i) {
+    const APEX_Instruction* ins = &fm->code[i];
+    Func_Inst* t = &fm->threaded[i];
+
+    t->handler = labels[ins->op];
+    t->rd = &fm->regs[ins->rd];
+    t->rs1 = &fm->regs[ins->rs1];
+    t->rs2 = &fm->regs[ins->rs2];
+    t->imm = ins->imm;
+    t->pc = 4000 + 4 * i;
+
+    if (ins->op == OP_BZ || ins->op == OP_BNZ) {
+      int target = code_index(fm, t->pc + ins->imm);
+
+      if (target >= 0) {
+        t->target = &fm->threaded[target];
+      } else {
+        t->target = &fm->threaded[outside++];
+        t->target->handler = labels[FUNC_OUT];
+        t->target->pc = t->pc + ins->imm;
+      }
+    }
+  }
+
+  fm->threaded[size].handler = labels[FUNC_OUT];
+  fm->threaded[size].pc = 4000 + 4 * size;
+  return 0;
+}
+
+/*
+ * Sets the model to the state of the pipelines after reset, running on
+ * data memory dm, which the caller sets up.
+ * Returns 0 on success, -1 if the threaded code could not be allocated
+ */
+int
+funcmodel_init(Func_Model* fm, const APEX_Instruction* code, int size,
+               Data_Memory* dm)
+{
+  memset(fm, 0, sizeof(*fm));
+  fm->code = code;
+  fm->code_size = size;
+  fm->data_memory = dm;
+  fm->pc = 4000;
+  fm->zero_flag = 1;
+  return predecode(fm);
+}
+
+void
+funcmodel_free(Func_Model* fm)
+{
+  if (fm->jit) {
+    jit_free(fm->jit);
+    free(fm->jit);
+    fm->jit = NULL;
+  }
+  free(fm->threaded);
+  fm->threaded = NULL;
+}
+
+/*
+ * Has funcmodel_run translate hot blocks to host code.
+ * Returns 0 on success, -1 if the host can not run it, in which case the
+ * model goes on interpreting
+ */
+int
+funcmodel_use_jit(Func_Model* fm)
+{
+  fm->jit = malloc(sizeof(*fm->jit));
+  if (!fm->jit || jit_init(fm->jit, fm->code, fm->code_size)) {
+    free(fm->jit);
+    fm->jit = NULL;
+    return -1;
+  }
+  return 0;
+}
+
+/* Writes the result of an instruction to rd, and the zero flag with it if
+ * it is an ADD, SUB or MUL
+ */
+static void
+write_result(Func_Model* fm, Func_Commit* commit, int rd, int value,
+             int sets_flag)
+{
+  fm->regs[rd] = value;
+  commit->rd = rd;
+  commit->value = value;
+  if (sets_flag) {
+    fm->zero_flag = value == 0;
+    commit->sets_flag = 1;
+    commit->zero_flag = fm->zero_flag;
+  }
+}
+
+/*
+ * Executes the instruction at pc and describes it in commit.
+ * Returns 0 on success, -1 if the model has halted or faulted, or there
+ * is no instruction at pc; a load or store that faults is not executed
+ */
+int
+funcmodel_step(Func_Model* fm, Func_Commit* commit)
+{
+  int index = code_index(fm, fm->pc);
+  const APEX_Instruction* ins;
+  int* regs = fm->regs;
+  int next = fm->pc + 4;
+  int loaded;
+
+  if (fm->halted || fm->faulted || index < 0) {
+    return -1;
+  }
+
+  ins = &fm->code[index];
+  memset(commit, 0, sizeof(*commit));
+  commit->pc = fm->pc;
+  commit->op = ins->op;
+  commit->rd = -1;
+
+  switch (ins->op) {
+    case OP_MOVC:
+      write_result(fm, commit, ins->rd, ins->imm, 0);
+      break;
+    case OP_ADD:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] + regs[ins->rs2], 1);
+      break;
+    case OP_ADDL:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] + ins->imm, 0);
+      break;
+    case OP_SUB:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] - regs[ins->rs2], 1);
+      break;
+    case OP_SUBL:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] - ins->imm, 0);
+      break;
+    case OP_MUL:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] * regs[ins->rs2], 1);
+      break;
+    case OP_AND:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] & regs[ins->rs2], 0);
+      break;
+    case OP_OR:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] | regs[ins->rs2], 0);
+      break;
+    case OP_EXOR:
+      write_result(fm, commit, ins->rd, regs[ins->rs1] ^ regs[ins->rs2], 0);
+      break;
+    case OP_LOAD:
+    case OP_LDR:
+      commit->memory = 1;
+      commit->address = regs[ins->rs1] +
+                        (ins->op == OP_LOAD ? ins->imm : regs[ins->rs2]);
+      if (datamem_read(fm->data_memory, commit->address, &loaded)) {
+        fm->faulted = 1;
+        fm->fault_address = commit->address;
+        return -1;
+      }
+      write_result(fm, commit, ins->rd, loaded, 0);
+      break;
+    case OP_STORE:
+    case OP_STR:
+      commit->memory = 1;
+      if (ins->op == OP_STORE) {
+        commit->address = regs[ins->rs2] + ins->imm;
+        commit->store_value = regs[ins->rs1];
+      } else {
+        commit->address = regs[ins->rs1] + regs[ins->rs2];
+        commit->store_value = regs[ins->rd];
+      }
+      if (datamem_write(fm->data_memory, commit->address,
+                        commit->store_value)) {
+        fm->faulted = 1;
+        fm->fault_address = commit->address;
+        return -1;
+      }
+      break;
+    case OP_BZ:
+      if (fm->zero_flag) {
+        next = fm->pc + ins->imm;
+      }
+      break;
+    case OP_BNZ:
+      if (!fm->zero_flag) {
+        next = fm->pc + ins->imm;
+      }
+      break;
+    case OP_JUMP:
+      next = regs[ins->rs1] + ins->imm;
+      break;
+    case OP_HALT:
+      fm->halted = 1;
+      break;
+  }
+
+  fm->pc = next;
+  fm->retired++;
+  return 0;
+}
+
+/* Goes on to the instruction of entry next, unless count are done */
+#define DISPATCH(next)                                                         \
+  do {                                                                         \
+    ip = (next);                                                               \
+    if (--left == 0) {                                                         \
+      goto stop;                                                               \
+    }                                                                          \
+    goto *ip->handler;                                                         \
+  } while (0)
+
+/*
+ * The threaded interpreter. Executes up to count instructions from pc and
+ * returns how many it did. With fm NULL only sets labels to its code for
+ * each OP_* and FUNC_OUT, for predecode.
+ *
+ * The zero flag lives in a local while it runs. ip is the entry being
+ * executed, and the pc of the model once it stops
+ */
+static long
+interpret(Func_Model* fm, long count, const void* const** labels)
+{
+  static const void* const handlers[NUM_HANDLERS] = {
+    [OP_MOVC] = &&op_movc,   [OP_STORE] = &&op_store, [OP_STR] = &&op_str,
+    [OP_ADD] = &&op_add,     [OP_ADDL] = &&op_addl,   [OP_SUB] = &&op_sub,
+    [OP_SUBL] = &&op_subl,   [OP_MUL] = &&op_mul,     [OP_LOAD] = &&op_load,
+    [OP_LDR] = &&op_ldr,     [OP_AND] = &&op_and,     [OP_OR] = &&op_or,
+    [OP_EXOR] = &&op_exor,   [OP_BZ] = &&op_bz,       [OP_BNZ] = &&op_bnz,
+    [OP_JUMP] = &&op_jump,   [OP_HALT] = &&op_halt,   [FUNC_OUT] = &&op_out,
+  };
+  Data_Memory* dm;
+  Func_Inst* code;
+  Func_Inst* ip;
+  long left = count;
+  unsigned int address;
+  int zero_flag;
+  int value;
+  int index;
+
+  if (!fm) {
+    *labels = handlers;
+    return 0;
+  }
+
+  index = code_index(fm, fm->pc);
+  if (count <= 0 || fm->halted || fm->faulted || index < 0) {
+    return 0;
+  }
+
+  dm = fm->data_memory;
+  code = fm->threaded;
+  zero_flag = fm->zero_flag;
+  ip = &code[index];
+  goto *ip->handler;
+
+op_movc:
+  *ip->rd = ip->imm;
+  DISPATCH(ip + 1);
+
+op_add:
+  value = *ip->rs1 + *ip->rs2;
+  *ip->rd = value;
+  zero_flag = value == 0;
+  DISPATCH(ip + 1);
+
+op_addl:
+  *ip->rd = *ip->rs1 + ip->imm;
+  DISPATCH(ip + 1);
+
+op_sub:
+  value = *ip->rs1 - *ip->rs2;
+  *ip->rd = value;
+  zero_flag = value == 0;
+  DISPATCH(ip + 1);
+
+op_subl:
+  *ip->rd = *ip->rs1 - ip->imm;
+  DISPATCH(ip + 1);
+
+op_mul:
+  value = *ip->rs1 * *ip->rs2;
+  *ip->rd = value;
+  zero_flag = value == 0;
+  DISPATCH(ip + 1);
+
+op_and:
+  *ip->rd = *ip->rs1 & *ip->rs2;
+  DISPATCH(ip + 1);
+
+op_or:
+  *ip->rd = *ip->rs1 | *ip->rs2;
+  DISPATCH(ip + 1);
+
+op_exor:
+  *ip->rd = *ip->rs1 ^ *ip->rs2;
+  DISPATCH(ip + 1);
+
+op_load:
+  address = *ip->rs1 + ip->imm;
+  if (datamem_read(dm, address, &value)) {
+    goto fault;
+  }
+  *ip->rd = value;
+  DISPATCH(ip + 1);
+
+op_ldr:
+  address = *ip->rs1 + *ip->rs2;
+  if (datamem_read(dm, address, &value)) {
+    goto fault;
+  }
+  *ip->rd = value;
+  DISPATCH(ip + 1);
+
+op_store:
+  address = *ip->rs2 + ip->imm;
+  if (datamem_write(dm, address, *ip->rs1)) {
+    goto fault;
+  }
+  DISPATCH(ip + 1);
+
+op_str:
+  address = *ip->rs1 + *ip->rs2;
+  if (datamem_write(dm, address, *ip->rd)) {
+    goto fault;
+  }
+  DISPATCH(ip + 1);
+
+op_bz:
+  DISPATCH(zero_flag ? ip->target : ip + 1);
+
+op_bnz:
+  DISPATCH(zero_flag ? ip + 1 : ip->target);
+
+op_jump:
+  value = *ip->rs1 + ip->imm;
+  index = code_index(fm, value);
+  if (index < 0) {
+    /* The JUMP is done, there is no instruction to go on to */
+    left--;
+    fm->pc = value;
+    goto done;
+  }
+  DISPATCH(&code[index]);
+
+op_halt:
+  fm->halted = 1;
+  left--;
+  ip++;
+  goto stop;
+
+fault:
+  fm->faulted = 1;
+  fm->fault_address = address;
+  goto stop;
+
+op_out:
+stop:
+  fm->pc = ip->pc;
+done:
+  fm->zero_flag = zero_flag;
+  fm->retired += count - left;
+  return count - left;
+}
+
+/* Returns a monotonic host time in seconds */
+static double
+host_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Executes up to count instructions, in translated code where there is
+ * any and with the threaded interpreter elsewhere.
+ * Returns the instructions executed, fewer than count if the model halted,
+ * faulted or reached a pc with no instruction
+ */
+long
+funcmodel_run(Func_Model* fm, long count)
+{
+  double start = host_time();
+  long left = count;
+
+  if (!fm->jit) {
+    left -= interpret(fm, count, NULL);
+  }
+
+  /* Interprets a block at a time until the translated code takes over */
+  while (fm->jit && left > 0) {
+    long block;
+    long done;
+
+    left -= jit_run(fm->jit, fm, left);
+    block = jit_block_length(fm->jit, fm->pc);
+    done = interpret(fm, block < left ? block : left, NULL);
+    left -= done;
+    if (!done) {
+      break;
+    }
+  }
+
+  fm->host_seconds += host_time() - start;
+  return count - left;
+}
+
+void
+funcmodel_print_stats(const Func_Model* fm)
+{
+  double seconds = fm->host_seconds > 0 ? fm->host_seconds : 1e-9;
+
+  printf("============= Functional Model =============\n");
+  printf("| Instructions          | %ld |\n", fm->retired);
+  printf("| Halted                | %s |\n", fm->halted ? "yes" : "no");
+  printf("| Host time (s)         | %.6f |\n", fm->host_seconds);
+  printf("| Instructions/second   | %.0f |\n", fm->retired / seconds);
+  if (fm->jit) {
+    jit_print_stats(fm->jit);
+  }
+}
+
+static double
+host_seconds(const void* ctx)
+{
+  return ((const Func_Model*)ctx)->host_seconds;
+}
+
+static double
+instructions_per_second(const void* ctx)
+{
+  const Func_Model* fm = ctx;
+
+  return fm->host_seconds > 0 ? fm->retired / fm->host_seconds : 0.0;
+}
+
+void
+funcmodel_register_stats(Func_Model* fm, Stats* stats)
+{
+  stats_group(stats, "func");
+  stats_long(stats, "instructions", &fm->retired,
+             "Instructions run on the functional model");
+  stats_formula(stats, "host_seconds", host_seconds, fm,
+                "Host seconds spent in the functional model");
+  stats_formula(stats, "instructions_per_second", instructions_per_second,
+                fm, "Functional model instructions per host second");
+  if (fm->jit) {
+    jit_register_stats(fm->jit, stats);
+  }
+}
@@ -0,0 +1,24 @@
+#ifndef _APEX_IMAGE_H_
+#define _APEX_IMAGE_H_
+/**
+ *  image.h
+ *  Contains binary images of the data memory and register file.
+ *
+ *  An image is a flat array of 32-bit words in host byte order, word i
+ *  of a memory image holds data address base + i.
+ */
+#include "datamem.h"
+
+int
+image_load_memory(Data_Memory* dm, const char* filename, unsigned long base);
+
+int
+image_save_memory(const Data_Memory* dm, const char* filename);
+
+int
+image_save_words(const char* filename, const int* words, int count);
+
+unsigned long
+image_hash(const Data_Memory* dm, const int* regs, int count);
+
+#endif
@@ -13,18 +13,31 @@
 int
 main(int argc, char const* argv[])
 {
-  /*if (argc != 2) {
-    fprintf(stderr, "APEX_Help : Usage %s <input_file>\n", argv[0]);
+  if (argc < 4) {
+    fprintf(stderr,
+            "APEX_Help : Usage %s <input_file> <display/simulate/functional> <cycles> [options]\n",
+            argv[0]);
+    print_options_help();
     exit(1);
-  }*/
+  }
+
+  APEX_Options opts;
+  set_default_options(&opts);
+  for (int i = 4; i < argc; ++i) {
+    if (parse_option(&opts, argv[i])) {
+      fprintf(stderr, "APEX_Error : Invalid option %s\n", argv[i]);
+      print_options_help();
+      exit(1);
+    }
+  }
 
-  APEX_CPU* cpu = APEX_cpu_init(argv[1]);
+  APEX_CPU* cpu = APEX_cpu_init(argv[1], &opts);
   if (!cpu) {
     fprintf(stderr, "APEX_Error : Unable to initialize CPU\n");
     exit(1);
   }
 
-  APEX_cpu_run(cpu, argv,atoi(argv[3]));
+  int rc = APEX_cpu_run(cpu, argv,atoi(argv[3]));
   APEX_cpu_stop(cpu);
-  return 0;
+  return rc;
 }
\ No newline at end of file
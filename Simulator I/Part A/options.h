@@ -0,0 +1,92 @@
+#ifndef _APEX_OPTIONS_H_
+#define _APEX_OPTIONS_H_
+/**
+ *  options.h
+ *  Contains the simulator options given on the command line after
+ *  <input_file> <display/simulate> <cycles>
+ */
+#include "cache.h"
+#include "checker.h"
+#include "datamem.h"
+#include "memsys.h"
+
+/* Stages Simulator I can resolve BZ, BNZ and JUMP in, RESOLVE_DEFAULT when
+ * --resolve is not given, which is RESOLVE_MEM1
+ */
+enum
+{
+  RESOLVE_DEFAULT,
+  RESOLVE_MEM1,
+  RESOLVE_EX1,
+  RESOLVE_DECODE
+};
+
+typedef struct APEX_Options
+{
+  /* Instruction cache and fetch buffer, I-cache is off when sets is 0 */
+  Cache_Config icache;
+  int fetch_buffer_size;
+
+  /* Data memory hierarchy, every level is off by default */
+  Cache_Config l1d;
+  Cache_Config l2;
+  Dram_Config dram;
+  Prefetch_Config prefetch;
+
+  /* MSHRs of the first data cache level, 0 keeps memory blocking */
+  int mshrs;
+
+  /* Bounds and hugepage regions of the sparse data memory */
+  Data_Memory_Config datamem;
+
+  /* Binary images read before the run and written after it, NULL if unused */
+  const char* mem_in;
+  unsigned long mem_in_base;
+  const char* mem_out;
+  const char* regs_out;
+
+  /* Statistics written as JSON and CSV at the end of the run and on
+   * SIGUSR1, NULL if unused, "-" for stdout
+   */
+  const char* stats_json;
+  const char* stats_csv;
+
+  /* Listing annotated with the per-PC profile, NULL if unused */
+  const char* profile;
+
+  /* Flag to indicate, report the critical path (Simulator II only) */
+  int critpath;
+
+  /* Forwarding paths of Simulator I, NULL for the default of the Part */
+  const char* bypass;
+
+  /* Stage Simulator I resolves branches in, one of RESOLVE_* */
+  int resolve;
+
+  /* Checks the retires against the functional model, one of CHECK_*,
+   * comparing digests every check_interval retires in CHECK_DIGEST
+   */
+  int check;
+  long check_interval;
+
+  /* Instructions run on the functional model before the pipeline starts */
+  long fast_forward;
+  int jit;		// Flag to indicate, the model translates hot blocks
+
+  /* Suppresses the code listing and per cycle stage contents */
+  int quiet;
+
+  /* Cycles between interval reports of the stall breakdown, 0 if none */
+  int interval;
+} APEX_Options;
+
+void
+set_default_options(APEX_Options* opts);
+
+int
+parse_option(APEX_Options* opts, const char* arg);
+
+void
+print_options_help(void);
+
+#endif
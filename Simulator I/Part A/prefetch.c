@@ -0,0 +1,174 @@
+/*
+ *  prefetch.c
+ *  Contains the stride and stream prefetchers.
+ *
+ *  The stride prefetcher is a reference prediction table indexed by the PC
+ *  of the load. Once the same non-zero stride has been seen twice it
+ *  proposes degree lines starting distance strides ahead.
+ *
+ *  The stream prefetcher follows accesses that walk through consecutive
+ *  lines in one direction, whatever their PC, and proposes degree lines
+ *  starting distance lines ahead of the last one touched.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "prefetch.h"
+
+void
+prefetch_init(Prefetcher* pf, const Prefetch_Config* config, int line_size)
+{
+  memset(pf, 0, sizeof(*pf));
+  pf->config = *config;
+  pf->line_size = line_size;
+
+  if (pf->config.degree > PREFETCH_MAX_DEGREE) {
+    pf->config.degree = PREFETCH_MAX_DEGREE;
+  }
+}
+
+int
+prefetch_enabled(const Prefetcher* pf)
+{
+  return (pf->config.stride || pf->config.stream) && pf->line_size > 0;
+}
+
+static int
+train_stride(Prefetcher* pf, int pc, unsigned long address,
+             unsigned long* candidates)
+{
+  Stride_Entry* entry = &pf->stride[(pc / 4) % PREFETCH_STRIDE_ENTRIES];
+  long stride;
+  long step;
+  int n = 0;
+
+  if (!entry->valid || entry->pc != pc) {
+    entry->valid = 1;
+    entry->pc = pc;
+    entry->last_address = address;
+    entry->stride = 0;
+    entry->confidence = 0;
+    return 0;
+  }
+
+  stride = (long)(address - entry->last_address);
+  entry->last_address = address;
+
+  if (stride != 0 && stride == entry->stride) {
+    if (entry->confidence < 3) {
+      entry->confidence++;
+    }
+  } else if (entry->confidence > 0) {
+    entry->confidence--;
+  } else {
+    entry->stride = stride;
+  }
+
+  if (entry->confidence < 2) {
+    return 0;
+  }
+
+  /* Strides within a line would keep proposing the same line */
+  step = entry->stride;
+  if (step > 0 && step < pf->line_size) {
+    step = pf->line_size;
+  } else if (step < 0 && -step < pf->line_size) {
+    step = -pf->line_size;
+  }
+
+  for (int i = 0; i < pf->config.degree; ++i) {
+    candidates[n++] = address + step * (pf->config.distance + i);
+  }
+  return n;
+}
+
+static int
+train_stream(Prefetcher* pf, unsigned long address, unsigned long* candidates)
+{
+  unsigned long line = address / pf->line_size;
+  Stream_Entry* entry = NULL;
+  Stream_Entry* victim = &pf->stream[0];
+  int direction = 0;
+  int n = 0;
+
+  for (int i = 0; i < PREFETCH_STREAMS; ++i) {
+    Stream_Entry* s = &pf->stream[i];
+
+    if (s->valid && line > s->last_line &&
+        line - s->last_line <= PREFETCH_STREAM_WINDOW) {
+      entry = s;
+      direction = 1;
+      break;
+    }
+    if (s->valid && line <= s->last_line &&
+        s->last_line - line <= PREFETCH_STREAM_WINDOW) {
+      entry = s;
+      direction = line == s->last_line ? 0 : -1;
+      break;
+    }
+    if (!s->valid || (victim->valid && s->lru < victim->lru)) {
+      victim = s;
+    }
+  }
+
+  if (!entry) {
+    memset(victim, 0, sizeof(*victim));
+    victim->valid = 1;
+    victim->last_line = line;
+    victim->lru = ++pf->lru_clock;
+    return 0;
+  }
+
+  entry->lru = ++pf->lru_clock;
+
+  /* Repeated accesses to the same line neither train nor trigger */
+  if (direction == 0) {
+    return 0;
+  }
+
+  if (direction == entry->direction) {
+    if (entry->confidence < 3) {
+      entry->confidence++;
+    }
+  } else {
+    entry->direction = direction;
+    entry->confidence = 1;
+  }
+  entry->last_line = line;
+
+  if (entry->confidence < 2) {
+    return 0;
+  }
+
+  for (int i = 0; i < pf->config.degree; ++i) {
+    long ahead = (long)direction * (pf->config.distance + i);
+    candidates[n++] = (line + ahead) * pf->line_size;
+  }
+  return n;
+}
+
+/*
+ * Trains the enabled prefetchers with a load.
+ * Returns the number of addresses stored in candidates, which must hold
+ * 2 * PREFETCH_MAX_DEGREE entries
+ */
+int
+prefetch_train(Prefetcher* pf, int pc, unsigned long address,
+               unsigned long* candidates)
+{
+  int n = 0;
+
+  if (!prefetch_enabled(pf)) {
+    return 0;
+  }
+
+  if (pf->config.stride) {
+    n += train_stride(pf, pc, address, candidates);
+  }
+
+  if (pf->config.stream) {
+    n += train_stream(pf, address, candidates + n);
+  }
+  return n;
+}
@@ -0,0 +1,180 @@
+/*
+ *  profile.c
+ *  Contains the per-PC profile and its annotated listing
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "profile.h"
+
+/* Instructions listed in the summary after the listing */
+#define HOTTEST 5
+
+/* Returns 0 on success, -1 if the counters could not be allocated */
+int
+profile_init(Profile* profile, int size)
+{
+  profile->count = calloc(size, sizeof(*profile->count));
+  profile->size = profile->count ? size : 0;
+  return profile->count ? 0 : -1;
+}
+
+void
+profile_free(Profile* profile)
+{
+  free(profile->count);
+  profile->count = NULL;
+  profile->size = 0;
+}
+
+/* Returns the first code label of the object at pc, NULL if it has none */
+static const char*
+find_label(const Apexo_Object* object, int pc)
+{
+  const Apexo_Header* header = object ? object->header : NULL;
+
+  for (uint32_t i = 0; header && i < header->symbol_count; ++i) {
+    if (object->symbols[i].kind == SYMBOL_CODE &&
+        object->symbols[i].value == pc) {
+      return object->symbols[i].name;
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Writes ins at pc the way apex_as reads it. A BZ or BNZ shows the pc it
+ * branches to, by its label when the object has one there.
+ */
+static void
+format_instruction(char* buf, size_t size, const APEX_Instruction* ins,
+                   int pc, const Apexo_Object* object)
+{
+  const Instruction_Format* format =
+    find_instruction_format(ins->opcode, strlen(ins->opcode));
+  int len = snprintf(buf, size, "%s", ins->opcode);
+
+  for (int i = 0; format && i < format->count && len < (int)size; ++i) {
+    const char* sep = i ? ", " : " ";
+    const char* label;
+
+    switch (format->slot[i]) {
+      case SLOT_RD:
+        len += snprintf(buf + len, size - len, "%sR%d", sep, ins->rd);
+        break;
+      case SLOT_RS1:
+        len += snprintf(buf + len, size - len, "%sR%d", sep, ins->rs1);
+        break;
+      case SLOT_RS2:
+        len += snprintf(buf + len, size - len, "%sR%d", sep, ins->rs2);
+        break;
+      case SLOT_IMM:
+        if (format->op != OP_BZ && format->op != OP_BNZ) {
+          len += snprintf(buf + len, size - len, "%s#%d", sep, ins->imm);
+        } else if ((label = find_label(object, pc + ins->imm))) {
+          len += snprintf(buf + len, size - len, "%s%.*s", sep,
+                          APEXO_SYMBOL_NAME, label);
+        } else {
+          len += snprintf(buf + len, size - len, "%s%d", sep, pc + ins->imm);
+        }
+        break;
+    }
+  }
+}
+
+/* Writes the code labels of the object at pc, if it has any */
+static void
+write_labels(FILE* fp, const Apexo_Object* object, int pc)
+{
+  const Apexo_Header* header = object ? object->header : NULL;
+
+  for (uint32_t i = 0; header && i < header->symbol_count; ++i) {
+    if (object->symbols[i].kind == SYMBOL_CODE &&
+        object->symbols[i].value == pc) {
+      fprintf(fp, "%.*s:\n", APEXO_SYMBOL_NAME, object->symbols[i].name);
+    }
+  }
+}
+
+static void
+write_line(FILE* fp, const long* count, int pc, long cycles,
+           const APEX_Instruction* ins, const Apexo_Object* object)
+{
+  char text[64];
+
+  format_instruction(text, sizeof(text), ins, pc, object);
+  fprintf(fp, "%6d %9ld %6.1f%% %8ld %8ld %8.2f %7ld %8ld    %s\n", pc,
+          count[PROFILE_CYCLES],
+          cycles ? 100.0 * count[PROFILE_CYCLES] / cycles : 0.0,
+          count[PROFILE_STALLS], count[PROFILE_RETIRED],
+          count[PROFILE_COMPLETED]
+            ? (double)count[PROFILE_LATENCY] / count[PROFILE_COMPLETED]
+            : 0.0,
+          count[PROFILE_FLUSHES], count[PROFILE_SQUASHED], text);
+}
+
+/*
+ * Writes the program with the counters of each instruction in front of
+ * it, then the instructions that took the most cycles.
+ * Returns 0 on success, -1 on failure
+ */
+int
+profile_write(const Profile* profile, const char* filename,
+              const APEX_Instruction* code, const Apexo_Object* object,
+              long cycles)
+{
+  int hottest[HOTTEST];
+  int listed = 0;
+  long attributed = 0;
+  FILE* fp = strcmp(filename, "-") == 0 ? stdout : fopen(filename, "w");
+
+  if (!fp) {
+    fprintf(stderr, "APEX_Error : Unable to write %s\n", filename);
+    return -1;
+  }
+
+  fprintf(fp, "; Cycles are charged to the oldest instruction not retired,\n"
+              "; latency is from issue to result, flushes are redirects\n"
+              "; and squashed the younger instructions they threw away\n");
+  fprintf(fp, ";%5s %9s %7s %8s %8s %8s %7s %8s    %s\n", "pc", "cycles",
+          "share", "stalls", "retired", "latency", "flushes", "squashed",
+          "instruction");
+
+  for (int i = 0; i < profile->size; ++i) {
+    const long* count = profile->count[i];
+    int pos = listed < HOTTEST ? listed++ : HOTTEST;
+
+    write_labels(fp, object, 4000 + 4 * i);
+    write_line(fp, count, 4000 + 4 * i, cycles, &code[i], object);
+    attributed += count[PROFILE_CYCLES];
+
+    /* Keep the HOTTEST instructions with the most cycles, most first */
+    while (pos > 0 &&
+           profile->count[hottest[pos - 1]][PROFILE_CYCLES] <
+             count[PROFILE_CYCLES]) {
+      if (pos < HOTTEST) {
+        hottest[pos] = hottest[pos - 1];
+      }
+      pos--;
+    }
+    if (pos < HOTTEST) {
+      hottest[pos] = i;
+    }
+  }
+
+  fprintf(fp, "; %ld of %ld cycles had no instruction in flight or to fetch\n",
+          cycles - attributed, cycles);
+  fprintf(fp, "; Hottest instructions\n");
+  for (int i = 0; i < listed; ++i) {
+    fprintf(fp, ";");
+    write_line(fp, profile->count[hottest[i]], 4000 + 4 * hottest[i], cycles,
+               &code[hottest[i]], object);
+  }
+
+  if (fp == stdout ? fflush(fp) != 0 : fclose(fp) != 0) {
+    fprintf(stderr, "APEX_Error : Unable to write %s\n", filename);
+    return -1;
+  }
+  return 0;
+}
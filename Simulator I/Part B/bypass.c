@@ -0,0 +1,152 @@
+/*
+ *  bypass.c
+ *  Contains the bypass network of the in-order pipeline
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "bypass.h"
+
+static const char* src_names[NUM_BYPASS_SRCS] = {
+  [BYPASS_EX2] = "ex2",
+  [BYPASS_MEM1] = "mem1",
+  [BYPASS_MEM2] = "mem2",
+  [BYPASS_WB] = "wb",
+};
+
+static const char* dst_names[NUM_BYPASS_DSTS] = {
+  [BYPASS_ALU] = "alu",
+  [BYPASS_ADDR] = "addr",
+  [BYPASS_DATA] = "data",
+  [BYPASS_FLAG] = "flag",
+};
+
+/* Returns the index of name of length len in names, -1 if it is not there */
+static int
+find_name(const char* const* names, int count, const char* name, size_t len)
+{
+  for (int i = 0; i < count; ++i) {
+    if (strlen(names[i]) == len && strncmp(names[i], name, len) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/* Parses <src>:<dst>[:<dst>...], dst may be all */
+static int
+parse_path(Bypass* bypass, const char* spec, size_t len)
+{
+  const char* end = spec + len;
+  const char* colon = memchr(spec, ':', len);
+  int src;
+
+  if (!colon) {
+    return -1;
+  }
+  src = find_name(src_names, NUM_BYPASS_SRCS, spec, colon - spec);
+  if (src < 0) {
+    return -1;
+  }
+
+  for (const char* p = colon + 1; p <= end;) {
+    const char* next = memchr(p, ':', end - p);
+    size_t n = (next ? next : end) - p;
+    int dst = find_name(dst_names, NUM_BYPASS_DSTS, p, n);
+
+    if (n == 3 && strncmp(p, "all", 3) == 0) {
+      bypass->path[src] = (1u << NUM_BYPASS_DSTS) - 1;
+    } else if (dst >= 0) {
+      bypass->path[src] |= 1u << dst;
+    } else {
+      return -1;
+    }
+    if (!next) {
+      break;
+    }
+    p = next + 1;
+  }
+  return 0;
+}
+
+/*
+ * Clears the scoreboard and sets the paths from spec: none, all, or a comma
+ * separated list of <src>:<dst>[:<dst>...], "ex2:alu:addr,mem2:all".
+ * Returns 0 on success, -1 if spec is malformed
+ */
+int
+bypass_init(Bypass* bypass, const char* spec)
+{
+  memset(bypass, 0, sizeof(*bypass));
+
+  if (strcmp(spec, "none") == 0) {
+    return 0;
+  }
+
+  if (strcmp(spec, "all") == 0) {
+    for (int i = 0; i < NUM_BYPASS_SRCS; ++i) {
+      bypass->path[i] = (1u << NUM_BYPASS_DSTS) - 1;
+    }
+    return 0;
+  }
+
+  while (*spec) {
+    const char* comma = strchr(spec, ',');
+    size_t len = comma ? (size_t)(comma - spec) : strlen(spec);
+
+    if (parse_path(bypass, spec, len)) {
+      return -1;
+    }
+    spec += len + (comma != NULL);
+  }
+  return 0;
+}
+
+/* Prints the operands each path forwarded, "off" for paths not built */
+void
+bypass_print_stats(const Bypass* bypass)
+{
+  static const char* names[NUM_BYPASS_SRCS] = {
+    [BYPASS_EX2] = "Execute2",
+    [BYPASS_MEM1] = "Memory1",
+    [BYPASS_MEM2] = "Memory2",
+    [BYPASS_WB] = "Writeback",
+  };
+
+  printf("============= Bypass =============\n");
+  printf("| %-21s | ALU | Address | Store data | Zero flag |\n",
+         "Forwarded from");
+  for (int i = 0; i < NUM_BYPASS_SRCS; ++i) {
+    printf("| %-21s |", names[i]);
+    for (int j = 0; j < NUM_BYPASS_DSTS; ++j) {
+      if (bypass_enabled(bypass, i, j)) {
+        printf(" %ld |", bypass->forwarded[i * NUM_BYPASS_DSTS + j]);
+      } else {
+        printf(" off |");
+      }
+    }
+    printf("\n");
+  }
+}
+
+void
+bypass_register_stats(Bypass* bypass, Stats* stats)
+{
+  static char labels[NUM_BYPASS_SRCS * NUM_BYPASS_DSTS][16];
+  static const char* label_names[NUM_BYPASS_SRCS * NUM_BYPASS_DSTS];
+
+  for (int i = 0; i < NUM_BYPASS_SRCS; ++i) {
+    for (int j = 0; j < NUM_BYPASS_DSTS; ++j) {
+      int k = i * NUM_BYPASS_DSTS + j;
+
+      snprintf(labels[k], sizeof(labels[k]), "%s_%s", src_names[i],
+               dst_names[j]);
+      label_names[k] = labels[k];
+    }
+  }
+
+  stats_group(stats, "bypass");
+  stats_vector(stats, "forwarded", bypass->forwarded,
+               NUM_BYPASS_SRCS * NUM_BYPASS_DSTS, label_names,
+               "Operands read through each bypass path");
+}
@@ -0,0 +1,193 @@
+/*
+ *  cache.c
+ *  Contains the set associative cache timing model shared by the
+ *  instruction cache and the data memory hierarchy
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+
+/*
+ * This function creates the tag array of a cache.
+ * Returns 0 on success, -1 on an invalid geometry
+ */
+int
+cache_init(Cache* cache, const Cache_Config* config)
+{
+  memset(cache, 0, sizeof(*cache));
+  cache->config = *config;
+
+  if (config->sets <= 0) {
+    return 0;
+  }
+
+  if (config->ways <= 0 || config->line_size < 4 ||
+      (config->line_size & (config->line_size - 1))) {
+    return -1;
+  }
+
+  while ((1 << cache->offset_bits) < config->line_size) {
+    cache->offset_bits++;
+  }
+
+  cache->lines = calloc((size_t)config->sets * config->ways, sizeof(Cache_Line));
+  if (!cache->lines) {
+    return -1;
+  }
+
+  return 0;
+}
+
+void
+cache_free(Cache* cache)
+{
+  free(cache->lines);
+  cache->lines = NULL;
+}
+
+/* Strips the offset bits from an address */
+unsigned long
+cache_line_address(const Cache* cache, unsigned long address)
+{
+  return address >> cache->offset_bits;
+}
+
+static Cache_Line*
+find_line(const Cache* cache, unsigned long address)
+{
+  unsigned long line = cache_line_address(cache, address);
+  Cache_Line* set = &cache->lines[(line % cache->config.sets) * cache->config.ways];
+
+  for (int i = 0; i < cache->config.ways; ++i) {
+    if (set[i].valid && set[i].tag == line) {
+      return &set[i];
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Checks for a line without touching LRU state or stats
+ */
+int
+cache_probe(const Cache* cache, unsigned long address)
+{
+  return find_line(cache, address) != NULL;
+}
+
+/*
+ * Looks up an address on behalf of the pipeline.
+ * Returns 1 on a hit, 0 on a miss. Misses do not allocate,
+ * the caller fills the line once it has arrived.
+ */
+int
+cache_lookup(Cache* cache, unsigned long address, int is_write)
+{
+  Cache_Line* line = find_line(cache, address);
+
+  cache->accesses++;
+  if (!line) {
+    cache->misses++;
+    return 0;
+  }
+
+  line->lru = ++cache->lru_clock;
+  if (is_write) {
+    line->dirty = 1;
+  }
+  if (line->prefetched) {
+    line->prefetched = 0;
+    cache->prefetch_hits++;
+  }
+  return 1;
+}
+
+/*
+ * Installs the line holding address, replacing the least recently used way.
+ * Returns 1 if a dirty line was evicted, its address is stored in victim
+ */
+int
+cache_fill(Cache* cache, unsigned long address, int is_write,
+           unsigned long* victim)
+{
+  Cache_Line* line = find_line(cache, address);
+  int evicted = 0;
+
+  if (!line) {
+    unsigned long tag = cache_line_address(cache, address);
+    Cache_Line* set = &cache->lines[(tag % cache->config.sets) * cache->config.ways];
+
+    line = &set[0];
+    for (int i = 1; i < cache->config.ways && line->valid; ++i) {
+      if (!set[i].valid || set[i].lru < line->lru) {
+        line = &set[i];
+      }
+    }
+
+    if (line->valid && line->dirty) {
+      evicted = 1;
+      cache->writebacks++;
+      if (victim) {
+        *victim = line->tag << cache->offset_bits;
+      }
+    }
+
+    if (line->valid && line->prefetched) {
+      cache->prefetch_unused++;
+    }
+
+    line->tag = tag;
+    line->valid = 1;
+    line->dirty = 0;
+    line->prefetched = 0;
+  }
+
+  line->lru = ++cache->lru_clock;
+  if (is_write) {
+    line->dirty = 1;
+  }
+  return evicted;
+}
+
+/*
+ * Installs a prefetched line unless it is already present.
+ * Returns 1 if a dirty line was evicted, its address is stored in victim
+ */
+int
+cache_prefetch_fill(Cache* cache, unsigned long address, unsigned long* victim)
+{
+  int evicted;
+
+  if (find_line(cache, address)) {
+    return 0;
+  }
+
+  evicted = cache_fill(cache, address, 0, victim);
+  find_line(cache, address)->prefetched = 1;
+  return evicted;
+}
+
+static double
+miss_rate(const void* ctx)
+{
+  const Cache* cache = ctx;
+
+  return cache->accesses ? (double)cache->misses / cache->accesses : 0.0;
+}
+
+/* Registers the counters of the cache in the current group of stats */
+void
+cache_register_stats(const Cache* cache, Stats* stats)
+{
+  stats_long(stats, "accesses", &cache->accesses, "Demand accesses");
+  stats_long(stats, "misses", &cache->misses, "Demand misses");
+  stats_formula(stats, "miss_rate", miss_rate, cache, "Misses per access");
+  stats_long(stats, "writebacks", &cache->writebacks,
+             "Dirty lines written back");
+  stats_long(stats, "prefetch_hits", &cache->prefetch_hits,
+             "First demand hits on prefetched lines");
+  stats_long(stats, "prefetch_unused", &cache->prefetch_unused,
+             "Prefetched lines evicted before any use");
+}
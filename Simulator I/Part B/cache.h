@@ -0,0 +1,71 @@
+#ifndef _APEX_CACHE_H_
+#define _APEX_CACHE_H_
+/**
+ *  cache.h
+ *  Contains a set associative, LRU replaced cache timing model.
+ *  Only tags are modelled, the data itself stays in code/data memory.
+ */
+#include "stats.h"
+
+/* Geometry and timing of a cache */
+typedef struct Cache_Config
+{
+  int sets;		    // Number of sets, 0 disables the cache
+  int ways;		    // Associativity
+  int line_size;	// Bytes per line
+  int hit_latency;	// Cycles taken by a hit
+  int miss_penalty;	// Extra cycles taken by a miss
+} Cache_Config;
+
+/* Model of a cache line (tag only) */
+typedef struct Cache_Line
+{
+  unsigned long tag;	// Line address stored in this way
+  int valid;		// Flag to indicate, way holds a line
+  int dirty;		// Flag to indicate, line was written
+  int prefetched;	// Flag to indicate, brought in by a prefetch and not yet used
+  long lru;		    // Last access time, smallest is replaced first
+} Cache_Line;
+
+/* Model of a cache */
+typedef struct Cache
+{
+  Cache_Config config;
+  Cache_Line* lines;
+  int offset_bits;
+  long lru_clock;
+
+  /* Some stats */
+  long accesses;
+  long misses;
+  long writebacks;
+  long prefetch_hits;	// First demand hits on prefetched lines
+  long prefetch_unused;	// Prefetched lines evicted before any use
+} Cache;
+
+int
+cache_init(Cache* cache, const Cache_Config* config);
+
+void
+cache_free(Cache* cache);
+
+unsigned long
+cache_line_address(const Cache* cache, unsigned long address);
+
+int
+cache_probe(const Cache* cache, unsigned long address);
+
+int
+cache_lookup(Cache* cache, unsigned long address, int is_write);
+
+int
+cache_fill(Cache* cache, unsigned long address, int is_write,
+           unsigned long* victim);
+
+int
+cache_prefetch_fill(Cache* cache, unsigned long address, unsigned long* victim);
+
+void
+cache_register_stats(const Cache* cache, Stats* stats);
+
+#endif
@@ -0,0 +1,430 @@
+/*
+ *  checker.c
+ *  Contains the co-simulation checker
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "checker.h"
+
+#define FNV_OFFSET 14695981039346656037UL
+#define FNV_PRIME 1099511628211UL
+
+/* Fields of a retire, in the order they are compared */
+enum
+{
+  FIELD_PC,
+  FIELD_OP,
+  FIELD_RD,
+  FIELD_VALUE,
+  FIELD_FLAG,
+  FIELD_ADDRESS,
+  FIELD_STORE,
+  NUM_FIELDS
+};
+
+static const char* field_names[NUM_FIELDS] = {
+  [FIELD_PC] = "PC",
+  [FIELD_OP] = "Instruction",
+  [FIELD_RD] = "Destination",
+  [FIELD_VALUE] = "Result",
+  [FIELD_FLAG] = "Zero flag",
+  [FIELD_ADDRESS] = "Address",
+  [FIELD_STORE] = "Store value",
+};
+
+/*
+ * Sets up the checker and the model for code, lockstep or with a digest
+ * compare every interval retires. The model's data memory is left to the
+ * caller.
+ * Returns 0 on success, -1 if the model or interval could not be allocated
+ */
+int
+checker_init(Checker* checker, int mode, long interval,
+             const APEX_Instruction* code, int size)
+{
+  memset(checker, 0, sizeof(*checker));
+  if (funcmodel_init(&checker->model, code, size, &checker->data_memory)) {
+    return -1;
+  }
+  checker->mode = mode;
+  checker->interval = interval;
+  checker->digest = FNV_OFFSET;
+  checker->model_digest = FNV_OFFSET;
+
+  if (mode == CHECK_DIGEST) {
+    checker->pending = calloc(interval, sizeof(*checker->pending));
+    checker->expected = calloc(interval, sizeof(*checker->expected));
+    if (!checker->pending || !checker->expected) {
+      checker_free(checker);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+void
+checker_free(Checker* checker)
+{
+  funcmodel_free(&checker->model);
+  datamem_free(&checker->data_memory);
+  free(checker->pending);
+  free(checker->expected);
+  checker->pending = NULL;
+  checker->expected = NULL;
+}
+
+/* FNV-1a taking a whole word per step, as the state hash does */
+static unsigned long
+hash_word(unsigned long hash, unsigned int word)
+{
+  return (hash ^ word) * FNV_PRIME;
+}
+
+/* Folds the fields of a retire that are compared into hash */
+static unsigned long
+fold(unsigned long hash, const Func_Commit* commit)
+{
+  hash = hash_word(hash, commit->pc);
+  hash = hash_word(hash, commit->op);
+  if (commit->rd >= 0) {
+    hash = hash_word(hash, commit->rd);
+    hash = hash_word(hash, commit->value);
+  }
+  if (commit->sets_flag) {
+    hash = hash_word(hash, commit->zero_flag);
+  }
+  if (commit->memory) {
+    hash = hash_word(hash, commit->address);
+  }
+  if (commit->op == OP_STORE || commit->op == OP_STR) {
+    hash = hash_word(hash, commit->store_value);
+  }
+  return hash;
+}
+
+/* Returns the first FIELD_* two retires differ in, NUM_FIELDS if none */
+static int
+first_difference(const Func_Commit* a, const Func_Commit* b)
+{
+  if (a->pc != b->pc) {
+    return FIELD_PC;
+  }
+  if (a->op != b->op) {
+    return FIELD_OP;
+  }
+  if (a->rd != b->rd) {
+    return FIELD_RD;
+  }
+  if (a->rd >= 0 && a->value != b->value) {
+    return FIELD_VALUE;
+  }
+  if (a->sets_flag != b->sets_flag ||
+      (a->sets_flag && a->zero_flag != b->zero_flag)) {
+    return FIELD_FLAG;
+  }
+  if (a->memory != b->memory || (a->memory && a->address != b->address)) {
+    return FIELD_ADDRESS;
+  }
+  if ((a->op == OP_STORE || a->op == OP_STR) &&
+      a->store_value != b->store_value) {
+    return FIELD_STORE;
+  }
+  return NUM_FIELDS;
+}
+
+/* Writes field of a retire as text, - when the instruction has none */
+static void
+field_text(const Func_Commit* commit, int field, char* text, size_t size)
+{
+  int store = commit->op == OP_STORE || commit->op == OP_STR;
+
+  snprintf(text, size, "-");
+  switch (field) {
+    case FIELD_PC:
+      snprintf(text, size, "%d", commit->pc);
+      break;
+    case FIELD_OP:
+      snprintf(text, size, "%s", opcode_name(commit->op));
+      break;
+    case FIELD_RD:
+      if (commit->rd >= 0) {
+        snprintf(text, size, "R%d", commit->rd);
+      }
+      break;
+    case FIELD_VALUE:
+      if (commit->rd >= 0) {
+        snprintf(text, size, "%d", commit->value);
+      }
+      break;
+    case FIELD_FLAG:
+      if (commit->sets_flag) {
+        snprintf(text, size, "%d", commit->zero_flag);
+      }
+      break;
+    case FIELD_ADDRESS:
+      if (commit->memory) {
+        snprintf(text, size, "%u", commit->address);
+      }
+      break;
+    case FIELD_STORE:
+      if (store) {
+        snprintf(text, size, "%d", commit->store_value);
+      }
+      break;
+  }
+}
+
+/* Reports retire number retire, where the pipeline and model first
+ * differ in field
+ */
+static void
+report(Checker* checker, long retire, const Func_Commit* pipeline,
+       const Func_Commit* model, int field)
+{
+  checker->diverged = retire;
+  fprintf(stderr,
+          "APEX_Error : Retire %ld at pc %d differs from the model in %s\n",
+          retire, pipeline->pc, field_names[field]);
+
+  printf("============= Divergence =============\n");
+  printf("| %-21s | %ld |\n", "Retire", retire);
+  printf("| %-21s | Pipeline | Model |\n", "Field");
+  for (int i = 0; i < NUM_FIELDS; ++i) {
+    char a[32];
+    char b[32];
+
+    field_text(pipeline, i, a, sizeof(a));
+    field_text(model, i, b, sizeof(b));
+    printf("| %-21s | %s | %s |%s\n", field_names[i], a, b,
+           i == field ? " <" : "");
+  }
+}
+
+/* Reports retire number retire, which the model had no instruction for */
+static void
+report_missing(Checker* checker, long retire, const Func_Commit* pipeline)
+{
+  const Func_Model* fm = &checker->model;
+
+  checker->diverged = retire;
+  if (fm->halted) {
+    fprintf(stderr,
+            "APEX_Error : Retire %ld at pc %d is past the model's HALT\n",
+            retire, pipeline->pc);
+  } else if (fm->faulted) {
+    fprintf(stderr,
+            "APEX_Error : Retire %ld at pc %d, the model faulted at "
+            "address %u\n",
+            retire, pipeline->pc, fm->fault_address);
+  } else {
+    fprintf(stderr,
+            "APEX_Error : Retire %ld at pc %d, the model has no instruction "
+            "at pc %d\n",
+            retire, pipeline->pc, fm->pc);
+  }
+}
+
+/*
+ * Runs the model over the retires of the interval and compares the
+ * digests. Only when they differ are the retires compared one by one, to
+ * find the first that differs
+ */
+static void
+catch_up(Checker* checker)
+{
+  long first = checker->retires - checker->count + 1;
+  long done = 0;
+
+  while (done < checker->count &&
+         !funcmodel_step(&checker->model, &checker->expected[done])) {
+    checker->model_digest =
+      fold(checker->model_digest, &checker->expected[done]);
+    done++;
+  }
+  checker->compares++;
+
+  if (done < checker->count || checker->digest != checker->model_digest) {
+    long i;
+
+    for (i = 0; i < done; ++i) {
+      int field =
+        first_difference(&checker->pending[i], &checker->expected[i]);
+
+      if (field != NUM_FIELDS) {
+        report(checker, first + i, &checker->pending[i],
+               &checker->expected[i], field);
+        break;
+      }
+    }
+    if (i == done && done < checker->count) {
+      report_missing(checker, first + done, &checker->pending[done]);
+    }
+  }
+  checker->count = 0;
+}
+
+/*
+ * Checks an instruction the pipeline retired against the model.
+ * Returns 0 if they match so far, -1 once they have diverged
+ */
+int
+checker_retire(Checker* checker, const Func_Commit* commit)
+{
+  Func_Commit expected;
+  int field;
+
+  if (checker->mode == CHECK_OFF || checker->diverged) {
+    return checker->diverged ? -1 : 0;
+  }
+
+  checker->retires++;
+  checker->digest = fold(checker->digest, commit);
+
+  if (checker->mode == CHECK_DIGEST) {
+    checker->pending[checker->count++] = *commit;
+    if (checker->count == checker->interval) {
+      catch_up(checker);
+    }
+    return checker->diverged ? -1 : 0;
+  }
+
+  if (funcmodel_step(&checker->model, &expected)) {
+    report_missing(checker, checker->retires, commit);
+    return -1;
+  }
+  checker->model_digest = fold(checker->model_digest, &expected);
+
+  field = first_difference(commit, &expected);
+  if (field != NUM_FIELDS) {
+    report(checker, checker->retires, commit, &expected, field);
+    return -1;
+  }
+  return 0;
+}
+
+/* Finds the first address two data memories hold different words at.
+ * Returns 1 if there is one, 0 if they are the same
+ */
+static int
+memory_difference(const Data_Memory* a, const Data_Memory* b,
+                  unsigned long* address)
+{
+  for (unsigned long d = 0; d < (1UL << DATAMEM_DIR_BITS); ++d) {
+    if (!a->directory[d] && !b->directory[d]) {
+      continue;
+    }
+    for (unsigned long t = 0; t < (1UL << DATAMEM_TABLE_BITS); ++t) {
+      const int* pa = a->directory[d] ? a->directory[d][t] : NULL;
+      const int* pb = b->directory[d] ? b->directory[d][t] : NULL;
+      unsigned long base = ((d << DATAMEM_TABLE_BITS) + t)
+                           << DATAMEM_PAGE_BITS;
+
+      for (unsigned long w = 0; pa != pb && w < DATAMEM_PAGE_WORDS; ++w) {
+        if ((pa ? pa[w] : 0) != (pb ? pb[w] : 0)) {
+          *address = base + w;
+          return 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+ * Compares the rest of the interval, then the final registers and zero
+ * flag of the pipeline with the model's, and data memory dm as well if
+ * the pipeline halted. A run stopped by the cycle limit or a fault may
+ * have stores in flight, so its memory is not compared.
+ * Returns 0 if everything matched, -1 if the run diverged anywhere
+ */
+int
+checker_finish(Checker* checker, const int* regs, int zero_flag,
+               const Data_Memory* dm, int halted)
+{
+  const Func_Model* fm = &checker->model;
+  unsigned long address;
+
+  if (checker->mode == CHECK_OFF) {
+    return 0;
+  }
+  if (checker->count && !checker->diverged) {
+    catch_up(checker);
+  }
+  if (checker->diverged) {
+    return -1;
+  }
+
+  for (int i = 0; i < ISA_REGS; ++i) {
+    if (regs[i] != fm->regs[i]) {
+      fprintf(stderr, "APEX_Error : Final R%d is %d, the model has %d\n", i,
+              regs[i], fm->regs[i]);
+      checker->final_diverged = 1;
+      return -1;
+    }
+  }
+
+  if (zero_flag != fm->zero_flag) {
+    fprintf(stderr, "APEX_Error : Final zero flag is %d, the model has %d\n",
+            zero_flag, fm->zero_flag);
+    checker->final_diverged = 1;
+    return -1;
+  }
+
+  if (halted && memory_difference(dm, fm->data_memory, &address)) {
+    fprintf(stderr, "APEX_Error : Final MEM[%lu] is %d, the model has %d\n",
+            address, datamem_peek(dm, address),
+            datamem_peek(fm->data_memory, address));
+    checker->final_diverged = 1;
+    return -1;
+  }
+  return 0;
+}
+
+void
+checker_print_stats(const Checker* checker)
+{
+  if (checker->mode == CHECK_OFF) {
+    return;
+  }
+
+  printf("============= Co-simulation =============\n");
+  if (checker->mode == CHECK_LOCKSTEP) {
+    printf("| Mode                  | lockstep |\n");
+  } else {
+    printf("| Mode                  | digest every %ld retires |\n",
+           checker->interval);
+    printf("| Digests compared      | %ld |\n", checker->compares);
+  }
+  printf("| Retires checked       | %ld |\n", checker->retires);
+  printf("| Digest                | %016lx |\n", checker->digest);
+  if (checker->diverged) {
+    printf("| Diverged at retire    | %ld |\n", checker->diverged);
+  } else if (checker->final_diverged) {
+    printf("| Result                | final state differs |\n");
+  } else {
+    printf("| Result                | match |\n");
+  }
+}
+
+void
+checker_register_stats(Checker* checker, Stats* stats)
+{
+  if (checker->mode == CHECK_OFF) {
+    return;
+  }
+
+  stats_group(stats, "check");
+  stats_long(stats, "retires", &checker->retires,
+             "Retires checked against the functional model");
+  stats_long(stats, "compares", &checker->compares,
+             "Digests compared, in digest mode");
+  stats_hash(stats, "digest", &checker->digest,
+             "Rolling hash of the retires checked");
+  stats_long(stats, "diverged", &checker->diverged,
+             "Retire the pipeline first differed from the model in, 0 if "
+             "none");
+  stats_int(stats, "final_diverged", &checker->final_diverged,
+            "Final state differed from the model");
+}
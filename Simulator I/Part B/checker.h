@@ -0,0 +1,71 @@
+#ifndef _APEX_CHECKER_H_
+#define _APEX_CHECKER_H_
+/**
+ *  checker.h
+ *  Contains the co-simulation checker. The functional model runs the same
+ *  program next to the pipeline and every instruction the pipeline retires
+ *  is matched against the one the model executes.
+ *
+ *  In lockstep mode the model executes each instruction as the pipeline
+ *  retires it and the two are compared field by field. In digest mode the
+ *  retires of both are only folded into rolling hashes; the model catches
+ *  up every interval retires and the hashes are compared then. Both modes
+ *  report the first retire that differs, digest mode up to an interval
+ *  after it happened. When the run ends the registers and zero flag are
+ *  compared, and the data memory too if the pipeline halted.
+ */
+#include "funcmodel.h"
+#include "stats.h"
+
+enum
+{
+  CHECK_OFF,
+  CHECK_LOCKSTEP,
+  CHECK_DIGEST
+};
+
+/* Retires between digest compares when --check=digest gives none */
+#define CHECK_DIGEST_INTERVAL 1024
+
+/* Model of the checker, off when mode is CHECK_OFF */
+typedef struct Checker
+{
+  int mode;
+  long interval;	// Retires between digest compares
+  Func_Model model;
+  Data_Memory data_memory;	// The model's, set up by the caller
+
+  /* Retires of the current interval, digest mode */
+  Func_Commit* pending;	// As the pipeline retired them
+  Func_Commit* expected;	// As the model executed them
+  long count;
+
+  long retires;		// Pipeline retires checked
+  long compares;	// Digests compared
+  unsigned long digest;	// Rolling hash of the pipeline retires
+  unsigned long model_digest;	// ... of the model's
+  long diverged;	// Retire the first difference was in, 0 if none
+  int final_diverged;	// Flag to indicate, the final state differed
+} Checker;
+
+int
+checker_init(Checker* checker, int mode, long interval,
+             const APEX_Instruction* code, int size);
+
+void
+checker_free(Checker* checker);
+
+int
+checker_retire(Checker* checker, const Func_Commit* commit);
+
+int
+checker_finish(Checker* checker, const int* regs, int zero_flag,
+               const Data_Memory* dm, int halted);
+
+void
+checker_print_stats(const Checker* checker);
+
+void
+checker_register_stats(Checker* checker, Stats* stats);
+
+#endif
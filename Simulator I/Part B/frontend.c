@@ -0,0 +1,149 @@
+/*
+ *  frontend.c
+ *  Contains the instruction cache and fetch buffer model.
+ *
+ *  The fetch buffer holds a run of sequential instructions [start_pc, end_pc).
+ *  Each cycle it is refilled from the I-cache one line at a time, Fetch
+ *  consumes from its head. Any PC outside the buffer is a redirect and
+ *  flushes it.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frontend.h"
+
+int
+frontend_init(Frontend* fe, const Cache_Config* icache, int buffer_size,
+              int pc)
+{
+  memset(fe, 0, sizeof(*fe));
+  fe->buffer_size = buffer_size;
+  fe->start_pc = pc;
+  fe->end_pc = pc;
+  return cache_init(&fe->icache, icache);
+}
+
+void
+frontend_free(Frontend* fe)
+{
+  cache_free(&fe->icache);
+}
+
+/* Extends the buffer up to the end of the line holding end_pc */
+static void
+append_line(Frontend* fe)
+{
+  int line_size = fe->icache.config.line_size;
+  int line_end = (fe->end_pc / line_size + 1) * line_size;
+  int limit = fe->start_pc + fe->buffer_size * 4;
+
+  fe->end_pc = line_end < limit ? line_end : limit;
+}
+
+/* Sends a missing line to the L2/DRAM, retried while the hierarchy is full */
+static void
+request_line(Frontend* fe, MemSys* ms, long clock)
+{
+  fe->fill_request = memsys_request(ms, fe->end_pc, MEM_IFETCH, clock);
+  if (!fe->fill_request) {
+    fe->fill_request = -1;
+  }
+}
+
+/*
+ * Advances the fetch buffer by one cycle.
+ * Returns 1 if the instruction at pc can be handed to Decode this cycle
+ */
+int
+frontend_fetch(Frontend* fe, MemSys* ms, int pc, long clock)
+{
+  if (!fe->icache.config.sets) {
+    return 1;
+  }
+
+  if (pc < fe->start_pc || pc > fe->end_pc) {
+    if (fe->fill_pending && fe->fill_request > 0) {
+      memsys_cancel(ms, fe->fill_request);
+    }
+    fe->start_pc = pc;
+    fe->end_pc = pc;
+    fe->fill_pending = 0;
+    fe->fill_request = 0;
+    fe->redirects++;
+  } else {
+    fe->start_pc = pc;
+  }
+
+  if (fe->fill_pending) {
+    int arrived;
+
+    if (fe->fill_request < 0) {
+      request_line(fe, ms, clock);
+      arrived = 0;
+    } else if (fe->fill_request > 0) {
+      arrived = memsys_done(ms, fe->fill_request, clock);
+    } else {
+      arrived = clock >= fe->fill_ready;
+    }
+
+    if (arrived) {
+      cache_fill(&fe->icache, fe->end_pc, 0, NULL);
+      append_line(fe);
+      fe->fill_pending = 0;
+      fe->fill_request = 0;
+    }
+  }
+
+  if (!fe->fill_pending && fe->end_pc - fe->start_pc < fe->buffer_size * 4) {
+    long ready = clock + fe->icache.config.hit_latency - 1;
+
+    if (cache_lookup(&fe->icache, fe->end_pc, 0)) {
+      if (ready <= clock) {
+        cache_fill(&fe->icache, fe->end_pc, 0, NULL);
+        append_line(fe);
+      } else {
+        fe->fill_pending = 1;
+        fe->fill_ready = ready;
+      }
+    } else if (memsys_backend_enabled(ms)) {
+      /* Missing lines come from the L2 shared with the data side */
+      fe->fill_pending = 1;
+      request_line(fe, ms, clock);
+    } else {
+      fe->fill_pending = 1;
+      fe->fill_ready = ready + fe->icache.config.miss_penalty;
+    }
+  }
+
+  return pc < fe->end_pc;
+}
+
+void
+frontend_print_stats(const Frontend* fe)
+{
+  if (!fe->icache.config.sets) {
+    return;
+  }
+
+  printf("============= Frontend =============\n");
+  printf("| I-cache accesses      | %ld |\n", fe->icache.accesses);
+  printf("| I-cache misses        | %ld |\n", fe->icache.misses);
+  printf("| Fetch buffer redirects| %ld |\n", fe->redirects);
+  printf("| Frontend stall cycles | %ld |\n", fe->stall_cycles);
+}
+
+void
+frontend_register_stats(const Frontend* fe, Stats* stats)
+{
+  stats_group(stats, "frontend");
+  stats_long(stats, "stall_cycles", &fe->stall_cycles,
+             "Cycles Fetch had nothing to hand to Decode");
+  stats_long(stats, "redirects", &fe->redirects,
+             "Fetch buffer flushes due to a changed PC");
+
+  if (fe->icache.config.sets) {
+    stats_group(stats, "frontend.icache");
+    cache_register_stats(&fe->icache, stats);
+  }
+}
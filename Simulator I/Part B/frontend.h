@@ -0,0 +1,42 @@
+#ifndef _APEX_FRONTEND_H_
+#define _APEX_FRONTEND_H_
+/**
+ *  frontend.h
+ *  Contains the instruction cache and fetch buffer model used by fetch()
+ */
+#include "cache.h"
+#include "memsys.h"
+
+/* Model of the fetch buffer sitting between I-cache and Fetch stage */
+typedef struct Frontend
+{
+  Cache icache;
+  int buffer_size;	// Instructions held by the fetch buffer
+  int start_pc;		// First buffered instruction
+  int end_pc;		// Address after the last buffered instruction
+  int fill_pending;	// Flag to indicate, an I-cache miss is outstanding
+  long fill_ready;	// Cycle the outstanding line arrives
+  int fill_request;	// L2/DRAM access for the outstanding line, -1 to retry
+
+  /* Some stats */
+  long stall_cycles;	// Cycles Fetch had nothing to hand to Decode
+  long redirects;	    // Fetch buffer flushes due to a changed PC
+} Frontend;
+
+int
+frontend_init(Frontend* fe, const Cache_Config* icache, int buffer_size,
+              int pc);
+
+void
+frontend_free(Frontend* fe);
+
+int
+frontend_fetch(Frontend* fe, MemSys* ms, int pc, long clock);
+
+void
+frontend_print_stats(const Frontend* fe);
+
+void
+frontend_register_stats(const Frontend* fe, Stats* stats);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef _APEX_FUNCMODEL_H_
+#define _APEX_FUNCMODEL_H_
+/**
+ *  funcmodel.h
+ *  Contains the functional model of the instruction set. It executes the
+ *  program with no notion of cycles, on registers of its own and a data
+ *  memory it is given. funcmodel_step executes one instruction and tells
+ *  what it changed, the pipelines are checked against it.
+ *  funcmodel_run executes many as fast as it can, for the functional mode
+ *  and --fast-forward.
+ *
+ *  funcmodel_run is a threaded interpreter. The program is predecoded once
+ *  into Func_Inst entries holding the address of the code for their opcode
+ *  (GCC labels as values) and pointers to the registers they use, so each
+ *  instruction ends in an indirect jump straight to the next one's code,
+ *  with no decode and no central switch. A taken BZ or BNZ goes to its
+ *  target's entry directly, only JUMP looks its target up. With
+ *  funcmodel_use_jit the blocks that get hot are translated to host code
+ *  instead (jit.c), and only the rest is interpreted.
+ */
+#include "datamem.h"
+#include "isa.h"
+#include "stats.h"
+
+/* Architectural effects of one instruction, as it retires */
+typedef struct Func_Commit
+{
+  int pc;
+  int op;		// Operation Code, one of OP_*
+  int rd;		// Register written, -1 if none
+  int value;		// Value written to rd
+  int sets_flag;	// Flag to indicate, it set the zero flag
+  int zero_flag;	// Zero flag it set
+  int memory;		// Flag to indicate, it read or wrote address
+  unsigned int address;
+  int store_value;	// Value STORE or STR wrote to address
+} Func_Commit;
+
+/* Instruction predecoded for the threaded interpreter */
+typedef struct Func_Inst
+{
+  const void* handler;	// Label of the code executing it
+  int* rd;		// Registers it names, in Func_Model regs
+  const int* rs1;
+  const int* rs2;
+  int imm;
+  int pc;
+  struct Func_Inst* target;	// Taken BZ or BNZ goes on here
+} Func_Inst;
+
+/* Model of the architectural state. regs are pointed to by the threaded
+ * code, so the model must not move once it is set up
+ */
+typedef struct Func_Model
+{
+  const APEX_Instruction* code;
+  int code_size;
+
+  int pc;
+  int regs[ISA_REGS];
+  int zero_flag;
+  Data_Memory* data_memory;
+
+  /* Threaded code, one entry per instruction, then an entry for falling
+   * off the end and one for each branch target outside code memory
+   */
+  Func_Inst* threaded;
+  struct Jit* jit;	// Translator of hot blocks, NULL to only interpret
+
+  int halted;		// Flag to indicate, HALT has executed
+  int faulted;		// Flag to indicate, an access faulted
+  unsigned int fault_address;
+  long retired;		// Instructions executed
+  double host_seconds;	// Host time spent in funcmodel_run
+} Func_Model;
+
+int
+funcmodel_init(Func_Model* fm, const APEX_Instruction* code, int size,
+               Data_Memory* dm);
+
+void
+funcmodel_free(Func_Model* fm);
+
+int
+funcmodel_use_jit(Func_Model* fm);
+
+int
+funcmodel_step(Func_Model* fm, Func_Commit* commit);
+
+long
+funcmodel_run(Func_Model* fm, long count);
+
+void
+funcmodel_print_stats(const Func_Model* fm);
+
+void
+funcmodel_register_stats(Func_Model* fm, Stats* stats);
+
+#endif
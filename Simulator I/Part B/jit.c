@@ -0,0 +1,894 @@
+/*
+ *  jit.c
+ *  Contains the translator of the functional model to x86-64
+ */
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "jit.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+
+/* Host registers, by their encoding */
+enum
+{
+  RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+  R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+/* Condition codes of Jcc */
+enum
+{
+  CC_S = 0x8,
+  CC_AE = 0x3,
+  CC_E = 0x4,
+  CC_NE = 0x5,
+  CC_L = 0xC
+};
+
+/*
+ * Translated code keeps the model in RBX and the instructions it may still
+ * execute in RBP. RAX, RCX and RDX are scratch, the others hold registers
+ * of the program, the ones enter saves first as helpers keep them too
+ */
+static const int host_regs[] = {
+  R12, R13, R14, R15, RSI, RDI, R8, R9, R10, R11
+};
+#define HOST_REGS (int)(sizeof(host_regs) / sizeof(host_regs[0]))
+
+/* Where an operand is, a host register or the model at RBX + disp */
+typedef struct Loc
+{
+  int reg;		// Host register, -1 for memory
+  int disp;
+} Loc;
+
+/* A load or store whose fast path missed, completed by a helper */
+typedef struct Slow_Path
+{
+  int k;		// Instruction in the block
+  int store;		// Flag to indicate, it is a STORE or STR
+  Loc value;		// What a store writes
+  int miss[2];		// Offsets of the rel32 jumping here, -1 if none
+  int resume;		// Offset the fast path goes on at
+  unsigned int dirty;	// Program registers in host registers, changed
+} Slow_Path;
+
+/* A block being translated */
+typedef struct Block
+{
+  unsigned char* p;	// Next byte to write
+  int host[ISA_REGS];	// Host register of each program one, -1 if none
+  unsigned int dirty;
+  Slow_Path slow[JIT_MAX_BLOCK];
+  int slow_count;
+} Block;
+
+#define REG_DISP(r) (int)(offsetof(Func_Model, regs) + 4 * (r))
+#define FIELD(f) field_loc(offsetof(Func_Model, f))
+
+static Loc
+reg_loc(int reg)
+{
+  Loc loc = { reg, 0 };
+
+  return loc;
+}
+
+static Loc
+field_loc(size_t disp)
+{
+  Loc loc = { -1, (int)disp };
+
+  return loc;
+}
+
+/* Returns where program register r is in block b */
+static Loc
+operand(const Block* b, int r)
+{
+  return b->host[r] >= 0 ? reg_loc(b->host[r]) : field_loc(REG_DISP(r));
+}
+
+static void
+emit8(Block* b, unsigned int byte)
+{
+  *b->p++ = byte;
+}
+
+static void
+emit32(Block* b, uint32_t value)
+{
+  memcpy(b->p, &value, 4);
+  b->p += 4;
+}
+
+static void
+emit64(Block* b, uint64_t value)
+{
+  memcpy(b->p, &value, 8);
+  b->p += 8;
+}
+
+/* Emits op, one or two bytes, with ModRM for register or extension r and
+ * operand rm, 64-bit if wide
+ */
+static void
+emit_rm(Block* b, int wide, unsigned int op, int r, Loc rm)
+{
+  int rex = 0x40 | (wide ? 8 : 0) | (r & 8 ? 4 : 0) | (rm.reg >= 8 ? 1 : 0);
+
+  if (rex != 0x40) {
+    emit8(b, rex);
+  }
+  if (op > 0xff) {
+    emit8(b, op >> 8);
+  }
+  emit8(b, op & 0xff);
+  if (rm.reg >= 0) {
+    emit8(b, 0xC0 | (r & 7) << 3 | (rm.reg & 7));
+  } else {
+    emit8(b, 0x80 | (r & 7) << 3 | RBX);
+    emit32(b, rm.disp);
+  }
+}
+
+/* mov r32, rm */
+static void
+emit_load(Block* b, int r, Loc rm)
+{
+  if (rm.reg != r) {
+    emit_rm(b, 0, 0x8B, r, rm);
+  }
+}
+
+/* mov rm, r32 */
+static void
+emit_store(Block* b, Loc rm, int r)
+{
+  if (rm.reg != r) {
+    emit_rm(b, 0, 0x89, r, rm);
+  }
+}
+
+/* op rm, imm32 with op the extension of 0x81, or mov rm, imm32 */
+static void
+emit_imm(Block* b, int wide, int ext, Loc rm, int imm)
+{
+  emit_rm(b, wide, ext < 0 ? 0xC7 : 0x81, ext < 0 ? 0 : ext, rm);
+  emit32(b, imm);
+}
+
+/* Emits a jump, on condition cc or always if cc is -1, with its rel32 to
+ * be patched. Returns the offset of the rel32 in the buffer
+ */
+static int
+emit_jump(Block* b, const Jit* jit, int cc)
+{
+  if (cc < 0) {
+    emit8(b, 0xE9);
+  } else {
+    emit8(b, 0x0F);
+    emit8(b, 0x80 | cc);
+  }
+  emit32(b, 0);
+  return (int)(b->p - jit->buffer) - 4;
+}
+
+/* Points the rel32 at offset of the buffer to target */
+static void
+patch(const Jit* jit, int offset, const void* target)
+{
+  int32_t rel = (int32_t)((const unsigned char*)target -
+                          (jit->buffer + offset + 4));
+
+  memcpy(jit->buffer + offset, &rel, 4);
+}
+
+static void
+emit_jump_to(Block* b, const Jit* jit, int cc, const void* target)
+{
+  patch(jit, emit_jump(b, jit, cc), target);
+}
+
+static void
+emit_push(Block* b, int reg)
+{
+  if (reg >= 8) {
+    emit8(b, 0x41);
+  }
+  emit8(b, 0x50 | (reg & 7));
+}
+
+static void
+emit_pop(Block* b, int reg)
+{
+  if (reg >= 8) {
+    emit8(b, 0x41);
+  }
+  emit8(b, 0x58 | (reg & 7));
+}
+
+/* Stores the program registers of mask from their host registers */
+static void
+emit_writeback(Block* b, unsigned int mask)
+{
+  for (int r = 0; r < ISA_REGS; ++r) {
+    if (mask & 1U << r) {
+      emit_store(b, field_loc(REG_DISP(r)), b->host[r]);
+    }
+  }
+}
+
+/* Leaves translated code with the model at pc */
+static void
+emit_leave(Block* b, const Jit* jit, int pc)
+{
+  emit_imm(b, 0, -1, FIELD(pc), pc);
+  emit_jump_to(b, jit, -1, jit->leave);
+}
+
+/* Returns the code index of pc, -1 if no instruction is there */
+static int
+code_index(const Jit* jit, int pc)
+{
+  unsigned int offset = (unsigned int)(pc - 4000);
+
+  if (offset % 4 || offset / 4 >= (unsigned int)jit->code_size) {
+    return -1;
+  }
+  return offset / 4;
+}
+
+/* Goes on to pc, through a jump patched once its block is translated */
+static void
+emit_exit(Block* b, Jit* jit, int pc)
+{
+  int target = code_index(jit, pc);
+
+  if (target >= 0 && jit->cache[target]) {
+    emit_jump_to(b, jit, -1, jit->cache[target]);
+    jit->chained++;
+    return;
+  }
+
+  if (target >= 0) {
+    int offset = emit_jump(b, jit, -1);
+
+    patch(jit, offset, b->p);
+    if (jit->exit_count == jit->exit_capacity) {
+      int capacity = jit->exit_capacity ? 2 * jit->exit_capacity : 64;
+      Jit_Exit* exits = realloc(jit->exits, capacity * sizeof(*exits));
+
+      if (!exits) {
+        /* It can still leave through the code below */
+        emit_leave(b, jit, pc);
+        return;
+      }
+      jit->exits = exits;
+      jit->exit_capacity = capacity;
+    }
+    jit->exits[jit->exit_count].offset = offset;
+    jit->exits[jit->exit_count].target = target;
+    jit->exit_count++;
+  }
+  emit_leave(b, jit, pc);
+}
+
+/* Helpers of the slow paths, which fault as funcmodel_step does */
+static long
+jit_load(Func_Model* fm, unsigned int address)
+{
+  int value;
+
+  if (datamem_read(fm->data_memory, address, &value)) {
+    fm->faulted = 1;
+    fm->fault_address = address;
+    return -1;
+  }
+  return (unsigned int)value;
+}
+
+static long
+jit_store(Func_Model* fm, unsigned int address, int value)
+{
+  if (datamem_write(fm->data_memory, address, value)) {
+    fm->faulted = 1;
+    fm->fault_address = address;
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * Emits the access of instruction k to the data address in EAX, a load
+ * into EAX or a store of value. Pages in the software TLB are accessed in
+ * line, counting the hit; anything else goes to the helper
+ */
+static void
+emit_access(Block* b, const Jit* jit, const Func_Model* fm, int k, int store,
+            Loc value)
+{
+  unsigned long limit = fm->data_memory->config.limit;
+  Slow_Path* slow = &b->slow[b->slow_count++];
+  int tlb = offsetof(Data_Memory, tlb);
+
+  slow->k = k;
+  slow->store = store;
+  slow->value = value;
+  slow->miss[0] = -1;
+  slow->dirty = b->dirty;
+
+  if (limit && limit <= 0xFFFFFFFFUL) {
+    emit_imm(b, 0, 7, reg_loc(RAX), (int)limit);
+    slow->miss[0] = emit_jump(b, jit, CC_AE);
+  }
+
+  emit8(b, 0x89), emit8(b, 0xC1);	// mov ecx, eax
+  emit8(b, 0xC1), emit8(b, 0xE9), emit8(b, DATAMEM_PAGE_BITS);	// shr ecx
+  emit8(b, 0x89), emit8(b, 0xCA);	// mov edx, ecx
+  emit8(b, 0x83), emit8(b, 0xE2), emit8(b, DATAMEM_TLB_ENTRIES - 1);
+  emit8(b, 0xC1), emit8(b, 0xE2), emit8(b, 4);	// shl edx, 4
+  emit_rm(b, 1, 0x03, RDX, FIELD(data_memory));	// add rdx, dm
+  emit8(b, 0xFF), emit8(b, 0xC1);	// inc ecx, the tag
+  emit8(b, 0x39), emit8(b, 0x8A);	// cmp [rdx + tag], ecx
+  emit32(b, tlb + offsetof(Datamem_Tlb_Entry, tag));
+  slow->miss[1] = emit_jump(b, jit, CC_NE);
+  emit8(b, 0x48), emit8(b, 0x8B), emit8(b, 0x92);	// mov rdx, [rdx + page]
+  emit32(b, tlb + offsetof(Datamem_Tlb_Entry, page));
+  emit8(b, 0x25);			// and eax, page offset
+  emit32(b, DATAMEM_PAGE_WORDS - 1);
+  if (store) {
+    emit_load(b, RCX, value);
+    emit8(b, 0x89), emit8(b, 0x0C), emit8(b, 0x82);	// mov [rdx+rax*4], ecx
+  } else {
+    emit8(b, 0x8B), emit8(b, 0x04), emit8(b, 0x82);	// mov eax, [rdx+rax*4]
+  }
+  emit_rm(b, 1, 0x8B, RCX, FIELD(data_memory));
+  emit8(b, 0x48), emit8(b, 0xFF), emit8(b, 0x81);	// inc qword [rcx + hits]
+  emit32(b, offsetof(Data_Memory, tlb_hits));
+
+  slow->resume = (int)(b->p - jit->buffer);
+}
+
+/* Emits the slow path of an access, and the way out if it faults */
+static void
+emit_slow_path(Block* b, const Jit* jit, const Slow_Path* slow, int pc,
+               int len)
+{
+  int saved[HOST_REGS];
+  int count = 0;
+  int fault;
+
+  for (int i = 0; i < 2; ++i) {
+    if (slow->miss[i] >= 0) {
+      patch(jit, slow->miss[i], b->p);
+    }
+  }
+
+  /* Helpers may change RSI, RDI and R8 to R11 */
+  for (int r = 0; r < ISA_REGS; ++r) {
+    if (b->host[r] == RSI || b->host[r] == RDI ||
+        (b->host[r] >= R8 && b->host[r] <= R11)) {
+      saved[count++] = b->host[r];
+      emit_push(b, b->host[r]);
+    }
+  }
+  if (count % 2) {
+    emit8(b, 0x48), emit8(b, 0x83), emit8(b, 0xEC), emit8(b, 8);
+  }
+
+  if (slow->store) {
+    emit_load(b, RDX, slow->value);
+  }
+  emit8(b, 0x89), emit8(b, 0xC6);	// mov esi, eax
+  emit8(b, 0x48), emit8(b, 0x89), emit8(b, 0xDF);	// mov rdi, rbx
+  emit8(b, 0x48), emit8(b, 0xB8);	// mov rax, helper
+  emit64(b, (uint64_t)(uintptr_t)(slow->store ? (void*)jit_store
+                                               : (void*)jit_load));
+  emit8(b, 0xFF), emit8(b, 0xD0);	// call rax
+
+  if (count % 2) {
+    emit8(b, 0x48), emit8(b, 0x83), emit8(b, 0xC4), emit8(b, 8);
+  }
+  while (count) {
+    emit_pop(b, saved[--count]);
+  }
+
+  emit8(b, 0x48), emit8(b, 0x85), emit8(b, 0xC0);	// test rax, rax
+  fault = emit_jump(b, jit, CC_S);
+  emit_jump_to(b, jit, -1, jit->buffer + slow->resume);
+
+  /* The access is not done, nor the rest of the block */
+  patch(jit, fault, b->p);
+  emit_writeback(b, slow->dirty);
+  emit_imm(b, 1, 0, reg_loc(RBP), len - slow->k);
+  emit_leave(b, jit, pc);
+}
+
+/* Returns the registers instruction ins reads and, in writes, writes */
+static unsigned int
+reads(const APEX_Instruction* ins, unsigned int* writes)
+{
+  *writes = 0;
+  switch (ins->op) {
+    case OP_MOVC:
+      *writes = 1U << ins->rd;
+      return 0;
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_AND:
+    case OP_OR:
+    case OP_EXOR:
+    case OP_LDR:
+      *writes = 1U << ins->rd;
+      return 1U << ins->rs1 | 1U << ins->rs2;
+    case OP_ADDL:
+    case OP_SUBL:
+    case OP_LOAD:
+      *writes = 1U << ins->rd;
+      return 1U << ins->rs1;
+    case OP_STORE:
+      return 1U << ins->rs1 | 1U << ins->rs2;
+    case OP_STR:
+      return 1U << ins->rd | 1U << ins->rs1 | 1U << ins->rs2;
+    case OP_JUMP:
+      return 1U << ins->rs1;
+  }
+  return 0;
+}
+
+/* Gives the program registers block b uses most host registers, and
+ * returns the ones it reads before writing
+ */
+static unsigned int
+allocate(Block* b, const APEX_Instruction* code, int len)
+{
+  int uses[ISA_REGS] = { 0 };
+  unsigned int live = 0;
+  unsigned int written = 0;
+
+  for (int k = 0; k < len; ++k) {
+    unsigned int writes;
+    unsigned int read = reads(&code[k], &writes);
+
+    live |= read & ~written;
+    written |= writes;
+    for (int r = 0; r < ISA_REGS; ++r) {
+      uses[r] += (read >> r & 1) + (writes >> r & 1);
+    }
+  }
+
+  for (int r = 0; r < ISA_REGS; ++r) {
+    b->host[r] = -1;
+  }
+  for (int i = 0; i < HOST_REGS; ++i) {
+    int best = -1;
+
+    for (int r = 0; r < ISA_REGS; ++r) {
+      if (b->host[r] < 0 && uses[r] && (best < 0 || uses[r] > uses[best])) {
+        best = r;
+      }
+    }
+    if (best < 0) {
+      break;
+    }
+    b->host[best] = host_regs[i];
+  }
+  return live;
+}
+
+/* Emits a register to register operation of instruction ins, op one of
+ * add, sub, and, or, xor or imul r32, rm
+ */
+static void
+emit_alu(Block* b, const APEX_Instruction* ins, unsigned int op)
+{
+  emit_load(b, RAX, operand(b, ins->rs1));
+  emit_rm(b, 0, op, RAX, operand(b, ins->rs2));
+}
+
+/* Stores EAX to rd, and the zero flag with it if sets_flag */
+static void
+emit_result(Block* b, const APEX_Instruction* ins, int sets_flag)
+{
+  emit_store(b, operand(b, ins->rd), RAX);
+  if (b->host[ins->rd] >= 0) {
+    b->dirty |= 1U << ins->rd;
+  }
+  if (sets_flag) {
+    emit8(b, 0x31), emit8(b, 0xC9);	// xor ecx, ecx
+    emit8(b, 0x85), emit8(b, 0xC0);	// test eax, eax
+    emit8(b, 0x0F), emit8(b, 0x94), emit8(b, 0xC1);	// sete cl
+    emit_store(b, FIELD(zero_flag), RCX);
+  }
+}
+
+/* Returns the instructions of the block at code index index */
+static int
+block_length(Jit* jit, int index)
+{
+  int len = 0;
+
+  if (jit->length[index]) {
+    return jit->length[index];
+  }
+
+  while (index + len < jit->code_size && len < JIT_MAX_BLOCK) {
+    int op = jit->code[index + len++].op;
+
+    if (op == OP_BZ || op == OP_BNZ || op == OP_JUMP || op == OP_HALT) {
+      break;
+    }
+  }
+  jit->length[index] = len;
+  return len;
+}
+
+/*
+ * Translates the block at code index index, for model fm.
+ * Returns its code, NULL if there was no room
+ */
+static const void*
+translate(Jit* jit, const Func_Model* fm, int index)
+{
+  const APEX_Instruction* code = &jit->code[index];
+  int len = block_length(jit, index);
+  int pc = 4000 + 4 * index;
+  unsigned char* entry = jit->buffer + jit->used;
+  Block block;
+  Block* b = &block;
+  unsigned int live;
+  int budget;
+
+  /* Bytes a block of len instructions may take, with room to spare */
+  if (jit->used + 512 + 512 * (size_t)len > JIT_BUFFER_BYTES) {
+    return NULL;
+  }
+
+  b->p = entry;
+  b->dirty = 0;
+  b->slow_count = 0;
+  live = allocate(b, code, len);
+  jit->cache[index] = entry;
+
+  /* Stop before the block unless all of it may run */
+  emit_imm(b, 1, 7, reg_loc(RBP), len);
+  budget = emit_jump(b, jit, CC_L);
+  emit_imm(b, 1, 5, reg_loc(RBP), len);
+  for (int r = 0; r < ISA_REGS; ++r) {
+    if (b->host[r] >= 0 && live & 1U << r) {
+      emit_load(b, b->host[r], field_loc(REG_DISP(r)));
+    }
+  }
+
+  for (int k = 0; k < len; ++k) {
+    const APEX_Instruction* ins = &code[k];
+    int ins_pc = pc + 4 * k;
+    int taken;
+
+    switch (ins->op) {
+      case OP_MOVC:
+        emit_imm(b, 0, -1, operand(b, ins->rd), ins->imm);
+        if (b->host[ins->rd] >= 0) {
+          b->dirty |= 1U << ins->rd;
+        }
+        break;
+      case OP_ADD:
+        emit_alu(b, ins, 0x03);
+        emit_result(b, ins, 1);
+        break;
+      case OP_SUB:
+        emit_alu(b, ins, 0x2B);
+        emit_result(b, ins, 1);
+        break;
+      case OP_MUL:
+        emit_alu(b, ins, 0x0FAF);
+        emit_result(b, ins, 1);
+        break;
+      case OP_AND:
+        emit_alu(b, ins, 0x23);
+        emit_result(b, ins, 0);
+        break;
+      case OP_OR:
+        emit_alu(b, ins, 0x0B);
+        emit_result(b, ins, 0);
+        break;
+      case OP_EXOR:
+        emit_alu(b, ins, 0x33);
+        emit_result(b, ins, 0);
+        break;
+      case OP_ADDL:
+      case OP_SUBL:
+        emit_load(b, RAX, operand(b, ins->rs1));
+        emit_imm(b, 0, ins->op == OP_ADDL ? 0 : 5, reg_loc(RAX), ins->imm);
+        emit_result(b, ins, 0);
+        break;
+      case OP_LOAD:
+      case OP_LDR:
+        emit_load(b, RAX, operand(b, ins->rs1));
+        if (ins->op == OP_LOAD) {
+          emit_imm(b, 0, 0, reg_loc(RAX), ins->imm);
+        } else {
+          emit_rm(b, 0, 0x03, RAX, operand(b, ins->rs2));
+        }
+        emit_access(b, jit, fm, k, 0, reg_loc(RAX));
+        emit_result(b, ins, 0);
+        break;
+      case OP_STORE:
+        emit_load(b, RAX, operand(b, ins->rs2));
+        emit_imm(b, 0, 0, reg_loc(RAX), ins->imm);
+        emit_access(b, jit, fm, k, 1, operand(b, ins->rs1));
+        break;
+      case OP_STR:
+        emit_load(b, RAX, operand(b, ins->rs1));
+        emit_rm(b, 0, 0x03, RAX, operand(b, ins->rs2));
+        emit_access(b, jit, fm, k, 1, operand(b, ins->rd));
+        break;
+      case OP_BZ:
+      case OP_BNZ:
+        emit_writeback(b, b->dirty);
+        emit_imm(b, 0, 7, FIELD(zero_flag), 0);
+        taken = emit_jump(b, jit, ins->op == OP_BZ ? CC_NE : CC_E);
+        emit_exit(b, jit, ins_pc + 4);
+        patch(jit, taken, b->p);
+        emit_exit(b, jit, ins_pc + ins->imm);
+        break;
+      case OP_JUMP:
+        emit_load(b, RAX, operand(b, ins->rs1));
+        emit_imm(b, 0, 0, reg_loc(RAX), ins->imm);
+        emit_writeback(b, b->dirty);
+        emit_store(b, FIELD(pc), RAX);
+        /* Looks the target up in the cache, leaving if it is not there */
+        emit8(b, 0x89), emit8(b, 0xC1);	// mov ecx, eax
+        emit_imm(b, 0, 5, reg_loc(RCX), 4000);
+        emit8(b, 0xF6), emit8(b, 0xC1), emit8(b, 3);	// test cl, 3
+        emit_jump_to(b, jit, CC_NE, jit->leave);
+        emit8(b, 0xC1), emit8(b, 0xE9), emit8(b, 2);	// shr ecx, 2
+        emit_imm(b, 0, 7, reg_loc(RCX), jit->code_size);
+        emit_jump_to(b, jit, CC_AE, jit->leave);
+        emit8(b, 0x48), emit8(b, 0xBA);	// mov rdx, cache
+        emit64(b, (uint64_t)(uintptr_t)jit->cache);
+        emit8(b, 0x48), emit8(b, 0x8B), emit8(b, 0x14), emit8(b, 0xCA);
+        emit8(b, 0x48), emit8(b, 0x85), emit8(b, 0xD2);	// test rdx, rdx
+        emit_jump_to(b, jit, CC_E, jit->leave);
+        emit8(b, 0xFF), emit8(b, 0xE2);	// jmp rdx
+        break;
+      case OP_HALT:
+        emit_writeback(b, b->dirty);
+        emit_imm(b, 0, -1, FIELD(halted), 1);
+        emit_leave(b, jit, ins_pc + 4);
+        break;
+    }
+  }
+
+  /* The block ran into its longest or the end of code memory */
+  if (code[len - 1].op != OP_BZ && code[len - 1].op != OP_BNZ &&
+      code[len - 1].op != OP_JUMP && code[len - 1].op != OP_HALT) {
+    emit_writeback(b, b->dirty);
+    emit_exit(b, jit, pc + 4 * len);
+  }
+
+  patch(jit, budget, b->p);
+  emit_leave(b, jit, pc);
+
+  for (int i = 0; i < b->slow_count; ++i) {
+    emit_slow_path(b, jit, &b->slow[i], pc + 4 * b->slow[i].k, len);
+  }
+
+  jit->used = b->p - jit->buffer;
+  jit->blocks++;
+
+  /* Blocks translated before can now jump here */
+  for (int i = 0; i < jit->exit_count; ++i) {
+    if (jit->exits[i].target == index) {
+      patch(jit, jit->exits[i].offset, entry);
+      jit->chained++;
+      jit->exits[i--] = jit->exits[--jit->exit_count];
+    }
+  }
+  return entry;
+}
+
+/* Emits enter, which saves the host registers translated code uses and
+ * jumps to a block, and leave, which returns the count left
+ */
+static void
+emit_entry_exit(Jit* jit)
+{
+  static const int saved[] = { RBX, RBP, R12, R13, R14, R15 };
+  Block block;
+  Block* b = &block;
+
+  b->p = jit->buffer;
+  jit->enter = (long (*)(Func_Model*, const void*, long))(void*)b->p;
+  for (int i = 0; i < 6; ++i) {
+    emit_push(b, saved[i]);
+  }
+  emit8(b, 0x48), emit8(b, 0x83), emit8(b, 0xEC), emit8(b, 8);	// align
+  emit8(b, 0x48), emit8(b, 0x89), emit8(b, 0xFB);	// mov rbx, rdi
+  emit8(b, 0x48), emit8(b, 0x89), emit8(b, 0xD5);	// mov rbp, rdx
+  emit8(b, 0xFF), emit8(b, 0xE6);	// jmp rsi
+
+  jit->leave = b->p;
+  emit8(b, 0x48), emit8(b, 0x89), emit8(b, 0xE8);	// mov rax, rbp
+  emit8(b, 0x48), emit8(b, 0x83), emit8(b, 0xC4), emit8(b, 8);
+  for (int i = 5; i >= 0; --i) {
+    emit_pop(b, saved[i]);
+  }
+  emit8(b, 0xC3);
+
+  jit->base = jit->used = b->p - jit->buffer;
+}
+
+/*
+ * Sets up the translator for the program in code.
+ * Returns 0 on success, -1 if the host can not run translated code
+ */
+int
+jit_init(Jit* jit, const APEX_Instruction* code, int size)
+{
+  memset(jit, 0, sizeof(*jit));
+  jit->code = code;
+  jit->code_size = size;
+
+  /* The TLB entries are indexed by shifting */
+  if (sizeof(Datamem_Tlb_Entry) != 16 || size <= 0) {
+    return -1;
+  }
+
+  jit->buffer = mmap(NULL, JIT_BUFFER_BYTES,
+                     PROT_READ | PROT_WRITE | PROT_EXEC,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (jit->buffer == MAP_FAILED) {
+    jit->buffer = NULL;
+    return -1;
+  }
+
+  jit->cache = calloc(size, sizeof(*jit->cache));
+  jit->heat = calloc(size, sizeof(*jit->heat));
+  jit->length = calloc(size, sizeof(*jit->length));
+  if (!jit->cache || !jit->heat || !jit->length) {
+    jit_free(jit);
+    return -1;
+  }
+
+  emit_entry_exit(jit);
+  return 0;
+}
+
+/*
+ * Runs translated code from the pc of fm for up to count instructions,
+ * translating blocks as they get hot. Returns the instructions executed;
+ * the caller interprets from the pc it stops at, which is a block not hot
+ * yet or one longer than the count left
+ */
+long
+jit_run(Jit* jit, Func_Model* fm, long count)
+{
+  long left = count;
+
+  while (left > 0 && !fm->halted && !fm->faulted) {
+    int index = code_index(jit, fm->pc);
+    const void* block;
+    long done;
+
+    if (index < 0) {
+      break;
+    }
+
+    block = jit->cache[index];
+    if (!block) {
+      if (++jit->heat[index] < JIT_HOT) {
+        break;
+      }
+      block = translate(jit, fm, index);
+      if (!block) {
+        jit_flush(jit);
+        block = translate(jit, fm, index);
+        if (!block) {
+          break;
+        }
+      }
+    }
+
+    done = left - jit->enter(fm, block, left);
+    left -= done;
+    if (!done) {
+      break;
+    }
+  }
+
+  jit->instructions += count - left;
+  fm->retired += count - left;
+  return count - left;
+}
+
+#else
+
+int
+jit_init(Jit* jit, const APEX_Instruction* code, int size)
+{
+  memset(jit, 0, sizeof(*jit));
+  jit->code = code;
+  jit->code_size = size;
+  return -1;
+}
+
+long
+jit_run(Jit* jit, Func_Model* fm, long count)
+{
+  return 0;
+}
+
+static int
+block_length(Jit* jit, int index)
+{
+  return 1;
+}
+
+#endif
+
+void
+jit_free(Jit* jit)
+{
+  if (jit->buffer) {
+    munmap(jit->buffer, JIT_BUFFER_BYTES);
+  }
+  free(jit->cache);
+  free(jit->heat);
+  free(jit->length);
+  free(jit->exits);
+  memset(jit, 0, sizeof(*jit));
+}
+
+/* Drops every translation */
+void
+jit_flush(Jit* jit)
+{
+  if (jit->cache) {
+    memset(jit->cache, 0, jit->code_size * sizeof(*jit->cache));
+  }
+  jit->used = jit->base;
+  jit->exit_count = 0;
+  jit->flushes++;
+}
+
+/* Returns the instructions of the block at pc, 1 if pc is outside code */
+int
+jit_block_length(Jit* jit, int pc)
+{
+  unsigned int offset = (unsigned int)(pc - 4000);
+
+  if (offset % 4 || offset / 4 >= (unsigned int)jit->code_size) {
+    return 1;
+  }
+  return block_length(jit, offset / 4);
+}
+
+void
+jit_print_stats(const Jit* jit)
+{
+  printf("| JIT blocks            | %ld |\n", jit->blocks);
+  printf("| JIT chained exits     | %ld |\n", jit->chained);
+  printf("| JIT flushes           | %ld |\n", jit->flushes);
+  printf("| JIT instructions      | %ld |\n", jit->instructions);
+}
+
+void
+jit_register_stats(Jit* jit, Stats* stats)
+{
+  stats_long(stats, "jit_blocks", &jit->blocks, "Blocks translated");
+  stats_long(stats, "jit_chained", &jit->chained,
+             "Exits of translated blocks jumping straight to another");
+  stats_long(stats, "jit_flushes", &jit->flushes,
+             "Times every translation was dropped to make room");
+  stats_long(stats, "jit_instructions", &jit->instructions,
+             "Instructions run in translated code");
+}
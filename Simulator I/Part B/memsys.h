@@ -0,0 +1,161 @@
+#ifndef _APEX_MEMSYS_H_
+#define _APEX_MEMSYS_H_
+/**
+ *  memsys.h
+ *  Contains the data memory hierarchy timing model: L1 D-cache, an L2
+ *  shared with the I-cache, and a DRAM controller with banks, row buffers
+ *  and an FR-FCFS scheduled request queue.
+ *
+ *  The model only decides when an access completes, values are still read
+ *  from and written to data_memory by the pipeline.
+ */
+#include "cache.h"
+#include "prefetch.h"
+
+/* Outstanding accesses the hierarchy can track at once */
+#define MEMSYS_MAX_REQUESTS 64
+
+/* Data addresses live apart from code addresses in the shared L2 */
+#define MEMSYS_DATA_SPACE (1UL << 40)
+
+enum
+{
+  MEM_READ,
+  MEM_WRITE,
+  MEM_IFETCH
+};
+
+/* Geometry and timing of the DRAM */
+typedef struct Dram_Config
+{
+  int banks;		    // Number of banks, 0 disables the DRAM model
+  int row_size;		// Bytes per row buffer
+  int t_cas;		    // Column access, cycles for a row buffer hit
+  int t_rcd;		    // Row activate
+  int t_rp;		    // Precharge
+  int t_burst;		// Data bus cycles per line
+  int queue_size;	// Request queue entries
+  int closed_page;	// Flag to indicate, rows are closed after every access
+} Dram_Config;
+
+/* Model of a DRAM request queue entry */
+typedef struct Dram_Request
+{
+  int valid;
+  unsigned long address;
+  int bank;
+  int row;
+  int is_write;
+  long arrival;		// Cycle the request reached the controller
+  int request;		// Hierarchy request waiting on it, 0 for writebacks
+} Dram_Request;
+
+/* Model of a DRAM bank */
+typedef struct Dram_Bank
+{
+  int open_row;		// Row in the row buffer, -1 when precharged
+  long ready;		    // Cycle the bank can take the next command
+} Dram_Bank;
+
+/* Model of the DRAM controller */
+typedef struct Dram
+{
+  Dram_Config config;
+  Dram_Request* queue;
+  int queue_capacity;
+  int count;
+  Dram_Bank* bank;
+  long bus_ready;
+
+  /* Some stats */
+  long reads;
+  long writes;
+  long row_hits;
+  long row_misses;
+  long row_conflicts;
+  long queue_full;
+  long queue_delay;
+  long service_time;
+} Dram;
+
+/* Model of an access travelling through the hierarchy */
+typedef struct Mem_Request
+{
+  int valid;
+  unsigned long address;
+  int kind;
+  int fill_l1;		    // Flag to indicate, L1 D-cache missed
+  int fill_l2;		    // Flag to indicate, L2 missed
+  int waiting_dram;	// Flag to indicate, not yet returned by DRAM
+  int done;		    // Flag to indicate, lines have been filled
+  int orphan;		    // Flag to indicate, requester no longer waits on it
+  int prefetch;		    // Flag to indicate, started by the prefetcher
+  int miss;		    // Flag to indicate, missed the first data cache level
+  int primary;		    // Miss this access merged into, 0 if none
+  long issued;		    // Cycle the pipeline made the access
+  long ready;		    // Cycle the access completes
+} Mem_Request;
+
+/* Model of the memory hierarchy */
+typedef struct MemSys
+{
+  Cache l1d;
+  Cache l2;
+  Dram dram;
+  Prefetcher prefetcher;
+  int mshrs;		    // Outstanding data misses allowed, 0 for no limit
+  Mem_Request request[MEMSYS_MAX_REQUESTS];
+
+  /* Some stats */
+  long accesses;
+  long total_latency;
+  long max_latency;
+  long prefetch_issued;
+  long prefetch_dropped;	// Proposed lines refused for lack of resources
+  long prefetch_late;		// Demand accesses that caught their prefetch in flight
+  long mshr_merged;		// Secondary misses merged into an outstanding miss
+  long mshr_full;		// Accesses refused because every MSHR was busy
+  long miss_cycles;		// Cycles with at least one demand miss outstanding
+  long misses_outstanding;	// Sum of demand misses outstanding over those cycles
+  Stat_Dist latency;		// Cycles from access to completion of demand accesses
+} MemSys;
+
+int
+memsys_init(MemSys* ms, const Cache_Config* l1d, const Cache_Config* l2,
+            const Dram_Config* dram, const Prefetch_Config* prefetch,
+            int mshrs);
+
+void
+memsys_free(MemSys* ms);
+
+int
+memsys_enabled(const MemSys* ms);
+
+int
+memsys_backend_enabled(const MemSys* ms);
+
+unsigned long
+memsys_data_address(int mem_address);
+
+int
+memsys_request(MemSys* ms, unsigned long address, int kind, long clock);
+
+int
+memsys_done(MemSys* ms, int handle, long clock);
+
+void
+memsys_cancel(MemSys* ms, int handle);
+
+void
+memsys_prefetch_train(MemSys* ms, int pc, unsigned long address, long clock);
+
+void
+memsys_tick(MemSys* ms, long clock);
+
+void
+memsys_print_stats(const MemSys* ms);
+
+void
+memsys_register_stats(const MemSys* ms, Stats* stats);
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef _APEX_OBJECT_H_
+#define _APEX_OBJECT_H_
+/**
+ *  object.h
+ *  Contains the .apexo object format written by apex_as and loaded by
+ *  the simulators.
+ *
+ *  An object is a header, the code as an array of APEX_Instruction, an
+ *  optional data segment of 32-bit words and an optional symbol table.
+ *  Everything is in host byte order and the code is laid out exactly as
+ *  code memory, so a simulator maps the file and runs from it directly.
+ */
+#include <stdint.h>
+
+#include "isa.h"
+
+#define APEXO_MAGIC "APEXOBJ"
+#define APEXO_VERSION 1
+
+/* Longest symbol name, with its terminating NUL */
+#define APEXO_SYMBOL_NAME 24
+
+enum
+{
+  SYMBOL_CODE,		// Value is the pc of an instruction
+  SYMBOL_DATA,		// Value is a data address
+  SYMBOL_CONST		// Value is a constant
+};
+
+typedef struct Apexo_Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t instruction_size;	// sizeof(APEX_Instruction) of the writer
+  uint32_t code_offset;		// Byte offsets from the start of the file
+  uint32_t code_count;
+  uint32_t data_offset;
+  uint32_t data_count;
+  uint32_t data_base;		// Data address of the first data word
+  uint32_t symbol_offset;
+  uint32_t symbol_count;
+  uint32_t reserved;
+} Apexo_Header;
+
+typedef struct Apexo_Symbol
+{
+  char name[APEXO_SYMBOL_NAME];
+  int32_t value;
+  int32_t kind;
+} Apexo_Symbol;
+
+/* A mapped object */
+typedef struct Apexo_Object
+{
+  void* map;
+  size_t size;
+  const Apexo_Header* header;
+  APEX_Instruction* code;
+  const int32_t* data;
+  const Apexo_Symbol* symbols;
+} Apexo_Object;
+
+int
+object_open(Apexo_Object* object, const char* filename);
+
+void
+object_close(Apexo_Object* object);
+
+void
+object_free_code(Apexo_Object* object, APEX_Instruction* code);
+
+int
+object_write(const char* filename, const APEX_Instruction* code,
+             int code_count, const int32_t* data, int data_count,
+             uint32_t data_base, const Apexo_Symbol* symbols,
+             int symbol_count);
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ *  options.c
+ *  Contains functions to parse simulator options
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "options.h"
+
+void
+set_default_options(APEX_Options* opts)
+{
+  memset(opts, 0, sizeof(*opts));
+  opts->fetch_buffer_size = 4;
+
+  opts->dram.row_size = 2048;
+  opts->dram.t_cas = 11;
+  opts->dram.t_rcd = 11;
+  opts->dram.t_rp = 11;
+  opts->dram.t_burst = 4;
+  opts->dram.queue_size = 16;
+
+  opts->prefetch.degree = 2;
+  opts->prefetch.distance = 2;
+
+  opts->jit = 1;
+}
+
+/* Returns the text after "name=" if arg is that option */
+static const char*
+option_value(const char* arg, const char* name)
+{
+  size_t len = strlen(name);
+
+  if (strncmp(arg, name, len) == 0 && arg[len] == '=') {
+    return arg + len + 1;
+  }
+  return NULL;
+}
+
+/* Parses <sets>:<ways>:<line size>[:<hit latency>[:<miss penalty>]] */
+static int
+parse_cache_config(const char* value, Cache_Config* config)
+{
+  int n = sscanf(value, "%d:%d:%d:%d:%d", &config->sets, &config->ways,
+                 &config->line_size, &config->hit_latency,
+                 &config->miss_penalty);
+  if (n < 3) {
+    return -1;
+  }
+  if (n < 4) {
+    config->hit_latency = 1;
+  }
+  if (n < 5) {
+    config->miss_penalty = 10;
+  }
+  return 0;
+}
+
+/* Parses <banks>:<row size>[:<tCAS>:<tRCD>:<tRP>[:<burst>]] */
+static int
+parse_dram_config(const char* value, Dram_Config* config)
+{
+  int n = sscanf(value, "%d:%d:%d:%d:%d:%d", &config->banks,
+                 &config->row_size, &config->t_cas, &config->t_rcd,
+                 &config->t_rp, &config->t_burst);
+  if (n < 2 || n == 3 || n == 4 || config->banks <= 0 ||
+      config->row_size <= 0) {
+    return -1;
+  }
+  return 0;
+}
+
+/* Parses stride|stream|both[:<degree>[:<distance>]] */
+static int
+parse_prefetch_config(const char* value, Prefetch_Config* config)
+{
+  char kind[16];
+  int n = sscanf(value, "%15[a-z]:%d:%d", kind, &config->degree,
+                 &config->distance);
+
+  if (n < 1 || config->degree <= 0 || config->distance <= 0) {
+    return -1;
+  }
+
+  config->stride = strcmp(kind, "stride") == 0 || strcmp(kind, "both") == 0;
+  config->stream = strcmp(kind, "stream") == 0 || strcmp(kind, "both") == 0;
+  return config->stride || config->stream ? 0 : -1;
+}
+
+/* Parses <base>:<size> in data addresses, either may be hexadecimal */
+static int
+parse_huge_region(const char* value, Data_Memory_Config* config)
+{
+  Huge_Region* region;
+  char* end;
+
+  if (config->huge_count == DATAMEM_MAX_HUGE) {
+    return -1;
+  }
+  region = &config->huge[config->huge_count];
+
+  region->base = strtoul(value, &end, 0);
+  if (*end != ':') {
+    return -1;
+  }
+  region->size = strtoul(end + 1, &end, 0);
+  if (*end != '\0' || region->size == 0) {
+    return -1;
+  }
+
+  config->huge_count++;
+  return 0;
+}
+
+/*
+ * Applies a single "--name=value" or "--flag" option.
+ * Returns 0 on success, -1 if the option is unknown or malformed
+ */
+int
+parse_option(APEX_Options* opts, const char* arg)
+{
+  const char* value;
+
+  if (strcmp(arg, "--quiet") == 0) {
+    opts->quiet = 1;
+    return 0;
+  }
+
+  if (strcmp(arg, "--critpath") == 0) {
+    opts->critpath = 1;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--icache"))) {
+    return parse_cache_config(value, &opts->icache);
+  }
+
+  if ((value = option_value(arg, "--fetch-buffer"))) {
+    opts->fetch_buffer_size = atoi(value);
+    return opts->fetch_buffer_size > 0 ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--l1d"))) {
+    return parse_cache_config(value, &opts->l1d);
+  }
+
+  if ((value = option_value(arg, "--l2"))) {
+    return parse_cache_config(value, &opts->l2);
+  }
+
+  if ((value = option_value(arg, "--dram"))) {
+    return parse_dram_config(value, &opts->dram);
+  }
+
+  if ((value = option_value(arg, "--dram-queue"))) {
+    opts->dram.queue_size = atoi(value);
+    return opts->dram.queue_size > 0 ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--prefetch"))) {
+    return parse_prefetch_config(value, &opts->prefetch);
+  }
+
+  if ((value = option_value(arg, "--mshrs"))) {
+    opts->mshrs = atoi(value);
+    return opts->mshrs >= 0 && opts->mshrs <= MEMSYS_MAX_REQUESTS ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--mem-limit"))) {
+    char* end;
+    opts->datamem.limit = strtoul(value, &end, 0);
+    return *end == '\0' && opts->datamem.limit <= (1UL << 32) ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--mem-huge"))) {
+    return parse_huge_region(value, &opts->datamem);
+  }
+
+  if ((value = option_value(arg, "--mem-in"))) {
+    opts->mem_in = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--mem-in-base"))) {
+    char* end;
+    opts->mem_in_base = strtoul(value, &end, 0);
+    return *end == '\0' ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--mem-out"))) {
+    opts->mem_out = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--regs-out"))) {
+    opts->regs_out = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--stats-json"))) {
+    opts->stats_json = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--stats-csv"))) {
+    opts->stats_csv = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--profile"))) {
+    opts->profile = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--bypass"))) {
+    opts->bypass = value;
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--interval"))) {
+    opts->interval = atoi(value);
+    return opts->interval > 0 ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--resolve"))) {
+    if (strcmp(value, "decode") == 0) {
+      opts->resolve = RESOLVE_DECODE;
+    } else if (strcmp(value, "ex1") == 0) {
+      opts->resolve = RESOLVE_EX1;
+    } else if (strcmp(value, "mem1") == 0) {
+      opts->resolve = RESOLVE_MEM1;
+    } else {
+      return -1;
+    }
+    return 0;
+  }
+
+  if ((value = option_value(arg, "--check"))) {
+    char* end;
+
+    if (strcmp(value, "lockstep") == 0) {
+      opts->check = CHECK_LOCKSTEP;
+      return 0;
+    }
+    if (strcmp(value, "digest") == 0) {
+      opts->check = CHECK_DIGEST;
+      opts->check_interval = CHECK_DIGEST_INTERVAL;
+      return 0;
+    }
+    if (strncmp(value, "digest:", 7) == 0) {
+      opts->check = CHECK_DIGEST;
+      opts->check_interval = strtol(value + 7, &end, 0);
+      return *end == '\0' && opts->check_interval > 0 ? 0 : -1;
+    }
+    return -1;
+  }
+
+  if ((value = option_value(arg, "--fast-forward"))) {
+    char* end;
+
+    opts->fast_forward = strtol(value, &end, 0);
+    return *end == '\0' && opts->fast_forward >= 0 ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--jit"))) {
+    if (strcmp(value, "on") == 0 || strcmp(value, "off") == 0) {
+      opts->jit = strcmp(value, "on") == 0;
+      return 0;
+    }
+    return -1;
+  }
+
+  if ((value = option_value(arg, "--dram-page"))) {
+    if (strcmp(value, "open") == 0 || strcmp(value, "closed") == 0) {
+      opts->dram.closed_page = strcmp(value, "closed") == 0;
+      return 0;
+    }
+    return -1;
+  }
+
+  return -1;
+}
+
+void
+print_options_help(void)
+{
+  fprintf(stderr,
+          "  --icache=S:W:L[:HIT[:MISS]]  I-cache with S sets, W ways, L byte lines\n"
+          "  --fetch-buffer=N             Fetch buffer holds N instructions\n"
+          "  --l1d=S:W:L[:HIT[:MISS]]     L1 D-cache, same format as --icache\n"
+          "  --l2=S:W:L[:HIT[:MISS]]      L2 shared by the I-cache and L1 D-cache\n"
+          "  --dram=B:R[:CAS:RCD:RP[:BURST]]  DRAM with B banks and R byte rows\n"
+          "  --dram-queue=N               DRAM request queue holds N entries\n"
+          "  --dram-page=open|closed      DRAM row buffer policy\n"
+          "  --prefetch=stride|stream|both[:DEGREE[:DISTANCE]]\n"
+          "                               Prefetch into the L1 D-cache (or L2)\n"
+          "  --mshrs=N                    Non-blocking memory with N MSHRs\n"
+          "  --mem-limit=N                Data addresses from N on fault\n"
+          "  --mem-huge=BASE:SIZE         Back SIZE data addresses with hugepages\n"
+          "  --mem-in=FILE                Map a binary data image at startup\n"
+          "  --mem-in-base=N              Data address of the image's first word\n"
+          "  --mem-out=FILE               Write final data memory as a binary image\n"
+          "  --regs-out=FILE              Write final R0-R15 as a binary image\n"
+          "  --stats-json=FILE            Write every statistic as JSON, - for stdout\n"
+          "  --stats-csv=FILE             Write every statistic as CSV, - for stdout\n"
+          "  --profile=FILE               Write the program annotated with per-PC cycles\n"
+          "  --critpath                   Report the critical path (Simulator II)\n"
+          "  --bypass=none|all|SRC:DST,...  Forwarding paths (Simulator I)\n"
+          "  --resolve=decode|ex1|mem1    Stage branches resolve in (Simulator I)\n"
+          "  --check=lockstep|digest[:N]  Check retires against the functional model\n"
+          "  --fast-forward=N             Run N instructions functionally first\n"
+          "  --jit=on|off                 Translate hot blocks of the functional model\n"
+          "  --quiet                      Print only the final state and stats\n"
+          "  --interval=N                 Print the stall breakdown every N cycles\n");
+}
@@ -10,18 +10,54 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <signal.h>
+#include <time.h>
 #include "cpu.h"
 
-/* Set this flag to 1 to enable debug messages */
-#define ENABLE_DEBUG_MESSAGES 1
+/* Debug messages are printed unless --quiet is given */
+static int debug_messages = 1;
+#define ENABLE_DEBUG_MESSAGES debug_messages
 
-int BZ_Flag;
-int count = 0;
-int physical_register_count = 0;
-int issue_count = 0;
-int ARF[24];
-int PRF[24];
+/* Set by SIGUSR1, the statistics are written at the end of the cycle */
+static volatile sig_atomic_t stats_requested;
 
+static void
+register_stats(APEX_CPU* cpu);
+
+
+
+/* Copies the data segment of an assembled object into data memory dm */
+static int
+load_object_data(APEX_CPU* cpu, Data_Memory* dm)
+{
+  const Apexo_Header* header = cpu->object.header;
+
+  for (uint32_t i = 0; header && i < header->data_count; ++i) {
+    if (datamem_write(dm, header->data_base + i, cpu->object.data[i])) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Sets up dm with the object data and --mem-in image, for the pipeline
+ * and for the functional model alike.
+ * Returns 0 on success, -1 on failure
+ */
+static int
+setup_data_memory(APEX_CPU* cpu, Data_Memory* dm)
+{
+  const APEX_Options* opts = &cpu->opts;
+
+  if (datamem_init(dm, &opts->datamem) || load_object_data(cpu, dm)) {
+    return -1;
+  }
+  if (opts->mem_in &&
+      image_load_memory(dm, opts->mem_in, opts->mem_in_base)) {
+    return -1;
+  }
+  return 0;
+}
 
 /*
  * This function creates and initializes APEX cpu.
@@ -29,39 +65,165 @@ int PRF[24];
  * Note : You are free to edit this function according to your
  * 				implementation
  */
-APEX_CPU* APEX_cpu_init(const char* filename)
+APEX_CPU* APEX_cpu_init(const char* filename, const APEX_Options* opts)
 {
   if (!filename) {
     return NULL;
   }
 
+  /* The bypass network is the one of the Simulator I pipeline */
+  if (opts->bypass) {
+    fprintf(stderr, "APEX_Error : Invalid option --bypass=%s\n",
+            opts->bypass);
+    return NULL;
+  }
+
+  /* Branches always resolve in the branch FU of Simulator II */
+  if (opts->resolve != RESOLVE_DEFAULT) {
+    fprintf(stderr, "APEX_Error : Invalid option --resolve=%s\n",
+            opts->resolve == RESOLVE_DECODE ? "decode"
+            : opts->resolve == RESOLVE_EX1  ? "ex1"
+                                            : "mem1");
+    return NULL;
+  }
+
   APEX_CPU* cpu = malloc(sizeof(*cpu));
   if (!cpu) {
     return NULL;
   }
 
   /* Initialize PC, Registers and all pipeline stages */
+  memset(cpu, 0, sizeof(*cpu));
   cpu->pc = 4000;
-  memset(cpu->regs, 0, sizeof(int) * 24);
-  memset(cpu->regs_valid, 1, sizeof(int) * 24);
-  memset(cpu->phy_regs, 0, sizeof(int) * 24);
-  memset(cpu->phy_regs_valid, 1, sizeof(int) * 24);
-  memset(cpu->stage, 0, sizeof(CPU_Stage) * NUM_STAGES);
-  memset(cpu->data_memory, 0, sizeof(int) * 4000);
+  cpu->opts = *opts;
+  cpu->fetch_stall = STALL_FETCH;
+  debug_messages = !opts->quiet;
 
-  for(int i = 0; i<24; i++){
+  for (int i = 0; i < NUM_OCC; i++) {
+    dist_init(&cpu->occupancy[i], 1);
+  }
+
+  for (int i = 0; i < ARCH_REGS; i++) {
+    cpu->regs_valid[i] = 1;
+    cpu->rename_table[i] = -1;
+  }
+  cpu->flag_rename = -1;
+  cpu->zero_flag = 1;
 
-    ARF[i] = 100;
+  /* No physical registers are allocated when the simulation starts */
+  for (int i = 0; i < PHY_REGS; i++) {
+    cpu->phy_regs_valid[i] = 1;
+    cpu->phy_regs_free[i] = 1;
   }
 
-  /* Parse input file and create code memory */
-  cpu->code_memory = create_code_memory(filename, &cpu->code_memory_size);
+  /* Map an assembled object, or parse input file and create code memory */
+  switch (object_open(&cpu->object, filename)) {
+    case 0:
+      cpu->code_memory = cpu->object.code;
+      cpu->code_memory_size = cpu->object.header->code_count;
+      break;
+    case 1:
+      cpu->code_memory = create_code_memory(filename, &cpu->code_memory_size);
+      break;
+    default:
+      cpu->code_memory = NULL;
+  }
 
   if (!cpu->code_memory) {
     free(cpu);
     return NULL;
   }
 
+  if (memsys_init(&cpu->memsys, &opts->l1d, &opts->l2, &opts->dram,
+                  &opts->prefetch, opts->mshrs)) {
+    fprintf(stderr, "APEX_Error : Invalid memory hierarchy configuration\n");
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (frontend_init(&cpu->frontend, &opts->icache, opts->fetch_buffer_size,
+                    cpu->pc)) {
+    fprintf(stderr, "APEX_Error : Invalid I-cache configuration\n");
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (setup_data_memory(cpu, &cpu->data_memory)) {
+    fprintf(stderr, "APEX_Error : Unable to set up data memory\n");
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (opts->profile && profile_init(&cpu->profile, cpu->code_memory_size)) {
+    fprintf(stderr, "APEX_Error : Unable to set up the profile\n");
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (opts->critpath &&
+      critpath_init(&cpu->critpath, cpu->code_memory_size, ROB_SIZE)) {
+    fprintf(stderr, "APEX_Error : Unable to set up the critical path\n");
+    profile_free(&cpu->profile);
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  if (funcmodel_init(&cpu->model, cpu->code_memory, cpu->code_memory_size,
+                     &cpu->data_memory)) {
+    fprintf(stderr, "APEX_Error : Unable to set up the functional model\n");
+    critpath_free(&cpu->critpath);
+    profile_free(&cpu->profile);
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+
+  /* A host that can not run translated code only interprets */
+  if (opts->jit) {
+    funcmodel_use_jit(&cpu->model);
+  }
+
+  if (opts->check &&
+      (checker_init(&cpu->checker, opts->check, opts->check_interval,
+                    cpu->code_memory, cpu->code_memory_size) ||
+       setup_data_memory(cpu, &cpu->checker.data_memory))) {
+    fprintf(stderr, "APEX_Error : Unable to set up the checker\n");
+    checker_free(&cpu->checker);
+    funcmodel_free(&cpu->model);
+    critpath_free(&cpu->critpath);
+    profile_free(&cpu->profile);
+    datamem_free(&cpu->data_memory);
+    frontend_free(&cpu->frontend);
+    memsys_free(&cpu->memsys);
+    object_free_code(&cpu->object, cpu->code_memory);
+    free(cpu);
+    return NULL;
+  }
+  if (opts->check && opts->jit) {
+    funcmodel_use_jit(&cpu->checker.model);
+  }
+
+  register_stats(cpu);
+
   if (ENABLE_DEBUG_MESSAGES) {
     fprintf(stderr,
             "APEX_CPU : Initialized APEX CPU, loaded %d instructions\n",
@@ -92,7 +254,15 @@ APEX_CPU* APEX_cpu_init(const char* filename)
 void
 APEX_cpu_stop(APEX_CPU* cpu)
 {
-  free(cpu->code_memory);
+  stats_free(&cpu->stats);
+  profile_free(&cpu->profile);
+  critpath_free(&cpu->critpath);
+  checker_free(&cpu->checker);
+  funcmodel_free(&cpu->model);
+  datamem_free(&cpu->data_memory);
+  frontend_free(&cpu->frontend);
+  memsys_free(&cpu->memsys);
+  object_free_code(&cpu->object, cpu->code_memory);
   free(cpu);
 }
 
@@ -111,199 +281,336 @@ get_code_index(int pc)
 static void
 print_instruction(CPU_Stage* stage)
 {
-  if (strcmp(stage->opcode, "STORE") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rs1, stage->rs2, stage->imm);
-  }
-
-  if (strcmp(stage->opcode, "STR") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "LOAD") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+  if (!stage->pc) {
+    return;
   }
 
-  if (strcmp(stage->opcode, "LDR") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "MOVC") == 0) {
-    printf("%s,R%d,#%d ", stage->opcode, stage->rd, stage->imm);
-  }
-
-  if (strcmp(stage->opcode, "ADD") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "ADDL") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
-  }
-
-  if (strcmp(stage->opcode, "SUB") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "SUBL") == 0) {
-    printf(
-      "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
-  }
-
-  if (strcmp(stage->opcode, "MUL") == 0) {
-    printf(
-      "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "BZ") == 0) {
-    printf(
-      "%s,#%d ", stage->opcode, stage->imm);
-  }
-
-  if (strcmp(stage->opcode, "AND") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
-
-  if (strcmp(stage->opcode, "OR") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+  switch (stage->op) {
+    case OP_STORE:
+      printf(
+        "%s,R%d,R%d,#%d ", stage->opcode, stage->rs1, stage->rs2, stage->imm);
+      break;
+    case OP_LOAD:
+    case OP_ADDL:
+    case OP_SUBL:
+      printf(
+        "%s,R%d,R%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
+      break;
+    case OP_STR:
+    case OP_LDR:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_AND:
+    case OP_OR:
+    case OP_EXOR:
+      printf(
+        "%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+      break;
+    case OP_MOVC:
+      printf("%s,R%d,#%d ", stage->opcode, stage->rd, stage->imm);
+      break;
+    case OP_BZ:
+      printf("%s,#%d ", stage->opcode, stage->imm);
+      break;
+    case OP_BNZ:
+      printf("%s,#%d", stage->opcode, stage->imm);
+      break;
+    case OP_JUMP:
+      printf("%s,R%d,#%d", stage->opcode, stage->rs1, stage->imm);
+      break;
+    case OP_HALT:
+      printf("HALT");
+      break;
   }
+}
 
-  if (strcmp(stage->opcode, "EX-OR") == 0) {
-    printf("%s,R%d,R%d,R%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+/* Prints a renamed operand, the architectural register is shown when the
+ * value comes from the architectural register file
+ */
+static void
+print_operand(int phys, int arch)
+{
+  if (phys >= 0) {
+    printf(",P%d", phys);
+  } else {
+    printf(",R%d", arch);
   }
+}
 
-  if (strcmp(stage->opcode, "HALT") == 0){
-    printf("HALT");
+static void
+print_renamed_instruction(CPU_Stage* stage)
+{
+  if (!stage->pc) {
+    return;
   }
 
-  if (strcmp(stage->opcode, "JUMP") == 0) {
-    printf("%s,R%d,#%d", stage->opcode,stage->rs1,stage->imm);
+  switch (stage->op) {
+    case OP_STORE:
+      printf("%s", stage->opcode);
+      print_operand(stage->prs1, stage->rs1);
+      print_operand(stage->prs2, stage->rs2);
+      printf(",#%d ", stage->imm);
+      break;
+    case OP_STR:
+    case OP_LDR:
+    case OP_ADD:
+    case OP_SUB:
+    case OP_MUL:
+    case OP_AND:
+    case OP_OR:
+    case OP_EXOR:
+      printf("%s", stage->opcode);
+      print_operand(stage->prd, stage->rd);
+      print_operand(stage->prs1, stage->rs1);
+      print_operand(stage->prs2, stage->rs2);
+      printf(" ");
+      break;
+    case OP_LOAD:
+    case OP_ADDL:
+    case OP_SUBL:
+      printf("%s", stage->opcode);
+      print_operand(stage->prd, stage->rd);
+      print_operand(stage->prs1, stage->rs1);
+      printf(",#%d ", stage->imm);
+      break;
+    case OP_MOVC:
+      printf("%s", stage->opcode);
+      print_operand(stage->prd, stage->rd);
+      printf(",#%d ", stage->imm);
+      break;
+    case OP_BZ:
+    case OP_BNZ:
+      printf("%s,#%d ", stage->opcode, stage->imm);
+      break;
+    case OP_HALT:
+      printf("HALT");
+      break;
+    case OP_JUMP:
+      printf("%s", stage->opcode);
+      print_operand(stage->prs1, stage->rs1);
+      printf(",#%d", stage->imm);
+      break;
   }
+}
 
-  if (strcmp(stage->opcode, "BNZ") == 0) {
-    printf("%s,#%d", stage->opcode,stage->imm);
-  }
+/* Debug function which dumps the cpu stage
+ * content
+ *
+ * Note : You are not supposed to edit this function
+ *
+ */
+static void
+print_stage_content(char* name, CPU_Stage* stage)
+{
+  printf("%-15s: pc(%d) ", name, stage->pc);
+  print_instruction(stage);
+  printf("\n");
 }
 
 static void
-print_renamed_instruction(CPU_Stage* stage)
+print_renamed_stage_content(char* name, CPU_Stage* stage)
 {
-  if (strcmp(stage->opcode, "STORE") == 0) {
-    printf(
-      "%s,P%d,P%d,#%d ", stage->opcode, stage->rs1, stage->rs2, stage->imm);
-  }
+  printf("%-15s: pc(%d) ", name, stage->pc);
+  print_renamed_instruction(stage);
+  printf("\n");
+}
 
-  if (strcmp(stage->opcode, "STR") == 0) {
-    printf(
-      "%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+void make_stage_empty(CPU_Stage *stage) {
+    strcpy(stage->opcode, "");
+    stage->pc = 0;
+}
 
-  if (strcmp(stage->opcode, "LOAD") == 0) {
-    printf(
-      "%s,P%d,P%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
-  }
+/* What an instruction does besides its operation, as bits of op_flags */
+enum
+{
+  WRITES_RD = 1 << 0,	// Writes register rd
+  SETS_FLAG = 1 << 1,	// Sets the zero flag
+  LOADS = 1 << 2,	// Reads data memory
+  STORES = 1 << 3,	// Writes data memory
+  BRANCHES = 1 << 4,	// May redirect fetch, takes a rename checkpoint
+  READS_RS1 = 1 << 5,	// Reads register rs1
+  READS_RS2 = 1 << 6,	// Reads register rs2
+  READS_RD = 1 << 7	// Reads register rd, the data STR stores
+};
+
+/* Indexed by OP_*, so the stages never compare opcode strings */
+static const unsigned char op_flags[NUM_OPCODES] = {
+  [OP_MOVC] = WRITES_RD,
+  [OP_STORE] = STORES | READS_RS1 | READS_RS2,
+  [OP_STR] = STORES | READS_RS1 | READS_RS2 | READS_RD,
+  [OP_ADD] = WRITES_RD | SETS_FLAG | READS_RS1 | READS_RS2,
+  [OP_ADDL] = WRITES_RD | READS_RS1,
+  [OP_SUB] = WRITES_RD | SETS_FLAG | READS_RS1 | READS_RS2,
+  [OP_SUBL] = WRITES_RD | READS_RS1,
+  [OP_MUL] = WRITES_RD | SETS_FLAG | READS_RS1 | READS_RS2,
+  [OP_LOAD] = WRITES_RD | LOADS | READS_RS1,
+  [OP_LDR] = WRITES_RD | LOADS | READS_RS1 | READS_RS2,
+  [OP_AND] = WRITES_RD | READS_RS1 | READS_RS2,
+  [OP_OR] = WRITES_RD | READS_RS1 | READS_RS2,
+  [OP_EXOR] = WRITES_RD | READS_RS1 | READS_RS2,
+  [OP_BZ] = BRANCHES,
+  [OP_BNZ] = BRANCHES,
+  [OP_JUMP] = BRANCHES | READS_RS1,
+};
+
+/* Returns 1 if the stage holds an instruction with any of the flags */
+static int
+has_flags(const CPU_Stage* stage, unsigned char flags)
+{
+  return stage->pc && (op_flags[stage->op] & flags);
+}
 
-  if (strcmp(stage->opcode, "LDR") == 0) {
-    printf(
-      "%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+static int
+is_memory(const CPU_Stage* stage)
+{
+  return has_flags(stage, LOADS | STORES);
+}
 
-  if (strcmp(stage->opcode, "MOVC") == 0) {
-    printf("%s,P%d,#%d ", stage->opcode, stage->rd, stage->imm);
-  }
+static int
+is_store(const CPU_Stage* stage)
+{
+  return has_flags(stage, STORES);
+}
 
-  if (strcmp(stage->opcode, "ADD") == 0) {
-    printf(
-      "%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+static int
+is_branch(const CPU_Stage* stage)
+{
+  return has_flags(stage, BRANCHES);
+}
 
-  if (strcmp(stage->opcode, "ADDL") == 0) {
-    printf(
-      "%s,P%d,P%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
-  }
+/* Instructions which set the zero flag */
+static int
+is_flag_producer(const CPU_Stage* stage)
+{
+  return has_flags(stage, SETS_FLAG);
+}
 
-  if (strcmp(stage->opcode, "SUB") == 0) {
-    printf(
-      "%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+static int
+has_dest(const CPU_Stage* stage)
+{
+  return has_flags(stage, WRITES_RD);
+}
 
-  if (strcmp(stage->opcode, "SUBL") == 0) {
-    printf(
-      "%s,P%d,P%d,#%d ", stage->opcode, stage->rd, stage->rs1, stage->imm);
-  }
+static int
+reads_rs1(const CPU_Stage* stage)
+{
+  return has_flags(stage, READS_RS1);
+}
 
-  if (strcmp(stage->opcode, "MUL") == 0) {
-    printf(
-      "%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+static int
+reads_rs2(const CPU_Stage* stage)
+{
+  return has_flags(stage, READS_RS2);
+}
 
-  if (strcmp(stage->opcode, "BZ") == 0) {
-    printf(
-      "%s,#%d ", stage->opcode, stage->imm);
-  }
+/* STR also reads rd, the value it stores */
+static int
+reads_rd(const CPU_Stage* stage)
+{
+  return has_flags(stage, READS_RD);
+}
 
-  if (strcmp(stage->opcode, "AND") == 0) {
-    printf("%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+/* BZ and BNZ read the zero flag */
+static int
+reads_flag(const CPU_Stage* stage)
+{
+  return stage->pc && (stage->op == OP_BZ || stage->op == OP_BNZ);
+}
 
-  if (strcmp(stage->opcode, "OR") == 0) {
-    printf("%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
-  }
+/* HALT has no IQ entry and no function unit */
+static int
+is_halt(const CPU_Stage* stage)
+{
+  return stage->pc && stage->op == OP_HALT;
+}
 
-  if (strcmp(stage->opcode, "EX-OR") == 0) {
-    printf("%s,P%d,P%d,P%d ", stage->opcode, stage->rd, stage->rs1, stage->rs2);
+/* Physical registers are always allocated in increasing order */
+static int
+free_phy_reg(APEX_CPU* cpu)
+{
+  for (int i = 0; i < PHY_REGS; i++) {
+    if (cpu->phy_regs_free[i]) {
+      return i;
+    }
   }
+  return -1;
+}
 
-  if (strcmp(stage->opcode, "HALT") == 0){
-    printf("HALT");
+static int
+free_iq_entry(APEX_CPU* cpu)
+{
+  for (int i = 0; i < IQ_SIZE; i++) {
+    if (cpu->issue_queue[i].pc == 0) {
+      return i;
+    }
   }
+  return -1;
+}
 
-  if (strcmp(stage->opcode, "JUMP") == 0) {
-    printf("%s,P%d,#%d", stage->opcode,stage->rs1,stage->imm);
+static int
+free_checkpoint(APEX_CPU* cpu)
+{
+  for (int i = 0; i < CHECKPOINTS; i++) {
+    if (!cpu->checkpoint_used[i]) {
+      return i;
+    }
   }
+  return -1;
+}
 
-  if (strcmp(stage->opcode, "BNZ") == 0) {
-    printf("%s,#%d", stage->opcode,stage->imm);
+static CPU_Stage*
+find_lsq_entry(APEX_CPU* cpu, long seq)
+{
+  for (int i = 0; i < cpu->lsq_count; i++) {
+    CPU_Stage* entry = &cpu->ls_queue[(cpu->lsq_head + i) % LSQ_SIZE];
+    if (entry->seq == seq) {
+      return entry;
+    }
   }
+  return NULL;
 }
 
-/* Debug function which dumps the cpu stage
- * content
- *
- * Note : You are not supposed to edit this function
- *
- */
+/* Looks up a source in the rename table, values still in regs are read now */
 static void
-print_stage_content(char* name, CPU_Stage* stage)
+rename_source(APEX_CPU* cpu, int arch, int* phys, int* value)
 {
-  printf("%-15s: pc(%d) ", name, stage->pc);
-  print_instruction(stage);
-  printf("\n");
+  *phys = cpu->rename_table[arch];
+  if (*phys < 0) {
+    *value = cpu->regs[arch];
+  }
 }
 
-static void
-print_renamed_stage_content(char* name, CPU_Stage* stage)
+static int
+source_ready(APEX_CPU* cpu, int phys)
 {
-  printf("%-15s: pc(%d) ", name, stage->pc);
-  print_renamed_instruction(stage);
-  printf("\n");
+  return phys < 0 || cpu->phy_regs_valid[phys];
 }
 
-void make_stage_empty(CPU_Stage *stage) {
-    strcpy(stage->opcode, "");
-    stage->pc = 0;
-}
+/* Writes a result to the physical register file and marks the ROB entry done */
+static void
+complete(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  if (has_dest(stage)) {
+    cpu->phy_regs[stage->prd] = stage->buffer;
+    cpu->phy_flags[stage->prd] = stage->buffer == 0;
+    cpu->phy_regs_valid[stage->prd] = 1;
+  }
 
-void make_register_valid(APEX_CPU* cpu, CPU_Stage *stage) {
-    
-    cpu->regs_valid[stage->rd] = 1;
-    cpu->regs_valid[stage->rs1] = 1;
-    cpu->regs_valid[stage->rs2] = 1;
+  CPU_Stage* entry = &cpu->reorder_buffer[stage->rob_index];
+  entry->buffer = stage->buffer;
+  entry->mem_address = stage->mem_address;
+  entry->mem_fault = stage->mem_fault;
+  entry->rs1_value = stage->rs1_value;
+  entry->rd_value = stage->rd_value;
+  entry->completed = 1;
+  entry->complete_cycle = cpu->clock;
+
+  if (entry->issue_cycle) {
+    profile_add(&cpu->profile, entry->pc, PROFILE_LATENCY,
+                cpu->clock - entry->issue_cycle);
+    profile_add(&cpu->profile, entry->pc, PROFILE_COMPLETED, 1);
+  }
 }
 
 /*
@@ -319,6 +626,30 @@ fetch(APEX_CPU* cpu)
 
   if (!stage->busy && !stage->stalled) {  
 
+    /* Ask the fetch buffer whether this pc has arrived from the I-cache */
+    int ready =
+      frontend_fetch(&cpu->frontend, &cpu->memsys, cpu->pc, cpu->clock);
+
+    /* Running off the end of code memory, or waiting on an I-cache miss,
+     * sends a bubble to decode
+     */
+    if (get_code_index(cpu->pc) < 0 ||
+        get_code_index(cpu->pc) >= cpu->code_memory_size || !ready) {
+
+      if (cpu->stage[DRF].stalled == 0) {
+        if (!ready) {
+          cpu->frontend.stall_cycles++;
+        }
+        cpu->fetch_stall = STALL_FETCH;
+        make_stage_empty(stage);
+        cpu->stage[DRF] = cpu->stage[F];
+      }
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_stage_content("Fetch", stage);
+      }
+      return 0;
+    }
+
     /* Store current PC in fetch latch */
     stage->pc = cpu->pc;
 
@@ -327,6 +658,7 @@ fetch(APEX_CPU* cpu)
      */
     APEX_Instruction* current_ins = &cpu->code_memory[get_code_index(cpu->pc)];
     strcpy(stage->opcode, current_ins->opcode);
+    stage->op = current_ins->op;
     stage->rd = current_ins->rd;
     stage->rs1 = current_ins->rs1;
     stage->rs2 = current_ins->rs2;
@@ -353,6 +685,9 @@ fetch(APEX_CPU* cpu)
 
   else{
 
+    /* Fetch is busy for one cycle while a misprediction is flushed */
+    stage->busy = 0;
+
   	if (ENABLE_DEBUG_MESSAGES) {
       print_stage_content("Fetch", stage);
     }
@@ -361,495 +696,422 @@ fetch(APEX_CPU* cpu)
   return 0;
 }
 
-int
-decode(APEX_CPU* cpu)
+static int
+operands_ready(APEX_CPU* cpu, CPU_Stage* entry);
+
+/* Returns 1 if the head of the ROB is a load or store waiting on memory */
+static int
+head_waits_on_memory(APEX_CPU* cpu)
 {
-  CPU_Stage* stage = &cpu->stage[DRF];
+  CPU_Stage* head = &cpu->reorder_buffer[cpu->rob_head];
 
+  return cpu->rob_count && is_memory(head) && !head->completed;
+}
 
+/* Returns 1 if an IQ entry is ready but was not selected for its FU */
+static int
+iq_waits_on_fu(APEX_CPU* cpu)
+{
+  for (int i = 0; i < IQ_SIZE; i++) {
+    if (cpu->issue_queue[i].pc != 0 &&
+        operands_ready(cpu, &cpu->issue_queue[i])) {
+      return 1;
+    }
+  }
+  return 0;
+}
 
-  if (!stage->busy && !stage->stalled) {
+/*
+ * Checks for a free ROB, IQ and LSQ entry, physical register and checkpoint.
+ * Returns STALL_NONE, or the STALL_* reason the instruction has to wait
+ */
+static int
+dispatch_stall(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  if (cpu->rob_count == ROB_SIZE) {
+    return head_waits_on_memory(cpu) ? STALL_MEM_HEAD : STALL_ROB;
+  }
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_stage_content("Pre Renaming Ins", stage);
-    }
+  if (!is_halt(stage) && free_iq_entry(cpu) < 0) {
+    return iq_waits_on_fu(cpu) ? STALL_FU : STALL_IQ;
+  }
 
-    if (strcmp(stage->opcode, "MOVC") == 0) {
+  if (is_memory(stage) && cpu->lsq_count == LSQ_SIZE) {
+    return STALL_LSQ;
+  }
 
-      if(ARF[stage->rd] == 100){
+  if (has_dest(stage) && free_phy_reg(cpu) < 0) {
+    return STALL_PHY_REGS;
+  }
 
-          ARF[stage->rd] = physical_register_count;
-          PRF[physical_register_count] = stage->rd;
-          stage->rd = physical_register_count;
-          physical_register_count++;
-        } else{
+  /* A speculation depth of 2 is supported */
+  if (is_branch(stage) && free_checkpoint(cpu) < 0) {
+    return STALL_CHECKPOINT;
+  }
 
-          stage->rd = ARF[stage->rd];
-        }
-    }
+  return STALL_NONE;
+}
 
-    /* STORE */
-    if(strcmp(stage->opcode, "STR") == 0|| strcmp(stage->opcode, "LDR") == 0) {
+/* Counts every full structure the stalled instruction needs. Unlike the
+ * STALL_* reason, a cycle counts against each of them
+ */
+static void
+count_blocked(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  cpu->blocked[OCC_ROB] += cpu->rob_count == ROB_SIZE;
 
-        if(ARF[stage->rd] == 100){
+  if (!is_halt(stage)) {
+    cpu->blocked[OCC_IQ] += free_iq_entry(cpu) < 0;
+  }
 
-          ARF[stage->rd] = physical_register_count;
-          PRF[physical_register_count] = stage->rd;
-          stage->rd = physical_register_count;
-          physical_register_count++;
-        } else{
+  if (is_memory(stage)) {
+    cpu->blocked[OCC_LSQ] += cpu->lsq_count == LSQ_SIZE;
+  }
 
-          stage->rd = ARF[stage->rd];
-        }
+  if (has_dest(stage)) {
+    cpu->blocked[OCC_PHY_REGS] += free_phy_reg(cpu) < 0;
+  }
+}
 
-      if(ARF[stage->rs1] == 100){
+/* Renames the instruction and sets up its IQ, ROB and LSQ entries */
+static void
+dispatch(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  stage->seq = ++cpu->next_seq;
+  stage->prd = -1;
+  stage->prs1 = -1;
+  stage->prs2 = -1;
+  stage->prev_prd = -1;
+  stage->pflag = -1;
+  stage->checkpoint = -1;
+  stage->completed = 0;
+  stage->address_valid = 0;
+  stage->mem_request = 0;
+  stage->mem_start = 0;
+  stage->mem_fault = 0;
+  stage->issue_cycle = 0;
+  stage->dispatch_cycle = cpu->clock;
+  stage->complete_cycle = cpu->clock;
+  stage->redirected = 0;
+  stage->rob_index = (cpu->rob_head + cpu->rob_count) % ROB_SIZE;
+
+  if (reads_rs1(stage)) {
+    rename_source(cpu, stage->rs1, &stage->prs1, &stage->rs1_value);
+  }
 
-          ARF[stage->rs1] = physical_register_count;
-          PRF[physical_register_count] = stage->rs1;
-          stage->rs1 = physical_register_count;
-          physical_register_count++;
-        }else{
+  if (reads_rs2(stage)) {
+    rename_source(cpu, stage->rs2, &stage->prs2, &stage->rs2_value);
+  }
 
-          stage->rs1 = ARF[stage->rs1];
-        }
+  /* STR stores the value of rd */
+  if (reads_rd(stage)) {
+    rename_source(cpu, stage->rd, &stage->prd, &stage->rd_value);
+  }
 
-      if(ARF[stage->rs2] == 100){
+  if (has_dest(stage)) {
+    int phys = free_phy_reg(cpu);
 
-          ARF[stage->rs2] = physical_register_count;
-          PRF[physical_register_count] = stage->rs2;
-          stage->rs2 = physical_register_count;
-          physical_register_count++;
-        }else{
+    cpu->phy_regs_free[phys] = 0;
+    cpu->phy_regs_valid[phys] = 0;
+    stage->prev_prd = cpu->rename_table[stage->rd];
+    cpu->rename_table[stage->rd] = phys;
+    stage->prd = phys;
+  }
 
-          stage->rs2 = ARF[stage->rs2];
-        }
-        cpu->stage[LSQ] = cpu->stage[DRF];
-    }else{
-      make_stage_empty(&cpu->stage[LSQ]);
+  /* BZ and BNZ read the zero flag of its youngest producer */
+  if (reads_flag(stage)) {
+    stage->pflag = cpu->flag_rename;
+    if (stage->pflag < 0) {
+      stage->zero_flag = cpu->zero_flag;
     }
+  }
+
+  if (is_flag_producer(stage)) {
+    cpu->flag_rename = stage->prd;
+  }
 
-    if(strcmp(stage->opcode, "STORE") == 0 || strcmp(stage->opcode, "LOAD") == 0) {
+  if (is_branch(stage)) {
+    stage->checkpoint = free_checkpoint(cpu);
+    cpu->checkpoint_used[stage->checkpoint] = 1;
+    memcpy(cpu->checkpoint_table[stage->checkpoint], cpu->rename_table,
+           sizeof(cpu->rename_table));
+    cpu->checkpoint_flag[stage->checkpoint] = cpu->flag_rename;
+  }
 
-        if(ARF[stage->rd] == 100){
+  if (is_halt(stage)) {
+
+    /* Nothing to execute, stop fetching until HALT commits */
+    stage->completed = 1;
+    cpu->stage[F].stalled = 1;
+    cpu->fetch_stall = STALL_DRAIN;
+    cpu->drain_start[0] = cpu->dispatch_stalls[STALL_DRAIN];
+    cpu->drain_start[1] = cpu->dispatch_stalls[STALL_MEM_HEAD];
+    make_stage_empty(&cpu->stage[F]);
+  } else {
+    cpu->issue_queue[free_iq_entry(cpu)] = *stage;
+  }
 
-          ARF[stage->rd] = physical_register_count;
-          PRF[physical_register_count] = stage->rd;
-          stage->rd = physical_register_count;
-          physical_register_count++;
-        } else{
+  cpu->reorder_buffer[stage->rob_index] = *stage;
+  cpu->rob_count++;
 
-          stage->rd = ARF[stage->rd];
-        }
+  if (is_memory(stage)) {
+    cpu->ls_queue[(cpu->lsq_head + cpu->lsq_count) % LSQ_SIZE] = *stage;
+    cpu->lsq_count++;
+  }
+}
 
-      if(ARF[stage->rs1] == 100){
+/*
+ *  Decode/Rename Stage of APEX Pipeline
+ *
+ *  Note : You are free to edit this function according to your
+ * 				 implementation
+ */
+int
+decode(APEX_CPU* cpu)
+{
+  CPU_Stage* stage = &cpu->stage[DRF];
+  int stall = cpu->fetch_stall;
 
-          ARF[stage->rs1] = physical_register_count;
-          PRF[physical_register_count] = stage->rs1;
-          stage->rs1 = physical_register_count;
-          physical_register_count++;
-        }else{
+  if (!stage->busy && stage->pc != 0) {
 
-          stage->rs1 = ARF[stage->rs1];
-        }
-        cpu->stage[LSQ] = cpu->stage[DRF];
-    }else{
-      make_stage_empty(&cpu->stage[LSQ]);
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_stage_content("Pre Renaming Ins", stage);
     }
 
-    if (strcmp(stage->opcode, "ADD") == 0 || strcmp(stage->opcode, "MUL") == 0 || strcmp(stage->opcode, "SUB") == 0 || strcmp(stage->opcode, "OR") == 0 || strcmp(stage->opcode, "EX-OR") == 0 || strcmp(stage->opcode, "AND") == 0) {
-
-        if(ARF[stage->rd] == 100){
-
-          ARF[stage->rd] = physical_register_count;
-          PRF[physical_register_count] = stage->rd;
-          stage->rd = physical_register_count;
-          physical_register_count++;
-        } else{
-
-          stage->rd = ARF[stage->rd];
-        }
-
-      if(ARF[stage->rs1] == 100){
-
-          ARF[stage->rs1] = physical_register_count;
-          PRF[physical_register_count] = stage->rs1;
-          stage->rs1 = physical_register_count;
-          physical_register_count++;
-        }else{
-
-          stage->rs1 = ARF[stage->rs1];
-        }
-
-      if(ARF[stage->rs2] == 100){
-
-          ARF[stage->rs2] = physical_register_count;
-          PRF[physical_register_count] = stage->rs2;
-          stage->rs2 = physical_register_count;
-          physical_register_count++;
-        }else{
-
-          stage->rs2 = ARF[stage->rs2];
-        }
+    stall = dispatch_stall(cpu, stage);
+    stage->stalled = stall != STALL_NONE;
+    if (stage->stalled) {
+      count_blocked(cpu, stage);
     }
 
-    if (strcmp(stage->opcode, "ADDL") == 0 || strcmp(stage->opcode, "SUBL") == 0) {
-
-      if(ARF[stage->rd] == 100){
-
-          ARF[stage->rd] = physical_register_count;
-          PRF[physical_register_count] = stage->rd;
-          stage->rd = physical_register_count;
-          physical_register_count++;
-        } else{
-
-          stage->rd = ARF[stage->rd];
-        }
-
-      if(ARF[stage->rs1] == 100){
-
-          ARF[stage->rs1] = physical_register_count;
-          PRF[physical_register_count] = stage->rs1;
-          stage->rs1 = physical_register_count;
-          physical_register_count++;
-        }else{
-
-          stage->rs1 = ARF[stage->rs1];
-        }
-    }
+    if (!stage->stalled) {
+      dispatch(cpu, stage);
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("Decode/RF", stage);
-    }
+      if (ENABLE_DEBUG_MESSAGES) {
+        print_renamed_stage_content("Decode/RF", stage);
+      }
 
-    cpu->stage[IQ] = cpu->stage[DRF];
-    cpu->reorder_buffer[count] = cpu->stage[DRF];
-    if(cpu->reorder_buffer[count].pc > 0){
-      count++;
+      make_stage_empty(stage);
+      return 0;
     }
+  } else if (stall == STALL_DRAIN && head_waits_on_memory(cpu)) {
+    stall = STALL_MEM_HEAD;
+  }
 
+  /* A cycle that dispatches nothing is charged to exactly one reason */
+  cpu->dispatch_stalls[stall]++;
 
-    
-} else{
-	if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("Decode/RF", stage);
-    }
-}
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_stage_content("Decode/RF", stage);
+  }
 
- 
   return 0;
 }
 
 int
 reorderBuffer(APEX_CPU* cpu)
 {
-    int i = 0;
-    while(i != count){
-
-      if (ENABLE_DEBUG_MESSAGES && cpu->reorder_buffer[i].pc != 0) {
-      
-      print_renamed_stage_content("ROB", &cpu->reorder_buffer[i]);
-    }
-    i++;
-
+  for (int i = 0; i < cpu->rob_count; i++) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_renamed_stage_content(
+        "ROB", &cpu->reorder_buffer[(cpu->rob_head + i) % ROB_SIZE]);
     }
+  }
 
   return 0;
 }
 
-int
-issueQueue(APEX_CPU* cpu)
-{ 
-    cpu->issue_queue[issue_count] = cpu->stage[IQ];
-    CPU_Stage* stage = &cpu->issue_queue[issue_count];
-
-  if (!stage->busy && !stage->stalled) {
-
-    if (strcmp(stage->opcode, "STORE") == 0 || strcmp(stage->opcode, "STR") == 0 || strcmp(stage->opcode, "LOAD") == 0 || strcmp(stage->opcode, "LDR") == 0) {
-
-      if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("IQ", stage);
-      make_stage_empty(&cpu->stage[MUL1]);
-      make_stage_empty(&cpu->stage[BP_FU]);
-      make_stage_empty(&cpu->stage[INT1]);
-
-    }
+/* An IQ entry wakes up once all of its source operands are valid */
+static int
+operands_ready(APEX_CPU* cpu, CPU_Stage* entry)
+{
+  if (!source_ready(cpu, entry->prs1) || !source_ready(cpu, entry->prs2)) {
     return 0;
-    }
-
-    if (strcmp(stage->opcode, "MOVC") == 0 || strcmp(stage->opcode, "ADD") == 0 || strcmp(stage->opcode, "ADDL") == 0 || strcmp(stage->opcode, "SUB") == 0 || strcmp(stage->opcode, "SUBL") == 0 || strcmp(stage->opcode, "OR") == 0 || strcmp(stage->opcode, "EX-OR") == 0 || strcmp(stage->opcode, "AND") == 0) {
-
-      if (strcmp(stage->opcode, "MOVC") == 0) {
+  }
 
-      if(cpu->phy_regs_valid[stage->rd] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      cpu->phy_regs_valid[stage->rd] = 0;
-      }
-    }
+  if (reads_rd(entry) && !source_ready(cpu, entry->prd)) {
+    return 0;
+  }
 
-    if (strcmp(stage->opcode, "ADD") == 0) {
+  /* The zero flag is ready with the result of its producer */
+  return source_ready(cpu, entry->pflag);
+}
 
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-        
-        stage->stalled = 1;
-      } else{
+/* Register operands are read at the time of issue */
+static void
+read_operands(APEX_CPU* cpu, CPU_Stage* entry)
+{
+  if (entry->prs1 >= 0) {
+    entry->rs1_value = cpu->phy_regs[entry->prs1];
+  }
 
-        stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
-      
-    }
+  if (entry->prs2 >= 0) {
+    entry->rs2_value = cpu->phy_regs[entry->prs2];
+  }
 
-    if (strcmp(stage->opcode, "AND") == 0) {
+  if (reads_rd(entry) && entry->prd >= 0) {
+    entry->rd_value = cpu->phy_regs[entry->prd];
+  }
 
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
-      
-    }
+  if (entry->pflag >= 0) {
+    entry->zero_flag = cpu->phy_flags[entry->pflag];
+  }
+}
 
-    if (strcmp(stage->opcode, "SUB") == 0) {
+/* Sends a picked IQ entry to function unit fu */
+static void
+issue(APEX_CPU* cpu, CPU_Stage* entry, int fu)
+{
+  cpu->fu_issued[fu]++;
+  cpu->reorder_buffer[entry->rob_index].issue_cycle = cpu->clock;
+  read_operands(cpu, entry);
+}
 
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
-    }
+/*
+ *  Issue Queue of APEX Pipeline, wakes up and selects at most one
+ *  instruction per function unit, lowest PC first
+ */
+int
+issueQueue(APEX_CPU* cpu)
+{ 
+  CPU_Stage* int_pick = NULL;
+  CPU_Stage* mul_pick = NULL;
+  CPU_Stage* br_pick = NULL;
 
-    if (strcmp(stage->opcode, "ADDL") == 0) {
+  for (int i = 0; i < IQ_SIZE; i++) {
+    CPU_Stage* entry = &cpu->issue_queue[i];
 
-      if(cpu->phy_regs_valid[stage->rd] == 0 || cpu->phy_regs_valid[stage->rs1] == 0){
-      //stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
+    if (entry->pc == 0 || !operands_ready(cpu, entry)) {
+      continue;
     }
 
-    if (strcmp(stage->opcode, "SUBL") == 0) {
-
-      if(cpu->phy_regs_valid[stage->rd] == 0 || cpu->phy_regs_valid[stage->rs1] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        cpu->phy_regs_valid[stage->rd] = 0;
+    if (entry->op == OP_MUL) {
+      if (!mul_pick || entry->pc < mul_pick->pc) {
+        mul_pick = entry;
       }
-    }
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
+    } else if (is_branch(entry)) {
+      if (!br_pick || entry->pc < br_pick->pc) {
+        br_pick = entry;
       }
-    }
-  
-  /* Read data from register file for Or */
-    if (strcmp(stage->opcode, "OR") == 0) {
-     if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
+    } else {
+      if (!int_pick || entry->pc < int_pick->pc) {
+        int_pick = entry;
       }
     }
-  
-
-    /* Read data from register file for Ex-Or */
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-     if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
+  }
 
-      stage->stalled = 1;
-      } else{
+  if (int_pick) {
+    issue(cpu, int_pick, FU_INT);
+    cpu->stage[INT1] = *int_pick;
+    make_stage_empty(int_pick);
+  }
 
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-          stage->rs2_value = cpu->phy_regs[stage->rs2];
-          cpu->phy_regs_valid[stage->rd] = 0;
-      }
-     
-    }
+  if (mul_pick) {
+    issue(cpu, mul_pick, FU_MUL);
+    cpu->stage[MUL1] = *mul_pick;
+    make_stage_empty(mul_pick);
+  }
 
-      if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("IQ", stage);
-      make_stage_empty(&cpu->stage[MUL1]);
-      make_stage_empty(&cpu->stage[BP_FU]);
-      make_stage_empty(&cpu->stage[MEM_FU]);
+  if (br_pick) {
+    issue(cpu, br_pick, FU_BRANCH);
+    cpu->stage[BP_FU] = *br_pick;
+    make_stage_empty(br_pick);
+  }
 
+  for (int i = 0; i < IQ_SIZE; i++) {
+    if (ENABLE_DEBUG_MESSAGES && cpu->issue_queue[i].pc != 0) {
+      print_renamed_stage_content("IQ", &cpu->issue_queue[i]);
     }
-    cpu->stage[INT1] = cpu->stage[IQ];
-    return 0;
-    }
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
-
-      if (ENABLE_DEBUG_MESSAGES) {
-
-            print_renamed_stage_content("IQ", stage);
-            make_stage_empty(&cpu->stage[BP_FU]);
-            make_stage_empty(&cpu->stage[INT1]);
-            make_stage_empty(&cpu->stage[MEM_FU]);
-        }
-
-        cpu->stage[MUL1] = cpu->stage[IQ];
-        return 0;
+  }
 
-    }
+  return 0;
+}
 
-    if (strcmp(stage->opcode, "BZ") == 0 || strcmp(stage->opcode, "JUMP") == 0 || strcmp(stage->opcode, "BNZ") == 0) {
+/*
+ * In non-blocking mode a load may start ahead of older loads, and of older
+ * stores once their addresses are known to differ. A store still waits
+ * until it is at the head of the ROB.
+ */
+static int
+can_start(APEX_CPU* cpu, int index)
+{
+  CPU_Stage* entry = &cpu->ls_queue[(cpu->lsq_head + index) % LSQ_SIZE];
 
-        if (ENABLE_DEBUG_MESSAGES) {
+  if (entry->mem_start || !entry->address_valid) {
+    return 0;
+  }
 
-            print_renamed_stage_content("IQ", stage);
-            make_stage_empty(&cpu->stage[MUL1]);
-            make_stage_empty(&cpu->stage[INT1]);
-            make_stage_empty(&cpu->stage[MEM_FU]);
-        }
-        cpu->stage[BP_FU] = cpu->stage[IQ];
-        
-        return 0;
-    }       
+  if (is_store(entry)) {
+    return cpu->reorder_buffer[cpu->rob_head].seq == entry->seq;
+  }
 
-    int iq = 0;
-    while(iq != count){
+  for (int i = 0; i < index; i++) {
+    CPU_Stage* older = &cpu->ls_queue[(cpu->lsq_head + i) % LSQ_SIZE];
 
-      if (ENABLE_DEBUG_MESSAGES && cpu->issue_queue[iq].pc != 0) {
-      
-      print_renamed_stage_content("IQ", &cpu->issue_queue[iq]);
+    if (is_store(older) &&
+        (!older->address_valid || older->mem_address == entry->mem_address)) {
+      return 0;
     }
-    iq++;
+  }
 
-    }     
+  return 1;
 }
 
-else{
-
-  issue_count++;
-
-  if (strcmp(cpu->stage[DRF].opcode, "BZ") == 0) {
-
-      cpu->stage[DRF].stalled = 0;
-    }
-
-  make_stage_empty(stage);
-
-    int iq = 0;
-    while(iq != count){
-
-      if (ENABLE_DEBUG_MESSAGES && cpu->issue_queue[iq].pc != 0) {
-      
-      print_renamed_stage_content("IQ", &cpu->issue_queue[iq]);
-    }
-    iq++;
+static void
+start_memory_op(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  /* Loads leaving the LSQ train the prefetcher */
+  if (!is_store(stage)) {
+    memsys_prefetch_train(&cpu->memsys, stage->pc,
+                          memsys_data_address(stage->mem_address),
+                          cpu->clock);
+  }
 
-    }
-    cpu->stage[INT1] = cpu->stage[IQ];
-}
-  return 0;
-  
+  cpu->fu_issued[FU_MEM]++;
+  stage->mem_start = cpu->clock + 1;
+  stage->mem_request = 0;
 }
 
 /*
- *  Memory Stage of APEX Pipeline
+ *  Load Store Queue of APEX Pipeline
  *
- *  Note : You are free to edit this function according to your
- * 				 implementation
+ *  Memory operations are started in program order from the head of the
+ *  LSQ, so loads never bypass earlier stores. A store is only started
+ *  once it is also at the head of the ROB.
+ *
+ *  With MSHRs configured, memory is non-blocking: one operation is
+ *  started per cycle and stays in the LSQ until it completes.
  */
 int
 lsQueue(APEX_CPU* cpu)
 {
-  CPU_Stage* stage = &cpu->stage[LSQ];
-
-  if (!stage->busy && !stage->stalled) {
-
-    if (strcmp(stage->opcode, "LOAD") == 0) {
-
-
-     if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rd] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        
-        cpu->phy_regs_valid[stage->rd] = 0;
+  if (cpu->opts.mshrs) {
+    for (int i = 0; i < cpu->lsq_count; i++) {
+      if (can_start(cpu, i)) {
+        start_memory_op(cpu, &cpu->ls_queue[(cpu->lsq_head + i) % LSQ_SIZE]);
+        break;
       }
     }
+  } else if (cpu->lsq_count && cpu->stage[MEM_FU].pc == 0) {
+    CPU_Stage* stage = &cpu->ls_queue[cpu->lsq_head];
+    CPU_Stage* rob_head = &cpu->reorder_buffer[cpu->rob_head];
 
-    /* Read data from register file for LDR */
-    if (strcmp(stage->opcode, "LDR") == 0) {
-
-      
-     if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-        stage->rs2_value = cpu->phy_regs[stage->rs2];
-        cpu->phy_regs_valid[stage->rd] = 0;
-      }
-    }
-  
-  if (strcmp(stage->opcode, "STORE") == 0) {
-
-      if(cpu->phy_regs_valid[stage->rs1] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-      }
-    }
-  
-  if (strcmp(stage->opcode, "STR") == 0) {
-
-      if(cpu->phy_regs_valid[stage->rs1] == 0 || cpu->phy_regs_valid[stage->rs2] == 0){
-      stage->stalled = 1;
-      } else{
-      stage->stalled = 0;
-      stage->rs1_value = cpu->phy_regs[stage->rs1];
-          stage->rs2_value = cpu->phy_regs[stage->rs2];
-      }
-    }
+    if (stage->address_valid &&
+        (!is_store(stage) || rob_head->seq == stage->seq)) {
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("LSQ", stage);
+      start_memory_op(cpu, stage);
+      cpu->stage[MEM_FU] = *stage;
+      make_stage_empty(stage);
+      cpu->lsq_head = (cpu->lsq_head + 1) % LSQ_SIZE;
+      cpu->lsq_count--;
     }
+  }
 
-    cpu->stage[MEM_FU] = cpu->stage[LSQ];
-  } else{
-  	
-  	if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("LSQ", stage);
+  for (int i = 0; i < cpu->lsq_count; i++) {
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_renamed_stage_content(
+        "LSQ", &cpu->ls_queue[(cpu->lsq_head + i) % LSQ_SIZE]);
     }
-
-    cpu->stage[MEM_FU] = cpu->stage[LSQ];
   }
 
   return 0;
@@ -857,7 +1119,7 @@ lsQueue(APEX_CPU* cpu)
 
 
 /*
- *  Memory Stage of APEX Pipeline
+ *  Integer Function Unit of APEX Pipeline, stage 1
  *
  *  Note : You are free to edit this function according to your
  * 				 implementation
@@ -867,83 +1129,52 @@ integer1(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[INT1];
 
-  if (!stage->busy && !stage->stalled) {
-
-    if (strcmp(stage->opcode, "HALT") == 0) {
-     
-      
-      cpu->stage[F].stalled = 1;
-      make_stage_empty(&cpu->stage[F]);
-      make_stage_empty(&cpu->stage[DRF]);
-      if (ENABLE_DEBUG_MESSAGES) {
-          print_renamed_stage_content("INT1", stage);
-      }
-
-      cpu->stage[INT2] = cpu->stage[INT1];
-      return 0;
-     
-    }
-
-    /* MOVC */
-    if(strcmp(stage->opcode, "MOVC") == 0) {
-
+  switch (stage->pc ? stage->op : -1) {
+    case OP_MOVC:
       stage->buffer = stage->imm;
-    }
-
-    if (strcmp(stage->opcode, "ADD") == 0) {
-
+      break;
+    case OP_ADD:
       stage->buffer = stage->rs1_value + stage->rs2_value;
-      printf("ADDDDDDD stage->buffer : %d\n", stage->buffer);
-    }
-
-    if (strcmp(stage->opcode, "ADDL") == 0) {
-
+      break;
+    case OP_ADDL:
       stage->buffer = stage->rs1_value + stage->imm;
-           
-    }
-
-    if (strcmp(stage->opcode, "SUB") == 0) {
-
+      break;
+    case OP_SUB:
       stage->buffer = stage->rs1_value - stage->rs2_value;
-
-    }
-
-    if (strcmp(stage->opcode, "SUBL") == 0) {
-
+      break;
+    case OP_SUBL:
       stage->buffer = stage->rs1_value - stage->imm;
-
-    }
-
-    if (strcmp(stage->opcode, "OR") == 0) {
-
+      break;
+    case OP_OR:
       stage->buffer = stage->rs1_value | stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "EX-OR") == 0) {
-
+      break;
+    case OP_EXOR:
       stage->buffer = stage->rs1_value ^ stage->rs2_value;
-    }
-
-    if (strcmp(stage->opcode, "AND") == 0) {
-
-      stage->buffer = stage->rs1_value&stage->rs2_value;
-    }
-
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("INT1", stage);
-    }
-
-    cpu->stage[INT2] = cpu->stage[INT1];
-  } else{
-
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("INT1", stage);
-    }
+      break;
+    case OP_AND:
+      stage->buffer = stage->rs1_value & stage->rs2_value;
+      break;
+
+    /* Address calculation for loads and stores */
+    case OP_STORE:
+      stage->mem_address = stage->rs2_value + stage->imm;
+      break;
+    case OP_STR:
+    case OP_LDR:
+      stage->mem_address = stage->rs1_value + stage->rs2_value;
+      break;
+    case OP_LOAD:
+      stage->mem_address = stage->rs1_value + stage->imm;
+      break;
+  }
 
-    cpu->stage[INT2] = cpu->stage[INT1];
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("INT1", stage);
   }
 
+  cpu->stage[INT2] = cpu->stage[INT1];
+  make_stage_empty(stage);
+
   return 0;
 }
 
@@ -952,23 +1183,27 @@ integer2(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[INT2];
 
-  if (!stage->busy && !stage->stalled) {
-
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("INT2", stage);
-    }
+  if (stage->pc != 0) {
 
-    cpu->stage[RE_ROB] = cpu->stage[INT2];
-  } else{
+    if (is_memory(stage)) {
 
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("INT2", stage);
+      /* Calculated addresses are written directly to the LSQ entry */
+      CPU_Stage* entry = find_lsq_entry(cpu, stage->seq);
+      entry->mem_address = stage->mem_address;
+      entry->rs1_value = stage->rs1_value;
+      entry->rd_value = stage->rd_value;
+      entry->address_valid = 1;
+    } else {
+      complete(cpu, stage);
     }
+  }
 
-    cpu->stage[RE_ROB] = cpu->stage[INT2];
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("INT2", stage);
   }
 
+  make_stage_empty(stage);
+
   return 0;
 }
 
@@ -977,31 +1212,19 @@ multi1(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MUL1];
 
-  if (!stage->busy && !stage->stalled) {
-
-
-
-    if (strcmp(stage->opcode, "MUL") == 0) {
-
-      stage->buffer = stage->rs1_value * stage->rs2_value;
-
-    }
-
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL1", stage);
-    }
+  if (stage->pc && stage->op == OP_MUL) {
 
-    cpu->stage[MUL2] = cpu->stage[MUL1];
-  } else{
+    stage->buffer = stage->rs1_value * stage->rs2_value;
 
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL1", stage);
-    }
+  }
 
-    cpu->stage[MUL2] = cpu->stage[MUL1];
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("MUL1", stage);
   }
 
+  cpu->stage[MUL2] = cpu->stage[MUL1];
+  make_stage_empty(stage);
+
   return 0;
 }
 
@@ -1010,23 +1233,13 @@ multi2(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MUL2];
 
-  if (!stage->busy && !stage->stalled) {
-
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL2", stage);
-    }
-
-    cpu->stage[MUL3] = cpu->stage[MUL2];
-  } else{
-
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL2", stage);
-    }
-
-    cpu->stage[MUL3] = cpu->stage[MUL2];
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("MUL2", stage);
   }
 
+  cpu->stage[MUL3] = cpu->stage[MUL2];
+  make_stage_empty(stage);
+
   return 0;
 }
 
@@ -1035,180 +1248,893 @@ multi3(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MUL3];
 
-  if (!stage->busy && !stage->stalled) {
+  if (stage->pc != 0) {
+    complete(cpu, stage);
+  }
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL3", stage);
-    }
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("MUL3", stage);
+  }
 
-    cpu->stage[RE_ROB] = cpu->stage[MUL3];
-  } else{
+  make_stage_empty(stage);
 
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MUL3", stage);
-    }
+  return 0;
+}
 
-    cpu->stage[RE_ROB] = cpu->stage[MUL3];
+static void
+squash_latch(APEX_CPU* cpu, CPU_Stage* stage, long seq)
+{
+  if (stage->pc != 0 && stage->seq > seq) {
+    if (stage->mem_request) {
+      memsys_cancel(&cpu->memsys, stage->mem_request);
+      stage->mem_request = 0;
+    }
+    make_stage_empty(stage);
   }
-
-  return 0;
 }
 
-int
-branchFU(APEX_CPU* cpu)
+/*
+ * Flushes every instruction younger than branch, restores the rename table
+ * from its checkpoint and redirects fetch to target
+ */
+static void
+flush_younger(APEX_CPU* cpu, CPU_Stage* branch, int target)
 {
-  CPU_Stage* stage = &cpu->stage[BP_FU];
+  while (cpu->rob_count) {
+    CPU_Stage* entry =
+      &cpu->reorder_buffer[(cpu->rob_head + cpu->rob_count - 1) % ROB_SIZE];
 
-  if (!stage->busy && !stage->stalled) {
+    if (entry->seq <= branch->seq) {
+      break;
+    }
 
+    if (has_dest(entry)) {
+      cpu->phy_regs_free[entry->prd] = 1;
+      cpu->phy_regs_valid[entry->prd] = 1;
+    }
+    if (entry->checkpoint >= 0) {
+      cpu->checkpoint_used[entry->checkpoint] = 0;
+    }
+    /* Slots spent behind a squashed HALT were lost to the misprediction */
+    if (is_halt(entry)) {
+      long drain = cpu->dispatch_stalls[STALL_DRAIN] - cpu->drain_start[0];
+      long memory = cpu->dispatch_stalls[STALL_MEM_HEAD] - cpu->drain_start[1];
 
+      cpu->dispatch_stalls[STALL_DRAIN] -= drain;
+      cpu->dispatch_stalls[STALL_MEM_HEAD] -= memory;
+      cpu->dispatch_stalls[STALL_WRONG_HALT] += drain + memory;
+    }
+    make_stage_empty(entry);
+    cpu->rob_count--;
+    cpu->squashed++;
+  }
 
-    if (strcmp(stage->opcode, "BZ") == 0) {
-
-        if (BZ_Flag == 0) {
-              cpu->pc = stage->pc + stage->imm;             
-                
-        } else {
+  while (cpu->lsq_count) {
+    CPU_Stage* entry =
+      &cpu->ls_queue[(cpu->lsq_head + cpu->lsq_count - 1) % LSQ_SIZE];
 
-                cpu->pc = cpu->pc + 8;
-        }
+    if (entry->seq <= branch->seq) {
+      break;
     }
+    squash_latch(cpu, entry, branch->seq);
+    cpu->lsq_count--;
+  }
+
+  for (int i = 0; i < IQ_SIZE; i++) {
+    squash_latch(cpu, &cpu->issue_queue[i], branch->seq);
+  }
+
+  squash_latch(cpu, &cpu->stage[INT1], branch->seq);
+  squash_latch(cpu, &cpu->stage[INT2], branch->seq);
+  squash_latch(cpu, &cpu->stage[MUL1], branch->seq);
+  squash_latch(cpu, &cpu->stage[MUL2], branch->seq);
+  squash_latch(cpu, &cpu->stage[MUL3], branch->seq);
+  squash_latch(cpu, &cpu->stage[MEM_FU], branch->seq);
+
+  make_stage_empty(&cpu->stage[DRF]);
+  cpu->stage[DRF].stalled = 0;
+  make_stage_empty(&cpu->stage[F]);
+  cpu->stage[F].stalled = 0;
+  cpu->stage[F].busy = 1;
+
+  /* Refetching after a JUMP is a redirect, after a BZ/BNZ a misprediction */
+  cpu->fetch_stall =
+    branch->op == OP_JUMP ? STALL_REDIRECT : STALL_RECOVERY;
+
+  memcpy(cpu->rename_table, cpu->checkpoint_table[branch->checkpoint],
+         sizeof(cpu->rename_table));
+  cpu->flag_rename = cpu->checkpoint_flag[branch->checkpoint];
+
+  cpu->pc = target;
+}
+
+int
+branchFU(APEX_CPU* cpu)
+{
+  CPU_Stage* stage = &cpu->stage[BP_FU];
+
+  if (stage->pc != 0) {
+
+    /* Branches are predicted not taken */
+    int taken = 0;
+    int target = stage->pc + stage->imm;
 
-    if (strcmp(stage->opcode, "JUMP") == 0) {
+    switch (stage->op) {
+      case OP_BZ:
+        taken = stage->zero_flag;
+        break;
+      case OP_BNZ:
+        taken = !stage->zero_flag;
+        break;
 
-        cpu->pc = stage->pc + stage->imm;
+      /* A JUMP flushes everything that entered the pipeline after it */
+      case OP_JUMP:
+        taken = 1;
+        target = stage->rs1_value + stage->imm;
+        break;
     }
-        
 
-    if (strcmp(stage->opcode, "BNZ") == 0) {
+    if (taken) {
+      long squashed = cpu->squashed;
 
-      if (BZ_Flag == 1) {
-              cpu->pc = stage->pc + stage->imm;             
-                
-        } else {
-          
-                cpu->pc = cpu->pc + 8;
-        }
-        
+      cpu->mispredicts += stage->op != OP_JUMP;
+      cpu->reorder_buffer[stage->rob_index].redirected = 1;
+      flush_younger(cpu, stage, target);
+      profile_add(&cpu->profile, stage->pc, PROFILE_FLUSHES, 1);
+      profile_add(&cpu->profile, stage->pc, PROFILE_SQUASHED,
+                  cpu->squashed - squashed);
     }
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("BP_FU", stage);
+    cpu->checkpoint_used[stage->checkpoint] = 0;
+    cpu->reorder_buffer[stage->rob_index].checkpoint = -1;
+    complete(cpu, stage);
+  }
+
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("BP_FU", stage);
+  }
+
+  make_stage_empty(stage);
+
+  return 0;
+}
+
+/* Starts or polls the access of a memory operation, 1 once it is done */
+static int
+access_done(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  if (memsys_enabled(&cpu->memsys)) {
+    if (!stage->mem_request) {
+      stage->mem_request = memsys_request(
+        &cpu->memsys, memsys_data_address(stage->mem_address),
+        is_store(stage) ? MEM_WRITE : MEM_READ, cpu->clock);
+    }
+    return stage->mem_request &&
+           memsys_done(&cpu->memsys, stage->mem_request, cpu->clock);
+  }
+
+  return cpu->clock >= stage->mem_start + MEM_LATENCY - 1;
+}
+
+/*
+ * Reads or writes data memory. A faulting access completes normally and
+ * only stops the simulation once it reaches the head of the ROB, so
+ * loads on a mispredicted path never fault
+ */
+static void
+perform_access(APEX_CPU* cpu, CPU_Stage* stage)
+{
+  Data_Memory* dm = &cpu->data_memory;
+  unsigned int address = stage->mem_address;
+
+  stage->mem_request = 0;
+
+  switch (stage->op) {
+    case OP_STORE:
+      stage->mem_fault = datamem_write(dm, address, stage->rs1_value) != 0;
+      break;
+    case OP_STR:
+      stage->mem_fault = datamem_write(dm, address, stage->rd_value) != 0;
+      break;
+    case OP_LOAD:
+    case OP_LDR:
+      stage->mem_fault = datamem_read(dm, address, &stage->buffer) != 0;
+      break;
+  }
+
+  complete(cpu, stage);
+}
+
+/* Non-blocking memory, every started LSQ entry completes on its own */
+static int
+memory_nonblocking(APEX_CPU* cpu)
+{
+  for (int i = 0; i < cpu->lsq_count; i++) {
+    CPU_Stage* entry = &cpu->ls_queue[(cpu->lsq_head + i) % LSQ_SIZE];
+
+    if (!entry->mem_start || entry->completed ||
+        cpu->clock < entry->mem_start) {
+      continue;
     }
 
-    cpu->stage[RE_ROB] = cpu->stage[BP_FU];
-  } else{
+    if (access_done(cpu, entry)) {
+      perform_access(cpu, entry);
+      entry->completed = 1;
+    }
 
-    make_stage_empty(stage);
     if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("BP_FU", stage);
+      print_renamed_stage_content("MEM_FU", entry);
     }
+  }
 
-    cpu->stage[RE_ROB] = cpu->stage[BP_FU];
+  while (cpu->lsq_count && cpu->ls_queue[cpu->lsq_head].completed) {
+    make_stage_empty(&cpu->ls_queue[cpu->lsq_head]);
+    cpu->lsq_head = (cpu->lsq_head + 1) % LSQ_SIZE;
+    cpu->lsq_count--;
   }
 
   return 0;
 }
 
+/*
+ *  Memory Function Unit of APEX Pipeline, non-pipelined
+ *
+ *  Note : You are free to edit this function according to your
+ * 				 implementation
+ */
 int
 memoryFU(APEX_CPU* cpu)
 {
   CPU_Stage* stage = &cpu->stage[MEM_FU];
 
-  if (!stage->busy && !stage->stalled) {
+  if (cpu->opts.mshrs) {
+    return memory_nonblocking(cpu);
+  }
 
-    /* STORE */
-    if(strcmp(stage->opcode, "STORE") == 0) {
-      stage->mem_address = stage->rs1_value + stage->imm;
-    }
+  if (stage->pc != 0 && cpu->clock >= stage->mem_start &&
+      access_done(cpu, stage)) {
 
-    if(strcmp(stage->opcode, "STR") == 0) {
-      stage->mem_address = stage->rs1_value + stage->rs2_value;
+    perform_access(cpu, stage);
+
+    if (ENABLE_DEBUG_MESSAGES) {
+      print_renamed_stage_content("MEM_FU", stage);
     }
 
-    if(strcmp(stage->opcode, "LOAD") == 0) {
+    make_stage_empty(stage);
+    return 0;
+  }
 
-      stage->mem_address = stage->rs1_value + stage->imm;
-    }
+  if (ENABLE_DEBUG_MESSAGES) {
+    print_renamed_stage_content("MEM_FU", stage);
+  }
 
-    if(strcmp(stage->opcode, "LDR") == 0) {
+  return 0;
+}
 
-      stage->mem_address = stage->rs1_value + stage->rs2_value;
+/* A freed physical register can no longer hold the latest zero flag. Its
+ * producer has committed, so zero_flag has it
+ */
+static void
+release_flag(APEX_CPU* cpu, int phys)
+{
+  if (cpu->flag_rename == phys) {
+    cpu->flag_rename = -1;
+  }
+  for (int i = 0; i < CHECKPOINTS; i++) {
+    if (cpu->checkpoint_flag[i] == phys) {
+      cpu->checkpoint_flag[i] = -1;
     }
+  }
+}
 
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MEM_FU", stage);
-    }
+/* Adds the instruction at the head of the ROB to the dependence graph */
+static void
+critpath_retire(APEX_CPU* cpu, const CPU_Stage* entry)
+{
+  Critpath_Inst ins = {
+    .pc = entry->pc,
+    .dispatch = entry->dispatch_cycle,
+    .complete = entry->complete_cycle,
+    .commit = cpu->clock,
+    .load = is_memory(entry) && !is_store(entry),
+    .store = is_store(entry),
+    .mem_address = entry->mem_address,
+    .redirect = entry->redirected,
+  };
+
+  if (reads_rs1(entry)) {
+    ins.src[ins.srcs++] = entry->rs1;
+  }
+  if (reads_rs2(entry)) {
+    ins.src[ins.srcs++] = entry->rs2;
+  }
+  if (reads_rd(entry)) {
+    ins.src[ins.srcs++] = entry->rd;
+  }
+  if (reads_flag(entry)) {
+    ins.src[ins.srcs++] = CRITPATH_FLAG;
+  }
 
-    cpu->stage[RE_ROB] = cpu->stage[MEM_FU];
-  } else{
+  if (has_dest(entry)) {
+    ins.dest[ins.dests++] = entry->rd;
+  }
+  if (is_flag_producer(entry)) {
+    ins.dest[ins.dests++] = CRITPATH_FLAG;
+  }
 
-    make_stage_empty(stage);
-    if (ENABLE_DEBUG_MESSAGES) {
-      print_renamed_stage_content("MEM_FU", stage);
-    }
+  critpath_commit(&cpu->critpath, &ins);
+}
 
-    cpu->stage[RE_ROB] = cpu->stage[MEM_FU];
+/* Checks the instruction at the head of the ROB against the functional
+ * model, as it commits
+ */
+static void
+check_retire(APEX_CPU* cpu, const CPU_Stage* entry)
+{
+  Func_Commit commit = {
+    .pc = entry->pc,
+    .op = entry->op,
+    .rd = -1,
+  };
+
+  if (has_dest(entry)) {
+    commit.rd = entry->rd;
+    commit.value = cpu->phy_regs[entry->prd];
+  }
+  if (is_flag_producer(entry)) {
+    commit.sets_flag = 1;
+    commit.zero_flag = cpu->phy_flags[entry->prd];
+  }
+  if (is_memory(entry)) {
+    commit.memory = 1;
+    commit.address = entry->mem_address;
+  }
+  if (is_store(entry)) {
+    commit.store_value = reads_rd(entry) ? entry->rd_value : entry->rs1_value;
   }
 
-  return 0;
+  checker_retire(&cpu->checker, &commit);
 }
 
+/*
+ *  Commit Stage of APEX Pipeline, retires the instruction at the head of
+ *  the ROB into the architectural register file
+ */
 int
 retireROB(APEX_CPU* cpu)
 {
-
     CPU_Stage* stage = &cpu->stage[RE_ROB];
+    CPU_Stage* entry = &cpu->reorder_buffer[cpu->rob_head];
 
-    if (strcmp(stage->opcode, "MOVC") == 0) {
-      cpu->phy_regs[stage->rd] = stage->buffer;
-      cpu->phy_regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-
-    }
-
-    if (strcmp(stage->opcode, "LOAD") == 0 || strcmp(stage->opcode, "LDR") == 0 || strcmp(stage->opcode, "STORE") == 0 || strcmp(stage->opcode, "STR") == 0) {
-      cpu->phy_regs[stage->rd] = stage->buffer;
-      cpu->phy_regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
-    }
+    make_stage_empty(stage);
 
-    if (strcmp(stage->opcode, "ADD") == 0 || strcmp(stage->opcode, "MUL") == 0 || strcmp(stage->opcode, "SUB") == 0) {
+    if (cpu->rob_count && entry->completed && entry->mem_fault) {
+      fprintf(stderr,
+              "APEX_Error : Data memory fault at address %u, pc %d\n",
+              (unsigned int)entry->mem_address, entry->pc);
+      cpu->faulted = 1;
+    } else if (cpu->rob_count && entry->completed) {
 
-      if (!stage->buffer) {
-                BZ_Flag = 0;
-           } else {
+      if (is_flag_producer(entry)) {
+        cpu->zero_flag = cpu->phy_flags[entry->prd];
+      }
 
-                BZ_Flag = 1;
-              }
-      cpu->phy_regs[stage->rd] = stage->buffer;
-      cpu->phy_regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
+      if (has_dest(entry)) {
+        cpu->regs[entry->rd] = cpu->phy_regs[entry->prd];
+        if (entry->prev_prd >= 0) {
+          cpu->phy_regs_free[entry->prev_prd] = 1;
+          release_flag(cpu, entry->prev_prd);
+        }
+      }
 
-    }
+      if (is_halt(entry)) {
+        cpu->halted = 1;
+      }
 
-    if (strcmp(stage->opcode, "OR") == 0 || strcmp(stage->opcode, "AND") == 0 || strcmp(stage->opcode, "EX-OR") == 0) {
-      cpu->phy_regs[stage->rd] = stage->buffer;
-      cpu->phy_regs_valid[stage->rd] = 1;
-      cpu->stage[DRF].stalled=0;
-      stage->stalled= 0;
+      cpu->ins_completed++;
+      cpu->op_retired[entry->op]++;
+      profile_add(&cpu->profile, entry->pc, PROFILE_RETIRED, 1);
+      if (cpu->critpath.window) {
+        critpath_retire(cpu, entry);
+      }
+      if (cpu->checker.mode) {
+        check_retire(cpu, entry);
+      }
+      *stage = *entry;
+      make_stage_empty(entry);
+      cpu->rob_head = (cpu->rob_head + 1) % ROB_SIZE;
+      cpu->rob_count--;
     }
 
     if (ENABLE_DEBUG_MESSAGES) {
       print_renamed_stage_content("RE_ROB", stage);
-      for(int i = 0; i < stage->rd; i++){
-
-        printf("ARF details: R%d : %d\n", PRF[i], cpu->phy_regs[i]); 
-      }
-      
     }
   return 0;
 }
 
+/* Returns a monotonic host time in seconds */
+static double
+host_time(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Prints how long the program ran and whether it reached HALT, and how
+ * fast the simulator ran it
+ */
+static void
+print_run_stats(const APEX_CPU* cpu)
+{
+  double seconds = cpu->host_seconds > 0 ? cpu->host_seconds : 1e-9;
+
+  printf("============= Run =============\n");
+  printf("| Cycles                | %d |\n", cpu->clock);
+  printf("| Instructions          | %d |\n", cpu->ins_completed);
+  printf("| CPI                   | %.3f |\n",
+         cpu->ins_completed ? (double)cpu->clock / cpu->ins_completed : 0.0);
+  printf("| Halted                | %s |\n", cpu->halted ? "yes" : "no");
+  printf("| Host time (s)         | %.6f |\n", cpu->host_seconds);
+  printf("| Cycles per second     | %.0f |\n", cpu->clock / seconds);
+  printf("| Instructions/second   | %.0f |\n", cpu->ins_completed / seconds);
+}
+
+/* Samples how full each OCC_* structure is at the end of a cycle */
+static void
+sample_occupancy(APEX_CPU* cpu)
+{
+  static const int capacity[NUM_OCC] = {
+    [OCC_IQ] = IQ_SIZE,
+    [OCC_ROB] = ROB_SIZE,
+    [OCC_LSQ] = LSQ_SIZE,
+    [OCC_PHY_REGS] = PHY_REGS,
+  };
+  int used[NUM_OCC] = {
+    [OCC_ROB] = cpu->rob_count,
+    [OCC_LSQ] = cpu->lsq_count,
+  };
+
+  for (int i = 0; i < IQ_SIZE; i++) {
+    used[OCC_IQ] += cpu->issue_queue[i].pc != 0;
+  }
+
+  for (int i = 0; i < PHY_REGS; i++) {
+    used[OCC_PHY_REGS] += !cpu->phy_regs_free[i];
+  }
+
+  for (int i = 0; i < NUM_OCC; i++) {
+    dist_sample(&cpu->occupancy[i], used[i]);
+    cpu->full_cycles[i] += used[i] == capacity[i];
+  }
+}
+
+/* Prints the entries in use of each OCC_* structure over the run, the share
+ * of cycles it ended full, and the cycles dispatch was blocked on it
+ */
+static void
+print_occupancy_stats(const APEX_CPU* cpu)
+{
+  static const char* names[NUM_OCC] = {
+    [OCC_IQ] = "IQ",
+    [OCC_ROB] = "ROB",
+    [OCC_LSQ] = "LSQ",
+    [OCC_PHY_REGS] = "Physical registers",
+  };
+
+  printf("============= Occupancy =============\n");
+  printf("| %-21s | Mean | p50 | p90 | p99 | Full | Blocked |\n", "Structure");
+  for (int i = 0; i < NUM_OCC; i++) {
+    const Stat_Dist* dist = &cpu->occupancy[i];
+
+    printf("| %-21s | %.2f | %ld | %ld | %ld | %.1f%% | %ld |\n", names[i],
+           dist_mean(dist), dist_percentile(dist, 50),
+           dist_percentile(dist, 90), dist_percentile(dist, 99),
+           dist->samples ? 100.0 * cpu->full_cycles[i] / dist->samples : 0.0,
+           cpu->blocked[i]);
+  }
+}
+
+/* Charges the cycle to the oldest instruction not retired: the head of the
+ * ROB, else the instruction in decode, else the one being fetched
+ */
+static void
+profile_cycle(APEX_CPU* cpu)
+{
+  CPU_Stage* stage = &cpu->stage[DRF];
+  int pc = cpu->halted ? cpu->stage[RE_ROB].pc : cpu->pc;
+
+  if (cpu->rob_count) {
+    pc = cpu->reorder_buffer[cpu->rob_head].pc;
+  } else if (stage->pc) {
+    pc = stage->pc;
+  }
+  profile_add(&cpu->profile, pc, PROFILE_CYCLES, 1);
+
+  if (stage->pc && stage->stalled) {
+    profile_add(&cpu->profile, stage->pc, PROFILE_STALLS, 1);
+  }
+}
+
+/* Sorts the dispatch slots of the run so far into the TD_* categories.
+ * Instructions still in flight are not in any of them yet
+ */
+static void
+topdown_slots(const APEX_CPU* cpu, long slots[NUM_TD])
+{
+  const long* stalls = cpu->dispatch_stalls;
+
+  slots[TD_RETIRING] = cpu->ins_completed;
+  slots[TD_BAD_SPEC] =
+    cpu->squashed + stalls[STALL_RECOVERY] + stalls[STALL_WRONG_HALT];
+  slots[TD_FRONTEND] = stalls[STALL_FETCH] + stalls[STALL_REDIRECT];
+  slots[TD_BACKEND_MEMORY] = stalls[STALL_LSQ] + stalls[STALL_MEM_HEAD];
+  slots[TD_BACKEND_CORE] = stalls[STALL_ROB] + stalls[STALL_IQ] +
+                           stalls[STALL_FU] + stalls[STALL_PHY_REGS] +
+                           stalls[STALL_CHECKPOINT] + stalls[STALL_DRAIN];
+}
+
+/* Prints each category as its share of the slots of cycles cycles */
+static void
+print_topdown(const char* title, const long slots[NUM_TD], long cycles)
+{
+  static const char* names[NUM_TD] = {
+    [TD_RETIRING] = "Retiring",
+    [TD_BAD_SPEC] = "Bad speculation",
+    [TD_FRONTEND] = "Frontend bound",
+    [TD_BACKEND_MEMORY] = "Backend memory bound",
+    [TD_BACKEND_CORE] = "Backend core bound",
+  };
+
+  printf("============= %s =============\n", title);
+  for (int i = 0; i < NUM_TD; ++i) {
+    printf("| %-21s | %.1f%% |\n", names[i],
+           cycles ? 100.0 * slots[i] / cycles : 0.0);
+  }
+}
+
+/* Prints the top-down breakdown of the cycles since the last interval */
+static void
+print_interval(APEX_CPU* cpu)
+{
+  long start = cpu->clock - (cpu->clock - 1) % cpu->opts.interval - 1;
+  long slots[NUM_TD];
+  char title[64];
+
+  topdown_slots(cpu, slots);
+  for (int i = 0; i < NUM_TD; ++i) {
+    long total = slots[i];
+
+    slots[i] -= cpu->interval_slots[i];
+    cpu->interval_slots[i] = total;
+  }
+
+  snprintf(title, sizeof(title), "Top-Down, cycles %ld-%d", start,
+           cpu->clock - 1);
+  print_topdown(title, slots, cpu->clock - start);
+}
+
+/* Prints the top-down breakdown of the run and the dispatch stalls under it */
+static void
+print_topdown_stats(const APEX_CPU* cpu)
+{
+  static const char* names[NUM_STALLS] = {
+    [STALL_FETCH] = "Fetch stalls",
+    [STALL_REDIRECT] = "JUMP redirects",
+    [STALL_RECOVERY] = "Mispredict recovery",
+    [STALL_WRONG_HALT] = "Wrong-path HALT",
+    [STALL_LSQ] = "LSQ full",
+    [STALL_MEM_HEAD] = "Memory at ROB head",
+    [STALL_ROB] = "ROB full",
+    [STALL_IQ] = "IQ full",
+    [STALL_FU] = "FU busy",
+    [STALL_PHY_REGS] = "Free list empty",
+    [STALL_CHECKPOINT] = "Checkpoints in use",
+    [STALL_DRAIN] = "HALT drain",
+  };
+  long slots[NUM_TD];
+
+  topdown_slots(cpu, slots);
+  print_topdown("Top-Down", slots, cpu->clock);
+
+  printf("============= Dispatch Stalls =============\n");
+  printf("| Squashed              | %ld |\n", cpu->squashed);
+  for (int i = STALL_NONE + 1; i < NUM_STALLS; ++i) {
+    printf("| %-21s | %ld |\n", names[i], cpu->dispatch_stalls[i]);
+  }
+}
+
+static double
+ipc(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->clock ? (double)cpu->ins_completed / cpu->clock : 0.0;
+}
+
+static double
+cpi(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->ins_completed ? (double)cpu->clock / cpu->ins_completed : 0.0;
+}
+
+static double
+host_seconds(const void* ctx)
+{
+  return ((const APEX_CPU*)ctx)->host_seconds;
+}
+
+static double
+cycles_per_second(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->host_seconds > 0 ? cpu->clock / cpu->host_seconds : 0.0;
+}
+
+static double
+instructions_per_second(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->host_seconds > 0 ? cpu->ins_completed / cpu->host_seconds
+                               : 0.0;
+}
+
+static double
+branch_mpki(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->ins_completed ? 1000.0 * cpu->mispredicts / cpu->ins_completed
+                            : 0.0;
+}
+
+static double
+l1d_mpki(const void* ctx)
+{
+  const APEX_CPU* cpu = ctx;
+
+  return cpu->ins_completed
+           ? 1000.0 * cpu->memsys.l1d.misses / cpu->ins_completed
+           : 0.0;
+}
+
+/* Registers the counters of the pipeline and of every module it owns */
+static void
+register_stats(APEX_CPU* cpu)
+{
+  static const char* op_names[NUM_OPCODES];
+  static const char* fu_names[NUM_FUS] = {
+    [FU_INT] = "int", [FU_MUL] = "mul", [FU_BRANCH] = "branch", [FU_MEM] = "mem",
+  };
+  static const char* td_names[NUM_TD] = {
+    [TD_RETIRING] = "retiring",
+    [TD_BAD_SPEC] = "bad_speculation",
+    [TD_FRONTEND] = "frontend_bound",
+    [TD_BACKEND_MEMORY] = "backend_memory_bound",
+    [TD_BACKEND_CORE] = "backend_core_bound",
+  };
+  static const char* stall_names[NUM_STALLS] = {
+    [STALL_NONE] = "none",
+    [STALL_FETCH] = "fetch",
+    [STALL_REDIRECT] = "redirect",
+    [STALL_RECOVERY] = "recovery",
+    [STALL_WRONG_HALT] = "wrong_halt",
+    [STALL_LSQ] = "lsq_full",
+    [STALL_MEM_HEAD] = "mem_head",
+    [STALL_ROB] = "rob_full",
+    [STALL_IQ] = "iq_full",
+    [STALL_FU] = "fu_busy",
+    [STALL_PHY_REGS] = "free_list_empty",
+    [STALL_CHECKPOINT] = "checkpoints",
+    [STALL_DRAIN] = "halt_drain",
+  };
+  static const char* occ_names[NUM_OCC] = {
+    [OCC_IQ] = "iq",
+    [OCC_ROB] = "rob",
+    [OCC_LSQ] = "lsq",
+    [OCC_PHY_REGS] = "phy_regs",
+  };
+  Stats* stats = &cpu->stats;
+
+  for (int i = 0; i < NUM_OPCODES; ++i) {
+    op_names[i] = opcode_name(i);
+  }
+
+  stats_init(stats);
+  stats_group(stats, "sim");
+  stats_int(stats, "cycles", &cpu->clock, "Cycles simulated");
+  stats_int(stats, "instructions", &cpu->ins_completed,
+            "Instructions committed");
+  stats_formula(stats, "ipc", ipc, cpu, "Instructions per cycle");
+  stats_formula(stats, "cpi", cpi, cpu, "Cycles per instruction");
+  stats_int(stats, "halted", &cpu->halted, "HALT committed");
+  stats_int(stats, "faulted", &cpu->faulted, "A data memory fault committed");
+  stats_hash(stats, "state_hash", &cpu->state_hash,
+             "Hash of the registers and data memory");
+  stats_formula(stats, "host_seconds", host_seconds, cpu,
+                "Host time spent in the simulation loop");
+  stats_formula(stats, "cycles_per_second", cycles_per_second, cpu,
+                "Simulated cycles per host second");
+  stats_formula(stats, "instructions_per_second", instructions_per_second,
+                cpu, "Committed instructions per host second");
+
+  stats_group(stats, "core");
+  stats_vector(stats, "retired", cpu->op_retired, NUM_OPCODES, op_names,
+               "Instructions committed by opcode");
+  stats_vector(stats, "issued", cpu->fu_issued, NUM_FUS, fu_names,
+               "Instructions started by function unit");
+  stats_long(stats, "mispredicts", &cpu->mispredicts,
+             "Taken BZ/BNZ, predicted not taken");
+  stats_formula(stats, "branch_mpki", branch_mpki, cpu,
+                "Mispredicts per thousand instructions");
+  if (cpu->memsys.l1d.config.sets) {
+    stats_formula(stats, "l1d_mpki", l1d_mpki, cpu,
+                  "L1D misses per thousand instructions");
+  }
+  stats_long(stats, "squashed", &cpu->squashed,
+             "Dispatched instructions flushed before commit");
+  stats_vector(stats, "topdown", cpu->topdown, NUM_TD, td_names,
+               "Dispatch slots by top-down category");
+  stats_vector(stats, "dispatch_stalls", cpu->dispatch_stalls, NUM_STALLS,
+               stall_names, "Unused dispatch slots by reason");
+  for (int i = 0; i < NUM_OCC; i++) {
+    char name[32];
+
+    snprintf(name, sizeof(name), "occupancy.%s", occ_names[i]);
+    stats_dist(stats, name, &cpu->occupancy[i],
+               "Entries in use at the end of each cycle");
+  }
+  stats_vector(stats, "full_cycles", cpu->full_cycles, NUM_OCC, occ_names,
+               "Cycles the structure ended full");
+  stats_vector(stats, "blocked", cpu->blocked, NUM_OCC, occ_names,
+               "Cycles dispatch stalled on an instruction needing the full "
+               "structure");
+
+  frontend_register_stats(&cpu->frontend, stats);
+  memsys_register_stats(&cpu->memsys, stats);
+  datamem_register_stats(&cpu->data_memory, stats);
+  critpath_register_stats(&cpu->critpath, stats);
+  checker_register_stats(&cpu->checker, stats);
+  funcmodel_register_stats(&cpu->model, stats);
+}
+
+/*
+ * Writes the registered statistics to the files given by --stats-json and
+ * --stats-csv, once derived counters are brought up to date.
+ * Returns 0 on success, 1 if a file could not be written
+ */
+static int
+write_stats(APEX_CPU* cpu)
+{
+  int failed = 0;
+
+  if (!cpu->opts.stats_json && !cpu->opts.stats_csv) {
+    return 0;
+  }
+
+  cpu->state_hash = image_hash(&cpu->data_memory, cpu->regs, ISA_REGS);
+  topdown_slots(cpu, cpu->topdown);
+
+  if (cpu->opts.stats_json &&
+      stats_write_json(&cpu->stats, cpu->opts.stats_json)) {
+    failed = 1;
+  }
+
+  if (cpu->opts.stats_csv &&
+      stats_write_csv(&cpu->stats, cpu->opts.stats_csv)) {
+    failed = 1;
+  }
+  return failed;
+}
+
+static void
+request_stats(int sig)
+{
+  (void)sig;
+  stats_requested = 1;
+}
+
+/*
+ * Prints the hash of the final registers and data memory, and writes
+ * them out as binary images if asked.
+ * Returns 0 on success, 1 if an image could not be written
+ */
+static int
+write_final_state(APEX_CPU* cpu)
+{
+  int failed = 0;
+
+  printf("============= Final State =============\n");
+  printf("| State hash            | %016lx |\n",
+         image_hash(&cpu->data_memory, cpu->regs, ISA_REGS));
+
+  if (cpu->opts.mem_out &&
+      image_save_memory(&cpu->data_memory, cpu->opts.mem_out)) {
+    failed = 1;
+  }
+
+  if (cpu->opts.regs_out &&
+      image_save_words(cpu->opts.regs_out, cpu->regs, ISA_REGS)) {
+    failed = 1;
+  }
+  return failed;
+}
+
+/* Prints the register file and the first words of data memory */
+static void
+print_architectural_state(const APEX_CPU* cpu)
+{
+	printf("============= Register File =============\n");
+	for(int i=0;i<16;i++){
+		printf("| Reg[%d] |  Values = %d |\n",i,cpu->regs[i]);
+	}
+
+	printf("====== State of Data Memory ======\n");
+	for(int i=0;i<25;i++){
+		printf("| MEM[%d] | Data Value = %d |\n",i,datamem_peek(&cpu->data_memory, i));
+	}
+}
+
+/* Takes the registers, zero flag and pc the functional model left */
+static void
+take_model_state(APEX_CPU* cpu)
+{
+  const Func_Model* fm = &cpu->model;
+
+  memcpy(cpu->regs, fm->regs, sizeof(fm->regs));
+  cpu->zero_flag = fm->zero_flag;
+  cpu->pc = fm->pc;
+  cpu->halted = fm->halted;
+  if (fm->faulted) {
+    fprintf(stderr, "APEX_Error : Data memory fault at address %u, pc %d\n",
+            fm->fault_address, fm->pc);
+    cpu->faulted = 1;
+  }
+}
+
+/*
+ * Runs the first --fast-forward instructions on the functional model, and
+ * the checker's model with it, then starts the pipeline from the state
+ * they leave. The caches and predictors start cold
+ */
+static void
+fast_forward(APEX_CPU* cpu)
+{
+  funcmodel_run(&cpu->model, cpu->opts.fast_forward);
+  if (cpu->checker.mode) {
+    funcmodel_run(&cpu->checker.model, cpu->opts.fast_forward);
+  }
+  take_model_state(cpu);
+  cpu->frontend.start_pc = cpu->pc;
+  cpu->frontend.end_pc = cpu->pc;
+}
+
+/*
+ * Runs up to n instructions on the functional model alone, with no
+ * pipeline, and reports how fast it went.
+ * Returns 0 on success, 1 on a fault or if an output could not be written
+ */
+static int
+run_functional(APEX_CPU* cpu, long n)
+{
+  int failed;
+
+  funcmodel_run(&cpu->model, n);
+  take_model_state(cpu);
+
+  print_architectural_state(cpu);
+  funcmodel_print_stats(&cpu->model);
+
+  failed = write_final_state(cpu);
+  failed |= write_stats(cpu);
+  return failed || cpu->faulted;
+}
+
 /*
  *  APEX CPU simulation loop
  *
@@ -1218,9 +2144,28 @@ retireROB(APEX_CPU* cpu)
 int
 APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
 {
-	if(strcmp(argv[2],"display") == 0){
+	if (strcmp(argv[2], "functional") == 0) {
+		return run_functional(cpu, n);
+	}
+
+	if(strcmp(argv[2],"display") != 0 && strcmp(argv[2],"simulate") != 0){
+		fprintf(stderr, "APEX_Error : Unknown mode %s\n", argv[2]);
+		return 1;
+	}
+
+	if (cpu->opts.fast_forward) {
+		fast_forward(cpu);
+	}
+
+	double start = host_time();
 
-		while (cpu->clock < n) {
+	/* kill -USR1 writes the statistics of a long run so far */
+	if (cpu->opts.stats_json || cpu->opts.stats_csv) {
+		signal(SIGUSR1, request_stats);
+	}
+
+	while (cpu->clock < n && !cpu->halted && !cpu->faulted &&
+	       !cpu->checker.diverged) {
 
     		if (ENABLE_DEBUG_MESSAGES) {
             printf("================================================================\n");
@@ -1228,81 +2173,76 @@ APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n)
             printf("================================================================\n");
         }
 
+        memsys_tick(&cpu->memsys, cpu->clock);
+
         retireROB(cpu);
-        printf("-------------------------------\n");
         memoryFU(cpu);
-        printf("-------------------------------\n");
+        lsQueue(cpu);
+        if (ENABLE_DEBUG_MESSAGES) {
+          printf("-------------------------------\n");
+        }
         branchFU(cpu);
-        printf("-------------------------------\n");
         multi3(cpu);
         multi2(cpu);
         multi1(cpu);
-        printf("-------------------------------\n");
         integer2(cpu);
         integer1(cpu);
-        printf("-------------------------------\n");
+        if (ENABLE_DEBUG_MESSAGES) {
+          printf("-------------------------------\n");
+        }
         reorderBuffer(cpu);
-        printf("-------------------------------\n");
-        lsQueue(cpu);
-        printf("-------------------------------\n");
+        if (ENABLE_DEBUG_MESSAGES) {
+          printf("-------------------------------\n");
+        }
         issueQueue(cpu);
-        printf("-------------------------------\n");
+        if (ENABLE_DEBUG_MESSAGES) {
+          printf("-------------------------------\n");
+        }
     		decode(cpu);
     		fetch(cpu);
-    		cpu->clock++;
-  		}
-
-  			printf("====== State of Data Memory ======\n");
-  				for(int i=0;i<25;i++){
-  					printf("| MEM[%d] | Data Value = %d |\n",i,cpu->data_memory[i]);
-				}
-		
-
-		return 0;
- 	}
-
-	if(strcmp(argv[2],"simulate") == 0){
-
-		while (cpu->clock < n) {
-
-    		if (ENABLE_DEBUG_MESSAGES) {
-      			printf("================================================================\n");
-      			printf("Clock Cycle #: %d\n", cpu->clock + 1);
-      			printf("================================================================\n");
+    		sample_occupancy(cpu);
+    		if (cpu->profile.count) {
+    			profile_cycle(cpu);
     		}
-
-    		retireROB(cpu);
-        printf("-------------------------------\n");
-        memoryFU(cpu);
-        printf("-------------------------------\n");
-        branchFU(cpu);
-        printf("-------------------------------\n");
-        multi3(cpu);
-        multi2(cpu);
-        multi1(cpu);
-        printf("-------------------------------\n");
-        integer2(cpu);
-        integer1(cpu);
-        printf("-------------------------------\n");
-        reorderBuffer(cpu);
-        printf("-------------------------------\n");
-        lsQueue(cpu);
-        printf("-------------------------------\n");
-        issueQueue(cpu);
-        printf("-------------------------------\n");
-        decode(cpu);
-        fetch(cpu);
     		cpu->clock++;
-  		}
 
+        if (cpu->opts.interval && cpu->clock % cpu->opts.interval == 0) {
+          print_interval(cpu);
+        }
 
+        if (stats_requested) {
+          stats_requested = 0;
+          cpu->host_seconds = host_time() - start;
+          write_stats(cpu);
+        }
+  	}
+	cpu->host_seconds = host_time() - start;
+	critpath_finish(&cpu->critpath);
+	int diverged = checker_finish(&cpu->checker, cpu->regs, cpu->zero_flag,
+	                              &cpu->data_memory, cpu->halted) != 0;
+
+	print_architectural_state(cpu);
 
-  			printf("====== State of Data Memory ======\n");
-  				for(int i=0;i<25;i++){
-  					printf("| MEM[%d] | Data Value = %d |\n",i,cpu->data_memory[i]);
-				}
-		
+	frontend_print_stats(&cpu->frontend);
+	memsys_print_stats(&cpu->memsys);
+	datamem_print_stats(&cpu->data_memory);
 
-		return 0;
+	/* The last interval may be cut short by HALT or the cycle limit */
+	if (cpu->opts.interval && cpu->clock % cpu->opts.interval) {
+		print_interval(cpu);
 	}
-}
\ No newline at end of file
+	print_topdown_stats(cpu);
+	print_occupancy_stats(cpu);
+	critpath_print_stats(&cpu->critpath, cpu->code_memory, cpu->clock);
+	checker_print_stats(&cpu->checker);
+	print_run_stats(cpu);
+
+	int failed = write_final_state(cpu);
+	failed |= write_stats(cpu);
+	if (cpu->opts.profile &&
+	    profile_write(&cpu->profile, cpu->opts.profile, cpu->code_memory,
+	                  &cpu->object, cpu->clock)) {
+		failed = 1;
+	}
+	return failed || cpu->faulted || diverged;
+}
@@ -8,6 +8,27 @@
  *  Gaurav Kothari (gkothar1@binghamton.edu)
  *  State University of New York, Binghamton
  */
+#include "checker.h"
+#include "datamem.h"
+#include "frontend.h"
+#include "isa.h"
+#include "object.h"
+#include "image.h"
+#include "critpath.h"
+#include "memsys.h"
+#include "options.h"
+#include "profile.h"
+
+/* Sizes of the out-of-order structures, see README.txt */
+#define ARCH_REGS 32
+#define PHY_REGS 24
+#define IQ_SIZE 8
+#define ROB_SIZE 12
+#define LSQ_SIZE 6
+#define CHECKPOINTS 2
+
+/* Memory operations take 3 cycles when no memory hierarchy is modelled */
+#define MEM_LATENCY 3
 
 enum
 {
@@ -27,21 +48,64 @@ enum
   NUM_STAGES
 };
 
-/* Format of an APEX instruction  */
-typedef struct APEX_Instruction
+/* Top-down categories of a dispatch slot, Simulator II dispatches at most
+ * one instruction a cycle
+ */
+enum
 {
-  char opcode[128];	// Operation Code
-  int rd;		    // Destination Register Address
-  int rs1;		    // Source-1 Register Address
-  int rs2;		    // Source-2 Register Address
-  int imm;		    // Literal Value
-} APEX_Instruction;
+  TD_RETIRING,
+  TD_BAD_SPEC,
+  TD_FRONTEND,
+  TD_BACKEND_MEMORY,
+  TD_BACKEND_CORE,
+  NUM_TD
+};
+
+/* Why the dispatch slot of a cycle went unused */
+enum
+{
+  STALL_NONE,
+  STALL_FETCH,		// Frontend: I-cache miss, or no code to fetch
+  STALL_REDIRECT,	// Frontend: refetching after a JUMP
+  STALL_RECOVERY,	// Bad speculation: refetching after a taken BZ/BNZ
+  STALL_WRONG_HALT,	// Bad speculation: stopped behind a HALT later squashed
+  STALL_LSQ,		// Backend memory: LSQ full
+  STALL_MEM_HEAD,	// Backend memory: ROB full or draining, load/store at head
+  STALL_ROB,		// Backend core: ROB full
+  STALL_IQ,		// Backend core: IQ full, waiting on operands
+  STALL_FU,		// Backend core: IQ full, ready entries waiting on an FU
+  STALL_PHY_REGS,	// Backend core: free list empty
+  STALL_CHECKPOINT,	// Backend core: no rename checkpoint for a branch
+  STALL_DRAIN,		// Backend core: nothing to dispatch behind HALT
+  NUM_STALLS
+};
+
+/* Structures whose occupancy is sampled every cycle */
+enum
+{
+  OCC_IQ,
+  OCC_ROB,
+  OCC_LSQ,
+  OCC_PHY_REGS,
+  NUM_OCC
+};
+
+/* Function units an instruction is issued to */
+enum
+{
+  FU_INT,
+  FU_MUL,
+  FU_BRANCH,
+  FU_MEM,
+  NUM_FUS
+};
 
 /* Model of CPU stage latch */
 typedef struct CPU_Stage
 {
   int pc;		    // Program Counter
   char opcode[128];	// Operation Code
+  int op;		    // Operation Code, one of OP_*
   int rs1;		    // Source-1 Register Address
   int rs2;		    // Source-2 Register Address
   int rd;		    // Destination Register Address
@@ -53,6 +117,28 @@ typedef struct CPU_Stage
   int busy;		    // Flag to indicate, stage is performing some action
   int stalled;		// Flag to indicate, stage is stalled 
   int empty; //Flag to indicate,stage is empty
+
+  /* Renaming and out-of-order bookkeeping */
+  int prd;		    // Physical register of rd, -1 if none
+  int prs1;		    // Physical register of rs1, -1 if read from regs
+  int prs2;		    // Physical register of rs2, -1 if read from regs
+  int prev_prd;		// Previous mapping of rd, freed at commit
+  int rd_value;		// Value of rd when it is a source (STR)
+  long seq;		    // Dispatch order
+  int pflag;		    // Physical register of the zero flag a BZ/BNZ reads,
+			    // -1 if read from zero_flag
+  int zero_flag;	// Zero flag a BZ/BNZ read
+  int checkpoint;	// Rename checkpoint held by a branch
+  int rob_index;	// Reorder buffer entry
+  int completed;	// Flag to indicate, result is available
+  int address_valid;	// Flag to indicate, mem_address is in the LSQ entry
+  long mem_start;	// Cycle the memory operation started
+  long issue_cycle;	// Cycle it left the IQ, 0 until then
+  long dispatch_cycle;	// Cycle it entered the IQ and ROB
+  long complete_cycle;	// Cycle its result became available
+  int redirected;	// Flag to indicate, it restarted fetch when taken
+  int mem_request;	// Memory hierarchy access in flight
+  int mem_fault;	// Flag to indicate, the access faulted
 } CPU_Stage;
 
 /* Model of APEX CPU */
@@ -64,38 +150,121 @@ typedef struct APEX_CPU
   /* Current program counter */
   int pc;
 
-  /* Integer register file */
-  int regs[32];
-  int regs_valid[32];
+  /* Architectural register file, updated at commit */
+  int regs[ARCH_REGS];
+  int regs_valid[ARCH_REGS];
+
+  /* Architectural zero flag, set when the last ADD, SUB or MUL to commit
+   * gave zero
+   */
+  int zero_flag;
+
+  /* Physical register file, each register extended with the zero flag of
+   * the result written to it
+   */
+  int phy_regs[PHY_REGS];
+  int phy_flags[PHY_REGS];
+  int phy_regs_valid[PHY_REGS];
+  int phy_regs_free[PHY_REGS];
+
+  /* Rename table, -1 when the latest value is in regs. The zero flag is
+   * renamed to the physical register of its youngest producer, -1 when
+   * the latest flag is zero_flag
+   */
+  int rename_table[ARCH_REGS];
+  int flag_rename;
+
+  /* Rename table checkpoints taken by unresolved branches */
+  int checkpoint_table[CHECKPOINTS][ARCH_REGS];
+  int checkpoint_flag[CHECKPOINTS];
+  int checkpoint_used[CHECKPOINTS];
+
+  /* Issue queue, an entry is free when its pc is 0 */
+  CPU_Stage issue_queue[IQ_SIZE];
 
-  /*Physical register file*/
-  int phy_regs[24];
-  int phy_regs_valid[24];
+  /* Reorder buffer and LSQ, circular in program order */
+  CPU_Stage reorder_buffer[ROB_SIZE];
+  int rob_head;
+  int rob_count;
+  CPU_Stage ls_queue[LSQ_SIZE];
+  int lsq_head;
+  int lsq_count;
 
-  CPU_Stage issue_queue[8];
-  CPU_Stage reorder_buffer[12];
-  CPU_Stage retire_rob[32];
+  /* Dispatch order of the youngest instruction */
+  long next_seq;
 
-  /* Array of 5 CPU_stage */
-  CPU_Stage stage[13];
+  /* Flag to indicate, HALT has committed */
+  int halted;
+
+  /* Flag to indicate, a memory fault reached the head of the ROB */
+  int faulted;
+
+  /* Array of 13 CPU_stage */
+  CPU_Stage stage[NUM_STAGES];
 
   /* Code Memory where instructions are stored */
   APEX_Instruction* code_memory;
   int code_memory_size;
 
-  /* Data Memory */
-  int data_memory[4096];
+  /* Assembled object code memory is mapped from, if any */
+  Apexo_Object object;
+
+  /* Data Memory, sparse 32-bit address space */
+  Data_Memory data_memory;
+
+  /* Options given on the command line */
+  APEX_Options opts;
+
+  /* I-cache and fetch buffer feeding the Fetch stage */
+  Frontend frontend;
+
+  /* Data cache, L2 and DRAM timing */
+  MemSys memsys;
 
   /* Some stats */
   int ins_completed;
 
-} APEX_CPU;
+  /* Top-down accounting of dispatch slots */
+  long dispatch_stalls[NUM_STALLS];	// Unused slots by STALL_* reason
+  long squashed;	// Dispatched instructions flushed before commit
+  int fetch_stall;	// STALL_* reason the decode latch was left empty
+  long drain_start[2];	// HALT drain and memory stalls when HALT dispatched
+  long interval_slots[NUM_TD];	// Slots when the current interval began
+
+  /* Occupancy of the OCC_* structures, sampled at the end of every cycle */
+  Stat_Dist occupancy[NUM_OCC];
+  long full_cycles[NUM_OCC];	// Cycles the structure ended full
+  long blocked[NUM_OCC];	// Cycles dispatch found it full and needed it
+  double host_seconds;	// Host time spent in the simulation loop
+
+  /* Counters only read through the statistics registry */
+  long op_retired[NUM_OPCODES];	// Committed instructions by OP_*
+  long fu_issued[NUM_FUS];	// Instructions started on each FU_*
+  long mispredicts;	// Taken BZ/BNZ, predicted not taken
+  long topdown[NUM_TD];	// Slots of the run, updated when stats are written
+  unsigned long state_hash;	// Hash of regs and data memory, likewise
+
+  /* Every statistic above and of the modules, by name */
+  Stats stats;
 
-APEX_Instruction*
-create_code_memory(const char* filename, int* size);
+  /* Cycles, stalls and retires by PC, with --profile */
+  Profile profile;
+
+  /* Dependence graph of the committed instructions, with --critpath */
+  Critpath critpath;
+
+  /* Functional model the retires are checked against, with --check */
+  Checker checker;
+
+  /* Functional model of the functional mode and --fast-forward, running
+   * on data_memory
+   */
+  Func_Model model;
+
+} APEX_CPU;
 
 APEX_CPU*
-APEX_cpu_init(const char* filename);
+APEX_cpu_init(const char* filename, const APEX_Options* opts);
 
 int
 APEX_cpu_run(APEX_CPU* cpu, char * argv[], int n);
@@ -0,0 +1,353 @@
+/*
+ *  critpath.c
+ *  Contains the critical path analysis of the committed instructions
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "critpath.h"
+
+enum
+{
+  NODE_D,
+  NODE_E,
+  NODE_C
+};
+
+static long
+node_id(long inst, int node)
+{
+  return 3 * inst + node;
+}
+
+static Critpath_Entry*
+entry(const Critpath* cp, long inst)
+{
+  return &cp->window[inst % CRITPATH_WINDOW];
+}
+
+static Critpath_Node*
+node(const Critpath* cp, long id)
+{
+  return &entry(cp, id / 3)->node[id % 3];
+}
+
+/* Returns 0 on success, -1 if the window could not be allocated */
+int
+critpath_init(Critpath* cp, int size, int rob_size)
+{
+  memset(cp, 0, sizeof(*cp));
+  cp->window = calloc(CRITPATH_WINDOW, sizeof(*cp->window));
+  cp->pc_cycles = calloc(size ? size : 1, sizeof(*cp->pc_cycles));
+  cp->pc_names = calloc(size ? size : 1, sizeof(*cp->pc_names));
+  cp->pc_text = calloc(size ? size : 1, sizeof(*cp->pc_text));
+  if (!cp->window || !cp->pc_cycles || !cp->pc_names || !cp->pc_text) {
+    critpath_free(cp);
+    return -1;
+  }
+
+  for (int i = 0; i < size; ++i) {
+    snprintf(cp->pc_text[i], sizeof(cp->pc_text[i]), "%d", 4000 + 4 * i);
+    cp->pc_names[i] = cp->pc_text[i];
+  }
+  for (int i = 0; i < CRITPATH_REGS; ++i) {
+    cp->last_writer[i] = -1;
+  }
+  for (int i = 0; i < CRITPATH_STORES; ++i) {
+    cp->store_inst[i] = -1;
+  }
+  cp->size = size;
+  cp->rob_size = rob_size;
+  cp->cut = -1;
+  return 0;
+}
+
+void
+critpath_free(Critpath* cp)
+{
+  free(cp->window);
+  free(cp->pc_cycles);
+  free(cp->pc_names);
+  free(cp->pc_text);
+  cp->window = NULL;
+  cp->pc_cycles = NULL;
+  cp->pc_names = NULL;
+  cp->pc_text = NULL;
+  cp->size = 0;
+}
+
+/* Offers an edge from node from to n, kept if it arrived last. On a tie
+ * the edge offered first wins, so D to E beats a producer that finished
+ * the cycle the consumer dispatched
+ */
+static void
+arrive(Critpath* cp, Critpath_Node* n, long from, int edge)
+{
+  const Critpath_Node* src;
+
+  if (from < node_id(cp->first, NODE_D)) {
+    return;
+  }
+
+  src = node(cp, from);
+  if (src->cycle > n->cycle) {
+    return;
+  }
+  if (n->parent < 0 || src->cycle > node(cp, n->parent)->cycle) {
+    n->parent = from;
+    n->edge = edge;
+  }
+}
+
+/* Adds the edges from node id back to the last charged node to the path */
+static void
+charge(Critpath* cp, long id)
+{
+  long v = id;
+
+  while (v > cp->cut) {
+    const Critpath_Node* n = node(cp, v);
+    unsigned int index = (unsigned int)(entry(cp, v / 3)->pc - 4000) / 4;
+    long cycles;
+
+    /* The first node, or a forced cut left this path behind */
+    if (n->parent < node_id(cp->first, NODE_D)) {
+      break;
+    }
+
+    cycles = n->cycle - node(cp, n->parent)->cycle;
+    cp->edge[n->edge] += cycles;
+    cp->length += cycles;
+    if (index < (unsigned int)cp->size) {
+      cp->pc_cycles[index] += cycles;
+    }
+    v = n->parent;
+  }
+  cp->cut = id;
+}
+
+/*
+ * Makes room in the window. Every later node can only have an edge from
+ * the nodes of the last ROB size instructions, so the oldest node where
+ * their paths join the path of the newest commit is on the final path.
+ * The path up to it is charged and the instructions before it dropped
+ */
+static void
+cut(Critpath* cp)
+{
+  long newest = node_id(cp->next - 1, NODE_C);
+  long live = cp->next - cp->rob_size;
+  long meet = newest;
+  long walk = ++cp->walks;
+
+  for (long v = newest; v >= 0 && v >= cp->cut; v = node(cp, v)->parent) {
+    node(cp, v)->mark = walk;
+    if (v == cp->cut) {
+      break;
+    }
+  }
+
+  for (long v = node_id(live < cp->first ? cp->first : live, NODE_D);
+       v < newest && meet > cp->cut; ++v) {
+    long u = v;
+
+    while (u > cp->cut && node(cp, u)->mark != walk) {
+      u = node(cp, u)->parent;
+    }
+    if (u <= cp->cut) {
+      u = cp->cut;
+    }
+    if (u < meet) {
+      meet = u;
+    }
+  }
+
+  /* Paths that never met leave nothing to drop, cut short at half the
+   * window instead and accept the error
+   */
+  if (cp->next - meet / 3 > CRITPATH_WINDOW * 3 / 4) {
+    long half = node_id(cp->next - CRITPATH_WINDOW / 2, NODE_C);
+
+    meet = newest;
+    while (meet > half && node(cp, meet)->parent >= 0) {
+      meet = node(cp, meet)->parent;
+    }
+    cp->forced++;
+  }
+
+  charge(cp, meet);
+  cp->first = meet / 3;
+}
+
+/* Adds a committed instruction and its incoming edges to the graph */
+void
+critpath_commit(Critpath* cp, const Critpath_Inst* ins)
+{
+  long i = cp->next;
+  unsigned int slot = (unsigned int)ins->mem_address % CRITPATH_STORES;
+  Critpath_Entry* e;
+  Critpath_Node* d;
+  Critpath_Node* x;
+  Critpath_Node* c;
+
+  if (!cp->window) {
+    return;
+  }
+  if (i - cp->first == CRITPATH_WINDOW) {
+    cut(cp);
+  }
+
+  e = entry(cp, i);
+  e->pc = ins->pc;
+  e->redirect = ins->redirect;
+  d = &e->node[NODE_D];
+  x = &e->node[NODE_E];
+  c = &e->node[NODE_C];
+  d->cycle = ins->dispatch;
+  x->cycle = ins->complete;
+  c->cycle = ins->commit;
+  for (int k = NODE_D; k <= NODE_C; ++k) {
+    e->node[k].parent = -1;
+    e->node[k].edge = CP_FETCH;
+    e->node[k].mark = 0;
+  }
+
+  if (i > 0) {
+    arrive(cp, d, node_id(i - 1, NODE_D), CP_FETCH);
+    if (entry(cp, i - 1)->redirect) {
+      arrive(cp, d, node_id(i - 1, NODE_E), CP_MISPREDICT);
+    }
+  }
+  if (i >= cp->rob_size) {
+    arrive(cp, d, node_id(i - cp->rob_size, NODE_C), CP_ROB);
+  }
+
+  arrive(cp, x, node_id(i, NODE_D), CP_EXECUTE);
+  for (int k = 0; k < ins->srcs; ++k) {
+    long producer = cp->last_writer[ins->src[k]];
+
+    if (producer >= 0) {
+      arrive(cp, x, node_id(producer, NODE_E), CP_REG);
+    }
+  }
+
+  if (ins->load && cp->store_inst[slot] >= 0 &&
+      cp->store_address[slot] == ins->mem_address) {
+    arrive(cp, x, node_id(cp->store_inst[slot], NODE_E), CP_MEM);
+  }
+
+  arrive(cp, c, node_id(i, NODE_E), CP_COMPLETE);
+  if (i > 0) {
+    arrive(cp, c, node_id(i - 1, NODE_C), CP_COMMIT);
+  }
+
+  for (int k = 0; k < ins->dests; ++k) {
+    cp->last_writer[ins->dest[k]] = i;
+  }
+  if (ins->store) {
+    cp->store_address[slot] = ins->mem_address;
+    cp->store_inst[slot] = i;
+  }
+  cp->next++;
+}
+
+/* Charges the rest of the path, back from the last commit */
+void
+critpath_finish(Critpath* cp)
+{
+  if (cp->window && cp->next) {
+    charge(cp, node_id(cp->next - 1, NODE_C));
+  }
+}
+
+static const char* edge_names[NUM_CP_EDGES] = {
+  [CP_FETCH] = "fetch",
+  [CP_MISPREDICT] = "mispredict",
+  [CP_ROB] = "rob",
+  [CP_EXECUTE] = "execute",
+  [CP_REG] = "reg",
+  [CP_MEM] = "mem",
+  [CP_COMPLETE] = "complete",
+  [CP_COMMIT] = "commit",
+};
+
+/* Prints the cycles of the path by edge type, and the instructions the
+ * most of them led to
+ */
+void
+critpath_print_stats(const Critpath* cp, const APEX_Instruction* code,
+                     long cycles)
+{
+  static const char* names[NUM_CP_EDGES] = {
+    [CP_FETCH] = "Fetch order",
+    [CP_MISPREDICT] = "Branch mispredict",
+    [CP_ROB] = "ROB capacity",
+    [CP_EXECUTE] = "Issue and execute",
+    [CP_REG] = "Register RAW",
+    [CP_MEM] = "Store to load",
+    [CP_COMPLETE] = "Wait to commit",
+    [CP_COMMIT] = "Commit order",
+  };
+  int hottest[CRITPATH_HOTTEST];
+  int listed = 0;
+  double length = cp->length ? cp->length : 1;
+
+  if (!cp->window) {
+    return;
+  }
+
+  printf("============= Critical Path =============\n");
+  printf("| Length                | %ld of %ld cycles |\n", cp->length,
+         cycles);
+  for (int i = 0; i < NUM_CP_EDGES; ++i) {
+    printf("| %-21s | %ld | %.1f%% |\n", names[i], cp->edge[i],
+           100.0 * cp->edge[i] / length);
+  }
+  if (cp->forced) {
+    printf("| Forced cuts           | %ld |\n", cp->forced);
+  }
+
+  /* Keep the CRITPATH_HOTTEST instructions with the most cycles */
+  for (int i = 0; i < cp->size; ++i) {
+    int pos = listed < CRITPATH_HOTTEST ? listed++ : CRITPATH_HOTTEST;
+
+    while (pos > 0 && cp->pc_cycles[hottest[pos - 1]] < cp->pc_cycles[i]) {
+      if (pos < CRITPATH_HOTTEST) {
+        hottest[pos] = hottest[pos - 1];
+      }
+      pos--;
+    }
+    if (pos < CRITPATH_HOTTEST) {
+      hottest[pos] = i;
+    }
+  }
+
+  printf("| %-21s | Cycles | Share |\n", "Instruction");
+  for (int i = 0; i < listed && cp->pc_cycles[hottest[i]]; ++i) {
+    char text[32];
+
+    snprintf(text, sizeof(text), "%d %s", 4000 + 4 * hottest[i],
+             code[hottest[i]].opcode);
+    printf("| %-21s | %ld | %.1f%% |\n", text, cp->pc_cycles[hottest[i]],
+           100.0 * cp->pc_cycles[hottest[i]] / length);
+  }
+}
+
+void
+critpath_register_stats(Critpath* cp, Stats* stats)
+{
+  if (!cp->window) {
+    return;
+  }
+
+  stats_group(stats, "critpath");
+  stats_long(stats, "length", &cp->length,
+             "Cycles of the critical path charged so far");
+  stats_vector(stats, "edges", cp->edge, NUM_CP_EDGES, edge_names,
+               "Critical path cycles by dependence edge");
+  stats_vector(stats, "pc", cp->pc_cycles, cp->size, cp->pc_names,
+               "Critical path cycles by the instruction they led to");
+  stats_long(stats, "forced", &cp->forced,
+             "Cuts made before the live paths met");
+}
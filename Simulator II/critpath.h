@@ -0,0 +1,121 @@
+#ifndef _APEX_CRITPATH_H_
+#define _APEX_CRITPATH_H_
+/**
+ *  critpath.h
+ *  Contains the critical path analysis of the committed instructions.
+ *  Each instruction adds three nodes to the dynamic dependence graph, at
+ *  the cycles they happened: dispatch (D), result (E) and commit (C). A
+ *  node only keeps the incoming edge that arrived last, so following those
+ *  edges back from the last commit gives the critical path of the run.
+ *
+ *  Only a window of recent instructions is kept. Once it fills, the node
+ *  every path from the live instructions leads back through is found; the
+ *  path up to it can no longer change, so it is charged and dropped.
+ */
+#include "isa.h"
+#include "stats.h"
+
+/* Instructions kept in the window, must be well above the ROB size */
+#define CRITPATH_WINDOW 4096
+
+/* Stores remembered for store to load edges, by address */
+#define CRITPATH_STORES 256
+
+/* Instructions of the path listed after the edge breakdown */
+#define CRITPATH_HOTTEST 10
+
+/* Registers tracked for read after write edges, the zero flag is last */
+#define CRITPATH_FLAG ISA_REGS
+#define CRITPATH_REGS (ISA_REGS + 1)
+
+/* Edges of the dependence graph */
+enum
+{
+  CP_FETCH,		// D to D: fetch and dispatch in program order
+  CP_MISPREDICT,	// E to D: refetch after a taken branch
+  CP_ROB,		// C to D: ROB entry freed by the commit ROB size older
+  CP_EXECUTE,		// D to E: wait in the IQ, then execution
+  CP_REG,		// E to E: register or zero flag read after write
+  CP_MEM,		// E to E: load of the address an older store wrote
+  CP_COMPLETE,		// E to C: commit waiting for the result
+  CP_COMMIT,		// C to C: commit in program order
+  NUM_CP_EDGES
+};
+
+/* Committed instruction, as the pipeline saw it */
+typedef struct Critpath_Inst
+{
+  int pc;
+  long dispatch;	// Cycles of its D, E and C nodes
+  long complete;
+  long commit;
+  int src[3];		// Registers read, CRITPATH_FLAG for the zero flag
+  int srcs;
+  int dest[2];		// Registers written
+  int dests;
+  int load;		// Flag to indicate, it read mem_address
+  int store;		// Flag to indicate, it wrote mem_address
+  int mem_address;
+  int redirect;		// Flag to indicate, fetch restarted after it
+} Critpath_Inst;
+
+/* Node of the dependence graph, ids are 3 * instruction + D, E or C */
+typedef struct Critpath_Node
+{
+  long cycle;
+  long parent;		// Node the last-arriving edge came from, -1 if none
+  int edge;		// CP_* of that edge
+  long mark;		// Last cut that walked through it
+} Critpath_Node;
+
+typedef struct Critpath_Entry
+{
+  int pc;
+  int redirect;
+  Critpath_Node node[3];
+} Critpath_Entry;
+
+/* Model of the analysis, off when window is NULL */
+typedef struct Critpath
+{
+  Critpath_Entry* window;	// CRITPATH_WINDOW instructions, circular
+  long first;		// Oldest instruction in the window
+  long next;		// Instructions committed
+  long cut;		// Node the path is charged back from, -1 if none yet
+  long walks;		// Cuts made so far, marks the nodes of each
+  int rob_size;
+
+  long last_writer[CRITPATH_REGS];	// Instruction, -1 if none committed
+  int store_address[CRITPATH_STORES];
+  long store_inst[CRITPATH_STORES];	// -1 if the slot is unused
+
+  long* pc_cycles;	// Path cycles by instruction of code memory
+  const char** pc_names;	// Labels of pc_cycles, the pc of each
+  char (*pc_text)[12];
+  int size;
+
+  long edge[NUM_CP_EDGES];	// Path cycles by CP_* edge
+  long length;		// Path cycles charged so far
+  long forced;		// Cuts made where the live paths had not met
+} Critpath;
+
+int
+critpath_init(Critpath* cp, int size, int rob_size);
+
+void
+critpath_free(Critpath* cp);
+
+void
+critpath_commit(Critpath* cp, const Critpath_Inst* ins);
+
+void
+critpath_finish(Critpath* cp);
+
+void
+critpath_print_stats(const Critpath* cp, const APEX_Instruction* code,
+                     long cycles);
+
+void
+critpath_register_stats(Critpath* cp, Stats* stats);
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _APEX_DATAMEM_H_
+#define _APEX_DATAMEM_H_
+/**
+ *  datamem.h
+ *  Contains the sparse data memory. Every 32-bit data address holds one
+ *  word. Pages are allocated the first time they are written, so a
+ *  program only pays for the memory it touches.
+ */
+#include "stats.h"
+
+/* Words per page, 4 KB of backing store */
+#define DATAMEM_PAGE_BITS 10
+#define DATAMEM_PAGE_WORDS (1U << DATAMEM_PAGE_BITS)
+
+/* Address bits resolved by each level of the page table */
+#define DATAMEM_TABLE_BITS 10
+#define DATAMEM_DIR_BITS (32 - DATAMEM_TABLE_BITS - DATAMEM_PAGE_BITS)
+
+/* Entries in the direct mapped software TLB */
+#define DATAMEM_TLB_ENTRIES 64
+
+/* Hugepage backed regions that can be configured */
+#define DATAMEM_MAX_HUGE 4
+
+/* Mappings owned by the data memory, hugepage regions and one image */
+#define DATAMEM_MAX_MAPS (DATAMEM_MAX_HUGE + 1)
+
+/* A range of addresses backed by one hugepage mapping */
+typedef struct Huge_Region
+{
+  unsigned long base;	// First address, rounded down to a page
+  unsigned long size;	// Addresses covered, rounded up to pages
+} Huge_Region;
+
+typedef struct Data_Memory_Config
+{
+  unsigned long limit;	// Accesses at or above fault, 0 for the whole space
+  int huge_count;
+  Huge_Region huge[DATAMEM_MAX_HUGE];
+} Data_Memory_Config;
+
+/* Model of a software TLB entry */
+typedef struct Datamem_Tlb_Entry
+{
+  unsigned int tag;	// Page number + 1, 0 when invalid
+  int* page;
+} Datamem_Tlb_Entry;
+
+/* Model of the data memory */
+typedef struct Data_Memory
+{
+  Data_Memory_Config config;
+  int** directory[1 << DATAMEM_DIR_BITS];
+  Datamem_Tlb_Entry tlb[DATAMEM_TLB_ENTRIES];
+  void* map[DATAMEM_MAX_MAPS];
+  unsigned long map_bytes[DATAMEM_MAX_MAPS];
+  int map_count;
+
+  /* Some stats */
+  long pages;		    // Pages allocated on first touch
+  long mapped_pages;	// Pages backed by a hugepage region or image
+  long tlb_hits;
+  long tlb_misses;
+  long faults;
+} Data_Memory;
+
+int
+datamem_init(Data_Memory* dm, const Data_Memory_Config* config);
+
+void
+datamem_free(Data_Memory* dm);
+
+int
+datamem_read(Data_Memory* dm, unsigned int address, int* value);
+
+int
+datamem_write(Data_Memory* dm, unsigned int address, int value);
+
+int
+datamem_peek(const Data_Memory* dm, unsigned int address);
+
+int*
+datamem_page(const Data_Memory* dm, unsigned int page);
+
+int
+datamem_attach(Data_Memory* dm, unsigned int first_page, void* map,
+               unsigned long bytes, unsigned long words);
+
+void
+datamem_print_stats(const Data_Memory* dm);
+
+void
+datamem_register_stats(const Data_Memory* dm, Stats* stats);
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ *  image.c
+ *  Contains functions to load and dump binary images.
+ *
+ *  A memory image is mapped copy-on-write and its pages are handed to the
+ *  data memory as they are, so loading costs no copy. Dumps map the
+ *  output file and copy only the pages that exist, untouched ranges stay
+ *  holes in the file.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "image.h"
+
+#define FNV_OFFSET 14695981039346656037UL
+#define FNV_PRIME 1099511628211UL
+
+/*
+ * Maps filename into data memory from address base, which must be the
+ * start of a page.
+ * Returns 0 on success, -1 on failure
+ */
+int
+image_load_memory(Data_Memory* dm, const char* filename, unsigned long base)
+{
+  struct stat st;
+  void* map;
+  int fd;
+
+  if (base & (DATAMEM_PAGE_WORDS - 1)) {
+    fprintf(stderr, "APEX_Error : Image base %lu is not a multiple of %u\n",
+            base, DATAMEM_PAGE_WORDS);
+    return -1;
+  }
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    perror(filename);
+    return -1;
+  }
+
+  if (fstat(fd, &st) || st.st_size % sizeof(int) ||
+      base + st.st_size / sizeof(int) > (1UL << 32)) {
+    fprintf(stderr, "APEX_Error : %s is not a valid memory image\n",
+            filename);
+    close(fd);
+    return -1;
+  }
+
+  if (st.st_size == 0) {
+    close(fd);
+    return 0;
+  }
+
+  map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    perror(filename);
+    return -1;
+  }
+
+  return datamem_attach(dm, base >> DATAMEM_PAGE_BITS, map, st.st_size,
+                        st.st_size / sizeof(int));
+}
+
+/* Returns one past the highest address holding a non-zero word */
+static unsigned long
+memory_end(const Data_Memory* dm)
+{
+  for (long d = (1 << DATAMEM_DIR_BITS) - 1; d >= 0; --d) {
+    if (!dm->directory[d]) {
+      continue;
+    }
+    for (long t = (1 << DATAMEM_TABLE_BITS) - 1; t >= 0; --t) {
+      const int* page = dm->directory[d][t];
+
+      for (long w = DATAMEM_PAGE_WORDS - 1; page && w >= 0; --w) {
+        if (page[w]) {
+          return ((((unsigned long)d << DATAMEM_TABLE_BITS) + t)
+                  << DATAMEM_PAGE_BITS) + w + 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+ * Writes data memory from address 0 up to the last non-zero word.
+ * Returns 0 on success, -1 on failure
+ */
+int
+image_save_memory(const Data_Memory* dm, const char* filename)
+{
+  unsigned long end = memory_end(dm);
+  unsigned long bytes = end * sizeof(int);
+  char* map;
+  int fd;
+
+  fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    perror(filename);
+    return -1;
+  }
+
+  if (bytes == 0) {
+    close(fd);
+    return 0;
+  }
+
+  if (ftruncate(fd, bytes)) {
+    perror(filename);
+    close(fd);
+    return -1;
+  }
+
+  map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    perror(filename);
+    return -1;
+  }
+
+  for (unsigned long page = 0; page << DATAMEM_PAGE_BITS < end; ++page) {
+    const int* words = datamem_page(dm, page);
+    unsigned long offset = (page << DATAMEM_PAGE_BITS) * sizeof(int);
+    unsigned long size = DATAMEM_PAGE_WORDS * sizeof(int);
+
+    if (!words) {
+      continue;
+    }
+    if (offset + size > bytes) {
+      size = bytes - offset;
+    }
+    memcpy(map + offset, words, size);
+  }
+
+  munmap(map, bytes);
+  return 0;
+}
+
+/*
+ * Writes count words to filename.
+ * Returns 0 on success, -1 on failure
+ */
+int
+image_save_words(const char* filename, const int* words, int count)
+{
+  FILE* fp = fopen(filename, "wb");
+
+  if (!fp) {
+    perror(filename);
+    return -1;
+  }
+
+  if (fwrite(words, sizeof(int), count, fp) != (size_t)count) {
+    perror(filename);
+    fclose(fp);
+    return -1;
+  }
+  return fclose(fp) ? -1 : 0;
+}
+
+/* FNV-1a taking a whole word per step rather than a byte */
+static unsigned long
+hash_word(unsigned long hash, unsigned int word)
+{
+  return (hash ^ word) * FNV_PRIME;
+}
+
+/*
+ * Hash of the registers followed by every non-zero memory word
+ * and its address, in address order. Memory that was never written
+ * hashes the same as memory that was written with zeroes
+ */
+unsigned long
+image_hash(const Data_Memory* dm, const int* regs, int count)
+{
+  unsigned long hash = FNV_OFFSET;
+
+  for (int i = 0; i < count; ++i) {
+    hash = hash_word(hash, regs[i]);
+  }
+
+  for (unsigned long d = 0; d < (1UL << DATAMEM_DIR_BITS); ++d) {
+    if (!dm->directory[d]) {
+      continue;
+    }
+    for (unsigned long t = 0; t < (1UL << DATAMEM_TABLE_BITS); ++t) {
+      const int* page = dm->directory[d][t];
+      unsigned long base = ((d << DATAMEM_TABLE_BITS) + t)
+                           << DATAMEM_PAGE_BITS;
+
+      for (unsigned long w = 0; page && w < DATAMEM_PAGE_WORDS; ++w) {
+        if (page[w]) {
+          hash = hash_word(hash, base + w);
+          hash = hash_word(hash, page[w]);
+        }
+      }
+    }
+  }
+  return hash;
+}
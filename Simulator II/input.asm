@@ -1,5 +1,5 @@
-MOVC,R0,#0 R0
-MOVC,R3,#3 R3
+MOVC,R0,#0
+MOVC,R3,#3
 ADD,R4,R0,R3
 MUL,R6,R4,R4
 STORE,R6,R0,#4
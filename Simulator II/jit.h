@@ -0,0 +1,84 @@
+#ifndef _APEX_JIT_H_
+#define _APEX_JIT_H_
+/**
+ *  jit.h
+ *  Contains the translator of the functional model. Basic blocks, which
+ *  end at a BZ, BNZ, JUMP or HALT, are counted as the interpreter enters
+ *  them, and once hot are translated to x86-64 code in an executable
+ *  mapping. Within a block the registers it uses most live in host
+ *  registers. A block's exits jump straight to the blocks they go to once
+ *  those are translated, so loops run without leaving translated code.
+ *
+ *  Translations are kept by the code index of their first pc. When the
+ *  mapping is full every translation is dropped and blocks are translated
+ *  again as they get hot. On other hosts, or if the mapping can not be
+ *  made executable, the model only interprets.
+ */
+#include "funcmodel.h"
+#include "stats.h"
+
+/* Bytes of translated code */
+#define JIT_BUFFER_BYTES (4 << 20)
+
+/* Entries into a block before it is translated */
+#define JIT_HOT 16
+
+/* Instructions in a block at most */
+#define JIT_MAX_BLOCK 64
+
+/* A jump of translated code to a block not translated yet */
+typedef struct Jit_Exit
+{
+  int offset;		// Of its rel32 in the buffer
+  int target;		// Code index it goes to
+} Jit_Exit;
+
+/* Model of the translator */
+typedef struct Jit
+{
+  const APEX_Instruction* code;
+  int code_size;
+
+  unsigned char* buffer;
+  size_t used;		// Bytes of buffer holding code
+  size_t base;		// Of them, the entry and exit code, kept by a flush
+  long (*enter)(Func_Model* fm, const void* block, long count);
+  const unsigned char* leave;	// Returns to enter's caller
+
+  const void** cache;	// Translation of each code index, NULL if none
+  int* heat;		// Entries into each code index, untranslated
+  int* length;		// Instructions of the block there, 0 if unknown
+
+  Jit_Exit* exits;
+  int exit_count;
+  int exit_capacity;
+
+  /* Some stats */
+  long blocks;		// Blocks translated
+  long chained;		// Exits jumping straight to another block
+  long flushes;		// Times every translation was dropped
+  long instructions;	// Instructions run in translated code
+} Jit;
+
+int
+jit_init(Jit* jit, const APEX_Instruction* code, int size);
+
+void
+jit_free(Jit* jit);
+
+void
+jit_flush(Jit* jit);
+
+int
+jit_block_length(Jit* jit, int pc);
+
+long
+jit_run(Jit* jit, Func_Model* fm, long count);
+
+void
+jit_print_stats(const Jit* jit);
+
+void
+jit_register_stats(Jit* jit, Stats* stats);
+
+#endif
@@ -0,0 +1,776 @@
+/*
+ *  memsys.c
+ *  Contains the data memory hierarchy timing model.
+ *
+ *  An access walks L1 D-cache -> L2 -> DRAM. Hits complete after the sum of
+ *  the hit latencies of the levels visited. Misses in the last cache level
+ *  are queued at the DRAM controller, which every cycle picks, per idle bank,
+ *  the oldest row buffer hit or else the oldest request (FR-FCFS). Lines are
+ *  filled into the caches when the access completes.
+ *
+ *  Prefetches travel the same way but nobody waits on them, they are
+ *  filled into the L1 D-cache, or the L2 when there is no L1 D-cache.
+ *
+ *  Misses in that first data cache level hold an MSHR until their line
+ *  arrives. Further misses to the same line merge into the outstanding one
+ *  instead of going down the hierarchy again.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memsys.h"
+
+/* First cache level on the data path, NULL if there is none */
+static Cache*
+data_cache(MemSys* ms)
+{
+  if (ms->l1d.config.sets) {
+    return &ms->l1d;
+  }
+  if (ms->l2.config.sets) {
+    return &ms->l2;
+  }
+  return NULL;
+}
+
+int
+memsys_init(MemSys* ms, const Cache_Config* l1d, const Cache_Config* l2,
+            const Dram_Config* dram, const Prefetch_Config* prefetch,
+            int mshrs)
+{
+  Cache* target;
+
+  memset(ms, 0, sizeof(*ms));
+  dist_init(&ms->latency, 4);
+
+  if (cache_init(&ms->l1d, l1d) || cache_init(&ms->l2, l2)) {
+    return -1;
+  }
+
+  ms->mshrs = mshrs;
+  target = data_cache(ms);
+  prefetch_init(&ms->prefetcher, prefetch, target ? target->config.line_size : 0);
+
+  ms->dram.config = *dram;
+  if (dram->banks <= 0) {
+    return 0;
+  }
+
+  if (dram->row_size <= 0 || dram->queue_size <= 0) {
+    return -1;
+  }
+
+  /* Writebacks may overrun the queue limit seen by reads */
+  ms->dram.queue_capacity = dram->queue_size * 2;
+  ms->dram.queue = calloc(ms->dram.queue_capacity, sizeof(Dram_Request));
+  ms->dram.bank = calloc(dram->banks, sizeof(Dram_Bank));
+  if (!ms->dram.queue || !ms->dram.bank) {
+    return -1;
+  }
+
+  for (int i = 0; i < dram->banks; ++i) {
+    ms->dram.bank[i].open_row = -1;
+  }
+  return 0;
+}
+
+void
+memsys_free(MemSys* ms)
+{
+  cache_free(&ms->l1d);
+  cache_free(&ms->l2);
+  free(ms->dram.queue);
+  free(ms->dram.bank);
+}
+
+/* Any level modelled behind the data path */
+int
+memsys_enabled(const MemSys* ms)
+{
+  return ms->l1d.config.sets || ms->l2.config.sets || ms->dram.config.banks;
+}
+
+/* Any level modelled behind the L1 caches */
+int
+memsys_backend_enabled(const MemSys* ms)
+{
+  return ms->l2.config.sets || ms->dram.config.banks;
+}
+
+/* Converts a data memory word address into a hierarchy byte address */
+unsigned long
+memsys_data_address(int mem_address)
+{
+  return MEMSYS_DATA_SPACE + (unsigned long)(unsigned)mem_address * 4;
+}
+
+static int
+dram_enqueue(MemSys* ms, unsigned long address, int is_write, long arrival,
+             int request)
+{
+  Dram* dram = &ms->dram;
+  unsigned long row_index = address / dram->config.row_size;
+
+  if (dram->count == dram->queue_capacity) {
+    /* Write buffer overflow, the writeback is dropped rather than served */
+    dram->queue_full++;
+    return -1;
+  }
+
+  for (int i = 0; i < dram->queue_capacity; ++i) {
+    Dram_Request* entry = &dram->queue[i];
+    if (!entry->valid) {
+      entry->valid = 1;
+      entry->address = address;
+      entry->bank = row_index % dram->config.banks;
+      entry->row = row_index / dram->config.banks;
+      entry->is_write = is_write;
+      entry->arrival = arrival;
+      entry->request = request;
+      dram->count++;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/* Sends a dirty line evicted from level 1 (L1D) or level 2 further down */
+static void
+write_back(MemSys* ms, int level, unsigned long victim, long clock)
+{
+  unsigned long l2_victim;
+
+  if (level == 1 && ms->l2.config.sets) {
+    if (cache_fill(&ms->l2, victim, 1, &l2_victim)) {
+      write_back(ms, 2, l2_victim, clock);
+    }
+    return;
+  }
+
+  if (ms->dram.config.banks) {
+    dram_enqueue(ms, victim, 1, clock, 0);
+  }
+}
+
+/* Fills the missing levels once an access has completed */
+static void
+finish_request(MemSys* ms, Mem_Request* r, long clock)
+{
+  unsigned long victim;
+  long latency;
+
+  if (r->done || r->primary || r->waiting_dram || clock < r->ready) {
+    return;
+  }
+
+  if (r->fill_l2) {
+    int evicted = r->prefetch && !r->fill_l1
+                    ? cache_prefetch_fill(&ms->l2, r->address, &victim)
+                    : cache_fill(&ms->l2, r->address, 0, &victim);
+    if (evicted) {
+      write_back(ms, 2, victim, clock);
+    }
+  }
+
+  if (r->fill_l1) {
+    int evicted = r->prefetch
+                    ? cache_prefetch_fill(&ms->l1d, r->address, &victim)
+                    : cache_fill(&ms->l1d, r->address, r->kind == MEM_WRITE,
+                                 &victim);
+    if (evicted) {
+      write_back(ms, 1, victim, clock);
+    }
+  }
+
+  if (!r->prefetch) {
+    latency = r->ready - r->issued + 1;
+    ms->total_latency += latency;
+    dist_sample(&ms->latency, latency);
+    if (latency > ms->max_latency) {
+      ms->max_latency = latency;
+    }
+  }
+
+  r->done = 1;
+
+  /* Accesses merged into this miss complete with it */
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    Mem_Request* q = &ms->request[i];
+    if (q->valid && q->primary == r - ms->request + 1) {
+      q->primary = 0;
+      q->ready = r->ready;
+    }
+  }
+
+  if (r->orphan) {
+    r->valid = 0;
+  }
+}
+
+/* Finds an access still in flight for the line holding address */
+static Mem_Request*
+find_in_flight(MemSys* ms, const Cache* cache, unsigned long address)
+{
+  unsigned long line = cache_line_address(cache, address);
+
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    Mem_Request* r = &ms->request[i];
+    if (r->valid && !r->done &&
+        cache_line_address(cache, r->address) == line) {
+      return r;
+    }
+  }
+  return NULL;
+}
+
+/* Misses holding an MSHR, including prefetches */
+static int
+outstanding_misses(const MemSys* ms)
+{
+  int n = 0;
+
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    const Mem_Request* r = &ms->request[i];
+    if (r->valid && !r->done && r->miss && !r->primary) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/* Hands a prefetch still in flight over to a demand access of the same line */
+static int
+take_over_prefetch(MemSys* ms, unsigned long address, int kind, long clock)
+{
+  Cache* target = data_cache(ms);
+  Mem_Request* r;
+
+  if (kind == MEM_IFETCH || !prefetch_enabled(&ms->prefetcher) ||
+      cache_probe(target, address)) {
+    return 0;
+  }
+
+  r = find_in_flight(ms, target, address);
+  if (!r || !r->prefetch) {
+    return 0;
+  }
+
+  /* The demand still looked up and missed the cache */
+  cache_lookup(target, address, kind == MEM_WRITE);
+
+  r->prefetch = 0;
+  r->orphan = 0;
+  r->kind = kind;
+  r->issued = clock;
+  ms->accesses++;
+  ms->prefetch_late++;
+  return r - ms->request + 1;
+}
+
+/*
+ * Starts an access.
+ * Returns a handle (> 0) to poll with memsys_done(), or 0 if the access
+ * cannot be accepted this cycle and must be retried
+ */
+int
+memsys_request(MemSys* ms, unsigned long address, int kind, long clock)
+{
+  Mem_Request* r = NULL;
+  Mem_Request* primary = NULL;
+  Cache* first = data_cache(ms);
+  int handle = take_over_prefetch(ms, address, kind, clock);
+  int latency = 0;
+  int hit = 0;
+  int use_l1 = kind != MEM_IFETCH && ms->l1d.config.sets;
+
+  if (handle) {
+    return handle;
+  }
+
+  /* A miss to a line already on its way waits for that line */
+  if (kind != MEM_IFETCH && first && !cache_probe(first, address)) {
+    primary = find_in_flight(ms, first, address);
+    if (primary && (!primary->miss || primary->kind == MEM_IFETCH)) {
+      primary = NULL;
+    }
+  }
+
+  if (kind != MEM_IFETCH && !primary && ms->mshrs &&
+      !(first && cache_probe(first, address)) &&
+      outstanding_misses(ms) >= ms->mshrs) {
+    ms->mshr_full++;
+    return 0;
+  }
+
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    if (!ms->request[i].valid) {
+      r = &ms->request[i];
+      handle = i + 1;
+      break;
+    }
+  }
+  if (!r) {
+    return 0;
+  }
+
+  /* Refuse before touching any state if the access would need a full queue */
+  if (!primary && ms->dram.config.banks &&
+      !(use_l1 && cache_probe(&ms->l1d, address)) &&
+      !(ms->l2.config.sets && cache_probe(&ms->l2, address)) &&
+      ms->dram.count >= ms->dram.config.queue_size) {
+    ms->dram.queue_full++;
+    return 0;
+  }
+
+  memset(r, 0, sizeof(*r));
+  r->valid = 1;
+  r->address = address;
+  r->kind = kind;
+  r->issued = clock;
+  ms->accesses++;
+
+  if (primary) {
+    cache_lookup(first, address, kind == MEM_WRITE);
+    r->primary = primary - ms->request + 1;
+    r->fill_l1 = use_l1 && kind == MEM_WRITE;
+    ms->mshr_merged++;
+    return handle;
+  }
+
+  if (use_l1) {
+    latency += ms->l1d.config.hit_latency;
+    hit = cache_lookup(&ms->l1d, address, kind == MEM_WRITE);
+    r->fill_l1 = !hit;
+  }
+
+  if (!hit && ms->l2.config.sets) {
+    latency += ms->l2.config.hit_latency;
+    hit = cache_lookup(&ms->l2, address, 0);
+    r->fill_l2 = !hit;
+  }
+
+  r->miss = kind != MEM_IFETCH && (!first || (use_l1 ? r->fill_l1 : r->fill_l2));
+
+  if (!hit && ms->dram.config.banks) {
+    r->waiting_dram = 1;
+    dram_enqueue(ms, address, 0, clock + latency, handle);
+    return handle;
+  }
+
+  if (!hit) {
+    latency += ms->l2.config.sets ? ms->l2.config.miss_penalty
+                                  : ms->l1d.config.miss_penalty;
+  }
+
+  r->ready = clock + (latency > 0 ? latency - 1 : 0);
+  finish_request(ms, r, clock);
+  return handle;
+}
+
+/*
+ * Returns 1 once the access behind handle has completed, the handle is
+ * released at that point
+ */
+int
+memsys_done(MemSys* ms, int handle, long clock)
+{
+  Mem_Request* r = &ms->request[handle - 1];
+
+  finish_request(ms, r, clock);
+  if (!r->done) {
+    return 0;
+  }
+
+  r->valid = 0;
+  return 1;
+}
+
+/* Drops interest in an access, e.g. a squashed load */
+void
+memsys_cancel(MemSys* ms, int handle)
+{
+  Mem_Request* r = &ms->request[handle - 1];
+
+  r->orphan = 1;
+  if (r->done) {
+    r->valid = 0;
+  }
+}
+
+/* Starts a prefetch of the line holding address, if it is worth it */
+static void
+issue_prefetch(MemSys* ms, unsigned long address, long clock)
+{
+  Cache* target = data_cache(ms);
+  Mem_Request* r = NULL;
+  int latency = 0;
+  int hit = 0;
+
+  /* Never wander out of the data space */
+  if (address < MEMSYS_DATA_SPACE || cache_probe(target, address) ||
+      find_in_flight(ms, target, address)) {
+    return;
+  }
+
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    if (!ms->request[i].valid) {
+      r = &ms->request[i];
+      break;
+    }
+  }
+
+  /* Prefetches must not take queue space demand accesses are waiting for */
+  if (!r || (ms->mshrs && outstanding_misses(ms) >= ms->mshrs) ||
+      (ms->dram.config.banks &&
+             !(target == &ms->l1d && ms->l2.config.sets &&
+               cache_probe(&ms->l2, address)) &&
+             ms->dram.count >= ms->dram.config.queue_size)) {
+    ms->prefetch_dropped++;
+    return;
+  }
+
+  memset(r, 0, sizeof(*r));
+  r->valid = 1;
+  r->address = address;
+  r->kind = MEM_READ;
+  r->prefetch = 1;
+  r->miss = 1;
+  r->orphan = 1;
+  r->issued = clock;
+  ms->prefetch_issued++;
+
+  if (target == &ms->l1d) {
+    latency += ms->l1d.config.hit_latency;
+    r->fill_l1 = 1;
+  }
+
+  if (ms->l2.config.sets) {
+    latency += ms->l2.config.hit_latency;
+    hit = target != &ms->l2 && cache_probe(&ms->l2, address);
+    r->fill_l2 = !hit;
+  }
+
+  if (!hit && ms->dram.config.banks) {
+    r->waiting_dram = 1;
+    dram_enqueue(ms, address, 0, clock + latency, r - ms->request + 1);
+    return;
+  }
+
+  if (!hit) {
+    latency += ms->l2.config.sets ? ms->l2.config.miss_penalty
+                                  : ms->l1d.config.miss_penalty;
+  }
+
+  r->ready = clock + (latency > 0 ? latency - 1 : 0);
+  finish_request(ms, r, clock);
+}
+
+/*
+ * Trains the prefetcher with a load made by the pipeline and starts the
+ * prefetches it proposes
+ */
+void
+memsys_prefetch_train(MemSys* ms, int pc, unsigned long address, long clock)
+{
+  unsigned long candidates[2 * PREFETCH_MAX_DEGREE];
+  int n = prefetch_train(&ms->prefetcher, pc, address, candidates);
+
+  for (int i = 0; i < n; ++i) {
+    issue_prefetch(ms, candidates[i], clock);
+  }
+}
+
+/* Issues one request to every idle bank, row buffer hits first */
+static void
+dram_schedule(MemSys* ms, long clock)
+{
+  Dram* dram = &ms->dram;
+
+  for (int b = 0; b < dram->config.banks; ++b) {
+    Dram_Bank* bank = &dram->bank[b];
+    Dram_Request* pick = NULL;
+    int pick_hit = 0;
+
+    if (bank->ready > clock) {
+      continue;
+    }
+
+    for (int i = 0; i < dram->queue_capacity; ++i) {
+      Dram_Request* entry = &dram->queue[i];
+      int hit;
+
+      if (!entry->valid || entry->bank != b || entry->arrival > clock) {
+        continue;
+      }
+
+      hit = entry->row == bank->open_row;
+      if (!pick || (hit && !pick_hit) ||
+          (hit == pick_hit && entry->arrival < pick->arrival)) {
+        pick = entry;
+        pick_hit = hit;
+      }
+    }
+
+    if (!pick) {
+      continue;
+    }
+
+    int latency = dram->config.t_cas;
+    if (pick_hit) {
+      dram->row_hits++;
+    } else if (bank->open_row < 0) {
+      dram->row_misses++;
+      latency += dram->config.t_rcd;
+    } else {
+      dram->row_conflicts++;
+      latency += dram->config.t_rp + dram->config.t_rcd;
+    }
+
+    long data = clock + latency;
+    if (data < dram->bus_ready) {
+      data = dram->bus_ready;
+    }
+    long done = data + dram->config.t_burst;
+    dram->bus_ready = done;
+
+    if (dram->config.closed_page) {
+      bank->open_row = -1;
+      bank->ready = done + dram->config.t_rp;
+    } else {
+      bank->open_row = pick->row;
+      bank->ready = done;
+    }
+
+    dram->queue_delay += clock - pick->arrival;
+    dram->service_time += done - pick->arrival;
+    if (pick->is_write) {
+      dram->writes++;
+    } else {
+      dram->reads++;
+    }
+
+    if (pick->request) {
+      Mem_Request* r = &ms->request[pick->request - 1];
+      r->waiting_dram = 0;
+      r->ready = done;
+    }
+
+    pick->valid = 0;
+    dram->count--;
+  }
+}
+
+/*
+ * Advances the hierarchy by one cycle, called once at the start of
+ * every clock cycle
+ */
+void
+memsys_tick(MemSys* ms, long clock)
+{
+  if (ms->dram.config.banks) {
+    dram_schedule(ms, clock);
+  }
+
+  int outstanding = 0;
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    const Mem_Request* r = &ms->request[i];
+    if (r->valid && !r->done && r->miss && !r->primary && !r->prefetch) {
+      outstanding++;
+    }
+  }
+  if (outstanding) {
+    ms->miss_cycles++;
+    ms->misses_outstanding += outstanding;
+  }
+
+  for (int i = 0; i < MEMSYS_MAX_REQUESTS; ++i) {
+    if (ms->request[i].valid) {
+      finish_request(ms, &ms->request[i], clock);
+    }
+  }
+}
+
+static double
+average_latency(const void* ctx)
+{
+  const MemSys* ms = ctx;
+
+  return ms->accesses ? (double)ms->total_latency / ms->accesses : 0.0;
+}
+
+static double
+mlp(const void* ctx)
+{
+  const MemSys* ms = ctx;
+
+  return ms->miss_cycles ? (double)ms->misses_outstanding / ms->miss_cycles
+                         : 0.0;
+}
+
+/* The level prefetches fill, the L1D when modelled and the L2 otherwise */
+static const Cache*
+prefetch_target(const MemSys* ms)
+{
+  return ms->l1d.config.sets ? &ms->l1d : &ms->l2;
+}
+
+/* Prefetches a demand access used, in time or still in flight */
+static long
+prefetch_useful(const MemSys* ms)
+{
+  return prefetch_target(ms)->prefetch_hits + ms->prefetch_late;
+}
+
+static double
+prefetch_accuracy(const void* ctx)
+{
+  const MemSys* ms = ctx;
+
+  return ms->prefetch_issued
+           ? (double)prefetch_useful(ms) / ms->prefetch_issued
+           : 0.0;
+}
+
+static double
+prefetch_coverage(const void* ctx)
+{
+  const MemSys* ms = ctx;
+  const Cache* target = prefetch_target(ms);
+  long demand = target->prefetch_hits + target->misses;
+
+  return demand ? (double)prefetch_useful(ms) / demand : 0.0;
+}
+
+static double
+prefetch_timeliness(const void* ctx)
+{
+  const MemSys* ms = ctx;
+  long useful = prefetch_useful(ms);
+
+  return useful ? (double)prefetch_target(ms)->prefetch_hits / useful : 0.0;
+}
+
+void
+memsys_print_stats(const MemSys* ms)
+{
+  const Dram* dram = &ms->dram;
+
+  if (!memsys_enabled(ms)) {
+    return;
+  }
+
+  printf("============= Memory Hierarchy =============\n");
+  printf("| Accesses              | %ld |\n", ms->accesses);
+  printf("| Average latency       | %.2f |\n", average_latency(ms));
+  printf("| Maximum latency       | %ld |\n", ms->max_latency);
+
+  printf("| MSHR merges           | %ld |\n", ms->mshr_merged);
+  printf("| MSHR full             | %ld |\n", ms->mshr_full);
+  printf("| MLP                   | %.2f |\n", mlp(ms));
+
+  if (ms->l1d.config.sets) {
+    printf("| L1D accesses          | %ld |\n", ms->l1d.accesses);
+    printf("| L1D misses            | %ld |\n", ms->l1d.misses);
+    printf("| L1D writebacks        | %ld |\n", ms->l1d.writebacks);
+  }
+
+  if (ms->l2.config.sets) {
+    printf("| L2 accesses           | %ld |\n", ms->l2.accesses);
+    printf("| L2 misses             | %ld |\n", ms->l2.misses);
+    printf("| L2 writebacks         | %ld |\n", ms->l2.writebacks);
+  }
+
+  if (prefetch_enabled(&ms->prefetcher)) {
+    const Cache* target = prefetch_target(ms);
+    printf("| Prefetches issued     | %ld |\n", ms->prefetch_issued);
+    printf("| Prefetches dropped    | %ld |\n", ms->prefetch_dropped);
+    printf("| Prefetches timely     | %ld |\n", target->prefetch_hits);
+    printf("| Prefetches late       | %ld |\n", ms->prefetch_late);
+    printf("| Prefetches unused     | %ld |\n", target->prefetch_unused);
+    printf("| Prefetch accuracy     | %.2f |\n", prefetch_accuracy(ms));
+    printf("| Prefetch coverage     | %.2f |\n", prefetch_coverage(ms));
+    printf("| Prefetch timeliness   | %.2f |\n", prefetch_timeliness(ms));
+  }
+
+  if (dram->config.banks) {
+    long served = dram->reads + dram->writes;
+    printf("| DRAM reads            | %ld |\n", dram->reads);
+    printf("| DRAM writes           | %ld |\n", dram->writes);
+    printf("| DRAM row hits         | %ld |\n", dram->row_hits);
+    printf("| DRAM row misses       | %ld |\n", dram->row_misses);
+    printf("| DRAM row conflicts    | %ld |\n", dram->row_conflicts);
+    printf("| DRAM queue full       | %ld |\n", dram->queue_full);
+    printf("| DRAM avg queue delay  | %.2f |\n",
+           served ? (double)dram->queue_delay / served : 0.0);
+    printf("| DRAM avg service time | %.2f |\n",
+           served ? (double)dram->service_time / served : 0.0);
+  }
+}
+
+/* Registers the counters of every level that is modelled */
+void
+memsys_register_stats(const MemSys* ms, Stats* stats)
+{
+  const Dram* dram = &ms->dram;
+
+  if (!memsys_enabled(ms)) {
+    return;
+  }
+
+  stats_group(stats, "memsys");
+  stats_long(stats, "accesses", &ms->accesses, "Data accesses");
+  stats_formula(stats, "average_latency", average_latency, ms,
+                "Average cycles of a demand access");
+  stats_long(stats, "max_latency", &ms->max_latency,
+             "Longest demand access");
+  stats_dist(stats, "latency", &ms->latency, "Cycles of demand accesses");
+  stats_long(stats, "mshr_merged", &ms->mshr_merged,
+             "Secondary misses merged into an outstanding miss");
+  stats_long(stats, "mshr_full", &ms->mshr_full,
+             "Accesses refused because every MSHR was busy");
+  stats_formula(stats, "mlp", mlp, ms,
+                "Average demand misses outstanding while any is");
+
+  if (ms->l1d.config.sets) {
+    stats_group(stats, "memsys.l1d");
+    cache_register_stats(&ms->l1d, stats);
+  }
+
+  if (ms->l2.config.sets) {
+    stats_group(stats, "memsys.l2");
+    cache_register_stats(&ms->l2, stats);
+  }
+
+  if (prefetch_enabled(&ms->prefetcher)) {
+    stats_group(stats, "memsys.prefetch");
+    stats_long(stats, "issued", &ms->prefetch_issued, "Prefetches issued");
+    stats_long(stats, "dropped", &ms->prefetch_dropped,
+               "Proposed lines refused for lack of resources");
+    stats_long(stats, "late", &ms->prefetch_late,
+               "Demand accesses that caught their prefetch in flight");
+    stats_formula(stats, "accuracy", prefetch_accuracy, ms,
+                  "Share of issued prefetches a demand access used");
+    stats_formula(stats, "coverage", prefetch_coverage, ms,
+                  "Share of demand misses a prefetch removed or shortened");
+    stats_formula(stats, "timeliness", prefetch_timeliness, ms,
+                  "Share of useful prefetches that arrived before the load");
+  }
+
+  if (dram->config.banks) {
+    stats_group(stats, "memsys.dram");
+    stats_long(stats, "reads", &dram->reads, "Reads served");
+    stats_long(stats, "writes", &dram->writes, "Writes served");
+    stats_long(stats, "row_hits", &dram->row_hits, "Accesses to the open row");
+    stats_long(stats, "row_misses", &dram->row_misses,
+               "Accesses to a closed bank");
+    stats_long(stats, "row_conflicts", &dram->row_conflicts,
+               "Accesses that closed another row");
+    stats_long(stats, "queue_full", &dram->queue_full,
+               "Requests refused by a full queue");
+    stats_long(stats, "queue_delay", &dram->queue_delay,
+               "Cycles requests waited in the queue");
+    stats_long(stats, "service_time", &dram->service_time,
+               "Cycles from arrival to data");
+  }
+}
@@ -0,0 +1,70 @@
+#ifndef _APEX_PREFETCH_H_
+#define _APEX_PREFETCH_H_
+/**
+ *  prefetch.h
+ *  Contains the stride and stream prefetchers trained on load addresses.
+ *  The prefetcher only proposes line addresses, the memory hierarchy
+ *  decides whether to fetch them.
+ */
+
+/* Entries in the PC indexed stride table */
+#define PREFETCH_STRIDE_ENTRIES 64
+
+/* Streams tracked by the stream prefetcher */
+#define PREFETCH_STREAMS 8
+
+/* Lines ahead of the last access that still count as the same stream */
+#define PREFETCH_STREAM_WINDOW 4
+
+/* Most addresses a single training access can propose */
+#define PREFETCH_MAX_DEGREE 16
+
+typedef struct Prefetch_Config
+{
+  int stride;		// Flag to indicate, PC indexed stride prefetcher is on
+  int stream;		// Flag to indicate, stream prefetcher is on
+  int degree;		// Lines requested per trigger
+  int distance;		// How far ahead of the trigger the first line is
+} Prefetch_Config;
+
+/* Model of a stride table entry */
+typedef struct Stride_Entry
+{
+  int valid;
+  int pc;
+  unsigned long last_address;
+  long stride;
+  int confidence;	// Saturates at 3, prefetches from 2
+} Stride_Entry;
+
+/* Model of a tracked stream */
+typedef struct Stream_Entry
+{
+  int valid;
+  unsigned long last_line;
+  int direction;	// +1 ascending, -1 descending, 0 not yet known
+  int confidence;
+  long lru;
+} Stream_Entry;
+
+/* Model of the prefetchers */
+typedef struct Prefetcher
+{
+  Prefetch_Config config;
+  int line_size;
+  Stride_Entry stride[PREFETCH_STRIDE_ENTRIES];
+  Stream_Entry stream[PREFETCH_STREAMS];
+  long lru_clock;
+} Prefetcher;
+
+void
+prefetch_init(Prefetcher* pf, const Prefetch_Config* config, int line_size);
+
+int
+prefetch_enabled(const Prefetcher* pf);
+
+int
+prefetch_train(Prefetcher* pf, int pc, unsigned long address,
+               unsigned long* candidates);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef _APEX_PROFILE_H_
+#define _APEX_PROFILE_H_
+/**
+ *  profile.h
+ *  Contains the per-PC profile. Every cycle, decode stall, flush and
+ *  retire of a run is charged to the instruction responsible for it, and
+ *  the program is written out as a listing annotated with the counts.
+ */
+#include "isa.h"
+#include "object.h"
+
+/* Counters kept for each instruction of code memory */
+enum
+{
+  PROFILE_CYCLES,	// Cycles it was the oldest instruction not retired
+  PROFILE_STALLS,	// Cycles it was held in decode
+  PROFILE_RETIRED,
+  PROFILE_FLUSHES,	// Times it redirected fetch and flushed younger work
+  PROFILE_SQUASHED,	// Younger instructions those redirects squashed
+  PROFILE_LATENCY,	// Sum of cycles from issue to result
+  PROFILE_COMPLETED,	// Executions PROFILE_LATENCY is summed over
+  NUM_PROFILE
+};
+
+/* Model of the profile, off when count is NULL */
+typedef struct Profile
+{
+  long (*count)[NUM_PROFILE];	// One row per instruction of code memory
+  int size;
+} Profile;
+
+/* Adds n to counter what of the instruction at pc, if it is code */
+static inline void
+profile_add(Profile* profile, int pc, int what, long n)
+{
+  unsigned int index = (unsigned int)(pc - 4000) / 4;
+
+  if (profile->count && index < (unsigned int)profile->size) {
+    profile->count[index][what] += n;
+  }
+}
+
+int
+profile_init(Profile* profile, int size);
+
+void
+profile_free(Profile* profile);
+
+int
+profile_write(const Profile* profile, const char* filename,
+              const APEX_Instruction* code, const Apexo_Object* object,
+              long cycles);
+
+#endif
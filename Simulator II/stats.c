@@ -0,0 +1,421 @@
+/*
+ *  stats.c
+ *  Contains the statistics registry and its JSON and CSV writers
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stats.h"
+
+/* Deepest group nesting the JSON writer follows */
+#define MAX_DEPTH 8
+
+void
+dist_init(Stat_Dist* dist, int width)
+{
+  memset(dist, 0, sizeof(*dist));
+  dist->width = width > 0 ? width : 1;
+}
+
+double
+dist_mean(const Stat_Dist* dist)
+{
+  return dist->samples ? (double)dist->sum / dist->samples : 0.0;
+}
+
+/* Returns the smallest value at least percent of the samples are below or
+ * equal to, to the width of a bucket
+ */
+long
+dist_percentile(const Stat_Dist* dist, int percent)
+{
+  long target = (dist->samples * percent + 99) / 100;
+  long seen = 0;
+
+  for (int i = 0; i < STAT_DIST_BUCKETS - 1; ++i) {
+    seen += dist->bucket[i];
+    if (seen >= target && seen) {
+      long value = (long)i * dist->width;
+      return value < dist->min ? dist->min : value;
+    }
+  }
+  return dist->max;
+}
+
+/* Index after the last non-empty bucket */
+static int
+dist_used(const Stat_Dist* dist)
+{
+  int used = STAT_DIST_BUCKETS;
+
+  while (used && !dist->bucket[used - 1]) {
+    used--;
+  }
+  return used;
+}
+
+void
+stats_init(Stats* stats)
+{
+  memset(stats, 0, sizeof(*stats));
+}
+
+void
+stats_free(Stats* stats)
+{
+  free(stats->stat);
+  stats_init(stats);
+}
+
+/* Names registered after this are prefixed with "group." */
+void
+stats_group(Stats* stats, const char* group)
+{
+  snprintf(stats->group, sizeof(stats->group), "%s", group);
+}
+
+static Stat*
+add_stat(Stats* stats, const char* name, int kind, const void* value,
+         const char* desc)
+{
+  Stat* stat;
+
+  if (stats->count == stats->capacity) {
+    int capacity = stats->capacity ? stats->capacity * 2 : 64;
+    Stat* grown = realloc(stats->stat, capacity * sizeof(*grown));
+
+    if (!grown) {
+      stats->failed = 1;
+      return NULL;
+    }
+    stats->stat = grown;
+    stats->capacity = capacity;
+  }
+
+  stat = &stats->stat[stats->count++];
+  memset(stat, 0, sizeof(*stat));
+  snprintf(stat->name, sizeof(stat->name), "%s%s%s", stats->group,
+           stats->group[0] ? "." : "", name);
+  stat->kind = kind;
+  stat->value = value;
+  stat->desc = desc;
+  return stat;
+}
+
+void
+stats_int(Stats* stats, const char* name, const int* value, const char* desc)
+{
+  add_stat(stats, name, STAT_INT, value, desc);
+}
+
+void
+stats_long(Stats* stats, const char* name, const long* value,
+           const char* desc)
+{
+  add_stat(stats, name, STAT_LONG, value, desc);
+}
+
+void
+stats_hash(Stats* stats, const char* name, const unsigned long* value,
+           const char* desc)
+{
+  add_stat(stats, name, STAT_HASH, value, desc);
+}
+
+void
+stats_vector(Stats* stats, const char* name, const long* values, int count,
+             const char* const* labels, const char* desc)
+{
+  Stat* stat = add_stat(stats, name, STAT_VECTOR, values, desc);
+
+  if (stat) {
+    stat->count = count;
+    stat->labels = labels;
+  }
+}
+
+void
+stats_dist(Stats* stats, const char* name, const Stat_Dist* dist,
+           const char* desc)
+{
+  add_stat(stats, name, STAT_DIST, dist, desc);
+}
+
+void
+stats_formula(Stats* stats, const char* name, Stat_Formula formula,
+              const void* ctx, const char* desc)
+{
+  Stat* stat = add_stat(stats, name, STAT_FORMULA, ctx, desc);
+
+  if (stat) {
+    stat->formula = formula;
+  }
+}
+
+static FILE*
+open_output(const Stats* stats, const char* filename)
+{
+  FILE* fp;
+
+  if (stats->failed) {
+    fprintf(stderr, "APEX_Error : Statistics registry ran out of memory\n");
+    return NULL;
+  }
+
+  fp = strcmp(filename, "-") == 0 ? stdout : fopen(filename, "w");
+  if (!fp) {
+    fprintf(stderr, "APEX_Error : Unable to write %s\n", filename);
+  }
+  return fp;
+}
+
+static int
+close_output(FILE* fp, const char* filename)
+{
+  int failed = ferror(fp);
+
+  if (fp == stdout) {
+    failed |= fflush(fp) != 0;
+  } else {
+    failed |= fclose(fp) != 0;
+  }
+  if (failed) {
+    fprintf(stderr, "APEX_Error : Unable to write %s\n", filename);
+  }
+  return failed ? -1 : 0;
+}
+
+static void
+print_double(FILE* fp, double value)
+{
+  if (isfinite(value)) {
+    fprintf(fp, "%.10g", value);
+  } else {
+    fprintf(fp, "null");
+  }
+}
+
+static void
+vector_label(char* buf, size_t size, const Stat* stat, int i)
+{
+  if (stat->labels && stat->labels[i]) {
+    snprintf(buf, size, "%s", stat->labels[i]);
+  } else {
+    snprintf(buf, size, "%d", i);
+  }
+}
+
+static void
+json_value(FILE* fp, const Stat* stat, int depth)
+{
+  char label[32];
+
+  switch (stat->kind) {
+    case STAT_INT:
+      fprintf(fp, "%d", *(const int*)stat->value);
+      break;
+    case STAT_LONG:
+      fprintf(fp, "%ld", *(const long*)stat->value);
+      break;
+    case STAT_HASH:
+      fprintf(fp, "\"%016lx\"", *(const unsigned long*)stat->value);
+      break;
+    case STAT_FORMULA:
+      print_double(fp, stat->formula(stat->value));
+      break;
+    case STAT_VECTOR:
+      fprintf(fp, "{");
+      for (int i = 0; i < stat->count; ++i) {
+        vector_label(label, sizeof(label), stat, i);
+        fprintf(fp, "%s\n%*s\"%s\": %ld", i ? "," : "", 2 * (depth + 1), "",
+                label, ((const long*)stat->value)[i]);
+      }
+      fprintf(fp, "\n%*s}", 2 * depth, "");
+      break;
+    case STAT_DIST: {
+      const Stat_Dist* dist = stat->value;
+      int used = dist_used(dist);
+
+      fprintf(fp, "{ \"samples\": %ld, \"mean\": ", dist->samples);
+      print_double(fp, dist_mean(dist));
+      fprintf(fp, ", \"min\": %ld, \"max\": %ld, \"p50\": %ld, \"p90\": %ld, "
+                  "\"p99\": %ld, \"width\": %d, \"buckets\": [",
+              dist->min, dist->max, dist_percentile(dist, 50),
+              dist_percentile(dist, 90), dist_percentile(dist, 99),
+              dist->width);
+      for (int i = 0; i < used; ++i) {
+        fprintf(fp, "%s%ld", i ? ", " : "", dist->bucket[i]);
+      }
+      fprintf(fp, "] }");
+      break;
+    }
+  }
+}
+
+/* Splits a dotted name into its components, returns how many there are */
+static int
+split_name(const char* name, char parts[][64], int max)
+{
+  int count = 0;
+
+  while (count < max) {
+    const char* dot = strchr(name, '.');
+    size_t len = dot ? (size_t)(dot - name) : strlen(name);
+
+    snprintf(parts[count++], 64, "%.*s", (int)len, name);
+    if (!dot) {
+      break;
+    }
+    name = dot + 1;
+  }
+  return count;
+}
+
+/*
+ * Writes every statistic as a JSON object, groups nest as objects.
+ * Returns 0 on success, -1 on failure
+ */
+int
+stats_write_json(const Stats* stats, const char* filename)
+{
+  char open[MAX_DEPTH][64];
+  char parts[MAX_DEPTH + 1][64];
+  int depth = 0;
+  int first[MAX_DEPTH + 1] = { 1 };
+  FILE* fp = open_output(stats, filename);
+
+  if (!fp) {
+    return -1;
+  }
+
+  fprintf(fp, "{");
+  for (int i = 0; i < stats->count; ++i) {
+    const Stat* stat = &stats->stat[i];
+    int count = split_name(stat->name, parts, MAX_DEPTH + 1);
+    int shared = 0;
+
+    /* Close the groups this name is not in, and open the new ones */
+    while (shared < depth && shared < count - 1 &&
+           strcmp(open[shared], parts[shared]) == 0) {
+      shared++;
+    }
+    while (depth > shared) {
+      fprintf(fp, "\n%*s}", 2 * depth, "");
+      depth--;
+    }
+    while (depth < count - 1) {
+      fprintf(fp, "%s\n%*s\"%s\": {", first[depth] ? "" : ",",
+              2 * (depth + 1), "", parts[depth]);
+      first[depth] = 0;
+      strcpy(open[depth], parts[depth]);
+      first[++depth] = 1;
+    }
+
+    fprintf(fp, "%s\n%*s\"%s\": ", first[depth] ? "" : ",", 2 * (depth + 1),
+            "", parts[count - 1]);
+    first[depth] = 0;
+    json_value(fp, stat, depth + 1);
+  }
+  while (depth > 0) {
+    fprintf(fp, "\n%*s}", 2 * depth, "");
+    depth--;
+  }
+  fprintf(fp, "\n}\n");
+
+  return close_output(fp, filename);
+}
+
+static void
+csv_name(FILE* fp, const char* name, const char* suffix)
+{
+  fprintf(fp, "%s%s%s,", name, suffix[0] ? "." : "", suffix);
+}
+
+static void
+csv_desc(FILE* fp, const char* desc)
+{
+  fputs(",\"", fp);
+  for (const char* p = desc ? desc : ""; *p; ++p) {
+    if (*p == '"') {
+      fputc('"', fp);
+    }
+    fputc(*p, fp);
+  }
+  fputs("\"\n", fp);
+}
+
+/*
+ * Writes every statistic as a name,value,description row, vectors and
+ * distributions as one row per element.
+ * Returns 0 on success, -1 on failure
+ */
+int
+stats_write_csv(const Stats* stats, const char* filename)
+{
+  char label[40];
+  FILE* fp = open_output(stats, filename);
+
+  if (!fp) {
+    return -1;
+  }
+
+  fprintf(fp, "name,value,description\n");
+  for (int i = 0; i < stats->count; ++i) {
+    const Stat* stat = &stats->stat[i];
+
+    switch (stat->kind) {
+      case STAT_INT:
+      case STAT_LONG:
+      case STAT_HASH:
+      case STAT_FORMULA:
+        csv_name(fp, stat->name, "");
+        if (stat->kind == STAT_INT) {
+          fprintf(fp, "%d", *(const int*)stat->value);
+        } else if (stat->kind == STAT_LONG) {
+          fprintf(fp, "%ld", *(const long*)stat->value);
+        } else if (stat->kind == STAT_HASH) {
+          fprintf(fp, "%016lx", *(const unsigned long*)stat->value);
+        } else {
+          print_double(fp, stat->formula(stat->value));
+        }
+        csv_desc(fp, stat->desc);
+        break;
+      case STAT_VECTOR:
+        for (int j = 0; j < stat->count; ++j) {
+          vector_label(label, sizeof(label), stat, j);
+          csv_name(fp, stat->name, label);
+          fprintf(fp, "%ld", ((const long*)stat->value)[j]);
+          csv_desc(fp, stat->desc);
+        }
+        break;
+      case STAT_DIST: {
+        const Stat_Dist* dist = stat->value;
+        int used = dist_used(dist);
+        const char* names[] = { "samples", "min", "max", "p50", "p90", "p99" };
+        long values[] = { dist->samples, dist->min, dist->max,
+                          dist_percentile(dist, 50), dist_percentile(dist, 90),
+                          dist_percentile(dist, 99) };
+
+        csv_name(fp, stat->name, "mean");
+        print_double(fp, dist_mean(dist));
+        csv_desc(fp, stat->desc);
+        for (int j = 0; j < 6; ++j) {
+          csv_name(fp, stat->name, names[j]);
+          fprintf(fp, "%ld", values[j]);
+          csv_desc(fp, stat->desc);
+        }
+        for (int j = 0; j < used; ++j) {
+          snprintf(label, sizeof(label), "bucket.%ld", (long)j * dist->width);
+          csv_name(fp, stat->name, label);
+          fprintf(fp, "%ld", dist->bucket[j]);
+          csv_desc(fp, stat->desc);
+        }
+        break;
+      }
+    }
+  }
+
+  return close_output(fp, filename);
+}
@@ -0,0 +1,130 @@
+#ifndef _APEX_STATS_H_
+#define _APEX_STATS_H_
+/**
+ *  stats.h
+ *  Contains the statistics registry. Counters stay plain fields of the
+ *  structures that update them; the registry only records their name and
+ *  address, and reads them when it is written out as JSON or CSV.
+ *
+ *  Names are dotted paths, "memsys.l1d.misses". Every name under a group
+ *  must be registered before the next group starts, so the JSON output can
+ *  nest them.
+ */
+
+/* Buckets of a distribution, the last one also counts larger values */
+#define STAT_DIST_BUCKETS 64
+
+enum
+{
+  STAT_INT,
+  STAT_LONG,
+  STAT_HASH,
+  STAT_VECTOR,
+  STAT_DIST,
+  STAT_FORMULA
+};
+
+/* Distribution of sampled values, in buckets of width values from 0 */
+typedef struct Stat_Dist
+{
+  int width;
+  long bucket[STAT_DIST_BUCKETS];
+  long samples;
+  long sum;
+  long min;
+  long max;
+} Stat_Dist;
+
+/* Value derived from other statistics when the registry is written */
+typedef double (*Stat_Formula)(const void* ctx);
+
+/* Registered statistic */
+typedef struct Stat
+{
+  char name[64];
+  const char* desc;
+  int kind;
+  const void* value;	// Counter, vector, distribution or formula context
+  int count;		    // Elements of a vector
+  const char* const* labels;	// Names of the elements, NULL for 0, 1, ...
+  Stat_Formula formula;
+} Stat;
+
+/* Model of the statistics registry */
+typedef struct Stats
+{
+  Stat* stat;
+  int count;
+  int capacity;
+  char group[48];	// Prefix of the names registered next
+  int failed;		// Flag to indicate, a registration ran out of memory
+} Stats;
+
+/* Adds a sample to a distribution */
+static inline void
+dist_sample(Stat_Dist* dist, long value)
+{
+  long index = value / dist->width;
+
+  if (index >= STAT_DIST_BUCKETS) {
+    index = STAT_DIST_BUCKETS - 1;
+  }
+  dist->bucket[index < 0 ? 0 : index]++;
+  if (!dist->samples || value < dist->min) {
+    dist->min = value;
+  }
+  if (!dist->samples || value > dist->max) {
+    dist->max = value;
+  }
+  dist->samples++;
+  dist->sum += value;
+}
+
+void
+dist_init(Stat_Dist* dist, int width);
+
+double
+dist_mean(const Stat_Dist* dist);
+
+long
+dist_percentile(const Stat_Dist* dist, int percent);
+
+void
+stats_init(Stats* stats);
+
+void
+stats_free(Stats* stats);
+
+void
+stats_group(Stats* stats, const char* group);
+
+void
+stats_int(Stats* stats, const char* name, const int* value, const char* desc);
+
+void
+stats_long(Stats* stats, const char* name, const long* value,
+           const char* desc);
+
+void
+stats_hash(Stats* stats, const char* name, const unsigned long* value,
+           const char* desc);
+
+void
+stats_vector(Stats* stats, const char* name, const long* values, int count,
+             const char* const* labels, const char* desc);
+
+void
+stats_dist(Stats* stats, const char* name, const Stat_Dist* dist,
+           const char* desc);
+
+void
+stats_formula(Stats* stats, const char* name, Stat_Formula formula,
+              const void* ctx, const char* desc);
+
+int
+stats_write_json(const Stats* stats, const char* filename);
+
+int
+stats_write_csv(const Stats* stats, const char* filename);
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ *  apex_as.c
+ *  Assembles an APEX program into an .apexo object the simulators can
+ *  map instead of parsing the text on every run. See assembler.c for the
+ *  syntax.
+ *
+ *  Usage : apex_as <input_file> [-o <output_file>] [-t]
+ *  The output defaults to the input name with its extension replaced by
+ *  .apexo, or .flat.asm with -t. With -t the program is written out as
+ *  plain instructions any of the simulators can read, and its data, if
+ *  any, as a .mem image for --mem-in
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "assembler.h"
+
+/* Memory images must start at a data memory page */
+#define MEMORY_IMAGE_ALIGN 1024
+
+/* Returns a malloc'ed copy of filename with its extension set to ext */
+static char*
+replace_extension(const char* filename, const char* ext)
+{
+  const char* slash = strrchr(filename, '/');
+  const char* dot = strrchr(filename, '.');
+  size_t len = strlen(filename);
+  char* output;
+
+  if (dot && (!slash || dot > slash)) {
+    len = dot - filename;
+  }
+
+  output = malloc(len + strlen(ext) + 1);
+  if (output) {
+    memcpy(output, filename, len);
+    strcpy(output + len, ext);
+  }
+  return output;
+}
+
+/*
+ * Writes the data of the program as a memory image next to output. The
+ * image starts at a page boundary, as --mem-in-base requires.
+ * Returns 0 on success, -1 on failure
+ */
+static int
+write_memory_image(const char* output, const Assembly* program)
+{
+  unsigned long base = program->data_base & ~(MEMORY_IMAGE_ALIGN - 1UL);
+  unsigned long pad = program->data_base - base;
+  char* filename = replace_extension(output, ".mem");
+  int32_t zero = 0;
+  FILE* fp;
+  int failed = 0;
+
+  if (!filename) {
+    return -1;
+  }
+
+  fp = fopen(filename, "wb");
+  if (!fp) {
+    perror(filename);
+    free(filename);
+    return -1;
+  }
+
+  for (unsigned long i = 0; i < pad && !failed; ++i) {
+    failed = fwrite(&zero, sizeof(zero), 1, fp) != 1;
+  }
+  failed = failed || fwrite(program->data, sizeof(*program->data),
+                            program->data_count, fp) !=
+                       (size_t)program->data_count;
+
+  if (fclose(fp) || failed) {
+    perror(filename);
+    free(filename);
+    return -1;
+  }
+
+  printf("APEX_AS : %s: %d words, run with --mem-in=%s --mem-in-base=%lu\n",
+         filename, program->data_count, filename, base);
+  free(filename);
+  return 0;
+}
+
+/*
+ * Writes the program in the format read by create_code_memory.
+ * Returns 0 on success, -1 on failure
+ */
+static int
+write_text(const char* output, const Assembly* program)
+{
+  FILE* fp = fopen(output, "w");
+  int failed = 0;
+
+  if (!fp) {
+    perror(output);
+    return -1;
+  }
+
+  for (int i = 0; i < program->code_count && !failed; ++i) {
+    const APEX_Instruction* ins = &program->code[i];
+    const Instruction_Format* format =
+      find_instruction_format(ins->opcode, strlen(ins->opcode));
+
+    fputs(format->name, fp);
+    for (int j = 0; j < format->count; ++j) {
+      if (format->slot[j] == SLOT_RD) {
+        fprintf(fp, ",R%d", ins->rd);
+      } else if (format->slot[j] == SLOT_RS1) {
+        fprintf(fp, ",R%d", ins->rs1);
+      } else if (format->slot[j] == SLOT_RS2) {
+        fprintf(fp, ",R%d", ins->rs2);
+      } else {
+        fprintf(fp, ",#%d", ins->imm);
+      }
+    }
+    failed = fputc('\n', fp) == EOF;
+  }
+
+  if (fclose(fp) || failed) {
+    perror(output);
+    return -1;
+  }
+
+  if (program->data_count) {
+    return write_memory_image(output, program);
+  }
+  return 0;
+}
+
+int
+main(int argc, char const* argv[])
+{
+  const char* input = NULL;
+  char* output = NULL;
+  Assembly program;
+  int text = 0;
+  int status;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      free(output);
+      output = strdup(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0) {
+      text = 1;
+    } else if (!input && argv[i][0] != '-') {
+      input = argv[i];
+    } else {
+      input = NULL;
+      break;
+    }
+  }
+
+  if (!input) {
+    fprintf(stderr, "APEX_Help : Usage %s <input_file> [-o <output_file>] [-t]\n",
+            argv[0]);
+    exit(1);
+  }
+
+  if (!output) {
+    output = replace_extension(input, text ? ".flat.asm" : ".apexo");
+  }
+
+  if (assemble(input, &program)) {
+    fprintf(stderr, "APEX_Error : Unable to assemble %s\n", input);
+    exit(1);
+  }
+
+  if (text) {
+    status = write_text(output, &program);
+  } else {
+    status = object_write(output, program.code, program.code_count,
+                          program.data, program.data_count,
+                          program.data_base, program.symbols,
+                          program.symbol_count);
+  }
+  if (status == 0) {
+    printf("APEX_AS : %s: %d instructions, %d data words, %d symbols\n",
+           output, program.code_count, program.data_count,
+           program.symbol_count);
+  }
+
+  assembly_free(&program);
+  free(output);
+  return status ? 1 : 0;
+}
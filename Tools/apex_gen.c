@@ -0,0 +1,465 @@
+/*
+ *  apex_gen.c
+ *  Generates synthetic APEX programs with a chosen instruction mix,
+ *  amount of ILP, branch behaviour and data footprint, for apex_as.
+ *
+ *  Usage : apex_gen [options] [-o <output_file>]
+ *  The program is written to stdout without -o. The same options and seed
+ *  always give the same program.
+ *
+ *  The program is a loop around a body of --length slots. Each slot is an
+ *  ALU op, a MUL, a LOAD, a STORE or a branch, drawn with the --mix
+ *  weights:
+ *    - ALU and MUL ops each extend one of --ilp independent dependency
+ *      chains, taken in turn. After --chain ops a chain restarts with a
+ *      MOVC, so nothing ties it to its earlier values.
+ *    - Loads write, and stores read, the next chain. They address the data
+ *      at R13 + k * --stride. R13 advances by the stride of the whole body
+ *      every iteration and wraps at --footprint words.
+ *    - A branch loads its outcome from a table, sets the zero flag with an
+ *      ADD and skips forward over 1 to 3 slots with BZ when taken. Every
+ *      branch has a bias, taken with probability --taken. Each outcome
+ *      follows that bias with probability --predictable, otherwise it is
+ *      taken with probability --taken.
+ *
+ *  Registers : R1-R8 chains, R0 zero, R9 footprint mask, R10 table mask,
+ *  R11 table index, R12 branch outcome, R13 data pointer, R14 one,
+ *  R15 iterations left
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_CHAINS 8
+#define MAX_LENGTH 4096
+
+/* Rows of the outcome table, branches repeat their outcomes after this
+ * many iterations
+ */
+#define MAX_TABLE_ROWS 1024
+
+enum
+{
+  SLOT_ALU,
+  SLOT_MUL,
+  SLOT_LOAD,
+  SLOT_STORE,
+  SLOT_BRANCH,
+  NUM_SLOT_KINDS
+};
+
+typedef struct Gen_Options
+{
+  uint64_t seed;
+  int length;
+  int iterations;
+  int mix[NUM_SLOT_KINDS];  // Weights of each kind of slot
+  int ilp;
+  int chain;		        // Ops before a chain restarts, 0 never
+  int taken;		        // Percent of branches taken
+  int predictable;	        // Percent of outcomes that follow the bias
+  long footprint;	        // Words, a power of 2
+  int stride;
+} Gen_Options;
+
+/* Options that take a single number */
+static const struct
+{
+  const char* name;
+  long min;
+  long max;
+  size_t offset;
+} number_options[] = {
+  { "--length", 1, MAX_LENGTH, offsetof(Gen_Options, length) },
+  { "--iterations", 1, 1L << 30, offsetof(Gen_Options, iterations) },
+  { "--ilp", 1, MAX_CHAINS, offsetof(Gen_Options, ilp) },
+  { "--chain", 0, 1L << 30, offsetof(Gen_Options, chain) },
+  { "--taken", 0, 100, offsetof(Gen_Options, taken) },
+  { "--predictable", 0, 100, offsetof(Gen_Options, predictable) },
+  { "--stride", 0, 1L << 20, offsetof(Gen_Options, stride) },
+};
+
+/* xorshift64*, so a seed gives the same program on every libc */
+static uint64_t rng_state;
+
+static uint64_t
+rng_next(void)
+{
+  rng_state ^= rng_state >> 12;
+  rng_state ^= rng_state << 25;
+  rng_state ^= rng_state >> 27;
+  return rng_state * 2685821657736338717ULL;
+}
+
+/* Returns a number in [0, n) */
+static int
+rng_below(int n)
+{
+  return (int)((rng_next() >> 33) % (uint64_t)n);
+}
+
+static long
+next_power_of_2(long n)
+{
+  long p = 1;
+
+  while (p < n) {
+    p *= 2;
+  }
+  return p;
+}
+
+static void
+set_default_options(Gen_Options* opts)
+{
+  static const int mix[NUM_SLOT_KINDS] = { 50, 10, 20, 10, 10 };
+
+  memset(opts, 0, sizeof(*opts));
+  opts->seed = 1;
+  opts->length = 64;
+  opts->iterations = 1000;
+  memcpy(opts->mix, mix, sizeof(mix));
+  opts->ilp = 4;
+  opts->taken = 50;
+  opts->predictable = 90;
+  opts->footprint = 4096;
+  opts->stride = 1;
+}
+
+/* Returns the value of "--name=value" if arg is that option, else NULL */
+static const char*
+option_value(const char* arg, const char* name)
+{
+  size_t len = strlen(name);
+
+  if (strncmp(arg, name, len) == 0 && arg[len] == '=') {
+    return arg + len + 1;
+  }
+  return NULL;
+}
+
+/* Parses a decimal number into *value. Returns 0 if it lies in [min, max] */
+static int
+parse_long(const char* text, long min, long max, long* value)
+{
+  char* end;
+
+  *value = strtol(text, &end, 10);
+  return end != text && *end == '\0' && *value >= min && *value <= max ? 0 : -1;
+}
+
+static int
+parse_mix(const char* text, int* mix)
+{
+  int total = 0;
+
+  for (int i = 0; i < NUM_SLOT_KINDS; ++i) {
+    char* end;
+
+    mix[i] = (int)strtol(text, &end, 10);
+    if (end == text || mix[i] < 0 ||
+        *end != (i == NUM_SLOT_KINDS - 1 ? '\0' : ':')) {
+      return -1;
+    }
+    total += mix[i];
+    text = end + 1;
+  }
+  return total > 0 ? 0 : -1;
+}
+
+/*
+ * Applies a single "--name=value" option.
+ * Returns 0 on success, -1 if the option is unknown or malformed
+ */
+static int
+parse_option(Gen_Options* opts, const char* arg)
+{
+  const char* value;
+  long n;
+
+  if ((value = option_value(arg, "--seed"))) {
+    char* end;
+    opts->seed = strtoull(value, &end, 0);
+    return *end == '\0' ? 0 : -1;
+  }
+
+  if ((value = option_value(arg, "--mix"))) {
+    return parse_mix(value, opts->mix);
+  }
+
+  if ((value = option_value(arg, "--footprint"))) {
+    if (parse_long(value, 1, 1L << 28, &n)) {
+      return -1;
+    }
+    opts->footprint = next_power_of_2(n);
+    return 0;
+  }
+
+  for (size_t i = 0; i < sizeof(number_options) / sizeof(number_options[0]);
+       ++i) {
+    if ((value = option_value(arg, number_options[i].name))) {
+      if (parse_long(value, number_options[i].min, number_options[i].max,
+                     &n)) {
+        return -1;
+      }
+      *(int*)((char*)opts + number_options[i].offset) = (int)n;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+static void
+print_help(const char* name)
+{
+  fprintf(stderr,
+          "APEX_Help : Usage %s [options] [-o <output_file>]\n"
+          "  --seed=N                     Seed of the program (default 1)\n"
+          "  --length=N                   Slots in the loop body (default 64)\n"
+          "  --iterations=N               Times the body runs (default 1000)\n"
+          "  --mix=ALU:MUL:LOAD:STORE:BR  Weights of each kind of slot\n"
+          "                               (default 50:10:20:10:10)\n"
+          "  --ilp=N                      Independent dependency chains, 1-8\n"
+          "                               (default 4)\n"
+          "  --chain=N                    Ops before a chain restarts, 0 never\n"
+          "                               (default 0)\n"
+          "  --taken=P                    Percent of branches taken (default 50)\n"
+          "  --predictable=P              Percent of outcomes that follow the\n"
+          "                               branch's bias (default 90)\n"
+          "  --footprint=N                Data words touched, rounded up to a\n"
+          "                               power of 2 (default 4096)\n"
+          "  --stride=N                   Words between accesses (default 1)\n",
+          name);
+}
+
+/* Picks the kind of each slot of the body, in proportion to the weights */
+static void
+choose_slots(const Gen_Options* opts, int* slots)
+{
+  int total = 0;
+
+  for (int i = 0; i < NUM_SLOT_KINDS; ++i) {
+    total += opts->mix[i];
+  }
+
+  for (int i = 0; i < opts->length; ++i) {
+    int pick = rng_below(total);
+
+    slots[i] = 0;
+    while (pick >= opts->mix[slots[i]]) {
+      pick -= opts->mix[slots[i]];
+      slots[i]++;
+    }
+  }
+}
+
+/* Writes the outcome table, a row of row_size words per iteration, 0 for
+ * taken
+ */
+static void
+write_outcomes(FILE* fp, const Gen_Options* opts, int branches, int rows,
+               int row_size)
+{
+  int* bias = calloc(branches ? branches : 1, sizeof(*bias));
+
+  for (int b = 0; b < branches; ++b) {
+    bias[b] = rng_below(100) < opts->taken;
+  }
+
+  fprintf(fp, "outcomes:\n");
+  for (int r = 0; r < rows; ++r) {
+    fprintf(fp, "        .word ");
+    for (int b = 0; b < row_size; ++b) {
+      int taken = 0;
+
+      if (b < branches) {
+        taken = rng_below(100) < opts->predictable
+                  ? bias[b]
+                  : rng_below(100) < opts->taken;
+      }
+      fprintf(fp, "%s%d", b ? ", " : "", !taken);
+    }
+    fprintf(fp, "\n");
+  }
+  free(bias);
+}
+
+static void
+generate(FILE* fp, const Gen_Options* opts)
+{
+  static const char* alu_ops[] = { "ADD", "SUB", "AND", "OR", "EX-OR",
+                                   "ADDL", "SUBL" };
+  static const char* slot_names[] = { "ALU", "MUL", "LOAD", "STORE",
+                                      "branch" };
+  int slots[MAX_LENGTH];
+  int skip_to[MAX_LENGTH + 1];
+  int count[NUM_SLOT_KINDS] = { 0 };
+  int chain_ops[MAX_CHAINS] = { 0 };
+  int next_chain = 0;
+  int memory_ops = 0;
+  int memory_index = 0;
+  int branches = 0;
+  int rows;
+  int row_size;
+  long table;
+
+  choose_slots(opts, slots);
+  for (int i = 0; i < opts->length; ++i) {
+    count[slots[i]]++;
+  }
+  memory_ops = count[SLOT_LOAD] + count[SLOT_STORE];
+
+  rows = (int)next_power_of_2(opts->iterations < MAX_TABLE_ROWS
+                                ? opts->iterations
+                                : MAX_TABLE_ROWS);
+  row_size = (int)next_power_of_2(count[SLOT_BRANCH]);
+
+  /* The table lies past the data, on its own page */
+  table = opts->footprint + (long)memory_ops * opts->stride;
+  table = (table + 1023) / 1024 * 1024;
+
+  fprintf(fp, "; Generated by apex_gen --seed=%llu --length=%d "
+              "--iterations=%d\n",
+          (unsigned long long)opts->seed, opts->length, opts->iterations);
+  fprintf(fp, ";   --mix=%d:%d:%d:%d:%d --ilp=%d --chain=%d --taken=%d "
+              "--predictable=%d\n",
+          opts->mix[0], opts->mix[1], opts->mix[2], opts->mix[3],
+          opts->mix[4], opts->ilp, opts->chain, opts->taken,
+          opts->predictable);
+  fprintf(fp, ";   --footprint=%ld --stride=%d\n", opts->footprint,
+          opts->stride);
+  fprintf(fp, "; Body slots:");
+  for (int i = 0; i < NUM_SLOT_KINDS; ++i) {
+    fprintf(fp, " %d %s%s", count[i], slot_names[i],
+            i == NUM_SLOT_KINDS - 1 ? "\n" : ",");
+  }
+  fprintf(fp, "; A branch slot is the LOAD of its outcome, an ADD and a BZ\n\n");
+
+  fprintf(fp, "        .equ ITERATIONS, %d\n", opts->iterations);
+  fprintf(fp, "        .equ FOOTPRINT, %ld\n", opts->footprint);
+  fprintf(fp, "        .equ ROW, %d\n", row_size);
+  fprintf(fp, "        .equ ROWS, %d\n\n", rows);
+
+  if (count[SLOT_BRANCH]) {
+    fprintf(fp, "        .data %ld\n", table);
+    write_outcomes(fp, opts, count[SLOT_BRANCH], rows, row_size);
+    fprintf(fp, "\n");
+  }
+
+  fprintf(fp, "        .text\n");
+  fprintf(fp, "        MOVC R0, #0\n");
+  fprintf(fp, "        MOVC R14, #1\n");
+  fprintf(fp, "        MOVC R15, #ITERATIONS\n");
+  fprintf(fp, "        MOVC R13, #0\n");
+  fprintf(fp, "        MOVC R9, #FOOTPRINT - 1\n");
+  fprintf(fp, "        MOVC R11, #0\n");
+  fprintf(fp, "        MOVC R10, #ROWS * ROW - 1\n");
+  for (int c = 0; c < opts->ilp; ++c) {
+    fprintf(fp, "        MOVC R%d, #%d\n", c + 1, c + 3);
+  }
+
+  /* Branches that skip to each slot, each needs a label there */
+  memset(skip_to, 0, sizeof(skip_to));
+  fprintf(fp, "loop:\n");
+  for (int i = 0; i < opts->length; ++i) {
+    int c = next_chain;
+    int reg = c + 1;
+
+    for (int b = 0; b < skip_to[i]; ++b) {
+      fprintf(fp, "skip%d_%d:\n", i, b);
+    }
+
+    switch (slots[i]) {
+      case SLOT_ALU:
+      case SLOT_MUL:
+        next_chain = (next_chain + 1) % opts->ilp;
+        if (opts->chain && chain_ops[c] == opts->chain) {
+          fprintf(fp, "        MOVC R%d, #%d\n", reg, rng_below(1000));
+          chain_ops[c] = 0;
+          break;
+        }
+        chain_ops[c]++;
+        if (slots[i] == SLOT_MUL) {
+          fprintf(fp, "        MUL R%d, R%d, R%d\n", reg, reg, reg);
+        } else {
+          const char* op = alu_ops[rng_below(7)];
+
+          if (strcmp(op, "ADDL") == 0 || strcmp(op, "SUBL") == 0) {
+            fprintf(fp, "        %s R%d, R%d, #%d\n", op, reg, reg,
+                    rng_below(16) + 1);
+          } else {
+            fprintf(fp, "        %s R%d, R%d, R14\n", op, reg, reg);
+          }
+        }
+        break;
+
+      case SLOT_LOAD:
+      case SLOT_STORE:
+        next_chain = (next_chain + 1) % opts->ilp;
+        chain_ops[c] = 0;
+        fprintf(fp, "        %s R%d, R13, #%ld\n",
+                slots[i] == SLOT_LOAD ? "LOAD" : "STORE", reg,
+                (long)memory_index++ * opts->stride);
+        break;
+
+      case SLOT_BRANCH: {
+        int target = i + 1 + rng_below(3);
+
+        if (target > opts->length) {
+          target = opts->length;
+        }
+        fprintf(fp, "        LOAD R12, R11, #outcomes + %d\n", branches++);
+        fprintf(fp, "        ADD R12, R12, R0\n");
+        fprintf(fp, "        BZ skip%d_%d\n", target, skip_to[target]++);
+        break;
+      }
+    }
+  }
+  for (int b = 0; b < skip_to[opts->length]; ++b) {
+    fprintf(fp, "skip%d_%d:\n", opts->length, b);
+  }
+
+  fprintf(fp, "        ADDL R13, R13, #%ld\n", (long)memory_ops * opts->stride);
+  fprintf(fp, "        AND R13, R13, R9\n");
+  fprintf(fp, "        ADDL R11, R11, #ROW\n");
+  fprintf(fp, "        AND R11, R11, R10\n");
+  fprintf(fp, "        SUB R15, R15, R14\n");
+  fprintf(fp, "        BNZ loop\n");
+  fprintf(fp, "        HALT\n");
+}
+
+int
+main(int argc, char const* argv[])
+{
+  Gen_Options opts;
+  const char* output = NULL;
+  FILE* fp = stdout;
+
+  set_default_options(&opts);
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (parse_option(&opts, argv[i])) {
+      fprintf(stderr, "APEX_Error : Invalid option %s\n", argv[i]);
+      print_help(argv[0]);
+      exit(1);
+    }
+  }
+
+  rng_state = opts.seed * 0x9E3779B97F4A7C15ULL + 1;
+
+  if (output && !(fp = fopen(output, "w"))) {
+    perror(output);
+    exit(1);
+  }
+
+  generate(fp, &opts);
+
+  if (output && fclose(fp)) {
+    perror(output);
+    exit(1);
+  }
+  return 0;
+}
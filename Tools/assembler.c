@@ -0,0 +1,1249 @@
+/*
+ *  assembler.c
+ *  Contains the two pass assembler behind apex_as.
+ *
+ *  On top of one instruction per line, as in ADD,R1,R2,R3, a program may
+ *  use
+ *    ; comment              everything after ; is ignored
+ *    name:                  label, a pc in .text or an address in .data
+ *    .equ name, expr        constant
+ *    .text                  following lines are code (the default)
+ *    .data [expr]           following lines are data, from address expr
+ *    .word expr, ...        one data word per expression
+ *    .space expr            skips expr data words, they stay zero
+ *    .macro name a, b       macro, \a in the body is replaced by the
+ *    ...                    argument and \@ by a number unique to the
+ *    .endm                  expansion, for labels
+ *    .rept expr ... .endr   repeats the block expr times
+ *
+ *  Operands may follow the opcode after a comma or blanks. Expressions
+ *  take numbers (decimal, 0x hex, 0b binary), symbols, parentheses and
+ *  the C operators | ^ & << >> + - * / % ~. Literal operands are written
+ *  #expr or expr. BZ and BNZ take a target such as a label, or #expr for
+ *  an offset relative to the branch as before.
+ *
+ *  The first pass expands macros and repeat blocks, lays out code and
+ *  data and defines labels and constants, so .equ, .data, .space and
+ *  .rept can only use symbols defined above them. The second pass
+ *  encodes instructions and data words, which may use any symbol.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdarg.h>
+
+#include "assembler.h"
+
+/* Address of the first instruction */
+#define CODE_BASE 4000
+
+/* Deepest nesting of macro expansions and repeat blocks */
+#define MAX_EXPANSION_DEPTH 64
+
+/* Most lines macros and repeat blocks may expand to, in total */
+#define MAX_EXPANDED_LINES (1 << 22)
+
+#define MAX_MACRO_PARAMS 8
+
+/* Errors reported before the assembler stops listing them */
+#define MAX_REPORTED_ERRORS 20
+
+/* Largest data segment, in words */
+#define MAX_DATA_WORDS (1 << 26)
+
+#define SYMBOL_BUCKETS 4096
+
+typedef struct Symbol
+{
+  char name[APEXO_SYMBOL_NAME];
+  long value;
+  int kind;
+  int next;		    // Next symbol in the same bucket, -1 if none
+} Symbol;
+
+typedef struct Body_Line
+{
+  char* text;
+  int line;
+} Body_Line;
+
+typedef struct Macro
+{
+  char name[APEXO_SYMBOL_NAME];
+  char params[MAX_MACRO_PARAMS][APEXO_SYMBOL_NAME];
+  int param_count;
+  Body_Line* body;
+  int body_count;
+  int body_capacity;
+} Macro;
+
+enum
+{
+  ITEM_INSTRUCTION,
+  ITEM_WORD
+};
+
+/* An instruction or data word, encoded by the second pass */
+typedef struct Item
+{
+  int kind;
+  const Instruction_Format* format;
+  long address;		// pc of the instruction or address of the word
+  char* text;		// Operands, or the expression of the word
+  int line;
+  int origin;
+} Item;
+
+typedef struct Assembler
+{
+  const char* filename;
+  int errors;
+  int line;		    // Source line being assembled
+  int origin;		// Top level line it was expanded from, 0 if none
+
+  Symbol* symbols;
+  int symbol_count;
+  int symbol_capacity;
+  int bucket[SYMBOL_BUCKETS];
+
+  Macro* macros;
+  int macro_count;
+  int macro_capacity;
+  int defining;		// Index + 1 of the macro being collected, 0 if none
+  int unique;		// Counter behind \@
+
+  Body_Line* rept;	// Body of the repeat block being collected
+  int rept_count;
+  int rept_capacity;
+  int rept_depth;
+  long rept_times;
+  int rept_line;	// Line of the .rept, expansions are reported from it
+  long expanded;	// Lines expanded so far, past the cap once reported
+
+  int in_data;
+  long data_pc;
+  int code_count;
+  Item* items;
+  int item_count;
+  int item_capacity;
+} Assembler;
+
+static void
+asm_error(Assembler* as, const char* fmt, ...)
+{
+  va_list args;
+
+  if (++as->errors > MAX_REPORTED_ERRORS) {
+    return;
+  }
+
+  fprintf(stderr, "APEX_Error : %s:%d: ", as->filename, as->line);
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+  if (as->origin) {
+    fprintf(stderr, " (expanded from line %d)", as->origin);
+  }
+  fprintf(stderr, "\n");
+}
+
+/* Makes room for one more element, the assembler gives up without memory */
+static void*
+grow(void* array, int* capacity, int count, size_t size)
+{
+  if (count < *capacity) {
+    return array;
+  }
+
+  *capacity = *capacity ? *capacity * 2 : 64;
+  array = realloc(array, *capacity * size);
+  if (!array) {
+    fprintf(stderr, "APEX_Error : Out of memory\n");
+    exit(1);
+  }
+  return array;
+}
+
+static char*
+copy_string(const char* s)
+{
+  char* copy = strdup(s);
+
+  if (!copy) {
+    fprintf(stderr, "APEX_Error : Out of memory\n");
+    exit(1);
+  }
+  return copy;
+}
+
+static char*
+skip_blanks(const char* s)
+{
+  while (*s == ' ' || *s == '\t') {
+    s++;
+  }
+  return (char*)s;
+}
+
+/* Strips leading and trailing white space in place */
+static char*
+trim(char* s)
+{
+  char* end;
+
+  s = skip_blanks(s);
+  end = s + strlen(s);
+  while (end > s && isspace((unsigned char)end[-1])) {
+    *--end = '\0';
+  }
+  return s;
+}
+
+static int
+is_ident_start(char c)
+{
+  return isalpha((unsigned char)c) || c == '_';
+}
+
+static int
+is_ident_char(char c)
+{
+  return isalnum((unsigned char)c) || c == '_';
+}
+
+/* Returns 1 if the word of length len is exactly the directive name */
+static int
+is_word(const char* s, size_t len, const char* name)
+{
+  return strlen(name) == len && strncmp(s, name, len) == 0;
+}
+
+static int
+is_register_name(const char* name, size_t len)
+{
+  if (len < 2 || (name[0] != 'R' && name[0] != 'r')) {
+    return 0;
+  }
+  for (size_t i = 1; i < len; ++i) {
+    if (!isdigit((unsigned char)name[i])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static unsigned int
+hash_name(const char* name, size_t len)
+{
+  unsigned int hash = 2166136261U;
+
+  for (size_t i = 0; i < len; ++i) {
+    hash = (hash ^ (unsigned char)name[i]) * 16777619U;
+  }
+  return hash % SYMBOL_BUCKETS;
+}
+
+static Symbol*
+find_symbol(Assembler* as, const char* name, size_t len)
+{
+  for (int i = as->bucket[hash_name(name, len)]; i >= 0;
+       i = as->symbols[i].next) {
+    if (is_word(name, len, as->symbols[i].name)) {
+      return &as->symbols[i];
+    }
+  }
+  return NULL;
+}
+
+static void
+define_symbol(Assembler* as, const char* name, size_t len, long value,
+              int kind)
+{
+  Symbol* symbol;
+  unsigned int hash = hash_name(name, len);
+
+  if (len >= APEXO_SYMBOL_NAME) {
+    asm_error(as, "'%.*s' is longer than %d characters", (int)len, name,
+              APEXO_SYMBOL_NAME - 1);
+    return;
+  }
+  if (is_register_name(name, len)) {
+    asm_error(as, "'%.*s' is a register name", (int)len, name);
+    return;
+  }
+  if (find_symbol(as, name, len)) {
+    asm_error(as, "'%.*s' is already defined", (int)len, name);
+    return;
+  }
+
+  as->symbols = grow(as->symbols, &as->symbol_capacity, as->symbol_count,
+                     sizeof(*as->symbols));
+  symbol = &as->symbols[as->symbol_count];
+  memcpy(symbol->name, name, len);
+  symbol->name[len] = '\0';
+  symbol->value = value;
+  symbol->kind = kind;
+  symbol->next = as->bucket[hash];
+  as->bucket[hash] = as->symbol_count++;
+}
+
+static Macro*
+find_macro(Assembler* as, const char* name, size_t len)
+{
+  for (int i = 0; i < as->macro_count; ++i) {
+    if (is_word(name, len, as->macros[i].name)) {
+      return &as->macros[i];
+    }
+  }
+  return NULL;
+}
+
+/* Expression parser, one function per precedence level */
+typedef struct Expr
+{
+  Assembler* as;
+  const char* p;
+  int ok;
+} Expr;
+
+static long
+parse_or(Expr* e);
+
+static void
+expr_error(Expr* e, const char* message, const char* at)
+{
+  if (e->ok) {
+    if (*at) {
+      asm_error(e->as, "%s at '%s'", message, at);
+    } else {
+      asm_error(e->as, "%s at end of expression", message);
+    }
+  }
+  e->ok = 0;
+}
+
+static long
+parse_primary(Expr* e)
+{
+  const char* start;
+  long value = 0;
+
+  e->p = skip_blanks(e->p);
+  start = e->p;
+
+  if (*e->p == '(') {
+    e->p++;
+    value = parse_or(e);
+    e->p = skip_blanks(e->p);
+    if (*e->p != ')') {
+      expr_error(e, "expected ')'", e->p);
+      return 0;
+    }
+    e->p++;
+    return value;
+  }
+
+  if (isdigit((unsigned char)*e->p)) {
+    char* end;
+    int base = 10;
+
+    if (e->p[0] == '0' && (e->p[1] == 'x' || e->p[1] == 'X')) {
+      base = 16;
+      e->p += 2;
+    } else if (e->p[0] == '0' && (e->p[1] == 'b' || e->p[1] == 'B')) {
+      base = 2;
+      e->p += 2;
+    }
+    value = (long)strtoul(e->p, &end, base);
+    if (end == e->p || is_ident_char(*end)) {
+      expr_error(e, "malformed number", start);
+      return 0;
+    }
+    e->p = end;
+    return value;
+  }
+
+  if (is_ident_start(*e->p)) {
+    Symbol* symbol;
+
+    while (is_ident_char(*e->p)) {
+      e->p++;
+    }
+    symbol = find_symbol(e->as, start, e->p - start);
+    if (!symbol) {
+      if (e->ok) {
+        asm_error(e->as, "'%.*s' is not defined", (int)(e->p - start), start);
+      }
+      e->ok = 0;
+      return 0;
+    }
+    return symbol->value;
+  }
+
+  expr_error(e, "expected a number or symbol", start);
+  return 0;
+}
+
+static long
+parse_unary(Expr* e)
+{
+  e->p = skip_blanks(e->p);
+
+  if (*e->p == '-') {
+    e->p++;
+    return -parse_unary(e);
+  }
+  if (*e->p == '+') {
+    e->p++;
+    return parse_unary(e);
+  }
+  if (*e->p == '~') {
+    e->p++;
+    return ~parse_unary(e);
+  }
+  return parse_primary(e);
+}
+
+static long
+parse_mul(Expr* e)
+{
+  long value = parse_unary(e);
+
+  for (;;) {
+    char op;
+    long rhs;
+
+    e->p = skip_blanks(e->p);
+    op = *e->p;
+    if (op != '*' && op != '/' && op != '%') {
+      return value;
+    }
+    e->p++;
+    rhs = parse_unary(e);
+    if (op == '*') {
+      value *= rhs;
+    } else if (rhs == 0) {
+      if (e->ok) {
+        asm_error(e->as, "division by zero");
+      }
+      e->ok = 0;
+    } else if (op == '/') {
+      value /= rhs;
+    } else {
+      value %= rhs;
+    }
+  }
+}
+
+static long
+parse_add(Expr* e)
+{
+  long value = parse_mul(e);
+
+  for (;;) {
+    e->p = skip_blanks(e->p);
+    if (*e->p == '+') {
+      e->p++;
+      value += parse_mul(e);
+    } else if (*e->p == '-') {
+      e->p++;
+      value -= parse_mul(e);
+    } else {
+      return value;
+    }
+  }
+}
+
+static long
+parse_shift(Expr* e)
+{
+  long value = parse_add(e);
+
+  for (;;) {
+    long rhs;
+    int left;
+
+    e->p = skip_blanks(e->p);
+    if ((e->p[0] != '<' && e->p[0] != '>') || e->p[1] != e->p[0]) {
+      return value;
+    }
+    left = e->p[0] == '<';
+    e->p += 2;
+    rhs = parse_add(e);
+    if (rhs < 0 || rhs > 63) {
+      if (e->ok) {
+        asm_error(e->as, "shift count %ld out of range", rhs);
+      }
+      e->ok = 0;
+      continue;
+    }
+    value = left ? (long)((unsigned long)value << rhs) : value >> rhs;
+  }
+}
+
+static long
+parse_and(Expr* e)
+{
+  long value = parse_shift(e);
+
+  while (*(e->p = skip_blanks(e->p)) == '&') {
+    e->p++;
+    value &= parse_shift(e);
+  }
+  return value;
+}
+
+static long
+parse_xor(Expr* e)
+{
+  long value = parse_and(e);
+
+  while (*(e->p = skip_blanks(e->p)) == '^') {
+    e->p++;
+    value ^= parse_and(e);
+  }
+  return value;
+}
+
+static long
+parse_or(Expr* e)
+{
+  long value = parse_xor(e);
+
+  while (*(e->p = skip_blanks(e->p)) == '|') {
+    e->p++;
+    value |= parse_xor(e);
+  }
+  return value;
+}
+
+/*
+ * Evaluates the expression text.
+ * Returns 0 on success, -1 after reporting an error
+ */
+static int
+eval_expr(Assembler* as, const char* text, long* value)
+{
+  Expr e = { as, text, 1 };
+
+  if (!*skip_blanks(text)) {
+    asm_error(as, "expected an expression");
+    return -1;
+  }
+
+  *value = parse_or(&e);
+  e.p = skip_blanks(e.p);
+  if (e.ok && *e.p) {
+    expr_error(&e, "unexpected text", e.p);
+  }
+  return e.ok ? 0 : -1;
+}
+
+/* Values are kept if they fit 32 bits, signed or not */
+static int
+check_word(Assembler* as, long value)
+{
+  if (value < -2147483648L || value > 4294967295L) {
+    asm_error(as, "%ld does not fit in 32 bits", value);
+    return -1;
+  }
+  return 0;
+}
+
+static void
+add_item(Assembler* as, int kind, const Instruction_Format* format,
+         long address, const char* text)
+{
+  Item* item;
+
+  as->items = grow(as->items, &as->item_capacity, as->item_count,
+                   sizeof(*as->items));
+  item = &as->items[as->item_count++];
+  item->kind = kind;
+  item->format = format;
+  item->address = address;
+  item->text = copy_string(text);
+  item->line = as->line;
+  item->origin = as->origin;
+}
+
+static void
+process_line(Assembler* as, const char* source, int depth);
+
+/* Runs lines through the first pass as if they were written here */
+static void
+expand_lines(Assembler* as, Body_Line* lines, int count, int depth,
+             char** texts)
+{
+  int saved_line = as->line;
+  int saved_origin = as->origin;
+  int origin = as->origin ? as->origin : as->line;
+
+  if (depth >= MAX_EXPANSION_DEPTH) {
+    asm_error(as, "macros or repeat blocks nested too deep");
+    return;
+  }
+
+  if (as->expanded > MAX_EXPANDED_LINES) {
+    return;
+  }
+  as->expanded += count;
+  if (as->expanded > MAX_EXPANDED_LINES) {
+    asm_error(as, "macros and repeat blocks expand to more than %d lines",
+              MAX_EXPANDED_LINES);
+    return;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    as->line = lines[i].line;
+    as->origin = origin;
+    process_line(as, texts ? texts[i] : lines[i].text, depth + 1);
+  }
+
+  as->line = saved_line;
+  as->origin = saved_origin;
+}
+
+/* Returns a copy of text with \param and \@ replaced */
+static char*
+substitute(const Macro* macro, char args[][128], int unique,
+           const char* text)
+{
+  size_t capacity = strlen(text) + 1;
+  size_t len = 0;
+  char* out = malloc(capacity);
+
+  while (out && *text) {
+    const char* piece = text;
+    size_t piece_len = 1;
+    char number[16];
+
+    if (text[0] == '\\' && text[1] == '@') {
+      snprintf(number, sizeof(number), "%d", unique);
+      piece = number;
+      piece_len = strlen(number);
+      text += 2;
+    } else if (text[0] == '\\' && is_ident_start(text[1])) {
+      const char* name = text + 1;
+      size_t name_len = 0;
+
+      while (is_ident_char(name[name_len])) {
+        name_len++;
+      }
+      for (int i = 0; i < macro->param_count; ++i) {
+        if (is_word(name, name_len, macro->params[i])) {
+          piece = args[i];
+          piece_len = strlen(args[i]);
+          break;
+        }
+      }
+      text = piece == text ? text + 1 : name + name_len;
+    } else {
+      text++;
+    }
+
+    if (len + piece_len + 1 > capacity) {
+      capacity = (len + piece_len + 1) * 2;
+      out = realloc(out, capacity);
+      if (!out) {
+        break;
+      }
+    }
+    memcpy(out + len, piece, piece_len);
+    len += piece_len;
+  }
+
+  if (!out) {
+    fprintf(stderr, "APEX_Error : Out of memory\n");
+    exit(1);
+  }
+  out[len] = '\0';
+  return out;
+}
+
+static void
+expand_macro(Assembler* as, Macro* macro, char* rest, int depth)
+{
+  char args[MAX_MACRO_PARAMS][128];
+  char** texts;
+  int count = 0;
+
+  rest = trim(rest);
+  while (*rest) {
+    char* comma = strchr(rest, ',');
+    char* arg;
+
+    if (comma) {
+      *comma = '\0';
+    }
+    arg = trim(rest);
+    if (count == MAX_MACRO_PARAMS || strlen(arg) >= sizeof(args[0])) {
+      count = -1;
+      break;
+    }
+    strcpy(args[count++], arg);
+    if (!comma) {
+      break;
+    }
+    rest = comma + 1;
+  }
+
+  if (count != macro->param_count) {
+    asm_error(as, "%s takes %d arguments", macro->name, macro->param_count);
+    return;
+  }
+
+  texts = malloc(sizeof(*texts) * (macro->body_count + 1));
+  if (!texts) {
+    fprintf(stderr, "APEX_Error : Out of memory\n");
+    exit(1);
+  }
+
+  as->unique++;
+  for (int i = 0; i < macro->body_count; ++i) {
+    texts[i] = substitute(macro, args, as->unique, macro->body[i].text);
+  }
+
+  expand_lines(as, macro->body, macro->body_count, depth, texts);
+
+  for (int i = 0; i < macro->body_count; ++i) {
+    free(texts[i]);
+  }
+  free(texts);
+}
+
+static void
+start_macro(Assembler* as, char* rest)
+{
+  Macro* macro;
+  char* name = rest;
+  size_t len = 0;
+
+  while (is_ident_char(name[len])) {
+    len++;
+  }
+  if (!len || !is_ident_start(*name) || len >= APEXO_SYMBOL_NAME) {
+    asm_error(as, ".macro needs a name");
+    return;
+  }
+  if (find_macro(as, name, len) || find_instruction_format(name, len)) {
+    asm_error(as, "'%.*s' is already an instruction or macro", (int)len,
+              name);
+    return;
+  }
+
+  as->macros = grow(as->macros, &as->macro_capacity, as->macro_count,
+                    sizeof(*as->macros));
+  macro = &as->macros[as->macro_count];
+  memset(macro, 0, sizeof(*macro));
+  memcpy(macro->name, name, len);
+
+  rest = skip_blanks(name + len);
+  while (*rest) {
+    size_t param_len = 0;
+
+    if (*rest == ',') {
+      rest = skip_blanks(rest + 1);
+      continue;
+    }
+    while (is_ident_char(rest[param_len])) {
+      param_len++;
+    }
+    if (!param_len || param_len >= APEXO_SYMBOL_NAME ||
+        macro->param_count == MAX_MACRO_PARAMS) {
+      asm_error(as, "bad parameter list for %s", macro->name);
+      return;
+    }
+    memcpy(macro->params[macro->param_count++], rest, param_len);
+    rest = skip_blanks(rest + param_len);
+  }
+
+  as->macro_count++;
+  as->defining = as->macro_count;
+}
+
+static void
+add_body_line(Body_Line** body, int* count, int* capacity, const char* text,
+              int line)
+{
+  *body = grow(*body, capacity, *count, sizeof(**body));
+  (*body)[*count].text = copy_string(text);
+  (*body)[*count].line = line;
+  (*count)++;
+}
+
+static void
+free_body(Body_Line* body, int count)
+{
+  for (int i = 0; i < count; ++i) {
+    free(body[i].text);
+  }
+  free(body);
+}
+
+/* Collects a line of a .rept block, expanding it at the matching .endr */
+static void
+collect_rept(Assembler* as, const char* source, const char* s, int depth)
+{
+  Body_Line* body;
+  int saved_line = as->line;
+  int count;
+  long times;
+
+  if (strncmp(s, ".rept", 5) == 0 && !is_ident_char(s[5])) {
+    as->rept_depth++;
+  } else if (strncmp(s, ".endr", 5) == 0 && !is_ident_char(s[5])) {
+    as->rept_depth--;
+  }
+
+  if (as->rept_depth) {
+    add_body_line(&as->rept, &as->rept_count, &as->rept_capacity, source,
+                  as->line);
+    return;
+  }
+
+  /* Nested blocks are collected again while this one expands */
+  body = as->rept;
+  count = as->rept_count;
+  times = as->rept_times;
+  as->rept = NULL;
+  as->rept_count = 0;
+  as->rept_capacity = 0;
+
+  as->line = as->rept_line;
+  for (long i = 0; i < times && as->errors <= MAX_REPORTED_ERRORS &&
+                   as->expanded <= MAX_EXPANDED_LINES;
+       ++i) {
+    expand_lines(as, body, count, depth, NULL);
+  }
+  as->line = saved_line;
+  free_body(body, count);
+}
+
+static void
+directive(Assembler* as, char* s)
+{
+  char* rest = s + 1;
+  size_t len;
+  long value;
+
+  while (is_ident_char(*rest)) {
+    rest++;
+  }
+  len = rest - s;
+  rest = skip_blanks(rest);
+
+  if (is_word(s, len, ".text") && !*rest) {
+    as->in_data = 0;
+  } else if (is_word(s, len, ".data")) {
+    as->in_data = 1;
+    if (*rest && eval_expr(as, rest, &value) == 0) {
+      if (value < 0 || value > 4294967295L) {
+        asm_error(as, "data address %ld out of range", value);
+      } else {
+        as->data_pc = value;
+      }
+    }
+  } else if (is_word(s, len, ".word") || is_word(s, len, ".space")) {
+    if (!as->in_data) {
+      asm_error(as, "%.*s belongs in .data", (int)len, s);
+    } else if (s[1] == 's') {
+      if (eval_expr(as, rest, &value) == 0) {
+        if (value < 0 || as->data_pc + value > 4294967296L) {
+          asm_error(as, ".space of %ld words out of range", value);
+        } else {
+          as->data_pc += value;
+        }
+      }
+    } else {
+      while (1) {
+        char* comma = strchr(rest, ',');
+
+        if (comma) {
+          *comma = '\0';
+        }
+        if (as->data_pc >= 4294967296L) {
+          asm_error(as, ".word at address %ld out of range", as->data_pc);
+          break;
+        }
+        add_item(as, ITEM_WORD, NULL, as->data_pc++, trim(rest));
+        if (!comma) {
+          break;
+        }
+        rest = comma + 1;
+      }
+    }
+  } else if (is_word(s, len, ".equ")) {
+    char* name = rest;
+    size_t name_len = 0;
+
+    while (is_ident_char(name[name_len])) {
+      name_len++;
+    }
+    rest = skip_blanks(name + name_len);
+    if (!name_len || !is_ident_start(*name) || *rest != ',') {
+      asm_error(as, ".equ needs a name and a value");
+    } else if (eval_expr(as, rest + 1, &value) == 0) {
+      define_symbol(as, name, name_len, value, SYMBOL_CONST);
+    }
+  } else if (is_word(s, len, ".macro")) {
+    start_macro(as, rest);
+  } else if (is_word(s, len, ".rept")) {
+    if (eval_expr(as, rest, &value) == 0) {
+      if (value < 0) {
+        asm_error(as, ".rept count %ld is negative", value);
+        value = 0;
+      }
+      as->rept_times = value;
+      as->rept_depth = 1;
+      as->rept_line = as->line;
+    }
+  } else if (is_word(s, len, ".endm") || is_word(s, len, ".endr")) {
+    asm_error(as, "%.*s without a matching %s", (int)len, s,
+              s[4] == 'm' ? ".macro" : ".rept");
+  } else {
+    asm_error(as, "unknown directive '%.*s'", (int)len, s);
+  }
+}
+
+static void
+statement(Assembler* as, char* s, int depth)
+{
+  const Instruction_Format* format;
+  Macro* macro;
+  char name[8];
+  char* rest = s;
+  size_t len;
+
+  while (is_ident_char(*rest) || *rest == '-') {
+    rest++;
+  }
+  len = rest - s;
+  rest = skip_blanks(rest);
+  if (*rest == ',') {
+    rest++;
+  } else if (rest == s + len && *rest) {
+    asm_error(as, "unexpected '%c'", *rest);
+    return;
+  }
+
+  macro = find_macro(as, s, len);
+  if (macro) {
+    expand_macro(as, macro, rest, depth);
+    return;
+  }
+
+  for (size_t i = 0; i < len && i < sizeof(name); ++i) {
+    name[i] = toupper((unsigned char)s[i]);
+  }
+  format = len < sizeof(name) ? find_instruction_format(name, len) : NULL;
+  if (!format) {
+    asm_error(as, "unknown instruction or macro '%.*s'", (int)len, s);
+    return;
+  }
+  if (as->in_data) {
+    asm_error(as, "%s belongs in .text", format->name);
+    return;
+  }
+
+  add_item(as, ITEM_INSTRUCTION, format, CODE_BASE + 4L * as->code_count,
+           rest);
+  as->code_count++;
+}
+
+static void
+process_line(Assembler* as, const char* source, int depth)
+{
+  char* copy = copy_string(source);
+  char* comment = strchr(copy, ';');
+  char* s;
+
+  if (comment) {
+    *comment = '\0';
+  }
+  s = trim(copy);
+
+  if (as->defining) {
+    Macro* macro = &as->macros[as->defining - 1];
+
+    if (strncmp(s, ".endm", 5) == 0 && !is_ident_char(s[5])) {
+      as->defining = 0;
+    } else if (strncmp(s, ".macro", 6) == 0 && !is_ident_char(s[6])) {
+      asm_error(as, ".macro inside the body of %s", macro->name);
+    } else {
+      add_body_line(&macro->body, &macro->body_count, &macro->body_capacity,
+                    source, as->line);
+    }
+    free(copy);
+    return;
+  }
+
+  if (as->rept_depth) {
+    collect_rept(as, source, s, depth);
+    free(copy);
+    return;
+  }
+
+  /* Labels, any number of them */
+  while (is_ident_start(*s)) {
+    char* end = s;
+    char* after;
+
+    while (is_ident_char(*end)) {
+      end++;
+    }
+    after = skip_blanks(end);
+    if (*after != ':') {
+      break;
+    }
+    if (as->in_data) {
+      define_symbol(as, s, end - s, as->data_pc, SYMBOL_DATA);
+    } else {
+      define_symbol(as, s, end - s, CODE_BASE + 4L * as->code_count,
+                    SYMBOL_CODE);
+    }
+    s = skip_blanks(after + 1);
+  }
+
+  if (*s == '.') {
+    directive(as, s);
+  } else if (*s) {
+    statement(as, s, depth);
+  }
+  free(copy);
+}
+
+static int
+parse_register(Assembler* as, const char* text, int* reg)
+{
+  size_t len = strlen(text);
+  long value = 0;
+
+  if (!is_register_name(text, len)) {
+    asm_error(as, "expected a register like R1, not '%s'", text);
+    return -1;
+  }
+  for (size_t i = 1; i < len && value < ISA_REGS; ++i) {
+    value = value * 10 + (text[i] - '0');
+  }
+  if (value >= ISA_REGS) {
+    asm_error(as, "register must be R0 to R%d", ISA_REGS - 1);
+    return -1;
+  }
+  *reg = (int)value;
+  return 0;
+}
+
+static void
+encode_instruction(Assembler* as, const Item* item, APEX_Instruction* ins)
+{
+  const Instruction_Format* format = item->format;
+  char* operands[4];
+  char* text = item->text;
+  int count = 0;
+
+  memset(ins, 0, sizeof(*ins));
+  memcpy(ins->opcode, format->name, sizeof(ins->opcode));
+  ins->op = format->op;
+
+  while (*text && count < 4) {
+    char* comma = strchr(text, ',');
+
+    if (comma) {
+      *comma = '\0';
+    }
+    operands[count++] = trim(text);
+    if (!comma) {
+      break;
+    }
+    text = comma + 1;
+  }
+
+  /* A trailing comma, as in "HALT,", is accepted */
+  if (count && !*operands[count - 1] && count == format->count + 1) {
+    count--;
+  }
+  if (count != format->count) {
+    asm_error(as, "%s takes %d operands", format->name, format->count);
+    return;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    const char* operand = operands[i];
+    long value;
+
+    if (format->slot[i] == SLOT_RD) {
+      parse_register(as, operand, &ins->rd);
+    } else if (format->slot[i] == SLOT_RS1) {
+      parse_register(as, operand, &ins->rs1);
+    } else if (format->slot[i] == SLOT_RS2) {
+      parse_register(as, operand, &ins->rs2);
+    } else if (eval_expr(as, operand + (*operand == '#'), &value) == 0) {
+      /* A branch target becomes an offset from the branch */
+      if (*operand != '#' &&
+          (format->op == OP_BZ || format->op == OP_BNZ)) {
+        value -= item->address;
+      }
+      if (check_word(as, value) == 0) {
+        ins->imm = (int)value;
+      }
+    }
+  }
+}
+
+static int
+build_output(Assembler* as, Assembly* out)
+{
+  long low = 0;
+  long high = -1;
+
+  out->code = calloc(as->code_count ? as->code_count : 1, sizeof(*out->code));
+  if (!out->code) {
+    return -1;
+  }
+
+  for (int i = 0; i < as->item_count; ++i) {
+    Item* item = &as->items[i];
+
+    if (item->kind == ITEM_WORD) {
+      if (high < low || item->address < low) {
+        low = item->address;
+      }
+      if (item->address > high) {
+        high = item->address;
+      }
+    }
+  }
+
+  if (high >= low) {
+    if (high - low + 1 > MAX_DATA_WORDS) {
+      as->line = 0;
+      as->origin = 0;
+      fprintf(stderr, "APEX_Error : %s: data spans more than %d words\n",
+              as->filename, MAX_DATA_WORDS);
+      return -1;
+    }
+    out->data_base = low;
+    out->data_count = high - low + 1;
+    out->data = calloc(out->data_count, sizeof(*out->data));
+    if (!out->data) {
+      return -1;
+    }
+  }
+
+  for (int i = 0; i < as->item_count; ++i) {
+    Item* item = &as->items[i];
+    long value;
+
+    as->line = item->line;
+    as->origin = item->origin;
+
+    if (item->kind == ITEM_INSTRUCTION) {
+      encode_instruction(as, item,
+                         &out->code[(item->address - CODE_BASE) / 4]);
+    } else if (eval_expr(as, item->text, &value) == 0 &&
+               check_word(as, value) == 0) {
+      out->data[item->address - low] = (int32_t)value;
+    }
+  }
+  out->code_count = as->code_count;
+
+  out->symbols = calloc(as->symbol_count ? as->symbol_count : 1,
+                        sizeof(*out->symbols));
+  if (!out->symbols) {
+    return -1;
+  }
+  for (int i = 0; i < as->symbol_count; ++i) {
+    memcpy(out->symbols[i].name, as->symbols[i].name,
+           sizeof(out->symbols[i].name));
+    out->symbols[i].value = (int32_t)as->symbols[i].value;
+    out->symbols[i].kind = as->symbols[i].kind;
+  }
+  out->symbol_count = as->symbol_count;
+  return 0;
+}
+
+static void
+free_assembler(Assembler* as)
+{
+  for (int i = 0; i < as->macro_count; ++i) {
+    free_body(as->macros[i].body, as->macros[i].body_count);
+  }
+  for (int i = 0; i < as->item_count; ++i) {
+    free(as->items[i].text);
+  }
+  free_body(as->rept, as->rept_count);
+  free(as->macros);
+  free(as->items);
+  free(as->symbols);
+}
+
+/*
+ * Assembles filename into out.
+ * Returns 0 on success, -1 after reporting the errors
+ */
+int
+assemble(const char* filename, Assembly* out)
+{
+  Assembler as;
+  char* line = NULL;
+  size_t len = 0;
+  FILE* fp;
+  int status = -1;
+
+  memset(out, 0, sizeof(*out));
+  memset(&as, 0, sizeof(as));
+  memset(as.bucket, -1, sizeof(as.bucket));
+  as.filename = filename;
+
+  fp = fopen(filename, "r");
+  if (!fp) {
+    perror(filename);
+    return -1;
+  }
+
+  while (getline(&line, &len, fp) != -1) {
+    as.line++;
+    process_line(&as, line, 0);
+  }
+  free(line);
+  fclose(fp);
+
+  if (as.defining) {
+    asm_error(&as, "missing .endm for %s", as.macros[as.defining - 1].name);
+  }
+  if (as.rept_depth) {
+    asm_error(&as, "missing .endr");
+  }
+  if (!as.errors && !as.code_count) {
+    asm_error(&as, "no instructions");
+  }
+
+  /* The second pass runs after errors too, so they are all reported */
+  if (as.code_count) {
+    status = build_output(&as, out);
+  }
+  if (as.errors > MAX_REPORTED_ERRORS) {
+    fprintf(stderr, "APEX_Error : %s: %d errors in total\n", filename,
+            as.errors);
+  }
+  if (as.errors) {
+    status = -1;
+  }
+
+  free_assembler(&as);
+  if (status) {
+    assembly_free(out);
+  }
+  return status;
+}
+
+void
+assembly_free(Assembly* out)
+{
+  free(out->code);
+  free(out->data);
+  free(out->symbols);
+  memset(out, 0, sizeof(*out));
+}
@@ -0,0 +1,32 @@
+#ifndef _APEX_ASSEMBLER_H_
+#define _APEX_ASSEMBLER_H_
+/**
+ *  assembler.h
+ *  Contains the assembler behind apex_as. On top of the instruction
+ *  format read by create_code_memory it understands comments, labels,
+ *  constants, a data section, macros and repeat blocks; see assembler.c
+ */
+#include <stdint.h>
+
+#include "isa.h"
+#include "object.h"
+
+/* Result of assembling a program */
+typedef struct Assembly
+{
+  APEX_Instruction* code;
+  int code_count;
+  int32_t* data;		// Words from data_base, zeroes in between
+  int data_count;
+  uint32_t data_base;
+  Apexo_Symbol* symbols;
+  int symbol_count;
+} Assembly;
+
+int
+assemble(const char* filename, Assembly* out);
+
+void
+assembly_free(Assembly* out);
+
+#endif
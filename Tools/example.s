@@ -0,0 +1,31 @@
+; Sums a table of words with a macro and a repeat block
+        .equ N, 8
+        .equ STRIDE, 1
+
+        .macro ADDN dst, src, amount
+        ADDL \dst, \src, #\amount
+        .endm
+
+        .data 100
+table:  .word 1, 2, 3, 4
+        .word 0x10, -1, (3 << 2) | 1, N * 2
+        .space 4
+tail:   .word end - start, table
+
+        .text
+start:  MOVC R1, #table        ; pointer
+        MOVC R7, #1             ; SUB sets the zero flag, SUBL does not
+        MOVC R2, #N            ; count
+        MOVC R3, #0            ; sum
+loop:   LOAD R4, R1, #0
+        ADD R3, R3, R4
+        ADDN R1, R1, STRIDE
+        SUB R2, R2, R7
+        BNZ loop
+        MOVC R5, #tail
+        .rept 2
+        LOAD R6, R5, #0
+        ADDL R5, R5, #1
+        .endr
+        STORE R3, R0, #200
+end:    HALT
@@ -0,0 +1,372 @@
+/*
+ *  file_parser.c
+ *  Contains functions to parse input file and create
+ *  code memory, you can edit this file to add new instructions
+ *
+ *  The file is mapped and parsed in a single pass, one line per
+ *  instruction, into a code memory array that grows as needed. Blank
+ *  lines are skipped. A malformed line is reported with its line and
+ *  column and the whole program is rejected.
+ *
+ *  Author :
+ *  Gaurav Kothari (gkothar1@binghamton.edu)
+ *  State University of New York, Binghamton
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "isa.h"
+
+/* Errors reported before the parser stops listing them */
+#define MAX_REPORTED_ERRORS 20
+
+/*
+ * Note : you can add new instructions to this table, in the order of
+ * their OP_* value, which indexes it
+ */
+static const Instruction_Format formats[] = {
+  { "MOVC", sizeof("MOVC") - 1, OP_MOVC, 2, { SLOT_RD, SLOT_IMM } },
+  { "STORE", sizeof("STORE") - 1, OP_STORE, 3, { SLOT_RS1, SLOT_RS2, SLOT_IMM } },
+  { "STR", sizeof("STR") - 1, OP_STR, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "ADD", sizeof("ADD") - 1, OP_ADD, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "ADDL", sizeof("ADDL") - 1, OP_ADDL, 3, { SLOT_RD, SLOT_RS1, SLOT_IMM } },
+  { "SUB", sizeof("SUB") - 1, OP_SUB, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "SUBL", sizeof("SUBL") - 1, OP_SUBL, 3, { SLOT_RD, SLOT_RS1, SLOT_IMM } },
+  { "MUL", sizeof("MUL") - 1, OP_MUL, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "LOAD", sizeof("LOAD") - 1, OP_LOAD, 3, { SLOT_RD, SLOT_RS1, SLOT_IMM } },
+  { "LDR", sizeof("LDR") - 1, OP_LDR, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "AND", sizeof("AND") - 1, OP_AND, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "OR", sizeof("OR") - 1, OP_OR, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "EX-OR", sizeof("EX-OR") - 1, OP_EXOR, 3, { SLOT_RD, SLOT_RS1, SLOT_RS2 } },
+  { "BZ", sizeof("BZ") - 1, OP_BZ, 1, { SLOT_IMM } },
+  { "BNZ", sizeof("BNZ") - 1, OP_BNZ, 1, { SLOT_IMM } },
+  { "JUMP", sizeof("JUMP") - 1, OP_JUMP, 2, { SLOT_RS1, SLOT_IMM } },
+  { "HALT", sizeof("HALT") - 1, OP_HALT, 0, { 0 } },
+};
+
+/* State of the single pass over the mapped file */
+typedef struct Parser
+{
+  const char* filename;
+  const char* cur;
+  const char* end;
+  const char* line_start;
+  int line;
+  int errors;
+} Parser;
+
+static void
+parse_error(Parser* p, const char* at, const char* fmt, ...)
+{
+  va_list args;
+
+  if (++p->errors > MAX_REPORTED_ERRORS) {
+    return;
+  }
+
+  fprintf(stderr, "APEX_Error : %s:%d:%d: ", p->filename, p->line,
+          (int)(at - p->line_start) + 1);
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  va_end(args);
+  fprintf(stderr, "\n");
+}
+
+static int
+at_line_end(const Parser* p)
+{
+  return p->cur == p->end || *p->cur == '\n' || *p->cur == '\r';
+}
+
+static void
+skip_blanks(Parser* p)
+{
+  while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) {
+    p->cur++;
+  }
+}
+
+static void
+skip_line(Parser* p)
+{
+  const char* nl = memchr(p->cur, '\n', p->end - p->cur);
+
+  p->cur = nl ? nl + 1 : p->end;
+  p->line_start = p->cur;
+  p->line++;
+}
+
+/* Returns the format of the opcode name of length len, NULL if unknown */
+const Instruction_Format*
+find_instruction_format(const char* name, size_t len)
+{
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    if (formats[i].len == len && formats[i].name[0] == name[0] &&
+        memcmp(formats[i].name, name, len) == 0) {
+      return &formats[i];
+    }
+  }
+  return NULL;
+}
+
+/* Returns the format of op, NULL if op is not an opcode */
+const Instruction_Format*
+instruction_format(int op)
+{
+  if (op < 0 || op >= (int)(sizeof(formats) / sizeof(formats[0]))) {
+    return NULL;
+  }
+  return &formats[op];
+}
+
+/* Returns the mnemonic of op, NULL if op is not an opcode */
+const char*
+opcode_name(int op)
+{
+  const Instruction_Format* format = instruction_format(op);
+
+  return format ? format->name : NULL;
+}
+
+/*
+ * Parses a decimal number, with an optional sign if allowed.
+ * Returns 0 on success, -1 if there are no digits or it overflows min/max
+ */
+static int
+parse_number(Parser* p, int allow_sign, long min, long max, long* value)
+{
+  int negative = 0;
+  long limit;
+  long n = 0;
+
+  if (allow_sign && p->cur < p->end && (*p->cur == '-' || *p->cur == '+')) {
+    negative = *p->cur == '-';
+    p->cur++;
+  }
+
+  if (p->cur == p->end || *p->cur < '0' || *p->cur > '9') {
+    return -1;
+  }
+
+  limit = negative ? -min : max;
+  while (p->cur < p->end && *p->cur >= '0' && *p->cur <= '9') {
+    n = n * 10 + (*p->cur - '0');
+    if (n > limit) {
+      return -1;
+    }
+    p->cur++;
+  }
+
+  *value = negative ? -n : n;
+  return 0;
+}
+
+/* Parses an operand into its slot of ins. Returns 0 on success */
+static int
+parse_operand(Parser* p, APEX_Instruction* ins, int slot)
+{
+  const char* start = p->cur;
+  long value;
+
+  if (slot == SLOT_IMM) {
+    if (p->cur == p->end || *p->cur != '#') {
+      parse_error(p, start, "expected a literal like #4");
+      return -1;
+    }
+    p->cur++;
+    if (parse_number(p, 1, INT_MIN, INT_MAX, &value)) {
+      parse_error(p, start, "literal is not a 32-bit integer");
+      return -1;
+    }
+    ins->imm = (int)value;
+    return 0;
+  }
+
+  if (p->cur == p->end || *p->cur != 'R') {
+    parse_error(p, start, "expected a register like R1");
+    return -1;
+  }
+  p->cur++;
+  if (parse_number(p, 0, 0, ISA_REGS - 1, &value)) {
+    parse_error(p, start, "register must be R0 to R%d", ISA_REGS - 1);
+    return -1;
+  }
+
+  if (slot == SLOT_RD) {
+    ins->rd = (int)value;
+  } else if (slot == SLOT_RS1) {
+    ins->rs1 = (int)value;
+  } else {
+    ins->rs2 = (int)value;
+  }
+  return 0;
+}
+
+/*
+ * Parses the instruction on the current line into ins.
+ * Returns 1 if an instruction was parsed, 0 for a blank line, -1 on error
+ */
+static int
+parse_line(Parser* p, APEX_Instruction* ins)
+{
+  const Instruction_Format* format;
+  const char* start;
+
+  skip_blanks(p);
+  if (at_line_end(p)) {
+    return 0;
+  }
+
+  start = p->cur;
+  while (p->cur < p->end && ((*p->cur >= 'A' && *p->cur <= 'Z') ||
+                             *p->cur == '-')) {
+    p->cur++;
+  }
+
+  format = find_instruction_format(start, p->cur - start);
+  if (!format) {
+    parse_error(p, start, "unknown opcode");
+    return -1;
+  }
+
+  memcpy(ins->opcode, format->name, sizeof(ins->opcode));
+  ins->op = format->op;
+  ins->rd = ins->rs1 = ins->rs2 = ins->imm = 0;
+
+  for (int i = 0; i < format->count; ++i) {
+    skip_blanks(p);
+    if (p->cur == p->end || *p->cur != ',') {
+      parse_error(p, p->cur, "%s takes %d operands", format->name,
+                  format->count);
+      return -1;
+    }
+    p->cur++;
+    skip_blanks(p);
+    if (parse_operand(p, ins, format->slot[i])) {
+      return -1;
+    }
+  }
+
+  /* A trailing comma, as in "HALT,", is accepted */
+  skip_blanks(p);
+  if (p->cur < p->end && *p->cur == ',') {
+    p->cur++;
+    skip_blanks(p);
+  }
+  if (!at_line_end(p)) {
+    parse_error(p, p->cur, "unexpected text after %s", format->name);
+    return -1;
+  }
+  return 1;
+}
+
+static APEX_Instruction*
+parse_program(Parser* p, int* size)
+{
+  /* The shortest instruction line, "HALT" and its newline, takes 5 bytes,
+   * so this is normally never grown. Pages of the array that are never
+   * written are never touched either
+   */
+  long estimate = (p->end - p->cur) / 5 + 1;
+  int capacity = estimate < INT_MAX / 2 ? (int)estimate : INT_MAX / 2;
+  int count = 0;
+  APEX_Instruction* code_memory = malloc(sizeof(*code_memory) * capacity);
+
+  if (!code_memory) {
+    return NULL;
+  }
+
+  while (p->cur < p->end) {
+    if (count == capacity) {
+      APEX_Instruction* grown;
+
+      if (capacity > INT_MAX / 2) {
+        parse_error(p, p->cur, "too many instructions");
+        break;
+      }
+      capacity *= 2;
+      grown = realloc(code_memory, sizeof(*code_memory) * capacity);
+      if (!grown) {
+        free(code_memory);
+        return NULL;
+      }
+      code_memory = grown;
+    }
+
+    if (parse_line(p, &code_memory[count]) > 0) {
+      count++;
+    }
+    skip_line(p);
+  }
+
+  if (p->errors > MAX_REPORTED_ERRORS) {
+    fprintf(stderr, "APEX_Error : %s: %d errors in total\n", p->filename,
+            p->errors);
+  }
+
+  if (!count && !p->errors) {
+    fprintf(stderr, "APEX_Error : %s: no instructions\n", p->filename);
+  }
+
+  if (!count || p->errors) {
+    free(code_memory);
+    return NULL;
+  }
+
+  *size = count;
+  return realloc(code_memory, sizeof(*code_memory) * count) ?: code_memory;
+}
+
+/*
+ * This function is related to parsing input file
+ *
+ * Note : You are not supposed to edit this function
+ */
+APEX_Instruction*
+create_code_memory(const char* filename, int* size)
+{
+  APEX_Instruction* code_memory;
+  Parser parser;
+  struct stat st;
+  char* map;
+  int fd;
+
+  if (!filename) {
+    return NULL;
+  }
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  if (fstat(fd, &st) || st.st_size == 0) {
+    fprintf(stderr, "APEX_Error : %s: no instructions\n", filename);
+    close(fd);
+    return NULL;
+  }
+
+  map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return NULL;
+  }
+
+  memset(&parser, 0, sizeof(parser));
+  parser.filename = filename;
+  parser.cur = map;
+  parser.end = map + st.st_size;
+  parser.line_start = map;
+  parser.line = 1;
+
+  code_memory = parse_program(&parser, size);
+  munmap(map, st.st_size);
+  return code_memory;
+}
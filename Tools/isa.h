@@ -0,0 +1,80 @@
+#ifndef _APEX_ISA_H_
+#define _APEX_ISA_H_
+/**
+ *  isa.h
+ *  Contains the APEX instruction format shared by the simulators, the
+ *  program loaders and apex_as
+ */
+#include <stddef.h>
+
+/* Registers an instruction can name, R0 to R15 */
+#define ISA_REGS 16
+
+/* Opcodes of the instruction set */
+enum
+{
+  OP_MOVC,
+  OP_STORE,
+  OP_STR,
+  OP_ADD,
+  OP_ADDL,
+  OP_SUB,
+  OP_SUBL,
+  OP_MUL,
+  OP_LOAD,
+  OP_LDR,
+  OP_AND,
+  OP_OR,
+  OP_EXOR,
+  OP_BZ,
+  OP_BNZ,
+  OP_JUMP,
+  OP_HALT
+};
+
+/* Format of an APEX instruction  */
+typedef struct APEX_Instruction
+{
+  char opcode[8];	// Operation Code
+  int op;		    // Operation Code, one of OP_*
+  int rd;		    // Destination Register Address
+  int rs1;		    // Source-1 Register Address
+  int rs2;		    // Source-2 Register Address
+  int imm;		    // Literal Value
+} APEX_Instruction;
+
+/* Number of OP_* values */
+#define NUM_OPCODES (OP_HALT + 1)
+
+/* Fields an operand is stored in */
+enum
+{
+  SLOT_RD,
+  SLOT_RS1,
+  SLOT_RS2,
+  SLOT_IMM
+};
+
+/* Operands of an instruction, in the order they are written */
+typedef struct Instruction_Format
+{
+  char name[8];
+  size_t len;
+  int op;
+  int count;
+  int slot[3];
+} Instruction_Format;
+
+APEX_Instruction*
+create_code_memory(const char* filename, int* size);
+
+const char*
+opcode_name(int op);
+
+const Instruction_Format*
+find_instruction_format(const char* name, size_t len);
+
+const Instruction_Format*
+instruction_format(int op);
+
+#endif
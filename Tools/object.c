@@ -0,0 +1,202 @@
+/*
+ *  object.c
+ *  Contains functions to write and map .apexo objects.
+ *
+ *  The code of a mapped object is checked once, so the simulators can
+ *  trust it as much as code memory built by the text loader.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "object.h"
+
+/* Returns 1 if count items of size bytes at offset lie inside the file */
+static int
+in_file(const Apexo_Object* object, uint32_t offset, uint32_t count,
+        size_t size, size_t align)
+{
+  return offset % align == 0 &&
+         (uint64_t)offset + (uint64_t)count * size <= object->size;
+}
+
+static int
+check_instruction(const APEX_Instruction* ins)
+{
+  const char* name = opcode_name(ins->op);
+
+  return name && strncmp(ins->opcode, name, sizeof(ins->opcode)) == 0 &&
+         ins->rd >= 0 && ins->rd < ISA_REGS && ins->rs1 >= 0 &&
+         ins->rs1 < ISA_REGS && ins->rs2 >= 0 && ins->rs2 < ISA_REGS;
+}
+
+static int
+check_object(Apexo_Object* object, const char* filename)
+{
+  const Apexo_Header* header = object->header;
+  const char* base = object->map;
+
+  if (header->version != APEXO_VERSION ||
+      header->instruction_size != sizeof(APEX_Instruction)) {
+    fprintf(stderr, "APEX_Error : %s: object version %u is not supported\n",
+            filename, header->version);
+    return -1;
+  }
+
+  if (!header->code_count ||
+      !in_file(object, header->code_offset, header->code_count,
+               sizeof(APEX_Instruction), sizeof(int)) ||
+      !in_file(object, header->data_offset, header->data_count,
+               sizeof(int32_t), sizeof(int32_t)) ||
+      (uint64_t)header->data_base + header->data_count > (1ULL << 32) ||
+      !in_file(object, header->symbol_offset, header->symbol_count,
+               sizeof(Apexo_Symbol), sizeof(int32_t))) {
+    fprintf(stderr, "APEX_Error : %s: object is truncated or corrupt\n",
+            filename);
+    return -1;
+  }
+
+  object->code = (APEX_Instruction*)(base + header->code_offset);
+  object->data = (const int32_t*)(base + header->data_offset);
+  object->symbols = (const Apexo_Symbol*)(base + header->symbol_offset);
+
+  for (uint32_t i = 0; i < header->code_count; ++i) {
+    if (!check_instruction(&object->code[i])) {
+      fprintf(stderr, "APEX_Error : %s: instruction %u is not valid\n",
+              filename, i);
+      return -1;
+    }
+  }
+
+  /* Symbol names are printed as C strings */
+  for (uint32_t i = 0; i < header->symbol_count; ++i) {
+    if (object->symbols[i].name[APEXO_SYMBOL_NAME - 1] != '\0') {
+      fprintf(stderr, "APEX_Error : %s: symbol %u is not valid\n", filename,
+              i);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Maps filename if it is an object.
+ * Returns 0 on success, 1 if the file is not an object, -1 on error
+ */
+int
+object_open(Apexo_Object* object, const char* filename)
+{
+  char magic[sizeof(((Apexo_Header*)0)->magic)];
+  struct stat st;
+  int fd;
+
+  memset(object, 0, sizeof(*object));
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (fstat(fd, &st) || st.st_size < (off_t)sizeof(Apexo_Header) ||
+      pread(fd, magic, sizeof(magic), 0) != (ssize_t)sizeof(magic) ||
+      memcmp(magic, APEXO_MAGIC, sizeof(magic)) != 0) {
+    close(fd);
+    return 1;
+  }
+
+  object->size = st.st_size;
+  object->map = mmap(NULL, object->size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (object->map == MAP_FAILED) {
+    object->map = NULL;
+    return -1;
+  }
+  object->header = object->map;
+
+  if (check_object(object, filename)) {
+    object_close(object);
+    return -1;
+  }
+  return 0;
+}
+
+void
+object_close(Apexo_Object* object)
+{
+  if (object->map) {
+    munmap(object->map, object->size);
+  }
+  memset(object, 0, sizeof(*object));
+}
+
+/* Releases code memory, whether it was mapped from object or allocated */
+void
+object_free_code(Apexo_Object* object, APEX_Instruction* code)
+{
+  if (object->map && code == object->code) {
+    object_close(object);
+  } else {
+    free(code);
+  }
+}
+
+/*
+ * Writes an object holding the given code, data segment and symbols.
+ * Returns 0 on success, -1 on failure
+ */
+int
+object_write(const char* filename, const APEX_Instruction* code,
+             int code_count, const int32_t* data, int data_count,
+             uint32_t data_base, const Apexo_Symbol* symbols,
+             int symbol_count)
+{
+  Apexo_Header header;
+  uint64_t end;
+  FILE* fp;
+  int failed;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, APEXO_MAGIC, sizeof(header.magic));
+  header.version = APEXO_VERSION;
+  header.instruction_size = sizeof(APEX_Instruction);
+  header.code_offset = sizeof(header);
+  header.code_count = code_count;
+  header.data_offset =
+    header.code_offset + (uint64_t)code_count * sizeof(APEX_Instruction);
+  header.data_count = data_count;
+  header.data_base = data_base;
+  header.symbol_offset =
+    header.data_offset + (uint64_t)data_count * sizeof(int32_t);
+  header.symbol_count = symbol_count;
+
+  end = sizeof(header) + (uint64_t)code_count * sizeof(APEX_Instruction) +
+        (uint64_t)data_count * sizeof(int32_t) +
+        (uint64_t)symbol_count * sizeof(Apexo_Symbol);
+  if (end > UINT32_MAX) {
+    fprintf(stderr, "APEX_Error : %s: object would exceed 4 GB\n", filename);
+    return -1;
+  }
+
+  fp = fopen(filename, "wb");
+  if (!fp) {
+    perror(filename);
+    return -1;
+  }
+
+  failed = fwrite(&header, sizeof(header), 1, fp) != 1 ||
+           fwrite(code, sizeof(*code), code_count, fp) != (size_t)code_count ||
+           fwrite(data, sizeof(*data), data_count, fp) != (size_t)data_count ||
+           fwrite(symbols, sizeof(*symbols), symbol_count, fp) !=
+             (size_t)symbol_count;
+
+  if (fclose(fp) || failed) {
+    perror(filename);
+    return -1;
+  }
+  return 0;
+}